@@ -22,18 +22,20 @@
 
 #include <Autopilot.h>
 
-#include <Data.h>
+#include <cstring>
 
 #include <fdm/fdm_Exception.h>
-#include <fdm/utils/fdm_Units.h>
-
-#include <hid/hid_Manager.h>
 
 #include <sim/Log.h>
 
+#include <defs.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Autopilot::Autopilot() :
+    _btn_dn ( false ),
+    _btn_up ( false ),
+
     _autopilot ( NULLPTR ),
 
     _c172_gfc700_ap ( NULLPTR ),
@@ -42,7 +44,12 @@ Autopilot::Autopilot() :
 
     _altitude  ( 100.0 ),
     _climbRate (   0.0 )
-{}
+{
+    updateState();
+
+    _state = _stateSim;
+    _published.write( _stateSim );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -55,144 +62,43 @@ Autopilot::~Autopilot()
 
 void Autopilot::init()
 {
-    try
-    {
-        if ( !_autopilot )
-        {
-            switch ( Data::get()->aircraftType )
-            {
-            case fdm::DataInp::C172:
-                //_autopilot = _c172_gfc700_ap = new fdm::C172_GFC700_AP();
-                //_autopilot = _c172_kap140_ap = new fdm::C172_KAP140_AP();
-                _autopilot = _c172_kfc325_ap = new fdm::C172_KFC325_AP();
-                break;
-
-            default:
-                _autopilot = NULLPTR;
-                break;
-            }
-
-            if ( _autopilot ) _autopilot->initialize();
-        }
-    }
-    catch ( const fdm::Exception &e )
-    {
-        Log::e() << e.getInfo() << std::endl;
-
-        fdm::Exception et = e;
-        while ( et.hasCause() )
-        {
-            et = et.getCause();
-            Log::e() << et.getInfo() << std::endl;
-        }
-    }
+    push( Command::Init, 0.0, Data::get()->aircraftType );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::stop()
 {
-    DELPTR( _autopilot );
-
-    _c172_gfc700_ap = NULLPTR;
-    _c172_kap140_ap = NULLPTR;
-    _c172_kfc325_ap = NULLPTR;
+    push( Command::Stop );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::update( double timeStep )
+void Autopilot::update()
 {
-    if ( _autopilot )
-    {
-        if ( _c172_kfc325_ap )
-        {
-            _c172_kfc325_ap->setHeadingILS( Data::get()->navigation.ils_heading );
-        }
-
-        _autopilot->update( timeStep,
-                            Data::get()->ownship.roll,
-                            Data::get()->ownship.pitch,
-                            Data::get()->ownship.heading,
-                            Data::get()->ownship.altitude_asl,
-                            Data::get()->ownship.ias,
-                            Data::get()->ownship.turnRate,
-                            Data::get()->ownship.yawRate,
-                            Data::get()->ownship.climbRate,
-                            Data::get()->navigation.dme_distance,
-                            Data::get()->navigation.nav_deviation,
-                            Data::get()->navigation.nav_cdi != Data::Navigation::NONE,
-                            Data::get()->navigation.ils_lc_deviation,
-                            Data::get()->navigation.ils_lc_visible,
-                            Data::get()->navigation.ils_gs_deviation,
-                            Data::get()->navigation.ils_gs_visible );
-
-        if ( hid::Manager::instance()->getAP_Disc() )
-        {
-            _autopilot->disengage();
-        }
-    }
+    _published.read( &_state );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::update( double timeStep, bool btn_dn, bool btn_up )
+void Autopilot::setButtons( bool btn_dn, bool btn_up )
 {
-    if ( _c172_kfc325_ap ) _c172_kfc325_ap->update( timeStep, btn_dn, btn_up );
+    _btn_dn = btn_dn;
+    _btn_up = btn_up;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedAP()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_gfc700_ap ) _c172_gfc700_ap->onPressedAP();
-        if ( _c172_kap140_ap ) _c172_kap140_ap->onPressedAP();
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedAP();
-    }
+    if ( isWorking() ) push( Command::PressedAP );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedFD()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            if ( !_c172_gfc700_ap->isActiveFD() )
-            {
-                _c172_gfc700_ap->setPitch( Data::get()->ownship.pitch );
-                _c172_gfc700_ap->setRoll( Data::get()->ownship.roll );
-            }
-
-            _c172_gfc700_ap->onPressedFD();
-        }
-
-        // KAP 140
-        if ( _c172_kap140_ap )
-        {
-            if ( !_c172_kap140_ap->isActiveFD() )
-            {
-                _c172_kap140_ap->setPitch( Data::get()->ownship.pitch );
-            }
-
-            _c172_kap140_ap->onPressedFD();
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-            {
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-            }
-
-            _c172_kfc325_ap->onPressedFD();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedFD );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -201,20 +107,12 @@ void Autopilot::onPressedALT()
 {
     if ( isWorking() )
     {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
+        push( Command::PressedALT );
 
-        // KFC 325
-        if ( _c172_kfc325_ap )
+        // shown at once, simulation thread captures altitude with the next step
+        if ( _state.inited && !_state.activeALT )
         {
-            if ( !_c172_kfc325_ap->isActiveALT() )
-                _altitude = Data::get()->ownship.altitude_asl;
-
-            _c172_kfc325_ap->setAltitude( _altitude );
-            _c172_kfc325_ap->onPressedALT();
+            _state.altitude = Data::get()->ownship.altitude_asl;
         }
     }
 }
@@ -223,679 +121,622 @@ void Autopilot::onPressedALT()
 
 void Autopilot::onPressedIAS()
 {
-    if ( isWorking() )
-    {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveIAS() )
-                _c172_kfc325_ap->setAirspeed( Data::get()->ownship.ias );
-
-            _c172_kfc325_ap->onPressedIAS();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedIAS );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedENG()
 {
-    if ( isWorking() )
-    {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveVS() )
-            {
-                _climbRate = Data::get()->ownship.climbRate;
-            }
-
-            _c172_kfc325_ap->setClimbRate( _climbRate );
-            _c172_kfc325_ap->onPressedENG();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedENG );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedARM()
 {
-    if ( isWorking() )
-    {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveARM() )
-            {
-                _altitude = Data::get()->ownship.altitude_asl;
-            }
-
-            _c172_kfc325_ap->setAltitude( _altitude );
-            _c172_kfc325_ap->onPressedARM();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedARM );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedVNV()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-
-        }
-    }
+    if ( isWorking() ) push( Command::PressedVNV );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedFLC()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-    }
+    if ( isWorking() ) push( Command::PressedFLC );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedVS()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-    }
+    if ( isWorking() ) push( Command::PressedVS );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedHDG( double hdg )
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->setHeading( hdg );
-            _c172_kfc325_ap->onPressedHDG();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedHDG, hdg );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedNAV( double crs )
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->setCourse( crs );
-            _c172_kfc325_ap->onPressedNAV();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedNAV, crs );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedAPR()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->onPressedAPR();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedAPR );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedBC()
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->onPressedBC();
-        }
-    }
+    if ( isWorking() ) push( Command::PressedBC );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedREV()
 {
-    if ( isWorking() )
-    {
-        // KAP 140
-        if ( _c172_kap140_ap )
-        {
-
-        }
-    }
+    if ( isWorking() ) push( Command::PressedREV );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedYD()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedYD();
-    }
+    if ( isWorking() ) push( Command::PressedYD );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedSoftRide()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedSoftRide();
-    }
+    if ( isWorking() ) push( Command::PressedSoftRide );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedHalfBank()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedHalfBank();
-    }
+    if ( isWorking() ) push( Command::PressedHalfBank );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onPressedTest()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedTest();
-    }
+    if ( isWorking() ) push( Command::PressedTest );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::onReleasedTest()
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onReleasedTest();
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getAirspeed() const
-{
-    if ( _autopilot ) return _autopilot->getAirspeed();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getAltitude() const
-{
-    if ( _autopilot ) return _autopilot->getAltitude();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getClimbRate() const
-{
-    if ( _autopilot ) return _autopilot->getClimbRate();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getHeading() const
-{
-    if ( _autopilot ) return _autopilot->getHeading();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCmdRoll() const
-{
-    if ( _autopilot ) return _autopilot->getCmdRoll();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCmdPitch() const
-{
-    if ( _autopilot ) return _autopilot->getCmdPitch();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCtrlRoll() const
-{
-    if ( _autopilot ) return _autopilot->getCtrlRoll();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCtrlPitch() const
-{
-    if ( _autopilot ) return _autopilot->getCtrlPitch();
-
-    return 0.0;
+    if ( isWorking() ) push( Command::ReleasedTest );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getCtrlYaw() const
+bool Autopilot::isWorking() const
 {
-    if ( _autopilot ) return _autopilot->getCtrlYaw();
-
-    return 0.0;
+    return ( Data::get()->stateOut == fdm::DataOut::Working );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampAP() const
+void Autopilot::setAltitude( double altitude )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAP();
-
-    return false;
+    push( Command::SetAltitude, altitude );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampFD() const
+void Autopilot::setClimbRate( double climbRate )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampFD();
-
-    return false;
+    push( Command::SetClimbRate, climbRate );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampYD() const
+void Autopilot::setCourse( double course )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampYD();
-
-    return false;
+    push( Command::SetCourse, course );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampALT() const
+void Autopilot::setHeading( double heading )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampALT();
-
-    return false;
+    push( Command::SetHeading, heading );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampIAS() const
+const Autopilot::State& Autopilot::step( double timeStep, const fdm::DataOut &dataOut,
+                                         const Data::Navigation &navigation,
+                                         bool disengage )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampIAS();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // commands queued by GUI thread since the previous step
+    const Command *command = _commands.front();
 
-bool Autopilot::getLampGS()  const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampGS();
+    while ( command )
+    {
+        apply( *command, dataOut );
+        _commands.pop();
 
-    return false;
-}
+        command = _commands.front();
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    if ( _autopilot )
+    {
+        if ( _c172_kfc325_ap )
+        {
+            _c172_kfc325_ap->setHeadingILS( navigation.ils_heading );
 
-bool Autopilot::getLampHDG() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampHDG();
+            // as before, when it was run by the GUI only while working
+            if ( dataOut.stateOut == fdm::DataOut::Working )
+            {
+                _c172_kfc325_ap->update( timeStep, _btn_dn, _btn_up );
+            }
+        }
 
-    return false;
-}
+        _autopilot->update( timeStep,
+                            dataOut.flight.roll,
+                            dataOut.flight.pitch,
+                            dataOut.flight.heading,
+                            dataOut.flight.altitude_asl,
+                            dataOut.flight.ias,
+                            dataOut.flight.turnRate,
+                            dataOut.flight.yawRate,
+                            dataOut.flight.climbRate,
+                            navigation.dme_distance,
+                            navigation.nav_deviation,
+                            navigation.nav_cdi != Data::Navigation::NONE,
+                            navigation.ils_lc_deviation,
+                            navigation.ils_lc_visible,
+                            navigation.ils_gs_deviation,
+                            navigation.ils_gs_visible );
+
+        if ( disengage )
+        {
+            _autopilot->disengage();
+        }
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    updateState();
 
-bool Autopilot::getLampNAV() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampNAV();
+    _published.write( _stateSim );
 
-    return false;
+    return _stateSim;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampAPR() const
+void Autopilot::push( Command::Type type, double value,
+                      fdm::DataInp::AircraftType aircraftType )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAPR();
-
-    return false;
-}
+    Command *command = _commands.reserve();
 
-////////////////////////////////////////////////////////////////////////////////
-
-bool Autopilot::getLampBC() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampBC();
+    if ( command )
+    {
+        command->type  = type;
+        command->value = value;
+        command->aircraftType = aircraftType;
 
-    return false;
+        _commands.commit();
+    }
+    else
+    {
+        Log::w() << "Autopilot commands queue is full" << std::endl;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampNAV_ARM() const
+void Autopilot::apply( const Command &command, const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampNAV_ARM();
+    switch ( command.type )
+    {
+    case Command::Init:
+        initAutopilot( command.aircraftType );
+        break;
 
-    return false;
-}
+    case Command::Stop:
+        stopAutopilot();
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedAP:
+        if ( _c172_gfc700_ap ) _c172_gfc700_ap->onPressedAP();
+        if ( _c172_kap140_ap ) _c172_kap140_ap->onPressedAP();
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedAP();
+        break;
 
-bool Autopilot::getLampAPR_ARM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAPR_ARM();
+    case Command::PressedFD:  pressedFD  ( dataOut ); break;
+    case Command::PressedALT: pressedALT ( dataOut ); break;
+    case Command::PressedIAS: pressedIAS ( dataOut ); break;
+    case Command::PressedENG: pressedENG ( dataOut ); break;
+    case Command::PressedARM: pressedARM ( dataOut ); break;
 
-    return false;
-}
+    case Command::PressedVNV:
+    case Command::PressedFLC:
+    case Command::PressedVS:
+        // GFC 700
+        if ( _c172_gfc700_ap )
+        {
+            // TODO
+        }
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedHDG: pressedHDG ( dataOut, command.value ); break;
+    case Command::PressedNAV: pressedNAV ( dataOut, command.value ); break;
+    case Command::PressedAPR: pressedAPR ( dataOut ); break;
+    case Command::PressedBC:  pressedBC  ( dataOut ); break;
 
-bool Autopilot::getLampSR() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampSR();
+    case Command::PressedREV:
+        // KAP 140
+        if ( _c172_kap140_ap )
+        {
 
-    return false;
-}
+        }
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedYD:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedYD();
+        break;
 
-bool Autopilot::getLampHB() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampHB();
+    case Command::PressedSoftRide:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedSoftRide();
+        break;
 
-    return false;
-}
+    case Command::PressedHalfBank:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedHalfBank();
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedTest:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedTest();
+        break;
 
-bool Autopilot::getLampTRIM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampTRIM();
+    case Command::ReleasedTest:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onReleasedTest();
+        break;
 
-    return false;
-}
+    case Command::SetAltitude:
+        _altitude = command.value;
+        if ( _autopilot ) _autopilot->setAltitude( _altitude );
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::SetClimbRate:
+        _climbRate = command.value;
+        if ( _autopilot ) _autopilot->setClimbRate( _climbRate );
+        break;
 
-bool Autopilot::getLampVS() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampVS();
+    case Command::SetCourse:
+        if ( _autopilot ) _autopilot->setCourse( command.value );
+        break;
 
-    return false;
+    case Command::SetHeading:
+        if ( _autopilot ) _autopilot->setHeading( command.value );
+        break;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampARM() const
+void Autopilot::initAutopilot( fdm::DataInp::AircraftType aircraftType )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampARM();
-
-    return false;
-}
+    try
+    {
+        if ( !_autopilot )
+        {
+            switch ( aircraftType )
+            {
+            case fdm::DataInp::C172:
+                //_autopilot = _c172_gfc700_ap = new fdm::C172_GFC700_AP();
+                //_autopilot = _c172_kap140_ap = new fdm::C172_KAP140_AP();
+                _autopilot = _c172_kfc325_ap = new fdm::C172_KFC325_AP();
+                break;
 
-////////////////////////////////////////////////////////////////////////////////
+            default:
+                _autopilot = NULLPTR;
+                break;
+            }
 
-double Autopilot::getMinAltitude() const
-{
-    if ( _autopilot ) return _autopilot->getMinAltitude();
+            if ( _autopilot ) _autopilot->initialize();
+        }
+    }
+    catch ( const fdm::Exception &e )
+    {
+        Log::e() << e.getInfo() << std::endl;
 
-    return 100.0;
+        fdm::Exception et = e;
+        while ( et.hasCause() )
+        {
+            et = et.getCause();
+            Log::e() << et.getInfo() << std::endl;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getMaxAltitude() const
+void Autopilot::stopAutopilot()
 {
-    if ( _autopilot ) return _autopilot->getMaxAltitude();
+    DELPTR( _autopilot );
 
-    return 50000.0;
+    _c172_gfc700_ap = NULLPTR;
+    _c172_kap140_ap = NULLPTR;
+    _c172_kfc325_ap = NULLPTR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getMinClimbRate() const
+void Autopilot::pressedFD( const fdm::DataOut &dataOut )
 {
-    if ( _autopilot ) return _autopilot->getMinClimbRate();
-
-    return -5000.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        if ( !_c172_gfc700_ap->isActiveFD() )
+        {
+            _c172_gfc700_ap->setPitch( dataOut.flight.pitch );
+            _c172_gfc700_ap->setRoll( dataOut.flight.roll );
+        }
 
-double Autopilot::getMaxClimbRate() const
-{
-    if ( _autopilot ) return _autopilot->getMaxClimbRate();
+        _c172_gfc700_ap->onPressedFD();
+    }
 
-    return  5000.0;
-}
+    // KAP 140
+    if ( _c172_kap140_ap )
+    {
+        if ( !_c172_kap140_ap->isActiveFD() )
+        {
+            _c172_kap140_ap->setPitch( dataOut.flight.pitch );
+        }
 
-////////////////////////////////////////////////////////////////////////////////
+        _c172_kap140_ap->onPressedFD();
+    }
 
-bool Autopilot::isActiveAP() const
-{
-    if ( _autopilot ) return _autopilot->isActiveAP();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+        {
+            _c172_kfc325_ap->setPitch( dataOut.flight.pitch );
+        }
 
-    return false;
+        _c172_kfc325_ap->onPressedFD();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveFD() const
+void Autopilot::pressedALT( const fdm::DataOut &dataOut )
 {
-    if ( _autopilot ) return _autopilot->isActiveFD();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveYD() const
-{
-    if ( _autopilot ) return _autopilot->isActiveYD();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveALT() )
+            _altitude = dataOut.flight.altitude_asl;
 
-    return false;
+        _c172_kfc325_ap->setAltitude( _altitude );
+        _c172_kfc325_ap->onPressedALT();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveALT() const
+void Autopilot::pressedIAS( const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveALT();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveIAS() )
+            _c172_kfc325_ap->setAirspeed( dataOut.flight.ias );
 
-    return false;
+        _c172_kfc325_ap->onPressedIAS();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveIAS() const
+void Autopilot::pressedENG( const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveIAS();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveVS() )
+        {
+            _climbRate = dataOut.flight.climbRate;
+        }
 
-    return false;
+        _c172_kfc325_ap->setClimbRate( _climbRate );
+        _c172_kfc325_ap->onPressedENG();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveVS() const
+void Autopilot::pressedARM( const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveVS();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveARM() )
+        {
+            _altitude = dataOut.flight.altitude_asl;
+        }
 
-    return false;
+        _c172_kfc325_ap->setAltitude( _altitude );
+        _c172_kfc325_ap->onPressedARM();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveARM() const
+void Autopilot::pressedHDG( const fdm::DataOut &dataOut, double hdg )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveARM();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveGS() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveGS();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( dataOut.flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->setHeading( hdg );
+        _c172_kfc325_ap->onPressedHDG();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveHDG() const
+void Autopilot::pressedNAV( const fdm::DataOut &dataOut, double crs )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveHDG();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveNAV() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveNAV();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( dataOut.flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->setCourse( crs );
+        _c172_kfc325_ap->onPressedNAV();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveAPR() const
+void Autopilot::pressedAPR( const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveAPR();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveBC() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveBC();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( dataOut.flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->onPressedAPR();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isInited() const
+void Autopilot::pressedBC( const fdm::DataOut &dataOut )
 {
-    return ( _autopilot != NULLPTR );
-}
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( dataOut.flight.pitch );
 
-bool Autopilot::isWorking() const
-{
-    return ( Data::get()->stateOut == fdm::DataOut::Working );
+        _c172_kfc325_ap->onPressedBC();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::setAltitude( double altitude )
+void Autopilot::updateState()
 {
-    _altitude = altitude;
+    memset( &_stateSim, 0, sizeof(State) );
 
-    if ( _autopilot ) _autopilot->setAltitude( _altitude );
-}
+    _stateSim.minAltitude  =   100.0;
+    _stateSim.maxAltitude  = 50000.0;
+    _stateSim.minClimbRate = -5000.0;
+    _stateSim.maxClimbRate =  5000.0;
 
-////////////////////////////////////////////////////////////////////////////////
+    if ( _autopilot )
+    {
+        _stateSim.airspeed  = _autopilot->getAirspeed();
+        _stateSim.altitude  = _autopilot->getAltitude();
+        _stateSim.climbRate = _autopilot->getClimbRate();
+        _stateSim.heading   = _autopilot->getHeading();
 
-void Autopilot::setClimbRate( double climbRate )
-{
-    _climbRate = climbRate;
+        _stateSim.cmdRoll  = _autopilot->getCmdRoll();
+        _stateSim.cmdPitch = _autopilot->getCmdPitch();
 
-    if ( _autopilot ) _autopilot->setClimbRate( _climbRate );
-}
+        _stateSim.ctrlRoll  = _autopilot->getCtrlRoll();
+        _stateSim.ctrlPitch = _autopilot->getCtrlPitch();
+        _stateSim.ctrlYaw   = _autopilot->getCtrlYaw();
 
-////////////////////////////////////////////////////////////////////////////////
+        _stateSim.minAltitude  = _autopilot->getMinAltitude();
+        _stateSim.maxAltitude  = _autopilot->getMaxAltitude();
+        _stateSim.minClimbRate = _autopilot->getMinClimbRate();
+        _stateSim.maxClimbRate = _autopilot->getMaxClimbRate();
 
-void Autopilot::setCourse( double course )
-{
-    if ( _autopilot ) _autopilot->setCourse( course );
-}
+        _stateSim.activeAP = _autopilot->isActiveAP();
+        _stateSim.activeFD = _autopilot->isActiveFD();
+        _stateSim.activeYD = _autopilot->isActiveYD();
 
-////////////////////////////////////////////////////////////////////////////////
+        _stateSim.inited = true;
+    }
 
-void Autopilot::setHeading( double heading )
-{
-    if ( _autopilot ) _autopilot->setHeading( heading );
+    if ( _c172_kfc325_ap )
+    {
+        _stateSim.lampAP  = _c172_kfc325_ap->getLampAP();
+        _stateSim.lampFD  = _c172_kfc325_ap->getLampFD();
+        _stateSim.lampYD  = _c172_kfc325_ap->getLampYD();
+        _stateSim.lampALT = _c172_kfc325_ap->getLampALT();
+        _stateSim.lampIAS = _c172_kfc325_ap->getLampIAS();
+        _stateSim.lampGS  = _c172_kfc325_ap->getLampGS();
+        _stateSim.lampHDG = _c172_kfc325_ap->getLampHDG();
+        _stateSim.lampNAV = _c172_kfc325_ap->getLampNAV();
+        _stateSim.lampAPR = _c172_kfc325_ap->getLampAPR();
+        _stateSim.lampBC  = _c172_kfc325_ap->getLampBC();
+        _stateSim.lampNAV_ARM = _c172_kfc325_ap->getLampNAV_ARM();
+        _stateSim.lampAPR_ARM = _c172_kfc325_ap->getLampAPR_ARM();
+        _stateSim.lampSR   = _c172_kfc325_ap->getLampSR();
+        _stateSim.lampHB   = _c172_kfc325_ap->getLampHB();
+        _stateSim.lampTRIM = _c172_kfc325_ap->getLampTRIM();
+        _stateSim.lampVS  = _c172_kfc325_ap->getLampVS();
+        _stateSim.lampARM = _c172_kfc325_ap->getLampARM();
+
+        _stateSim.activeALT = _c172_kfc325_ap->isActiveALT();
+        _stateSim.activeIAS = _c172_kfc325_ap->isActiveIAS();
+        _stateSim.activeVS  = _c172_kfc325_ap->isActiveVS();
+        _stateSim.activeARM = _c172_kfc325_ap->isActiveARM();
+        _stateSim.activeGS  = _c172_kfc325_ap->isActiveGS();
+        _stateSim.activeHDG = _c172_kfc325_ap->isActiveHDG();
+        _stateSim.activeNAV = _c172_kfc325_ap->isActiveNAV();
+        _stateSim.activeAPR = _c172_kfc325_ap->isActiveAPR();
+        _stateSim.activeBC  = _c172_kfc325_ap->isActiveBC();
+    }
 }
@@ -24,21 +24,87 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+
 #include <fdm/auto/fdm_Autopilot.h>
 
+#include <fdm/utils/fdm_RingBuffer.h>
+#include <fdm/utils/fdm_SeqLock.h>
+
 #include <fdm_c172/c172_GFC700_AP.h>
 #include <fdm_c172/c172_KAP140_AP.h>
 #include <fdm_c172/c172_KFC325_AP.h>
 
+#include <Data.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
  * @brief Autopilot class.
+ *
+ * Autopilot control laws are updated by the simulation thread inside the FDM
+ * step, see step(). GUI thread only selects modes and values, which are
+ * queued as commands, and shows the state published by the simulation
+ * thread, see update().
  */
 class Autopilot
 {
 public:
 
+    /** Autopilot state published by the simulation thread. */
+    struct State
+    {
+        double airspeed;                    ///< [m/s] selected airspeed
+        double altitude;                    ///< [m]   selected altitude
+        double climbRate;                   ///< [m/s] selected climb rate
+        double heading;                     ///< [rad] selected heading
+
+        double cmdRoll;                     ///< [rad] flight director roll command
+        double cmdPitch;                    ///< [rad] flight director pitch command
+
+        double ctrlRoll;                    ///< roll control command
+        double ctrlPitch;                   ///< pitch control command
+        double ctrlYaw;                     ///< yaw control command
+
+        double minAltitude;                 ///< [m]   min altitude
+        double maxAltitude;                 ///< [m]   max altitude
+        double minClimbRate;                ///< [m/s] min climb rate
+        double maxClimbRate;                ///< [m/s] max climb rate
+
+        bool lampAP;                        ///<
+        bool lampFD;                        ///<
+        bool lampYD;                        ///<
+        bool lampALT;                       ///<
+        bool lampIAS;                       ///<
+        bool lampGS;                        ///<
+        bool lampHDG;                       ///<
+        bool lampNAV;                       ///<
+        bool lampAPR;                       ///<
+        bool lampBC;                        ///<
+        bool lampNAV_ARM;                   ///<
+        bool lampAPR_ARM;                   ///<
+        bool lampSR;                        ///<
+        bool lampHB;                        ///<
+        bool lampTRIM;                      ///<
+        bool lampVS;                        ///<
+        bool lampARM;                       ///<
+
+        bool activeAP;                      ///<
+        bool activeFD;                      ///<
+        bool activeYD;                      ///<
+        bool activeALT;                     ///<
+        bool activeIAS;                     ///<
+        bool activeVS;                      ///<
+        bool activeARM;                     ///<
+        bool activeGS;                      ///<
+        bool activeHDG;                     ///<
+        bool activeNAV;                     ///<
+        bool activeAPR;                     ///<
+        bool activeBC;                      ///<
+
+        bool inited;                        ///< specifies if autopilot is initialized
+    };
+
     Autopilot();
 
     /** @brief Autopilot class destructor. */
@@ -47,8 +113,15 @@ public:
     void init();
     void stop();
 
-    void update( double timeStep );
-    void update( double timeStep, bool btn_dn, bool btn_up );
+    /** @brief Takes the latest state published by the simulation thread. */
+    void update();
+
+    /**
+     * @brief Sets KFC 325 DN and UP buttons state.
+     * @param btn_dn specifies if DN button is pressed
+     * @param btn_up specifies if UP button is pressed
+     */
+    void setButtons( bool btn_dn, bool btn_up );
 
     void onPressedAP();
     void onPressedFD();
@@ -75,56 +148,57 @@ public:
     void onPressedTest();
     void onReleasedTest();
 
-    double getAirspeed() const;
-    double getAltitude() const;
-    double getClimbRate() const;
-    double getHeading() const;
-
-    double getCmdRoll() const;
-    double getCmdPitch() const;
-
-    double getCtrlRoll() const;
-    double getCtrlPitch() const;
-    double getCtrlYaw() const;
-
-    bool getLampAP() const;
-    bool getLampFD() const;
-    bool getLampYD() const;
-    bool getLampALT() const;
-    bool getLampIAS() const;
-    bool getLampGS()  const;
-    bool getLampHDG() const;
-    bool getLampNAV() const;
-    bool getLampAPR() const;
-    bool getLampBC()  const;
-    bool getLampNAV_ARM() const;
-    bool getLampAPR_ARM() const;
-    bool getLampSR() const;
-    bool getLampHB() const;
-    bool getLampTRIM() const;
-    bool getLampVS()  const;
-    bool getLampARM() const;
-
-    double getMinAltitude()  const;
-    double getMaxAltitude()  const;
-    double getMinClimbRate() const;
-    double getMaxClimbRate() const;
-
-    bool isActiveAP() const;
-    bool isActiveFD() const;
-    bool isActiveYD() const;
-
-    bool isActiveALT() const;
-    bool isActiveIAS() const;
-    bool isActiveVS()  const;
-    bool isActiveARM() const;
-    bool isActiveGS()  const;
-    bool isActiveHDG() const;
-    bool isActiveNAV() const;
-    bool isActiveAPR() const;
-    bool isActiveBC()  const;
-
-    bool isInited() const;
+    inline double getAirspeed()  const { return _state.airspeed;  }
+    inline double getAltitude()  const { return _state.altitude;  }
+    inline double getClimbRate() const { return _state.climbRate; }
+    inline double getHeading()   const { return _state.heading;   }
+
+    inline double getCmdRoll()  const { return _state.cmdRoll;  }
+    inline double getCmdPitch() const { return _state.cmdPitch; }
+
+    inline double getCtrlRoll()  const { return _state.ctrlRoll;  }
+    inline double getCtrlPitch() const { return _state.ctrlPitch; }
+    inline double getCtrlYaw()   const { return _state.ctrlYaw;   }
+
+    inline bool getLampAP()  const { return _state.lampAP;  }
+    inline bool getLampFD()  const { return _state.lampFD;  }
+    inline bool getLampYD()  const { return _state.lampYD;  }
+    inline bool getLampALT() const { return _state.lampALT; }
+    inline bool getLampIAS() const { return _state.lampIAS; }
+    inline bool getLampGS()  const { return _state.lampGS;  }
+    inline bool getLampHDG() const { return _state.lampHDG; }
+    inline bool getLampNAV() const { return _state.lampNAV; }
+    inline bool getLampAPR() const { return _state.lampAPR; }
+    inline bool getLampBC()  const { return _state.lampBC;  }
+    inline bool getLampNAV_ARM() const { return _state.lampNAV_ARM; }
+    inline bool getLampAPR_ARM() const { return _state.lampAPR_ARM; }
+    inline bool getLampSR()   const { return _state.lampSR;   }
+    inline bool getLampHB()   const { return _state.lampHB;   }
+    inline bool getLampTRIM() const { return _state.lampTRIM; }
+    inline bool getLampVS()  const { return _state.lampVS;  }
+    inline bool getLampARM() const { return _state.lampARM; }
+
+    inline double getMinAltitude()  const { return _state.minAltitude;  }
+    inline double getMaxAltitude()  const { return _state.maxAltitude;  }
+    inline double getMinClimbRate() const { return _state.minClimbRate; }
+    inline double getMaxClimbRate() const { return _state.maxClimbRate; }
+
+    inline bool isActiveAP() const { return _state.activeAP; }
+    inline bool isActiveFD() const { return _state.activeFD; }
+    inline bool isActiveYD() const { return _state.activeYD; }
+
+    inline bool isActiveALT() const { return _state.activeALT; }
+    inline bool isActiveIAS() const { return _state.activeIAS; }
+    inline bool isActiveVS()  const { return _state.activeVS;  }
+    inline bool isActiveARM() const { return _state.activeARM; }
+    inline bool isActiveGS()  const { return _state.activeGS;  }
+    inline bool isActiveHDG() const { return _state.activeHDG; }
+    inline bool isActiveNAV() const { return _state.activeNAV; }
+    inline bool isActiveAPR() const { return _state.activeAPR; }
+    inline bool isActiveBC()  const { return _state.activeBC;  }
+
+    inline bool isInited() const { return _state.inited; }
+
     bool isWorking() const;
 
     void setAltitude( double altitude );
@@ -132,8 +206,67 @@ public:
     void setCourse( double course );
     void setHeading( double heading );
 
+    /**
+     * @brief Updates autopilot. Called by the simulation thread only.
+     * @param timeStep [s] time step
+     * @param dataOut FDM output data
+     * @param navigation navigation data
+     * @param disengage specifies if autopilot disconnect button is pressed
+     * @return updated state
+     */
+    const State& step( double timeStep, const fdm::DataOut &dataOut,
+                       const Data::Navigation &navigation,
+                       bool disengage );
+
 private:
 
+    /** Command queued by GUI thread. */
+    struct Command
+    {
+        /** Command types. */
+        enum Type
+        {
+            Init = 0,                       ///< initialize autopilot
+            Stop,                           ///< stop autopilot
+            PressedAP,                      ///< AP button pressed
+            PressedFD,                      ///< FD button pressed
+            PressedALT,                     ///< ALT button pressed
+            PressedIAS,                     ///< IAS button pressed
+            PressedENG,                     ///< ENG button pressed
+            PressedARM,                     ///< ARM button pressed
+            PressedVNV,                     ///< VNV button pressed
+            PressedFLC,                     ///< FLC button pressed
+            PressedVS,                      ///< VS button pressed
+            PressedHDG,                     ///< HDG button pressed, value is heading
+            PressedNAV,                     ///< NAV button pressed, value is course
+            PressedAPR,                     ///< APR button pressed
+            PressedBC,                      ///< BC button pressed
+            PressedREV,                     ///< REV button pressed
+            PressedYD,                      ///< YD button pressed
+            PressedSoftRide,                ///< soft ride button pressed
+            PressedHalfBank,                ///< half bank button pressed
+            PressedTest,                    ///< test button pressed
+            ReleasedTest,                   ///< test button released
+            SetAltitude,                    ///< altitude selected
+            SetClimbRate,                   ///< climb rate selected
+            SetCourse,                      ///< course selected
+            SetHeading                      ///< heading selected
+        };
+
+        Type type;                          ///< command type
+        double value;                       ///< [m], [m/s] or [rad] selected value
+        fdm::DataInp::AircraftType aircraftType;    ///< aircraft type (Init command only)
+    };
+
+    fdm::RingBuffer< Command, 64 > _commands;   ///< commands queued by GUI thread
+    fdm::SeqLock< State > _published;           ///< state published by the simulation thread
+
+    State _state;                           ///< state shown by GUI (GUI thread)
+    State _stateSim;                        ///< state (simulation thread)
+
+    std::atomic< bool > _btn_dn;            ///< specifies if KFC 325 DN button is pressed
+    std::atomic< bool > _btn_up;            ///< specifies if KFC 325 UP button is pressed
+
     fdm::Autopilot *_autopilot;             ///< autopilot
 
     fdm::C172_GFC700_AP *_c172_gfc700_ap;   ///< Cessna 172 Garmin GFC 700 autopilot
@@ -142,6 +275,26 @@ private:
 
     double _altitude;                       ///< [m]   desired altitude
     double _climbRate;                      ///< [m/s] desired climb rate
+
+    void push( Command::Type type, double value = 0.0,
+               fdm::DataInp::AircraftType aircraftType = fdm::DataInp::C172 );
+
+    void apply( const Command &command, const fdm::DataOut &dataOut );
+
+    void initAutopilot( fdm::DataInp::AircraftType aircraftType );
+    void stopAutopilot();
+
+    void pressedFD  ( const fdm::DataOut &dataOut );
+    void pressedALT ( const fdm::DataOut &dataOut );
+    void pressedIAS ( const fdm::DataOut &dataOut );
+    void pressedENG ( const fdm::DataOut &dataOut );
+    void pressedARM ( const fdm::DataOut &dataOut );
+    void pressedHDG ( const fdm::DataOut &dataOut, double hdg );
+    void pressedNAV ( const fdm::DataOut &dataOut, double crs );
+    void pressedAPR ( const fdm::DataOut &dataOut );
+    void pressedBC  ( const fdm::DataOut &dataOut );
+
+    void updateState();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -239,6 +239,31 @@ public:
         WindShear  windShear;               ///< wind shear model type
     };
 
+    /** Joystick input read by the simulation thread at each step. */
+    struct Input
+    {
+        /** Sampled control axis. */
+        struct Axis
+        {
+            bool sampled;                   ///< specifies if axis is sampled
+
+            short joystick;                 ///< joystick index
+            short axis;                     ///< joystick axis index
+            bool  inverted;                 ///< specifies if joystick axis is inverted
+
+            double deadzone;                ///< axis tune deadzone
+            double curvature;               ///< axis tune curvature
+            double scale;                   ///< axis tune scale
+        };
+
+        Axis roll;                          ///< roll axis
+        Axis pitch;                         ///< pitch axis
+        Axis yaw;                           ///< yaw axis
+
+        bool ap_disc;                       ///< specifies if autopilot disconnect button is pressed
+        bool cws;                           ///< specifies if control wheel steering button is pressed
+    };
+
     /** Navigation data. */
     struct Navigation
     {
@@ -432,6 +457,7 @@ public:
         Environment environment;            ///< environment data
         Ground      ground;                 ///< ground data
         Initial     initial;                ///< initial conditions
+        Input       input;                  ///< joystick input sampled by simulation thread
         Masses      masses;                 ///< masses data
         Navigation  navigation;             ///< navigation data
         Ownship     ownship;                ///< ownship data
@@ -447,6 +473,8 @@ public:
         double timeCoef;                    ///< [-] time coefficient
         double timeStep;                    ///< [s] simulation time step
 
+        fdm::LatencyTrace::Stamp trace;     ///< latency trace stamp of the FDM output data
+
         bool freezePosition;                ///< specifies if aircraft position is to be frozen
         bool freezeAttitude;                ///< specifies if aircraft attitude is to be frozen
         bool freezeVelocity;                ///< specifies if aircraft velocity is to be frozen
@@ -63,11 +63,10 @@ Manager::Manager() :
     _ap  = new Autopilot();
     _nav = new nav::Manager();
     _sfx = new sfx::Thread();
-    _sim = new Simulation();
+    _sim = new Simulation( _ap );
     _win = new MainWindow();
 
     _g1000_ifd = new g1000::IFD();
-    memset( &_g1000_input, 0, sizeof( g1000::Input ) );
 
     _timerSim = new QElapsedTimer();
     _timerOut = new QElapsedTimer();
@@ -95,10 +94,12 @@ Manager::~Manager()
         }
     }
 
+    // simulation thread steps the autopilot and the G1000 sensors
+    DELPTR( _sim );
+
     DELPTR( _ap  );
     DELPTR( _nav );
     DELPTR( _sfx );
-    DELPTR( _sim );
     DELPTR( _win );
 
     DELPTR( _g1000_ifd );
@@ -173,10 +174,12 @@ void Manager::timerEvent( QTimerEvent *event )
 
     hid::Manager::instance()->update( _timeStep );
 
-    _ap->update( _timeStep );
+    // autopilot and G1000 IFD sensors are updated by the simulation thread
+    _ap->update();
 
-    updatedInputG1000();
-    _g1000_ifd->update( _timeStep, _g1000_input );
+    g1000::IFD::State ifdState;
+    _sim->getStateIFD( &ifdState );
+    _g1000_ifd->setState( ifdState );
 
     _nav->setCourse( fdm::Units::deg2rad( _win->getCourse() ) );
     _nav->setFreqNAV( 1000 * _win->getFreqNav() );
@@ -221,20 +224,14 @@ void Manager::timerEvent( QTimerEvent *event )
     Data::get()->controls.nws = _win->getNWS();
     Data::get()->controls.abs = _win->getABS();
 
-    if ( _ap->isActiveAP() && _ap->isActiveFD() && !hid::Manager::instance()->getCWS() )
-    {
-        Data::get()->controls.roll  -= _ap->getCtrlRoll();
-        Data::get()->controls.pitch -= _ap->getCtrlPitch();
-
-        Data::get()->controls.roll  = std::max( -1.0, std::min( 1.0, Data::get()->controls.roll  ) );
-        Data::get()->controls.pitch = std::max( -1.0, std::min( 1.0, Data::get()->controls.pitch ) );
-    }
+    // joystick axes are sampled again by the simulation thread at each step,
+    // autopilot commands are added by the simulation thread as well
+    updatedInputAxis( &Data::get()->input.roll  , hid::Assignment::RollAxis  , r_d, r_c, r_s );
+    updatedInputAxis( &Data::get()->input.pitch , hid::Assignment::PitchAxis , p_d, p_c, p_s );
+    updatedInputAxis( &Data::get()->input.yaw   , hid::Assignment::YawAxis   , y_d, y_c, y_s );
 
-    if ( _ap->isActiveYD() )
-    {
-        Data::get()->controls.yaw -= _ap->getCtrlYaw();
-        Data::get()->controls.yaw = std::max( -1.0, std::min( 1.0, Data::get()->controls.yaw ) );
-    }
+    Data::get()->input.ap_disc = hid::Manager::instance()->getAP_Disc();
+    Data::get()->input.cws     = hid::Manager::instance()->getCWS();
 
     // engines
     for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
@@ -251,46 +248,20 @@ void Manager::timerEvent( QTimerEvent *event )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updatedInputG1000()
+void Manager::updatedInputAxis( Data::Input::Axis *axis, hid::Assignment::Action action,
+                                double deadzone, double curvature, double scale )
 {
-    _g1000_input.ref_pressure = 101325.0;
-
-    _g1000_input.fd_visible = false;
-    _g1000_input.fd_pitch = 0.0;
-    _g1000_input.fd_roll  = 0.0;
-
-    _g1000_input.sel_course    = 0.0;
-    _g1000_input.sel_heading   = 0.0;
-    _g1000_input.sel_airspeed  = 0.0;
-    _g1000_input.sel_altitude  = 0.0;
-    _g1000_input.sel_climbRate = 0.0;
-
-    _g1000_input.com_1_act = 118.000;
-    _g1000_input.com_1_sby = 118.000;
-    _g1000_input.com_2_act = 136.975;
-    _g1000_input.com_2_sby = 136.975;
-
-    _g1000_input.nav_1_act = 108.00;
-    _g1000_input.nav_1_sby = 108.00;
-    _g1000_input.nav_2_act = 117.95;
-    _g1000_input.nav_2_sby = 117.95;
-}
+    const hid::Assignment &assignment = hid::Manager::instance()->getAssignment( action );
 
-////////////////////////////////////////////////////////////////////////////////
-
-void Manager::updatedInputG1000( const fdm::DataOut &dataOut )
-{
-    _g1000_input.roll    = dataOut.flight.roll;
-    _g1000_input.pitch   = dataOut.flight.pitch;
-    _g1000_input.heading = dataOut.flight.heading;
+    axis->sampled = ( assignment.type == hid::Assignment::Joystick );
 
-    _g1000_input.airspeed_u_bas = dataOut.flight.airspeed_u_bas;
-    _g1000_input.airspeed_v_bas = dataOut.flight.airspeed_v_bas;
-    _g1000_input.airspeed_w_bas = dataOut.flight.airspeed_w_bas;
+    axis->joystick = assignment.data.joystick.joystickId;
+    axis->axis     = assignment.data.joystick.axisId;
+    axis->inverted = assignment.data.joystick.inverted;
 
-    _g1000_input.air_pressure    = dataOut.environment.air_pressure;
-    _g1000_input.air_density     = dataOut.environment.air_density;
-    _g1000_input.air_temperature = dataOut.environment.air_temperature;
+    axis->deadzone  = deadzone;
+    axis->curvature = curvature;
+    axis->scale     = scale;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,7 +270,8 @@ void Manager::onDataOutUpdated( const fdm::DataOut &dataOut )
 {
     double dt = Data::get()->timeCoef * (double)_timerOut->restart() / 1000.0;
 
-    updatedInputG1000( dataOut );
+    Data::get()->trace = dataOut.trace;
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Publish, dataOut.trace );
 
     // hud
     Data::get()->cgi.hud.roll    = dataOut.flight.roll;
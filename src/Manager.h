@@ -28,6 +28,7 @@
 
 #include <g1000/sim/g1000_IFD.h>
 #include <gui/MainWindow.h>
+#include <hid/hid_Assignment.h>
 #include <nav/nav_Manager.h>
 #include <sfx/sfx_Thread.h>
 
@@ -68,8 +69,7 @@ private:
     Simulation   *_sim;         ///< simulation
     MainWindow   *_win;         ///< GUI
 
-    g1000::IFD *_g1000_ifd;     ///< G1000 Integrated Flight Deck
-    g1000::Input _g1000_input;  ///< G1000 Integrated Flight Deck input data
+    g1000::IFD *_g1000_ifd;     ///< G1000 Integrated Flight Deck, state is set by the simulation thread
 
     QElapsedTimer *_timerSim;   ///< elapsed timer
     QElapsedTimer *_timerOut;   ///< elapsed timer
@@ -78,8 +78,8 @@ private:
 
     int _timerId;               ///< timer Id
 
-    void updatedInputG1000();
-    void updatedInputG1000( const fdm::DataOut &dataOut );
+    void updatedInputAxis( Data::Input::Axis *axis, hid::Assignment::Action action,
+                           double deadzone, double curvature, double scale );
 
 private slots:
 
@@ -22,11 +22,18 @@
 
 #include <Simulation.h>
 
+#include <algorithm>
+
+#include <QCoreApplication>
+
+#include <hid/hid_AxisTune.h>
+#include <hid/hid_Joysticks.h>
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Simulation::Simulation() :
+Simulation::Simulation( Autopilot *ap ) :
     QThread ( NULLPTR ),
 
     _timeoutTimer ( NULLPTR ),
@@ -34,6 +41,19 @@ Simulation::Simulation() :
 
     _fdm ( NULLPTR ),
 
+    _ap ( ap ),
+
+    _ifd ( NULLPTR ),
+
+    _ctrlRoll  ( 0.0 ),
+    _ctrlPitch ( 0.0 ),
+    _ctrlYaw   ( 0.0 ),
+
+    _avionicsTime  ( 0.0 ),
+    _avionicsSteps ( 0 ),
+
+    _eventTime ( 0 ),
+
     _timeStep ( 0.0 ),
     _timeCoef ( 1.0 ),
 
@@ -41,8 +61,16 @@ Simulation::Simulation() :
 {
     memset( &_dataInp, 0, sizeof(fdm::DataInp) );
     memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+    memset( &_input  , 0, sizeof(Data::Input) );
+
+    memset( &_apState    , 0, sizeof(Autopilot::State) );
+    memset( &_ifdInput   , 0, sizeof(g1000::Input) );
+    memset( &_navigation , 0, sizeof(Data::Navigation) );
+
+    memset( _events, 0, sizeof(_events) );
 
     _fdm = new fdm::Manager( &_dataInp, &_dataOut );
+    _ifd = new g1000::IFD();
 
 #   ifdef SIM_USE_THREADS
     moveToThread( this );
@@ -61,12 +89,19 @@ Simulation::~Simulation()
     DELPTR( _elapsedTimer );
 
     DELPTR( _fdm );
+    DELPTR( _ifd );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Simulation::init()
 {
+    // simulation state is published to external clients on demand
+    if ( QCoreApplication::arguments().contains( "--shared-state" ) )
+    {
+        _fdm->openSharedState();
+    }
+
 #   ifdef SIM_USE_THREADS
     start();
     setPriority( QThread::HighPriority );
@@ -99,6 +134,13 @@ void Simulation::run()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Simulation::getStateIFD( g1000::IFD::State *state ) const
+{
+    _ifdState.read( state );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Simulation::onDataInpUpdated( const Data::DataBuf *data )
 {
     _timeCoef = data->timeCoef;
@@ -131,9 +173,10 @@ void Simulation::onDataInpUpdated( const Data::DataBuf *data )
     _dataInp.ground.n_z_wgs   = data->ground.n_z_wgs;
 
     // controls
-    _dataInp.controls.roll         = data->controls.roll;
-    _dataInp.controls.pitch        = data->controls.pitch;
-    _dataInp.controls.yaw          = data->controls.yaw;
+    _ctrlRoll  = data->controls.roll;
+    _ctrlPitch = data->controls.pitch;
+    _ctrlYaw   = data->controls.yaw;
+
     _dataInp.controls.trim_roll    = data->controls.trim_roll;
     _dataInp.controls.trim_pitch   = data->controls.trim_pitch;
     _dataInp.controls.trim_yaw     = data->controls.trim_yaw;
@@ -151,6 +194,11 @@ void Simulation::onDataInpUpdated( const Data::DataBuf *data )
     _dataInp.controls.nws = data->controls.nws;
     _dataInp.controls.abs = data->controls.abs;
 
+    _input = data->input;
+
+    // navigation
+    _navigation = data->navigation;
+
     // engines
     for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
     {
@@ -212,9 +260,140 @@ void Simulation::update()
 {
     _timeStep = _timeCoef * static_cast<double>( _elapsedTimer->restart() ) / 1000.0;
 
+    _eventTime = 0;
+
+    // joystick axes are sampled at each step rather than at the GUI rate
+    sampleAxis( _input.roll  , &_ctrlRoll  );
+    sampleAxis( _input.pitch , &_ctrlPitch );
+    sampleAxis( _input.yaw   , &_ctrlYaw, &_dataInp.controls.wheel_nose );
+
+    // axes are sampled from the latest state, events history is not used
+    // but it is drained so it never holds stale events
+    hid::Joysticks::instance()->clearEvents();
+
+    // new input is stamped with the time of the event, not the time of sampling
+    if ( _eventTime > 0 )
+    {
+        _dataInp.trace = fdm::LatencyTrace::stamp( _eventTime );
+    }
+
+    // avionics are updated every given number of steps using output of the previous step
+    _avionicsTime += _timeStep;
+    _avionicsSteps++;
+
+    if ( _avionicsSteps >= SIM_AVIONICS_DIVISOR )
+    {
+        updateAvionics( _avionicsTime );
+
+        _avionicsTime  = 0.0;
+        _avionicsSteps = 0;
+    }
+
+    updateControls();
+
     _fdm->step( _timeStep );
 
     ////////////////////////////////
     emit dataOutUpdated( _dataOut );
     ////////////////////////////////
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::sampleAxis( const Data::Input::Axis &axis, double *value,
+                             double *raw )
+{
+    hid::Joysticks::State state;
+
+    if ( axis.sampled && axis.axis >= 0 && axis.axis < HID_MAX_AXES
+      && hid::Joysticks::instance()->getState( axis.joystick, &state ) )
+    {
+        double position = state.axis[ axis.axis ];
+
+        if ( axis.inverted ) position *= -1.0;
+
+        (*value) = -hid::AxisTune::getAxisTune( position, axis.deadzone,
+                                                axis.curvature, axis.scale );
+
+        if ( raw ) (*raw) = position;
+
+        if ( state.events != _events[ axis.joystick ] )
+        {
+            _events[ axis.joystick ] = state.events;
+            _eventTime = std::max( _eventTime, state.time );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateAvionics( double timeStep )
+{
+    _apState = _ap->step( timeStep, _dataOut, _navigation, _input.ap_disc );
+
+    updateInputIFD();
+    _ifd->update( timeStep, _ifdInput );
+
+    g1000::IFD::State state;
+    _ifd->getState( &state );
+    _ifdState.write( state );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateControls()
+{
+    _dataInp.controls.roll  = _ctrlRoll;
+    _dataInp.controls.pitch = _ctrlPitch;
+    _dataInp.controls.yaw   = _ctrlYaw;
+
+    if ( _apState.activeAP && _apState.activeFD && !_input.cws )
+    {
+        _dataInp.controls.roll  = std::max( -1.0, std::min( 1.0, _ctrlRoll  - _apState.ctrlRoll  ) );
+        _dataInp.controls.pitch = std::max( -1.0, std::min( 1.0, _ctrlPitch - _apState.ctrlPitch ) );
+    }
+
+    if ( _apState.activeYD )
+    {
+        _dataInp.controls.yaw = std::max( -1.0, std::min( 1.0, _ctrlYaw - _apState.ctrlYaw ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateInputIFD()
+{
+    _ifdInput.roll    = _dataOut.flight.roll;
+    _ifdInput.pitch   = _dataOut.flight.pitch;
+    _ifdInput.heading = _dataOut.flight.heading;
+
+    _ifdInput.airspeed_u_bas = _dataOut.flight.airspeed_u_bas;
+    _ifdInput.airspeed_v_bas = _dataOut.flight.airspeed_v_bas;
+    _ifdInput.airspeed_w_bas = _dataOut.flight.airspeed_w_bas;
+
+    _ifdInput.air_pressure    = _dataOut.environment.air_pressure;
+    _ifdInput.air_density     = _dataOut.environment.air_density;
+    _ifdInput.air_temperature = _dataOut.environment.air_temperature;
+
+    _ifdInput.ref_pressure = 101325.0;
+
+    _ifdInput.fd_visible = false;
+    _ifdInput.fd_pitch = 0.0;
+    _ifdInput.fd_roll  = 0.0;
+
+    _ifdInput.sel_course    = 0.0;
+    _ifdInput.sel_heading   = 0.0;
+    _ifdInput.sel_airspeed  = 0.0;
+    _ifdInput.sel_altitude  = 0.0;
+    _ifdInput.sel_climbRate = 0.0;
+
+    _ifdInput.com_1_act = 118.000;
+    _ifdInput.com_1_sby = 118.000;
+    _ifdInput.com_2_act = 136.975;
+    _ifdInput.com_2_sby = 136.975;
+
+    _ifdInput.nav_1_act = 108.00;
+    _ifdInput.nav_1_sby = 108.00;
+    _ifdInput.nav_2_act = 117.95;
+    _ifdInput.nav_2_sby = 117.95;
+}
@@ -30,6 +30,13 @@
 
 #include <fdm/fdm_Manager.h>
 
+#include <fdm/utils/fdm_SeqLock.h>
+
+#include <g1000/sim/g1000_IFD.h>
+
+#include <hid/hid_Defines.h>
+
+#include <Autopilot.h>
 #include <Data.h>
 #include <defs.h>
 
@@ -44,8 +51,11 @@ class Simulation : public QThread
 
 public:
 
-    /** Constructor. */
-    Simulation();
+    /**
+     * Constructor.
+     * @param ap autopilot updated inside the FDM step
+     */
+    Simulation( Autopilot *ap );
 
     /** Destructor. */
     virtual ~Simulation();
@@ -56,6 +66,12 @@ public:
     /** */
     void run();
 
+    /**
+     * Gets the latest G1000 IFD state. Might be called by any thread.
+     * @param state output state
+     */
+    void getStateIFD( g1000::IFD::State *state ) const;
+
 public slots:
 
     /** */
@@ -81,11 +97,55 @@ private:
     fdm::DataInp _dataInp;          ///< flight dynamics model input data
     fdm::DataOut _dataOut;          ///< flight dynamics model output data
 
+    Data::Input _input;             ///< joystick input read at each step
+
+    Autopilot *_ap;                 ///< autopilot
+    Autopilot::State _apState;      ///< autopilot state
+
+    g1000::IFD *_ifd;               ///< G1000 Integrated Flight Deck
+    g1000::Input _ifdInput;         ///< G1000 Integrated Flight Deck input data
+
+    fdm::SeqLock< g1000::IFD::State > _ifdState;    ///< G1000 Integrated Flight Deck state published to GUI thread
+
+    Data::Navigation _navigation;   ///< navigation data
+
+    double _ctrlRoll;               ///< pilot roll control, autopilot command not included
+    double _ctrlPitch;              ///< pilot pitch control, autopilot command not included
+    double _ctrlYaw;                ///< pilot yaw control, autopilot command not included
+
+    double _avionicsTime;           ///< [s] time elapsed since the last avionics update
+    unsigned int _avionicsSteps;    ///< number of steps since the last avionics update
+
+    unsigned int _events[ HID_MAX_JOYS ];   ///< number of joysticks events already sampled
+    long long _eventTime;                   ///< [ns] time of the newest joystick event sampled in the current step
+
     double _timeStep;               ///<
     double _timeCoef;               ///<
 
     int _timerId;                   ///<
 
+    /**
+     * @brief Samples the latest joystick axis position.
+     * @param axis sampled axis
+     * @param value output control value, unchanged if axis is not sampled
+     * @param raw output raw axis position (optional)
+     * Updates time of the newest event if new joystick events were sampled.
+     */
+    void sampleAxis( const Data::Input::Axis &axis, double *value,
+                     double *raw = NULLPTR );
+
+    /**
+     * @brief Updates autopilot and G1000 IFD sensors using the latest FDM output.
+     * @param timeStep [s] time step
+     */
+    void updateAvionics( double timeStep );
+
+    /** @brief Sets controls as sum of pilot controls and autopilot commands. */
+    void updateControls();
+
+    /** @brief Updates G1000 IFD input data. */
+    void updateInputIFD();
+
 private slots:
 
     void update();
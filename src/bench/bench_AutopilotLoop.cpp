@@ -0,0 +1,325 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_AutopilotLoop.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <cgi/cgi_Defines.h>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Angles.h>
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Units.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_AUTOPILOT_ALTITUDE    500.0   /* initial altitude AGL [m]                   */
+#define BENCH_AUTOPILOT_AIRSPEED     55.0   /* initial airspeed [m/s]                     */
+#define BENCH_AUTOPILOT_HEADING      30.0   /* commanded heading change [deg]             */
+#define BENCH_AUTOPILOT_RISE          0.9   /* rise time heading change fraction          */
+#define BENCH_AUTOPILOT_HOLD_TIME    10.0   /* time of holding before heading change [s]  */
+#define BENCH_AUTOPILOT_TIMER_PHASE 0.005   /* GUI timer phase relative to FDM steps [s]  */
+#define BENCH_AUTOPILOT_STEP_TIME   0.001   /* FDM step and queued signal delivery time [s] */
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* AutopilotLoop::getName( Schedule schedule )
+{
+    switch ( schedule )
+    {
+        case GuiTimer: return "gui_timer";
+        case FdmStep:  return "fdm_step";
+    }
+
+    return "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AutopilotLoop::AutopilotLoop( unsigned int divisor, double drawTime ) :
+    _session ( NULLPTR ),
+    _ap ( NULLPTR ),
+    _divisor ( divisor > 0 ? divisor : 1 ),
+    _drawTime ( drawTime )
+{
+    _session = new Session( fdm::DataInp::C172 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AutopilotLoop::~AutopilotLoop()
+{
+    DELPTR( _ap );
+    DELPTR( _session );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool AutopilotLoop::run( Schedule schedule, double duration, Result *result )
+{
+    memset( result, 0, sizeof(Result) );
+    result->rise = -1.0;
+
+    if ( !_session->initialize( BENCH_AUTOPILOT_ALTITUDE, BENCH_AUTOPILOT_AIRSPEED ) )
+    {
+        fdm::Log::e() << "Cannot initialize " << Session::getName( _session->getType() ) << std::endl;
+        return false;
+    }
+
+    DELPTR( _ap );
+
+    try
+    {
+        _ap = new fdm::C172_KFC325_AP();
+        _ap->initialize();
+    }
+    catch ( const fdm::Exception &e )
+    {
+        fdm::Log::e() << e.getInfo() << std::endl;
+        return false;
+    }
+
+    engage();
+
+    const double heading_0  = _session->getDataOut().flight.heading;
+    const double altitude_0 = _session->getDataOut().flight.altitude_asl;
+    const double heading_1  = fdm::Angles::normalize( heading_0 + fdm::Units::deg2rad( BENCH_AUTOPILOT_HEADING ) );
+
+    const unsigned int steps = static_cast< unsigned int >( ( BENCH_AUTOPILOT_HOLD_TIME + duration ) / FDM_TIME_STEP + 0.5 );
+
+    fdm::DataOut dataOut_prev = _session->getDataOut();
+
+    double time_timer  = BENCH_AUTOPILOT_TIMER_PHASE;   // next GUI timer event
+    double time_update = 0.0;                           // last autopilot update
+    double time_sample = 0.0;                           // FDM output the current commands were computed from
+
+    double sum_interval = 0.0;
+    double sum_interval2 = 0.0;
+    double sum_age = 0.0;
+    double sum_ctrl_rate2 = 0.0;
+
+    double ctrl_roll_prev = 0.0;
+
+    bool changed = false;
+
+    for ( unsigned int n = 0; n < steps; n++ )
+    {
+        const double time = n * FDM_TIME_STEP;
+
+        // heading change is selected once holding is finished
+        if ( !changed && time >= BENCH_AUTOPILOT_HOLD_TIME )
+        {
+            _ap->setHeading( heading_1 );
+            changed = true;
+        }
+
+        if ( schedule == FdmStep )
+        {
+            // autopilot is updated using output of the previous step just before the next one
+            if ( n % _divisor == 0 )
+            {
+                update( _divisor * FDM_TIME_STEP, _session->getDataOut() );
+
+                if ( result->updates > 0 )
+                {
+                    double interval = time - time_update;
+                    sum_interval  += interval;
+                    sum_interval2 += interval * interval;
+                    result->interval_max = std::max( result->interval_max, interval );
+                }
+
+                time_sample = time;
+                time_update = time;
+                result->updates++;
+            }
+        }
+        else
+        {
+            // GUI thread events processed before the next step
+            double time_proc = getProcessingTime( time_timer );
+
+            while ( time_proc < time )
+            {
+                // output of the previous step is queued after the step is done
+                bool delivered = getProcessingTime( time - FDM_TIME_STEP + BENCH_AUTOPILOT_STEP_TIME ) <= time_proc;
+
+                update( time_proc - time_update, delivered ? _session->getDataOut() : dataOut_prev );
+
+                if ( result->updates > 0 )
+                {
+                    double interval = time_proc - time_update;
+                    sum_interval  += interval;
+                    sum_interval2 += interval * interval;
+                    result->interval_max = std::max( result->interval_max, interval );
+                }
+
+                time_sample = delivered ? time : time - FDM_TIME_STEP;
+                time_update = time_proc;
+                result->updates++;
+
+                // timer events missed while GUI thread was busy are merged
+                while ( time_timer <= time_proc ) time_timer += FDM_TIME_STEP;
+
+                time_proc = getProcessingTime( time_timer );
+            }
+        }
+
+        // commands applied in this step
+        double age = time - time_sample;
+        sum_age += age;
+        result->age_max = std::max( result->age_max, age );
+
+        double ctrl_roll = 0.0;
+
+        fdm::DataInp *dataInp = _session->getDataInp();
+
+        if ( _ap->isActiveAP() && _ap->isActiveFD() )
+        {
+            ctrl_roll = _ap->getCtrlRoll();
+
+            dataInp->controls.roll  = fdm::Misc::satur( -1.0, 1.0, -_ap->getCtrlRoll()  );
+            dataInp->controls.pitch = fdm::Misc::satur( -1.0, 1.0, -_ap->getCtrlPitch() );
+        }
+
+        if ( _ap->isActiveYD() )
+        {
+            dataInp->controls.yaw = fdm::Misc::satur( -1.0, 1.0, -_ap->getCtrlYaw() );
+        }
+
+        if ( n > 0 )
+        {
+            double ctrl_rate = ( ctrl_roll - ctrl_roll_prev ) / FDM_TIME_STEP;
+            sum_ctrl_rate2 += ctrl_rate * ctrl_rate;
+        }
+
+        ctrl_roll_prev = ctrl_roll;
+
+        dataOut_prev = _session->getDataOut();
+
+        _session->step( FDM_TIME_STEP );
+
+        if ( !_session->isWorking() )
+        {
+            fdm::Log::e() << "Simulation stopped at " << time << " s" << std::endl;
+            return false;
+        }
+
+        // heading response
+        if ( changed )
+        {
+            const fdm::DataOut &dataOut = _session->getDataOut();
+
+            double error = fdm::Angles::normalize( dataOut.flight.heading - heading_1, -M_PI );
+
+            result->overshoot = std::max( result->overshoot, error );
+            result->alt_dev = std::max( result->alt_dev, fabs( dataOut.flight.altitude_asl - altitude_0 ) );
+
+            double change = fdm::Units::deg2rad( BENCH_AUTOPILOT_HEADING );
+
+            if ( result->rise < 0.0 && error > -( 1.0 - BENCH_AUTOPILOT_RISE ) * change )
+            {
+                result->rise = time + FDM_TIME_STEP - BENCH_AUTOPILOT_HOLD_TIME;
+            }
+
+            result->error = error;
+        }
+    }
+
+    if ( result->updates > 1 )
+    {
+        double count = result->updates - 1;
+
+        result->interval_mean = sum_interval / count;
+        result->interval_std  = sqrt( std::max( 0.0, sum_interval2 / count
+                                      - result->interval_mean * result->interval_mean ) );
+    }
+
+    result->age_mean  = sum_age / steps;
+    result->ctrl_rate = sqrt( sum_ctrl_rate2 / steps );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double AutopilotLoop::getProcessingTime( double time ) const
+{
+    // events are delayed until the OTW frame being drawn is finished
+    double frame = floor( time / CGI_TIME_STEP ) * CGI_TIME_STEP;
+
+    if ( time < frame + _drawTime )
+    {
+        return frame + _drawTime;
+    }
+
+    return time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AutopilotLoop::engage()
+{
+    const fdm::DataOut &dataOut = _session->getDataOut();
+
+    // same as pressing FD, AP, ALT and HDG buttons in the application
+    _ap->setPitch( dataOut.flight.pitch );
+    _ap->onPressedFD();
+    _ap->onPressedAP();
+
+    _ap->setAltitude( dataOut.flight.altitude_asl );
+    _ap->onPressedALT();
+
+    _ap->setHeading( dataOut.flight.heading );
+    _ap->onPressedHDG();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AutopilotLoop::update( double timeStep, const fdm::DataOut &dataOut )
+{
+    fdm::Autopilot *autopilot = _ap;
+
+    autopilot->update( timeStep,
+                       dataOut.flight.roll,
+                       dataOut.flight.pitch,
+                       dataOut.flight.heading,
+                       dataOut.flight.altitude_asl,
+                       dataOut.flight.ias,
+                       dataOut.flight.turnRate,
+                       dataOut.flight.yawRate,
+                       dataOut.flight.climbRate,
+                       0.0,
+                       0.0, false,
+                       0.0, false,
+                       0.0, false );
+}
@@ -0,0 +1,134 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_AUTOPILOTLOOP_H
+#define BENCH_AUTOPILOTLOOP_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm_c172/c172_KFC325_AP.h>
+
+#include <bench/bench_Session.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Headless autopilot control loop comparison class.
+ *
+ * Cessna 172 with KFC 325 autopilot holds altitude and is commanded
+ * a heading change. Time is simulated, so results are deterministic.
+ * Autopilot is updated either:
+ * - by GUI thread timer at FDM_TIME_STEP, as Manager class did; timer events
+ *   and queued FDM output are delayed while OTW frames are drawn, so update
+ *   interval varies and commands are computed from stale FDM output,
+ * - inside the FDM step every given number of steps, as Simulation class does.
+ */
+class AutopilotLoop
+{
+public:
+
+    /** Autopilot update schedules. */
+    enum Schedule
+    {
+        GuiTimer = 0,                   ///< GUI thread timer
+        FdmStep                         ///< inside the FDM step
+    };
+
+    /** Comparison results. */
+    struct Result
+    {
+        unsigned int updates;           ///< number of autopilot updates
+
+        double interval_mean;           ///< [s] mean autopilot update interval
+        double interval_std;            ///< [s] autopilot update interval standard deviation (jitter)
+        double interval_max;            ///< [s] max autopilot update interval
+
+        double age_mean;                ///< [s] mean age of FDM output the applied commands were computed from
+        double age_max;                 ///< [s] max age of FDM output the applied commands were computed from
+
+        double overshoot;               ///< [rad] heading overshoot
+        double rise;                    ///< [s] heading 90% rise time, negative if not reached
+        double error;                   ///< [rad] final heading error
+        double alt_dev;                 ///< [m] max altitude deviation
+        double ctrl_rate;               ///< [1/s] RMS of the roll control command rate
+    };
+
+    /**
+     * @brief Returns schedule name.
+     * @param schedule autopilot update schedule
+     * @return schedule name
+     */
+    static const char* getName( Schedule schedule );
+
+    /**
+     * @brief Constructor.
+     * @param divisor number of FDM steps per autopilot update (FdmStep schedule)
+     * @param drawTime [s] simulated OTW frame drawing time (GuiTimer schedule)
+     */
+    AutopilotLoop( unsigned int divisor, double drawTime );
+
+    /** @brief Destructor. */
+    virtual ~AutopilotLoop();
+
+    /**
+     * @brief Runs heading change.
+     * @param schedule autopilot update schedule
+     * @param duration [s] run duration after heading change
+     * @param result output results
+     * @return true on success, false on failure
+     */
+    bool run( Schedule schedule, double duration, Result *result );
+
+private:
+
+    Session *_session;                  ///< headless simulation session
+
+    fdm::C172_KFC325_AP *_ap;           ///< autopilot
+
+    const unsigned int _divisor;        ///< number of FDM steps per autopilot update
+    const double _drawTime;             ///< [s] simulated OTW frame drawing time
+
+    /**
+     * @brief Returns time at which GUI thread event loop processes event.
+     * @param time [s] event time
+     * @return [s] event processing time
+     */
+    double getProcessingTime( double time ) const;
+
+    /** @brief Engages autopilot in altitude and heading hold modes. */
+    void engage();
+
+    /**
+     * @brief Updates autopilot.
+     * @param timeStep [s] time step
+     * @param dataOut FDM output data
+     */
+    void update( double timeStep, const fdm::DataOut &dataOut );
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_AUTOPILOTLOOP_H
@@ -0,0 +1,320 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Benchmark.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Time.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Benchmark::Benchmark( unsigned int batches ) :
+    _batches ( batches > 0 ? batches : 1 ),
+    _thresholdFactor ( 1.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Benchmark::~Benchmark()
+{
+    Cases::iterator it = _cases.begin();
+    while ( it != _cases.end() )
+    {
+        DELPTR( (*it) );
+        it = _cases.erase( it );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::addCase( Case *benchCase )
+{
+    _cases.push_back( benchCase );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Benchmark::readThresholds( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() )
+        {
+            fdm::XmlNode thresholdNode = rootNode.getFirstChildElement( "threshold" );
+
+            while ( thresholdNode.isValid() )
+            {
+                std::string name = thresholdNode.getAttribute( "name" );
+                double threshold = 0.0;
+
+                if ( FDM_SUCCESS == fdm::XmlUtils::read( thresholdNode, &threshold ) )
+                {
+                    _thresholds[ name ] = threshold;
+                }
+                else
+                {
+                    fdm::Log::w() << "Invalid threshold " << fdm::XmlUtils::getErrorInfo( thresholdNode ) << std::endl;
+                }
+
+                thresholdNode = thresholdNode.getNextSiblingElement( "threshold" );
+            }
+
+            return true;
+        }
+    }
+
+    fdm::Log::e() << "Cannot read thresholds file \"" << file << "\"" << std::endl;
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::run( const std::string &filter )
+{
+    _results.clear();
+
+    for ( Cases::iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        if ( (*it)->getName().compare( 0, filter.length(), filter ) == 0 )
+        {
+            try
+            {
+                _results.push_back( runCase( *it ) );
+            }
+            catch ( const fdm::Exception &e )
+            {
+                fdm::Log::e() << (*it)->getName() << ": " << e.getInfo() << std::endl;
+
+                Result result;
+
+                result.name         = (*it)->getName();
+                result.operations   = 0;
+                result.batches      = 0;
+                result.min_us       = 0.0;
+                result.median_us    = 0.0;
+                result.mean_us      = 0.0;
+                result.threshold_us = -1.0;
+                result.reference    = (*it)->getReference();
+                result.speedup      = 0.0;
+                result.passed       = false;
+
+                _results.push_back( result );
+            }
+        }
+    }
+
+    // speedups relative to reference cases
+    for ( Results::iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        if ( !(*it).reference.empty() && (*it).median_us > 0.0 )
+        {
+            for ( Results::const_iterator ref = _results.begin(); ref != _results.end(); ++ref )
+            {
+                if ( (*ref).name == (*it).reference && (*ref).median_us > 0.0 )
+                {
+                    (*it).speedup = (*ref).median_us / (*it).median_us;
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Benchmark::writeJSON( const char *file ) const
+{
+    std::fstream fs( file, std::ios_base::out | std::ios_base::trunc );
+
+    if ( fs.is_open() )
+    {
+        fs.setf( std::ios_base::fixed );
+
+        fs << "{\n";
+        fs << "  \"suite\": \"" << SIM_APP_NAME << "\",\n";
+        fs << "  \"version\": \"" << SIM_APP_VER << "\",\n";
+        fs << "  \"passed\": " << ( isPassed() ? "true" : "false" ) << ",\n";
+        fs << "  \"results\": [\n";
+
+        for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+        {
+            fs << "    {\n";
+            fs << "      \"name\": \"" << (*it).name << "\",\n";
+            fs << "      \"operations\": " << (*it).operations << ",\n";
+            fs << "      \"batches\": " << (*it).batches << ",\n";
+            fs << "      \"min_us\": "    << std::setprecision( 4 ) << (*it).min_us    << ",\n";
+            fs << "      \"median_us\": " << std::setprecision( 4 ) << (*it).median_us << ",\n";
+            fs << "      \"mean_us\": "   << std::setprecision( 4 ) << (*it).mean_us   << ",\n";
+
+            if ( (*it).threshold_us < 0.0 )
+                fs << "      \"threshold_us\": null,\n";
+            else
+                fs << "      \"threshold_us\": " << std::setprecision( 4 ) << (*it).threshold_us << ",\n";
+
+            if ( (*it).reference.empty() )
+                fs << "      \"reference\": null,\n";
+            else
+                fs << "      \"reference\": \"" << (*it).reference << "\",\n";
+
+            if ( (*it).speedup > 0.0 )
+                fs << "      \"speedup\": " << std::setprecision( 3 ) << (*it).speedup << ",\n";
+            else
+                fs << "      \"speedup\": null,\n";
+
+            fs << "      \"passed\": " << ( (*it).passed ? "true" : "false" ) << "\n";
+            fs << "    }" << ( ( it + 1 ) != _results.end() ? "," : "" ) << "\n";
+        }
+
+        fs << "  ]\n";
+        fs << "}\n";
+
+        fs.close();
+
+        return true;
+    }
+
+    fdm::Log::e() << "Cannot write results file \"" << file << "\"" << std::endl;
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::print() const
+{
+    fdm::Log::out().setf( std::ios_base::fixed );
+
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        fdm::Log::out() << std::left << std::setw( 48 ) << std::setfill( ' ' ) << (*it).name << std::right;
+        fdm::Log::out() << std::setw( 12 ) << std::setprecision( 4 ) << (*it).median_us << " us";
+
+        if ( (*it).threshold_us >= 0.0 )
+        {
+            fdm::Log::out() << " (max " << std::setprecision( 4 ) << (*it).threshold_us << " us)";
+        }
+
+        if ( (*it).speedup > 0.0 )
+        {
+            fdm::Log::out() << " (x" << std::setprecision( 2 ) << (*it).speedup << " vs " << (*it).reference << ")";
+        }
+
+        if ( !(*it).passed )
+        {
+            fdm::Log::out() << " FAILED";
+        }
+
+        fdm::Log::out() << std::endl;
+    }
+
+    fdm::Log::out().unsetf( std::ios_base::fixed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Benchmark::isPassed() const
+{
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        if ( !(*it).passed ) return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Benchmark::Result Benchmark::runCase( Case *benchCase )
+{
+    Result result;
+
+    result.name       = benchCase->getName();
+    result.operations = benchCase->getCount();
+    result.batches    = _batches;
+    result.reference  = benchCase->getReference();
+    result.speedup    = 0.0;
+
+    std::vector< double > times;
+
+    benchCase->setUp();
+
+    // warm-up batch (caches, lazy initializations, etc.)
+    benchCase->run( benchCase->getCount() );
+
+    for ( unsigned int i = 0; i < _batches; i++ )
+    {
+        double t_0 = fdm::Time::get();
+        benchCase->run( benchCase->getCount() );
+        double t_1 = fdm::Time::get();
+
+        times.push_back( 1.0e6 * ( t_1 - t_0 ) / (double)benchCase->getCount() );
+    }
+
+    benchCase->tearDown();
+
+    std::sort( times.begin(), times.end() );
+
+    double sum = 0.0;
+
+    for ( unsigned int i = 0; i < times.size(); i++ )
+    {
+        sum += times[ i ];
+    }
+
+    result.min_us    = times.front();
+    result.median_us = times[ times.size() / 2 ];
+    result.mean_us   = sum / (double)times.size();
+
+    Thresholds::const_iterator it = _thresholds.find( result.name );
+
+    if ( it != _thresholds.end() )
+    {
+        result.threshold_us = _thresholdFactor * it->second;
+        result.passed = result.median_us <= result.threshold_us;
+    }
+    else
+    {
+        result.threshold_us = -1.0;
+        result.passed = true;
+    }
+
+    return result;
+}
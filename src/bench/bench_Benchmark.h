@@ -0,0 +1,166 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_BENCHMARK_H
+#define BENCH_BENCHMARK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <bench/bench_Case.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Benchmark runner class.
+ *
+ * Runs registered cases, collects per operation timing statistics, checks
+ * them against regression thresholds and writes results in JSON format.
+ *
+ * Thresholds XML file format:
+ * @code
+ * <bench>
+ *   <threshold name="{ case name }"> { [us] maximum median time per operation } </threshold>
+ *   ... { more entries }
+ * </bench>
+ * @endcode
+ *
+ * JSON output format:
+ * @code
+ * {
+ *   "suite": "{ application name }",
+ *   "version": "{ application version }",
+ *   "passed": { true if all thresholds are met },
+ *   "results": [
+ *     {
+ *       "name": "{ case name }",
+ *       "operations": { number of operations per batch },
+ *       "batches": { number of timed batches },
+ *       "min_us": { [us] minimum time per operation },
+ *       "median_us": { [us] median time per operation },
+ *       "mean_us": { [us] mean time per operation },
+ *       "threshold_us": { [us] threshold or null },
+ *       "reference": "{ reference case name }" or null,
+ *       "speedup": { reference case median time divided by this case median time } or null,
+ *       "passed": { true if threshold is met or not defined }
+ *     },
+ *     ... { more entries }
+ *   ]
+ * }
+ * @endcode
+ */
+class Benchmark
+{
+public:
+
+    /** Case result. */
+    struct Result
+    {
+        std::string name;           ///< case name
+        unsigned int operations;    ///< number of operations per batch
+        unsigned int batches;       ///< number of timed batches
+        double min_us;              ///< [us] minimum time per operation
+        double median_us;           ///< [us] median time per operation
+        double mean_us;             ///< [us] mean time per operation
+        double threshold_us;        ///< [us] threshold (negative if not defined)
+        std::string reference;      ///< reference case name (empty if none)
+        double speedup;             ///< [-] speedup relative to reference case (zero if not available)
+        bool passed;                ///< specifies if threshold is met
+    };
+
+    typedef std::vector< Case* > Cases;
+    typedef std::vector< Result > Results;
+    typedef std::map< std::string, double > Thresholds;
+
+    /**
+     * @brief Constructor.
+     * @param batches number of timed batches per case
+     */
+    Benchmark( unsigned int batches = 7 );
+
+    /** @brief Destructor. */
+    virtual ~Benchmark();
+
+    /**
+     * @brief Adds case, benchmark takes ownership of the case object.
+     * @param benchCase case object
+     */
+    void addCase( Case *benchCase );
+
+    /**
+     * @brief Reads regression thresholds.
+     * @param file thresholds XML file path
+     * @return true on success, false on failure
+     */
+    bool readThresholds( const char *file );
+
+    /**
+     * @brief Runs cases.
+     * @param filter only cases which names begin with filter are run
+     */
+    void run( const std::string &filter = "" );
+
+    /**
+     * @brief Writes results in JSON format.
+     * @param file output file path
+     * @return true on success, false on failure
+     */
+    bool writeJSON( const char *file ) const;
+
+    /** @brief Prints results summary. */
+    void print() const;
+
+    /** @brief Returns true if all cases met their thresholds. */
+    bool isPassed() const;
+
+    inline const Results& getResults() const { return _results; }
+
+    inline void setThresholdFactor( double factor ) { _thresholdFactor = factor; }
+
+private:
+
+    Cases _cases;               ///< cases
+    Results _results;           ///< results
+    Thresholds _thresholds;     ///< [us] thresholds
+
+    const unsigned int _batches;    ///< number of timed batches per case
+
+    double _thresholdFactor;    ///< [-] thresholds scaling factor (for slower or faster machines)
+
+    /**
+     * @brief Runs single case.
+     * @param benchCase case object
+     * @return case result
+     */
+    Result runCase( Case *benchCase );
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_BENCHMARK_H
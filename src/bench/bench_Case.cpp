@@ -0,0 +1,58 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Case.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+volatile double Case::_sink = 0.0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Case::Case( const char *name, unsigned int count, const char *reference ) :
+    _name ( name ),
+    _count ( count ),
+    _reference ( reference )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Case::~Case() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Case::setUp() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Case::tearDown() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Case::sink( double value )
+{
+    _sink = _sink + value;
+}
@@ -0,0 +1,95 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_CASE_H
+#define BENCH_CASE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Benchmark case base class.
+ *
+ * Single benchmark case measures the cost of one operation (table lookup,
+ * integration step, FDM step, etc.). Runner calls run() with number of
+ * operations to be performed in one timed batch.
+ */
+class Case
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param name case name (dot separated, e.g. "fdm.utils.table1")
+     * @param count number of operations in a single batch
+     * @param reference name of the case this case is compared against
+     */
+    Case( const char *name, unsigned int count, const char *reference = "" );
+
+    /** @brief Destructor. */
+    virtual ~Case();
+
+    /** @brief Prepares case, called once before first batch. */
+    virtual void setUp();
+
+    /** @brief Cleans up case, called once after last batch. */
+    virtual void tearDown();
+
+    /**
+     * @brief Performs given number of operations.
+     * @param count number of operations
+     */
+    virtual void run( unsigned int count ) = 0;
+
+    inline const std::string& getName() const { return _name; }
+
+    inline unsigned int getCount() const { return _count; }
+
+    inline const std::string& getReference() const { return _reference; }
+
+protected:
+
+    /**
+     * @brief Consumes value so the compiler cannot optimize computations out.
+     * @param value computed value
+     */
+    static void sink( double value );
+
+private:
+
+    static volatile double _sink;   ///< results sink
+
+    const std::string _name;        ///< case name
+    const unsigned int _count;      ///< number of operations in a single batch
+    const std::string _reference;   ///< reference case name (empty if none)
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_CASE_H
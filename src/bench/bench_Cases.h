@@ -0,0 +1,74 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_CASES_H
+#define BENCH_CASES_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <bench/bench_Benchmark.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Adds utilities benchmark cases (tables, matrices, quaternions, solvers).
+ * @param benchmark benchmark runner
+ */
+void addCasesUtils( Benchmark *benchmark );
+
+/**
+ * @brief Adds models benchmark cases (rotor blades, main rotors).
+ * @param benchmark benchmark runner
+ */
+void addCasesModels( Benchmark *benchmark );
+
+/**
+ * @brief Adds aircraft benchmark cases (integration and full FDM steps).
+ * @param benchmark benchmark runner
+ */
+void addCasesAircraft( Benchmark *benchmark );
+
+/**
+ * @brief Adds navigation benchmark cases.
+ * @param benchmark benchmark runner
+ */
+void addCasesNav( Benchmark *benchmark );
+
+/**
+ * @brief Adds map benchmark cases (symbols culling and decluttering).
+ * @param benchmark benchmark runner
+ */
+void addCasesMap( Benchmark *benchmark );
+
+/**
+ * @brief Adds scenery intersections and collisions detection benchmark cases.
+ * @param benchmark benchmark runner
+ */
+void addCasesIntersections( Benchmark *benchmark );
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_CASES_H
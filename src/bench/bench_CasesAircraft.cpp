@@ -0,0 +1,430 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <bench/bench_Session.h>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm_c130/c130_FDM.h>
+#include <fdm_c172/c172_FDM.h>
+#include <fdm_f16/f16_FDM.h>
+#include <fdm_uh60/uh60_FDM.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Flight dynamics model probe template class.
+ *
+ * Gives access to the aircraft model so that it can be integrated directly,
+ * bypassing input and output data handling done by the FDM wrapper.
+ */
+template < class TYPE >
+class Probe : public TYPE
+{
+public:
+
+    Probe( const fdm::DataInp *dataInpPtr, fdm::DataOut *dataOutPtr ) :
+        TYPE( dataInpPtr, dataOutPtr, false )
+    {}
+
+    inline fdm::Aircraft* getAircraft() { return this->fdm::FDM::_aircraft; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Aircraft model Runge-Kutta 4th order integration benchmark case. */
+template < class TYPE >
+class CaseAircraftUpdate : public Case
+{
+public:
+
+    CaseAircraftUpdate( const char *name, fdm::DataInp::AircraftType type,
+                        const char *reference = "" ) :
+        Case( name, 200, reference ),
+        _type ( type ),
+        _probe ( NULLPTR )
+    {}
+
+    void setUp()
+    {
+        Session::setDefaults( &_dataInp, _type );
+        memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+
+        _dataInp.initial.altitude_agl = 500.0;
+        _dataInp.initial.airspeed     = 60.0;
+
+        _probe = new Probe< TYPE >( &_dataInp, &_dataOut );
+
+        for ( unsigned int i = 0; i < FDM_MAX_INIT_STEPS && !_probe->isReady(); i++ )
+        {
+            _probe->initialize();
+        }
+    }
+
+    void tearDown()
+    {
+        DELPTR( _probe );
+    }
+
+    void run( unsigned int count )
+    {
+        fdm::Aircraft *aircraft = _probe->getAircraft();
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            aircraft->update( FDM_TIME_STEP, true );
+        }
+
+        sink( aircraft->getAltitude_ASL() );
+    }
+
+protected:
+
+    const fdm::DataInp::AircraftType _type;
+
+    fdm::DataInp _dataInp;
+    fdm::DataOut _dataOut;
+
+    Probe< TYPE > *_probe;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Aircraft model multi-rate integration benchmark case.
+ *
+ * Slow modules (mass, propulsion) are updated at reduced rates, speedup is
+ * reported against single rate integration case.
+ */
+template < class TYPE >
+class CaseAircraftMultiRate : public CaseAircraftUpdate< TYPE >
+{
+public:
+
+    CaseAircraftMultiRate( const char *name, fdm::DataInp::AircraftType type,
+                           const char *reference ) :
+        CaseAircraftUpdate< TYPE >( name, type, reference )
+    {}
+
+    void setUp()
+    {
+        CaseAircraftUpdate< TYPE >::setUp();
+
+        fdm::Aircraft::Rates rates = this->_probe->getAircraft()->getRates();
+
+        rates.mass = 10.0;
+        rates.prop = 25.0;
+
+        this->_probe->getAircraft()->setRates( rates );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Aircraft model integration with moderate turbulence benchmark case.
+ *
+ * Turbulence cost is reported against no turbulence integration case.
+ */
+template < class TYPE >
+class CaseAircraftTurbulence : public CaseAircraftUpdate< TYPE >
+{
+public:
+
+    CaseAircraftTurbulence( const char *name, fdm::DataInp::AircraftType type,
+                            const char *reference ) :
+        CaseAircraftUpdate< TYPE >( name, type, reference )
+    {}
+
+    void setUp()
+    {
+        CaseAircraftUpdate< TYPE >::setUp();
+
+        this->_probe->getAircraft()->getEnvir()->setTurbulence( fdm::Turbulence::Moderate );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Landing gear contact benchmark case.
+ *
+ * A single operation is 4 * FDM_TIME_STEP of simulated time on the ground,
+ * integrated either with 4 steps of FDM_TIME_STEP using single step contact
+ * (current path) or with a single 4 times larger step sub-stepped as
+ * required by the gear stiffness. Taxi starts at 10 m/s with idle engines,
+ * landing starts 0.5 m above the ground at 50 m/s and 3 m/s sink rate and is
+ * restarted every 5 seconds.
+ *
+ * Gear force noise (RMS of the gear load factor change between samples) and
+ * the peak gear load factor are logged on tear down.
+ */
+template < class TYPE >
+class CaseGear : public Case
+{
+public:
+
+    enum Scenario
+    {
+        Taxi = 0,
+        Landing
+    };
+
+    CaseGear( const char *name, fdm::DataInp::AircraftType type,
+              Scenario scenario, bool subSteps, const char *reference = "" ) :
+        Case( name, 50, reference ),
+        _type ( type ),
+        _scenario ( scenario ),
+        _subSteps ( subSteps ),
+        _probe ( NULLPTR )
+    {}
+
+    void setUp()
+    {
+        Session::setDefaults( &_dataInp, _type );
+        memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+
+        _dataInp.initial.altitude_agl = 0.0;
+        _dataInp.initial.airspeed     = 0.0;
+
+        _dataInp.controls.landing_gear = 1.0;
+
+        for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            _dataInp.engine[ i ].throttle = 0.0;
+        }
+
+        _probe = new Probe< TYPE >( &_dataInp, &_dataOut );
+
+        for ( unsigned int i = 0; i < FDM_MAX_INIT_STEPS && !_probe->isReady(); i++ )
+        {
+            _probe->initialize();
+        }
+
+        fdm::Aircraft *aircraft = _probe->getAircraft();
+
+        aircraft->setContactStepsMax( _subSteps ? FDM_MAX_CONTACT_STEPS : 1 );
+
+        _stateInit = aircraft->getStateVect();
+
+        if ( _scenario == Taxi )
+        {
+            _stateInit( fdm::Aircraft::_i_u ) = 10.0;
+        }
+        else
+        {
+            fdm::Vector3 r_wgs = aircraft->getNormal_WGS() * 0.5;
+
+            _stateInit( fdm::Aircraft::_i_x ) += r_wgs.x();
+            _stateInit( fdm::Aircraft::_i_y ) += r_wgs.y();
+            _stateInit( fdm::Aircraft::_i_z ) += r_wgs.z();
+
+            _stateInit( fdm::Aircraft::_i_u ) = 50.0;
+            _stateInit( fdm::Aircraft::_i_w ) =  3.0;
+        }
+
+        aircraft->setStateVector( _stateInit );
+
+        _time = 0.0;
+        _load = 0.0;
+        _peak = 0.0;
+        _sum_sq = 0.0;
+        _samples = 0;
+    }
+
+    void tearDown()
+    {
+        if ( _samples > 0 )
+        {
+            fdm::Log::i() << getName()
+                          << ": gear load noise " << sqrt( _sum_sq / (double)_samples )
+                          << ", peak load " << _peak << std::endl;
+        }
+
+        DELPTR( _probe );
+    }
+
+    void run( unsigned int count )
+    {
+        fdm::Aircraft *aircraft = _probe->getAircraft();
+
+        const unsigned int steps = _subSteps ? 1 : 4;
+        const double timeStep = 4.0 * FDM_TIME_STEP / (double)steps;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            if ( _scenario == Landing && _time > 5.0 )
+            {
+                aircraft->setStateVector( _stateInit );
+                _time = 0.0;
+            }
+
+            for ( unsigned int j = 0; j < steps; j++ )
+            {
+                aircraft->update( timeStep, true );
+            }
+
+            _time += 4.0 * FDM_TIME_STEP;
+
+            // gear load factor is sampled at the same rate in both modes
+            double load = aircraft->getGear()->getFor_BAS().z()
+                        / ( aircraft->getMass()->getMass() * fdm::WGS84::_g );
+
+            _peak = fdm::Misc::max( _peak, fabs( load ) );
+
+            if ( _time > 4.0 * FDM_TIME_STEP )
+            {
+                _sum_sq += ( load - _load ) * ( load - _load );
+                _samples++;
+            }
+
+            _load = load;
+        }
+
+        sink( aircraft->getAltitude_AGL() );
+    }
+
+private:
+
+    const fdm::DataInp::AircraftType _type;
+    const Scenario _scenario;
+    const bool _subSteps;
+
+    fdm::DataInp _dataInp;
+    fdm::DataOut _dataOut;
+
+    Probe< TYPE > *_probe;
+
+    fdm::Aircraft::StateVector _stateInit;
+
+    double _time;
+    double _load;
+    double _peak;
+    double _sum_sq;
+
+    unsigned int _samples;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Full flight dynamics model step benchmark case. */
+class CaseStep : public Case
+{
+public:
+
+    CaseStep( const std::string &name, Session::AircraftType type ) :
+        Case( name.c_str(), 200 ),
+        _type ( type ),
+        _session ( NULLPTR )
+    {}
+
+    void setUp()
+    {
+        _session = new Session( _type );
+
+        if ( !_session->initialize( 500.0, 60.0 ) )
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::UnknownException );
+            e.setInfo( "Cannot initialize flight dynamics model." );
+
+            FDM_THROW( e );
+        }
+    }
+
+    void tearDown()
+    {
+        DELPTR( _session );
+    }
+
+    void run( unsigned int count )
+    {
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            // crash or ground contact ends the flight, start over
+            if ( !_session->isWorking() && _session->getDataOut().stateOut != fdm::DataOut::Idle )
+            {
+                _session->initialize( 500.0, 60.0 );
+            }
+
+            _session->step( FDM_TIME_STEP );
+        }
+
+        sink( _session->getDataOut().flight.altitude_asl );
+    }
+
+private:
+
+    const Session::AircraftType _type;
+
+    Session *_session;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesAircraft( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseAircraftUpdate< fdm::C172_FDM >( "fdm.aircraft.c172.update", fdm::DataInp::C172 ) );
+    benchmark->addCase( new CaseAircraftUpdate< fdm::F16_FDM  >( "fdm.aircraft.f16.update",  fdm::DataInp::F16  ) );
+    benchmark->addCase( new CaseAircraftUpdate< fdm::UH60_FDM >( "fdm.aircraft.uh60.update", fdm::DataInp::UH60 ) );
+
+    benchmark->addCase( new CaseAircraftMultiRate< fdm::C172_FDM >( "fdm.aircraft.c172.update_multirate", fdm::DataInp::C172, "fdm.aircraft.c172.update" ) );
+    benchmark->addCase( new CaseAircraftMultiRate< fdm::F16_FDM  >( "fdm.aircraft.f16.update_multirate",  fdm::DataInp::F16,  "fdm.aircraft.f16.update"  ) );
+    benchmark->addCase( new CaseAircraftMultiRate< fdm::UH60_FDM >( "fdm.aircraft.uh60.update_multirate", fdm::DataInp::UH60, "fdm.aircraft.uh60.update" ) );
+
+    benchmark->addCase( new CaseAircraftTurbulence< fdm::C172_FDM >( "fdm.aircraft.c172.update_turbulence", fdm::DataInp::C172, "fdm.aircraft.c172.update" ) );
+    benchmark->addCase( new CaseAircraftTurbulence< fdm::F16_FDM  >( "fdm.aircraft.f16.update_turbulence",  fdm::DataInp::F16,  "fdm.aircraft.f16.update"  ) );
+    benchmark->addCase( new CaseAircraftTurbulence< fdm::UH60_FDM >( "fdm.aircraft.uh60.update_turbulence", fdm::DataInp::UH60, "fdm.aircraft.uh60.update" ) );
+
+    benchmark->addCase( new CaseGear< fdm::F16_FDM  >( "fdm.gear.f16.taxi",            fdm::DataInp::F16,  CaseGear< fdm::F16_FDM  >::Taxi,    false ) );
+    benchmark->addCase( new CaseGear< fdm::F16_FDM  >( "fdm.gear.f16.taxi_substep",    fdm::DataInp::F16,  CaseGear< fdm::F16_FDM  >::Taxi,    true, "fdm.gear.f16.taxi" ) );
+    benchmark->addCase( new CaseGear< fdm::F16_FDM  >( "fdm.gear.f16.landing",         fdm::DataInp::F16,  CaseGear< fdm::F16_FDM  >::Landing, false ) );
+    benchmark->addCase( new CaseGear< fdm::F16_FDM  >( "fdm.gear.f16.landing_substep", fdm::DataInp::F16,  CaseGear< fdm::F16_FDM  >::Landing, true, "fdm.gear.f16.landing" ) );
+    benchmark->addCase( new CaseGear< fdm::C130_FDM >( "fdm.gear.c130.taxi",            fdm::DataInp::C130, CaseGear< fdm::C130_FDM >::Taxi,    false ) );
+    benchmark->addCase( new CaseGear< fdm::C130_FDM >( "fdm.gear.c130.taxi_substep",    fdm::DataInp::C130, CaseGear< fdm::C130_FDM >::Taxi,    true, "fdm.gear.c130.taxi" ) );
+    benchmark->addCase( new CaseGear< fdm::C130_FDM >( "fdm.gear.c130.landing",         fdm::DataInp::C130, CaseGear< fdm::C130_FDM >::Landing, false ) );
+    benchmark->addCase( new CaseGear< fdm::C130_FDM >( "fdm.gear.c130.landing_substep", fdm::DataInp::C130, CaseGear< fdm::C130_FDM >::Landing, true, "fdm.gear.c130.landing" ) );
+
+    for ( unsigned int i = 0; i < Session::_types_count; i++ )
+    {
+        std::string name = "fdm.step.";
+        name += Session::getName( Session::_types[ i ] );
+
+        benchmark->addCase( new CaseStep( name, Session::_types[ i ] ) );
+    }
+}
+
+} // end of bench namespace
@@ -0,0 +1,541 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <fdm/fdm_Collisions.h>
+
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+#include <cgi/cgi_TriangleBVH.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Scenery intersections benchmark case. A single operation is a ground
+ * elevation query, i.e. a down-ray from 10000 m to -1000 m, over a synthetic
+ * 512x512 cells (30 m) terrain expressed in WGS, split into 32x32 cells
+ * drawables.
+ *
+ * Scene graph traversal approach is represented by its intersection part
+ * only: bounding sphere test of every drawable and test of every triangle
+ * of drawables hit, as done by osgUtil::LineSegmentIntersector without
+ * kd-trees, leaving out the visitor and intersector allocations.
+ */
+class CaseIntersections : public Case
+{
+public:
+
+    CaseIntersections( const char *name, bool bvh, const char *reference = "" ) :
+        Case( name, 1000, reference ),
+        _bvh ( bvh )
+    {}
+
+    void setUp()
+    {
+        const int cells = 512;
+        const int chunk = 32;
+        const double cell = 30.0;
+
+        const double lat_0 = fdm::Units::deg2rad(   21.3 );
+        const double lon_0 = fdm::Units::deg2rad( -157.9 );
+
+        const double d_lat = cell / fdm::WGS84::_a;
+        const double d_lon = cell / ( fdm::WGS84::_a * cos( lat_0 ) );
+
+        std::vector< fdm::Vector3 > grid;
+
+        for ( int j = 0; j <= cells; j++ )
+        {
+            for ( int i = 0; i <= cells; i++ )
+            {
+                double elev = 300.0 * sin( 0.011 * i ) * cos( 0.017 * j )
+                            +  20.0 * sin( 0.3 * i + 0.2 * j );
+
+                grid.push_back( fdm::WGS84::geo2wgs( lat_0 + j * d_lat, lon_0 + i * d_lon, elev ) );
+            }
+        }
+
+        _chunks.clear();
+        _tree.clear();
+
+        for ( int c_j = 0; c_j < cells / chunk; c_j++ )
+        {
+            for ( int c_i = 0; c_i < cells / chunk; c_i++ )
+            {
+                Chunk ch;
+
+                for ( int j = c_j * chunk; j < ( c_j + 1 ) * chunk; j++ )
+                {
+                    for ( int i = c_i * chunk; i < ( c_i + 1 ) * chunk; i++ )
+                    {
+                        const fdm::Vector3 &v_0 = grid[ j * ( cells + 1 ) + i ];
+                        const fdm::Vector3 &v_1 = grid[ j * ( cells + 1 ) + i + 1 ];
+                        const fdm::Vector3 &v_2 = grid[ ( j + 1 ) * ( cells + 1 ) + i ];
+                        const fdm::Vector3 &v_3 = grid[ ( j + 1 ) * ( cells + 1 ) + i + 1 ];
+
+                        addTriangle( &ch, v_0, v_1, v_2 );
+                        addTriangle( &ch, v_1, v_3, v_2 );
+                    }
+                }
+
+                ch.center = ( grid[ c_j * chunk * ( cells + 1 ) + c_i * chunk ]
+                            + grid[ ( c_j + 1 ) * chunk * ( cells + 1 ) + ( c_i + 1 ) * chunk ] ) * 0.5;
+                ch.radius = 0.0;
+
+                for ( unsigned int k = 0; k < ch.v.size(); k += 3 )
+                {
+                    fdm::Vector3 v( ch.v[ k ], ch.v[ k + 1 ], ch.v[ k + 2 ] );
+                    ch.radius = std::max( ch.radius, ( v - ch.center ).getLength() );
+                }
+
+                _chunks.push_back( ch );
+            }
+        }
+
+        _tree.build();
+
+        std::mt19937 gen( 1 );
+        std::uniform_real_distribution< double > dist( 0.0, 1.0 );
+
+        _rays.clear();
+
+        for ( unsigned int i = 0; i < 4096; i++ )
+        {
+            double lat = lat_0 + dist( gen ) * cells * d_lat;
+            double lon = lon_0 + dist( gen ) * cells * d_lon;
+
+            fdm::Vector3 b = fdm::WGS84::geo2wgs( lat, lon,  10000.0 );
+            fdm::Vector3 e = fdm::WGS84::geo2wgs( lat, lon, -1000.0 );
+
+            cgi::TriangleBVH::Ray ray = { { b.x(), b.y(), b.z() }, { e.x(), e.y(), e.z() } };
+
+            _rays.push_back( ray );
+        }
+
+        _step = 0;
+    }
+
+    void tearDown()
+    {
+        _chunks.clear();
+        _tree.clear();
+        _rays.clear();
+    }
+
+    void run( unsigned int count )
+    {
+        double sum = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            const cgi::TriangleBVH::Ray &ray = _rays[ _step % _rays.size() ];
+
+            if ( _bvh )
+            {
+                cgi::TriangleBVH::Hit hit;
+
+                if ( _tree.intersect( ray.b, ray.e, &hit ) ) sum += hit.t;
+            }
+            else
+            {
+                sum += intersectChunks( ray );
+            }
+
+            _step++;
+        }
+
+        sink( sum );
+    }
+
+private:
+
+    struct Chunk
+    {
+        std::vector< double > v;
+        fdm::Vector3 center;
+        double radius;
+    };
+
+    const bool _bvh;
+
+    std::vector< Chunk > _chunks;
+    std::vector< cgi::TriangleBVH::Ray > _rays;
+
+    cgi::TriangleBVH _tree;
+
+    unsigned int _step;
+
+    void addTriangle( Chunk *ch, const fdm::Vector3 &v_0, const fdm::Vector3 &v_1, const fdm::Vector3 &v_2 )
+    {
+        double v[ 9 ];
+
+        v_0.getArray( &v[ 0 ] );
+        v_1.getArray( &v[ 3 ] );
+        v_2.getArray( &v[ 6 ] );
+
+        _tree.insert( &v[ 0 ], &v[ 3 ], &v[ 6 ] );
+
+        ch->v.insert( ch->v.end(), v, v + 9 );
+    }
+
+    double intersectChunks( const cgi::TriangleBVH::Ray &ray ) const
+    {
+        fdm::Vector3 b( ray.b[ 0 ], ray.b[ 1 ], ray.b[ 2 ] );
+        fdm::Vector3 e( ray.e[ 0 ], ray.e[ 1 ], ray.e[ 2 ] );
+        fdm::Vector3 d = e - b;
+
+        double t_min = 1.0;
+
+        for ( std::vector< Chunk >::const_iterator it = _chunks.begin(); it != _chunks.end(); ++it )
+        {
+            // segment to sphere center distance
+            double t = std::max( 0.0, std::min( 1.0, ( ( it->center - b ) * d ) / ( d * d ) ) );
+
+            if ( ( b + d * t - it->center ).getLength() > it->radius ) continue;
+
+            for ( unsigned int k = 0; k < it->v.size(); k += 9 )
+            {
+                fdm::Vector3 v_0( it->v[ k     ], it->v[ k + 1 ], it->v[ k + 2 ] );
+                fdm::Vector3 v_1( it->v[ k + 3 ], it->v[ k + 4 ], it->v[ k + 5 ] );
+                fdm::Vector3 v_2( it->v[ k + 6 ], it->v[ k + 7 ], it->v[ k + 8 ] );
+
+                fdm::Vector3 e_1 = v_1 - v_0;
+                fdm::Vector3 e_2 = v_2 - v_0;
+
+                fdm::Vector3 p = d % e_2;
+
+                double det = e_1 * p;
+
+                if ( fabs( det ) < 1.0e-12 ) continue;
+
+                fdm::Vector3 s = b - v_0;
+
+                double u = ( s * p ) / det;
+
+                if ( u < 0.0 || u > 1.0 ) continue;
+
+                fdm::Vector3 q = s % e_1;
+
+                double v = ( d * q ) / det;
+
+                if ( v < 0.0 || u + v > 1.0 ) continue;
+
+                double t_hit = ( e_2 * q ) / det;
+
+                if ( t_hit >= 0.0 && t_hit < t_min ) t_min = t_hit;
+            }
+        }
+
+        return t_min;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Collisions detection benchmark case. A single operation is a collision
+ * check of a single step of the F-16 (7 collision points) flying at 300 m/s
+ * over a synthetic 128x128 cells (30 m) terrain triangles BVH.
+ *
+ * Round robin approach tests one collision point per step with a segment
+ * from the aircraft origin, as done by Aircraft before fdm::Collisions.
+ */
+class CaseCollisions : public Case
+{
+public:
+
+    CaseCollisions( const char *name, bool swept, double altitude_agl,
+                    const char *reference = "" ) :
+        Case( name, 1000, reference ),
+        _swept ( swept ),
+        _altitude_agl ( altitude_agl ),
+        _isect ( &_tree ),
+        _collisions ( &_isect )
+    {}
+
+    void setUp()
+    {
+        const int cells = 128;
+        const double cell = 30.0;
+
+        const double lat_0 = fdm::Units::deg2rad(   21.3 );
+        const double lon_0 = fdm::Units::deg2rad( -157.9 );
+
+        const double d_lat = cell / fdm::WGS84::_a;
+        const double d_lon = cell / ( fdm::WGS84::_a * cos( lat_0 ) );
+
+        std::vector< fdm::Vector3 > grid;
+
+        for ( int j = 0; j <= cells; j++ )
+        {
+            for ( int i = 0; i <= cells; i++ )
+            {
+                double elev = 300.0 * sin( 0.044 * i ) * cos( 0.068 * j )
+                            +  20.0 * sin( 0.3 * i + 0.2 * j );
+
+                grid.push_back( fdm::WGS84::geo2wgs( lat_0 + j * d_lat, lon_0 + i * d_lon, elev ) );
+            }
+        }
+
+        _tree.clear();
+
+        for ( int j = 0; j < cells; j++ )
+        {
+            for ( int i = 0; i < cells; i++ )
+            {
+                double v[ 12 ];
+
+                grid[ j * ( cells + 1 ) + i ].getArray( &v[ 0 ] );
+                grid[ j * ( cells + 1 ) + i + 1 ].getArray( &v[ 3 ] );
+                grid[ ( j + 1 ) * ( cells + 1 ) + i ].getArray( &v[ 6 ] );
+                grid[ ( j + 1 ) * ( cells + 1 ) + i + 1 ].getArray( &v[ 9 ] );
+
+                _tree.insert( &v[ 0 ], &v[ 3 ], &v[ 6 ] );
+                _tree.insert( &v[ 3 ], &v[ 9 ], &v[ 6 ] );
+            }
+        }
+
+        _tree.build();
+
+        _cp.clear();
+        _cp.push_back( fdm::Vector3(  8.29,  0.00,  0.27 ) );
+        _cp.push_back( fdm::Vector3( -6.18,  0.00,  0.42 ) );
+        _cp.push_back( fdm::Vector3( -6.61,  0.00, -3.29 ) );
+        _cp.push_back( fdm::Vector3( -2.50, -0.65,  1.32 ) );
+        _cp.push_back( fdm::Vector3( -2.50,  0.65,  1.32 ) );
+        _cp.push_back( fdm::Vector3( -2.00, -4.72,  0.00 ) );
+        _cp.push_back( fdm::Vector3( -2.00,  4.72,  0.00 ) );
+
+        _collisions.setPoints( _cp );
+
+        // eastbound flight along the terrain center line, terrain following
+        _poses.clear();
+
+        fdm::Quaternion att_ned( fdm::Angles( 0.0, 0.0, M_PI_2 ) );
+
+        double lat = lat_0 + 0.5 * cells * d_lat;
+
+        for ( unsigned int i = 0; i < 1000; i++ )
+        {
+            double lon = lon_0 + ( 10.0 + 3.0 * i ) / cell * d_lon;
+
+            fdm::Vector3 b = fdm::WGS84::geo2wgs( lat, lon,  10000.0 );
+            fdm::Vector3 e = fdm::WGS84::geo2wgs( lat, lon, -1000.0 );
+
+            double b_tmp[ 3 ];
+            double e_tmp[ 3 ];
+
+            b.getArray( b_tmp );
+            e.getArray( e_tmp );
+
+            cgi::TriangleBVH::Hit hit;
+
+            if ( !_tree.intersect( b_tmp, e_tmp, &hit ) ) continue;
+
+            fdm::Vector3 r( hit.r[ 0 ], hit.r[ 1 ], hit.r[ 2 ] );
+
+            fdm::Geo pos_geo;
+
+            pos_geo.lat = lat;
+            pos_geo.lon = lon;
+            pos_geo.alt = fdm::WGS84::wgs2geo( r ).alt + _altitude_agl;
+
+            fdm::WGS84 wgs( pos_geo );
+
+            Pose pose;
+
+            pose.pos_wgs = wgs.getPos_WGS();
+            pose.bas2wgs = fdm::Matrix3x3( wgs.getWGS2BAS( att_ned ) ).getTransposed();
+            pose.ground_wgs = r;
+            pose.normal_wgs = wgs.getNorm_WGS();
+
+            _poses.push_back( pose );
+        }
+
+        _collisions.reset();
+
+        _cp_index = 0;
+        _step = 0;
+    }
+
+    void tearDown()
+    {
+        _tree.clear();
+        _poses.clear();
+    }
+
+    void run( unsigned int count )
+    {
+        double sum = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            unsigned int index = _step % _poses.size();
+
+            const Pose &pose = _poses[ index ];
+
+            // updated every step by the aircraft regardless of collisions
+            _isect.setGroundWGS( pose.ground_wgs );
+            _isect.setNormalWGS( pose.normal_wgs );
+
+            if ( _swept )
+            {
+                if ( index == 0 ) _collisions.reset();
+
+                if ( _collisions.update( pose.pos_wgs, pose.bas2wgs ) ) sum += 1.0;
+            }
+            else
+            {
+                if ( _isect.isIntersection( pose.pos_wgs, pose.pos_wgs + pose.bas2wgs * _cp[ _cp_index ], true ) ) sum += 1.0;
+
+                _cp_index = ( _cp_index + 1 ) % _cp.size();
+            }
+
+            _step++;
+        }
+
+        sink( sum );
+    }
+
+private:
+
+    /** Terrain triangles BVH intersections. */
+    class TerrainIntersections : public fdm::Intersections
+    {
+    public:
+
+        TerrainIntersections( const cgi::TriangleBVH *tree ) :
+            _tree ( tree )
+        {
+            _inited = true;
+        }
+
+        int getIntersection( const fdm::Vector3 &b, const fdm::Vector3 &e,
+                             fdm::Vector3 *r, fdm::Vector3 *n, bool ) const
+        {
+            double b_tmp[ 3 ];
+            double e_tmp[ 3 ];
+
+            b.getArray( b_tmp );
+            e.getArray( e_tmp );
+
+            cgi::TriangleBVH::Hit hit;
+
+            if ( _tree->intersect( b_tmp, e_tmp, &hit ) )
+            {
+                r->set( hit.r[ 0 ], hit.r[ 1 ], hit.r[ 2 ] );
+                n->set( hit.n[ 0 ], hit.n[ 1 ], hit.n[ 2 ] );
+
+                return FDM_SUCCESS;
+            }
+
+            return FDM_FAILURE;
+        }
+
+        unsigned int getIntersections( const fdm::Vector3 b[], const fdm::Vector3 e[],
+                                       Hit hits[], unsigned int count, bool ) const
+        {
+            const unsigned int size = 16;
+
+            cgi::TriangleBVH::Ray rays_tmp[ size ];
+            cgi::TriangleBVH::Hit hits_tmp[ size ];
+
+            unsigned int result = 0;
+
+            for ( unsigned int i = 0; i < count; i += size )
+            {
+                unsigned int n = std::min( size, count - i );
+
+                for ( unsigned int j = 0; j < n; j++ )
+                {
+                    b[ i + j ].getArray( rays_tmp[ j ].b );
+                    e[ i + j ].getArray( rays_tmp[ j ].e );
+                }
+
+                result += _tree->intersect( rays_tmp, hits_tmp, n );
+
+                for ( unsigned int j = 0; j < n; j++ )
+                {
+                    hits[ i + j ].valid = hits_tmp[ j ].valid;
+                    hits[ i + j ].t = hits_tmp[ j ].t;
+                    hits[ i + j ].r.set( hits_tmp[ j ].r[ 0 ], hits_tmp[ j ].r[ 1 ], hits_tmp[ j ].r[ 2 ] );
+                    hits[ i + j ].n.set( hits_tmp[ j ].n[ 0 ], hits_tmp[ j ].n[ 1 ], hits_tmp[ j ].n[ 2 ] );
+                }
+            }
+
+            return result;
+        }
+
+    private:
+
+        const cgi::TriangleBVH *_tree;
+    };
+
+    struct Pose
+    {
+        fdm::Vector3 pos_wgs;
+        fdm::Matrix3x3 bas2wgs;
+        fdm::Vector3 ground_wgs;
+        fdm::Vector3 normal_wgs;
+    };
+
+    const bool _swept;
+    const double _altitude_agl;
+
+    cgi::TriangleBVH _tree;
+
+    TerrainIntersections _isect;
+
+    fdm::Collisions _collisions;
+    fdm::Collisions::Points _cp;
+
+    std::vector< Pose > _poses;
+
+    unsigned int _cp_index;
+    unsigned int _step;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesIntersections( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseIntersections( "cgi.intersections.drawables", false ) );
+    benchmark->addCase( new CaseIntersections( "cgi.intersections.bvh", true, "cgi.intersections.drawables" ) );
+
+    benchmark->addCase( new CaseCollisions( "fdm.collisions.round_robin" , false,   60.0 ) );
+    benchmark->addCase( new CaseCollisions( "fdm.collisions.swept"       , true ,   60.0, "fdm.collisions.round_robin" ) );
+    benchmark->addCase( new CaseCollisions( "fdm.collisions.swept_high"  , true , 3000.0, "fdm.collisions.round_robin" ) );
+}
+
+} // end of bench namespace
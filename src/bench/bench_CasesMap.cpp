@@ -0,0 +1,203 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+#include <cgi/map/cgi_QuadTree.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Map symbols selection benchmark case. A single operation is a map frame
+ * with the view panned over a synthetic worldwide data base of 50000 symbols.
+ *
+ * Node per icon approach is represented by its culling part only: view test
+ * of every single symbol, as done by the cull traversal for every symbol
+ * transform node. Quadtree approach includes query, decluttering and filling
+ * the instances array to be uploaded. Region variant queries and fills the
+ * array only when the view leaves the region around the previously queried
+ * view, as done by Symbols::update().
+ */
+class CaseMapSymbols : public Case
+{
+public:
+
+    CaseMapSymbols( const char *name, bool culled, bool region,
+                    const char *reference = "" ) :
+        Case( name, 100, reference ),
+        _culled ( culled ),
+        _region ( region )
+    {}
+
+    void setUp()
+    {
+        std::mt19937 gen( 1 );
+
+        std::uniform_real_distribution< double > dist_sin_lat( -0.99, 0.99 );
+        std::uniform_real_distribution< double > dist_lon( -M_PI, M_PI );
+
+        _x.clear();
+        _y.clear();
+        _quadTree.clear();
+
+        for ( unsigned int i = 0; i < 50000; i++ )
+        {
+            double lat = asin( dist_sin_lat( gen ) );
+            double lon = dist_lon( gen );
+
+            // spherical Mercator projection
+            double x = fdm::WGS84::_a * lon;
+            double y = fdm::WGS84::_a * log( tan( M_PI_4 + 0.5 * lat ) );
+
+            _x.push_back( x );
+            _y.push_back( y );
+
+            _quadTree.insert( i, x, y );
+        }
+
+        _quadTree.build();
+
+        _step = 0;
+        _queried = false;
+    }
+
+    void tearDown()
+    {
+        _x.clear();
+        _y.clear();
+        _quadTree.clear();
+        _instances.clear();
+    }
+
+    void run( unsigned int count )
+    {
+        unsigned int visible = 0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            // 1000 km wide view panned eastwards along 45 deg N
+            const double w_2 = 500.0e3;
+            const double h_2 = 300.0e3;
+
+            // symbol size 10 km, see Icons::setScale()
+            const double size = 10.0e3;
+
+            double lon = fdm::Units::deg2rad( -180.0 + 0.1 * ( _step % 3600 ) );
+
+            double x = fdm::WGS84::_a * lon;
+            double y = fdm::WGS84::_a * log( tan( M_PI_4 + 0.5 * fdm::Units::deg2rad( 45.0 ) ) );
+
+            if ( _region && _queried
+              && x - w_2 - size >= _x_min && x + w_2 + size <= _x_max
+              && y - h_2 - size >= _y_min && y + h_2 + size <= _y_max )
+            {
+                visible += (unsigned int)_items.size();
+            }
+            else if ( _culled )
+            {
+                // region extends the view by half of its size on every side
+                double d_x = _region ? w_2 : 0.0;
+                double d_y = _region ? h_2 : 0.0;
+
+                _x_min = x - w_2 - size - d_x;
+                _x_max = x + w_2 + size + d_x;
+                _y_min = y - h_2 - size - d_y;
+                _y_max = y + h_2 + size + d_y;
+
+                _queried = true;
+
+                _quadTree.find( &_items, _x_min, _y_min, _x_max, _y_max, size );
+
+                _instances.clear();
+
+                for ( cgi::QuadTree::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
+                {
+                    _instances.push_back( (float)_x[ *it ] );
+                    _instances.push_back( (float)_y[ *it ] );
+                    _instances.push_back( 0.0f );
+                }
+
+                visible += (unsigned int)_items.size();
+            }
+            else
+            {
+                for ( unsigned int j = 0; j < _x.size(); j++ )
+                {
+                    if ( fabs( _x[ j ] - x ) < w_2 + size
+                      && fabs( _y[ j ] - y ) < h_2 + size )
+                    {
+                        visible++;
+                    }
+                }
+            }
+
+            _step++;
+        }
+
+        sink( visible );
+    }
+
+private:
+
+    const bool _culled;
+    const bool _region;
+
+    double _x_min;
+    double _x_max;
+    double _y_min;
+    double _y_max;
+
+    bool _queried;
+
+    std::vector< double > _x;
+    std::vector< double > _y;
+
+    std::vector< float > _instances;
+
+    cgi::QuadTree _quadTree;
+    cgi::QuadTree::Items _items;
+
+    unsigned int _step;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesMap( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseMapSymbols( "cgi.map.symbols.node_per_icon", false, false ) );
+    benchmark->addCase( new CaseMapSymbols( "cgi.map.symbols.quadtree", true, false, "cgi.map.symbols.node_per_icon" ) );
+    benchmark->addCase( new CaseMapSymbols( "cgi.map.symbols.quadtree_region", true, true, "cgi.map.symbols.quadtree" ) );
+}
+
+} // end of bench namespace
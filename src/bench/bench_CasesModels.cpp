@@ -0,0 +1,369 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <cstdio>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Path.h>
+
+#include <fdm/models/fdm_MainRotor.h>
+#include <fdm/models/fdm_MainRotorBE.h>
+#include <fdm/models/fdm_RotorBlade.h>
+#include <fdm/models/fdm_WindField.h>
+
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Reads helicopter main rotor data node.
+ * @param doc XML document
+ * @param name main rotor node name
+ * @return main rotor data node
+ */
+static fdm::XmlNode getMainRotorNode( fdm::XmlDoc &doc, const char *name = "main_rotor_be" )
+{
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() )
+        {
+            fdm::XmlNode nodeAero = rootNode.getFirstChildElement( "aerodynamics" );
+            fdm::XmlNode nodeRotor = nodeAero.getFirstChildElement( name );
+
+            if ( nodeRotor.isValid() )
+            {
+                return nodeRotor;
+            }
+        }
+    }
+
+    fdm::Exception e;
+
+    e.setType( fdm::Exception::FileReadingError );
+    e.setInfo( "Cannot read main rotor data file." );
+
+    FDM_THROW( e );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Rotor blade integration benchmark case. */
+class CaseRotorBlade : public Case
+{
+public:
+
+    CaseRotorBlade() : Case( "fdm.models.rotor_blade.integrate", 1000 ), _blade ( NULLPTR ) {}
+
+    void setUp()
+    {
+        fdm::XmlDoc doc( fdm::Path::get( "fdm/xh/xh_fdm.xml" ).c_str() );
+        fdm::XmlNode nodeRotor = getMainRotorNode( doc );
+        fdm::XmlNode nodeBlade = nodeRotor.getFirstChildElement( "blade" );
+
+        _blade = new fdm::RotorBlade( true );
+        _blade->readData( nodeBlade );
+    }
+
+    void tearDown()
+    {
+        DELPTR( _blade );
+    }
+
+    void run( unsigned int count )
+    {
+        const double omega = 27.0;
+        const double dt = fdm::MainRotorBE::_timeStepMax;
+
+        double azimuth = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            _blade->integrate( dt,
+                               fdm::Vector3( 30.0, 0.0, 2.0 ),
+                               fdm::Vector3(),
+                               fdm::Vector3(),
+                               fdm::Vector3(),
+                               fdm::Vector3(),
+                               fdm::Vector3( 0.0, 0.0, 9.81 ),
+                               omega, azimuth, 1.225,
+                               0.15, 0.0, 0.0 );
+
+            azimuth += omega * dt;
+        }
+
+        sink( _blade->getBeta() );
+    }
+
+private:
+
+    fdm::RotorBlade *_blade;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Blade element main rotor update benchmark case. */
+class CaseMainRotorBE : public Case
+{
+public:
+
+    CaseMainRotorBE() : Case( "fdm.models.main_rotor_be.update", 100 ), _rotor ( NULLPTR ) {}
+
+    void setUp()
+    {
+        fdm::XmlDoc doc( fdm::Path::get( "fdm/xh/xh_fdm.xml" ).c_str() );
+        fdm::XmlNode nodeRotor = getMainRotorNode( doc );
+
+        _rotor = new fdm::MainRotorBE();
+        _rotor->readData( nodeRotor );
+
+        _azimuth = 0.0;
+    }
+
+    void tearDown()
+    {
+        DELPTR( _rotor );
+    }
+
+    void run( unsigned int count )
+    {
+        const double omega = 27.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            _rotor->update( FDM_TIME_STEP,
+                            fdm::Vector3( 30.0, 0.0, 2.0 ),
+                            fdm::Vector3(),
+                            fdm::Vector3(),
+                            fdm::Vector3(),
+                            fdm::Vector3(),
+                            fdm::Vector3( 0.0, 0.0, 9.81 ),
+                            omega, _azimuth, 1.225,
+                            0.15, 0.0, 0.0 );
+
+            _azimuth += omega * FDM_TIME_STEP;
+        }
+
+        sink( _rotor->getThrust() );
+    }
+
+private:
+
+    fdm::MainRotorBE *_rotor;
+
+    double _azimuth;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Main rotor step benchmark case. Each step evaluates the rotor four times,
+ * as Runge-Kutta integration does, with the collective varying in time so
+ * the iterative inflow solve cannot settle on the previous solution.
+ */
+class CaseMainRotor : public Case
+{
+public:
+
+    CaseMainRotor( const char *name, bool dynamicInflow, const char *reference = "" ) :
+        Case( name, 2000, reference ),
+        _dynamicInflow ( dynamicInflow ),
+        _rotor ( NULLPTR )
+    {}
+
+    void setUp()
+    {
+        fdm::XmlDoc doc( fdm::Path::get( "fdm/uh60/uh60_fdm.xml" ).c_str() );
+        fdm::XmlNode nodeRotor = getMainRotorNode( doc, "main_rotor" );
+
+        _rotor = new fdm::MainRotor();
+        _rotor->readData( nodeRotor );
+        _rotor->setDynamicInflow( _dynamicInflow );
+
+        _time = 0.0;
+    }
+
+    void tearDown()
+    {
+        DELPTR( _rotor );
+    }
+
+    void run( unsigned int count )
+    {
+        const double omega = 27.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            _rotor->integrate( FDM_TIME_STEP );
+            _rotor->update( omega, omega * _time, 0.15 + 0.05 * sin( _time ), 0.0, 0.0 );
+
+            for ( int j = 0; j < 4; j++ )
+            {
+                fdm::Vector3 vel_bas( 30.0, 0.0, 2.0 + 0.1 * j );
+
+                _rotor->computeForceAndMoment( vel_bas,
+                                               fdm::Vector3(),
+                                               fdm::Vector3(),
+                                               fdm::Vector3(),
+                                               vel_bas,
+                                               fdm::Vector3(),
+                                               fdm::Vector3( 0.0, 0.0, 9.81 ),
+                                               1.225 );
+            }
+
+            _time += FDM_TIME_STEP;
+        }
+
+        sink( _rotor->getThrust() );
+    }
+
+private:
+
+    const bool _dynamicInflow;
+
+    fdm::MainRotor *_rotor;
+
+    double _time;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Gridded wind field lookup benchmark case. A single operation is a single
+ * wind lookup at the aircraft position, as done by every derivative
+ * evaluation. Field is 16 km x 16 km x 2 km with 200 m x 200 m x 100 m
+ * nodes spacing, positions are spread over the grid.
+ */
+class CaseWindField : public Case
+{
+public:
+
+    CaseWindField() :
+        Case( "fdm.models.wind_field.lookup", 10000 ),
+        _file ( "bench_wind_field.bin" )
+    {}
+
+    void setUp()
+    {
+        fdm::WindField::Grid grid;
+
+        grid.nx = 81;
+        grid.ny = 81;
+        grid.nz = 21;
+        grid.nt = 4;
+
+        grid.origin.lat = fdm::Units::deg2rad( 52.0 );
+        grid.origin.lon = fdm::Units::deg2rad( 21.0 );
+        grid.origin.alt = 0.0;
+
+        grid.dx = 200.0;
+        grid.dy = 200.0;
+        grid.dz = 100.0;
+        grid.dt = 60.0;
+
+        grid.scale = 0.01;
+
+        std::vector< fdm::WindField::Slice > slices( grid.nt );
+
+        for ( unsigned int l = 0; l < grid.nt; l++ )
+        {
+            for ( unsigned int n = 0; n < grid.nx * grid.ny * grid.nz; n++ )
+            {
+                slices[ l ].push_back( fdm::Vector3( 5.0 + sin( 0.01 * n ), 2.0 * cos( 0.02 * n ), 0.1 * l ) );
+            }
+        }
+
+        if ( !fdm::WindField::save( _file, grid, slices ) || !_windField.load( _file ) )
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Cannot create wind field file." );
+
+            FDM_THROW( e );
+        }
+
+        fdm::WGS84 origin( grid.origin );
+
+        _pos_wgs.clear();
+
+        for ( unsigned int i = 0; i < 1000; i++ )
+        {
+            fdm::Vector3 r_ned( 16.0 * ( i % 997 ), 16.0 * ( ( 7 * i ) % 991 ), -2.0 * ( ( 13 * i ) % 983 ) );
+            _pos_wgs.push_back( origin.getPos_WGS() + origin.getNED2WGS() * r_ned );
+        }
+
+        _windField.update( 30.0 );
+    }
+
+    void tearDown()
+    {
+        _windField.unload();
+        remove( _file );
+    }
+
+    void run( unsigned int count )
+    {
+        double sum = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            sum += _windField.getWind_WGS( _pos_wgs[ i % _pos_wgs.size() ] ).x();
+        }
+
+        sink( sum );
+    }
+
+private:
+
+    const char *_file;
+
+    fdm::WindField _windField;
+
+    std::vector< fdm::Vector3 > _pos_wgs;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesModels( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseRotorBlade() );
+    benchmark->addCase( new CaseMainRotorBE() );
+    benchmark->addCase( new CaseMainRotor( "fdm.models.main_rotor.update", false ) );
+    benchmark->addCase( new CaseMainRotor( "fdm.models.main_rotor.update_dynamic_inflow", true, "fdm.models.main_rotor.update" ) );
+    benchmark->addCase( new CaseWindField() );
+}
+
+} // end of bench namespace
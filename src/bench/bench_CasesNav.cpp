@@ -0,0 +1,235 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <random>
+
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+#include <nav/nav_Index.h>
+#include <nav/nav_Manager.h>
+
+#include <Data.h>
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Navigation manager update benchmark case. */
+class CaseNavManager : public Case
+{
+public:
+
+    CaseNavManager() : Case( "nav.manager.update", 100 ), _manager ( NULLPTR ) {}
+
+    void setUp()
+    {
+        // loads navigation database
+        nav::DataBase::instance();
+
+        _manager = new nav::Manager();
+
+        // Honolulu VOR and ADF frequencies
+        _manager->setFreqNAV( 114800 );
+        _manager->setFreqADF( 242 );
+        _manager->setCourse( fdm::Units::deg2rad( 80.0 ) );
+    }
+
+    void tearDown()
+    {
+        DELPTR( _manager );
+    }
+
+    void run( unsigned int count )
+    {
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            // approaching Honolulu International Airport (PHNL) from the west
+            double lon = fdm::Units::deg2rad( -158.2 + 0.25 * ( i % 100 ) / 100.0 );
+
+            fdm::Vector3 pos_wgs = fdm::WGS84::geo2wgs( fdm::Units::deg2rad( 21.3 ), lon, 500.0 );
+
+            Data::get()->ownship.pos_x_wgs = pos_wgs.x();
+            Data::get()->ownship.pos_y_wgs = pos_wgs.y();
+            Data::get()->ownship.pos_z_wgs = pos_wgs.z();
+
+            _manager->update();
+        }
+
+        sink( Data::get()->navigation.nav_bearing );
+    }
+
+private:
+
+    nav::Manager *_manager;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Creates synthetic worldwide VOR data base.
+ * Stations are uniformly distributed over the globe and tuned to one of
+ * the 200 VOR channels (108.00-117.95 MHz).
+ * @param list output list of stations
+ * @param count number of stations
+ */
+static void createWorldNAV( nav::DataBase::ListNAV *list, unsigned int count )
+{
+    std::mt19937 gen( 1 );
+
+    std::uniform_real_distribution< double > dist_sin_lat( -1.0, 1.0 );
+    std::uniform_real_distribution< double > dist_lon( -M_PI, M_PI );
+    std::uniform_int_distribution< int > dist_chan( 0, 199 );
+
+    list->clear();
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        nav::DataBase::NAV nav;
+
+        nav.type = nav::DataBase::NAV::VOR;
+
+        nav.lat  = asin( dist_sin_lat( gen ) );
+        nav.lon  = dist_lon( gen );
+        nav.elev = 0.0;
+        nav.freq = 108000 + 50 * dist_chan( gen );
+
+        nav.pos_wgs = fdm::WGS84::geo2wgs( nav.lat, nav.lon, nav.elev );
+
+        list->push_back( nav );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Navaid tuning query benchmark case. Receiver is retuned at every query,
+ * which is the worst case for the navigation manager.
+ */
+class CaseNavTuning : public Case
+{
+public:
+
+    CaseNavTuning( const char *name, bool indexed, const char *reference = "" ) :
+        Case( name, 1000, reference ),
+        _indexed ( indexed )
+    {}
+
+    void setUp()
+    {
+        createWorldNAV( &_list, 50000 );
+
+        _index.clear();
+
+        for ( unsigned int i = 0; i < _list.size(); i++ )
+        {
+            _index.insert( i, _list[ i ].freq, _list[ i ].lat, _list[ i ].lon );
+        }
+
+        _step = 0;
+    }
+
+    void tearDown()
+    {
+        _list.clear();
+        _index.clear();
+    }
+
+    void run( unsigned int count )
+    {
+        unsigned int found = 0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            // flying eastwards along 45 deg N, scanning through channels
+            double lat = fdm::Units::deg2rad( 45.0 );
+            double lon = fdm::Units::deg2rad( -180.0 + 0.01 * ( _step % 36000 ) );
+            int freq = 108000 + 50 * ( _step % 200 );
+
+            fdm::Vector3 pos_wgs = fdm::WGS84::geo2wgs( lat, lon, 500.0 );
+
+            if ( find( pos_wgs, lat, lon, freq ) ) found++;
+
+            _step++;
+        }
+
+        sink( found );
+    }
+
+private:
+
+    const bool _indexed;
+
+    nav::DataBase::ListNAV _list;
+
+    nav::Index _index;
+    nav::Index::Items _items;
+
+    unsigned int _step;
+
+    bool find( const fdm::Vector3 &pos_wgs, double lat, double lon, int freq )
+    {
+        const double range = nav::Manager::_range_vor;
+
+        if ( _indexed )
+        {
+            _index.find( &_items, freq, lat, lon, range );
+
+            for ( nav::Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
+            {
+                if ( getDistance( _list[ *it ].pos_wgs, pos_wgs ) < range ) return true;
+            }
+        }
+        else
+        {
+            for ( nav::DataBase::ListNAV::const_iterator it = _list.begin(); it != _list.end(); ++it )
+            {
+                if ( (*it).freq == freq && getDistance( (*it).pos_wgs, pos_wgs ) < range ) return true;
+            }
+        }
+
+        return false;
+    }
+
+    static double getDistance( const fdm::Vector3 &pos_1, const fdm::Vector3 &pos_2 )
+    {
+        // orthodromic distance, as computed by navigation manager
+        return fdm::WGS84::_r1 * acos( pos_1.getNormalized() * pos_2.getNormalized() );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesNav( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseNavManager() );
+    benchmark->addCase( new CaseNavTuning( "nav.tuning.linear", false ) );
+    benchmark->addCase( new CaseNavTuning( "nav.tuning.indexed", true, "nav.tuning.linear" ) );
+}
+
+} // end of bench namespace
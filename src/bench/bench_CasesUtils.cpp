@@ -0,0 +1,255 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Cases.h>
+
+#include <cmath>
+#include <vector>
+
+#include <fdm/utils/fdm_GaussJordan.h>
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Matrix6x6.h>
+#include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Table1.h>
+#include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Vector3.h>
+#include <fdm/utils/fdm_Vector6.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Table1 lookup benchmark case. */
+class CaseTable1 : public Case
+{
+public:
+
+    CaseTable1() : Case( "fdm.utils.table1.get_value", 100000 ) {}
+
+    void setUp()
+    {
+        std::vector< double > keys;
+        std::vector< double > vals;
+
+        // typical aerodynamic coefficient table size (angle of attack)
+        for ( int i = 0; i < 60; i++ )
+        {
+            keys.push_back( -M_PI_2 + M_PI * i / 59.0 );
+            vals.push_back( sin( 2.0 * keys.back() ) );
+        }
+
+        _table = fdm::Table1( keys, vals );
+    }
+
+    void run( unsigned int count )
+    {
+        double sum = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            sum += _table.getValue( -1.6 + 3.2 * ( i % 1000 ) / 1000.0 );
+        }
+
+        sink( sum );
+    }
+
+private:
+
+    fdm::Table1 _table;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Table2 lookup benchmark case. */
+class CaseTable2 : public Case
+{
+public:
+
+    CaseTable2() : Case( "fdm.utils.table2.get_value", 100000 ) {}
+
+    void setUp()
+    {
+        std::vector< double > rows;
+        std::vector< double > cols;
+        std::vector< double > data;
+
+        // typical aerodynamic coefficient table size (angle of attack vs Mach number)
+        for ( int r = 0; r < 40; r++ ) rows.push_back( -M_PI_2 + M_PI * r / 39.0 );
+        for ( int c = 0; c < 20; c++ ) cols.push_back( 2.0 * c / 19.0 );
+
+        for ( int r = 0; r < 40; r++ )
+        {
+            for ( int c = 0; c < 20; c++ )
+            {
+                data.push_back( sin( 2.0 * rows[ r ] ) * ( 1.0 + 0.1 * cols[ c ] ) );
+            }
+        }
+
+        _table = fdm::Table2( rows, cols, data );
+    }
+
+    void run( unsigned int count )
+    {
+        double sum = 0.0;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            sum += _table.getValue( -1.6 + 3.2 * ( i % 1000 ) / 1000.0,
+                                    2.1 * ( i % 97 ) / 97.0 );
+        }
+
+        sink( sum );
+    }
+
+private:
+
+    fdm::Table2 _table;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Matrix3x3 operations benchmark case. */
+class CaseMatrix3x3 : public Case
+{
+public:
+
+    CaseMatrix3x3() : Case( "fdm.utils.matrix3x3.mult", 100000 ) {}
+
+    void run( unsigned int count )
+    {
+        fdm::Matrix3x3 m1( fdm::Angles( 0.1, 0.2, 0.3 ) );
+        fdm::Matrix3x3 m2( fdm::Angles( 0.3, -0.2, 0.1 ) );
+        fdm::Vector3 v( 1.0, 2.0, 3.0 );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            v = ( m1 * m2.getTransposed() ) * v;
+        }
+
+        sink( v.getLength() );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Quaternion operations benchmark case. */
+class CaseQuaternion : public Case
+{
+public:
+
+    CaseQuaternion() : Case( "fdm.utils.quaternion.mult", 100000 ) {}
+
+    void run( unsigned int count )
+    {
+        fdm::Quaternion q1( fdm::Angles( 0.1, 0.2, 0.3 ) );
+        fdm::Quaternion q2( fdm::Angles( 1.0e-3, 2.0e-3, 3.0e-3 ) );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            q1 = q1 * q2;
+            q1.normalize();
+        }
+
+        sink( q1.getAngles().psi() );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Vector3 operations benchmark case. */
+class CaseVector3 : public Case
+{
+public:
+
+    CaseVector3() : Case( "fdm.utils.vector3.cross", 100000 ) {}
+
+    void run( unsigned int count )
+    {
+        fdm::Vector3 v1( 1.0, 2.0, 3.0 );
+        fdm::Vector3 v2( 0.3, -0.2, 0.1 );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            v1 = ( v1 % v2 + v1 * 0.5 ).getNormalized();
+        }
+
+        sink( v1.x() );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Gauss-Jordan 6x6 solver benchmark case. */
+class CaseGaussJordan6 : public Case
+{
+public:
+
+    CaseGaussJordan6() : Case( "fdm.utils.gauss_jordan_6.solve", 20000 ) {}
+
+    void setUp()
+    {
+        // mass and inertia matrix alike
+        for ( unsigned int r = 0; r < 6; r++ )
+        {
+            for ( unsigned int c = 0; c < 6; c++ )
+            {
+                _mtr( r, c ) = ( r == c ) ? 1000.0 + 10.0 * r : 1.0 / ( 1.0 + r + c );
+            }
+
+            _rhs( r ) = 1.0 + r;
+        }
+    }
+
+    void run( unsigned int count )
+    {
+        fdm::Vector6 x;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            fdm::GaussJordan< 6 >::solve( _mtr, _rhs, &x );
+        }
+
+        sink( x( 0 ) );
+    }
+
+private:
+
+    fdm::Matrix6x6 _mtr;
+    fdm::Vector6 _rhs;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void addCasesUtils( Benchmark *benchmark )
+{
+    benchmark->addCase( new CaseTable1() );
+    benchmark->addCase( new CaseTable2() );
+    benchmark->addCase( new CaseMatrix3x3() );
+    benchmark->addCase( new CaseQuaternion() );
+    benchmark->addCase( new CaseVector3() );
+    benchmark->addCase( new CaseGaussJordan6() );
+}
+
+} // end of bench namespace
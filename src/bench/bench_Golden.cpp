@@ -0,0 +1,428 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Golden.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+#ifdef _LINUX_
+#   include <time.h>
+#endif
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Time.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <bench/bench_Trajectory.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* Golden::_scenarios[] =
+{
+    "takeoff",
+    "touchdown"
+};
+
+const unsigned int Golden::_scenarios_count = sizeof( _scenarios ) / sizeof( _scenarios[ 0 ] );
+
+////////////////////////////////////////////////////////////////////////////////
+
+Golden::Golden( const std::string &dataDir, const std::string &outDir ) :
+    _dataDir ( dataDir ),
+    _outDir ( outDir ),
+    _budgetFactor ( 1.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Golden::~Golden() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Golden::readTolerances( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() )
+        {
+            fdm::XmlNode toleranceNode = rootNode.getFirstChildElement( "tolerance" );
+
+            while ( toleranceNode.isValid() )
+            {
+                std::string name = toleranceNode.getAttribute( "name" );
+
+                Tolerance tolerance;
+
+                tolerance.value = 0.0;
+                tolerance.angle = toleranceNode.getAttribute( "angle" ) == "1";
+
+                if ( FDM_SUCCESS == fdm::XmlUtils::read( toleranceNode, &tolerance.value ) )
+                {
+                    _tolerances[ name ] = tolerance;
+                }
+                else
+                {
+                    fdm::Log::w() << "Invalid tolerance " << fdm::XmlUtils::getErrorInfo( toleranceNode ) << std::endl;
+                }
+
+                toleranceNode = toleranceNode.getNextSiblingElement( "tolerance" );
+            }
+
+            return true;
+        }
+    }
+
+    fdm::Log::e() << "Cannot read tolerances file \"" << file << "\"" << std::endl;
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Golden::run( const std::string &filter, bool update )
+{
+    _results.clear();
+
+    Jobs jobs;
+
+    // initialization is done sequentially (XML parsing, data files reading)
+    for ( unsigned int i = 0; i < Session::_types_count; i++ )
+    {
+        std::string name = Session::getName( Session::_types[ i ] );
+
+        if ( name.compare( 0, filter.length(), filter ) == 0 )
+        {
+            jobs.push_back( createJob( Session::_types[ i ], name ) );
+        }
+
+        for ( unsigned int j = 0; j < _scenarios_count; j++ )
+        {
+            std::string name_scenario = name + "_" + _scenarios[ j ];
+
+            if ( name_scenario.compare( 0, filter.length(), filter ) != 0 ) continue;
+
+            std::ifstream ifs( ( _dataDir + name_scenario + ".xml" ).c_str() );
+
+            if ( ifs.is_open() )
+            {
+                jobs.push_back( createJob( Session::_types[ i ], name_scenario ) );
+            }
+        }
+    }
+
+    std::vector< std::thread > threads;
+
+    for ( Jobs::iterator it = jobs.begin(); it != jobs.end(); ++it )
+    {
+        if ( (*it)->ready )
+        {
+            threads.push_back( std::thread( &Golden::fly, *it ) );
+        }
+    }
+
+    for ( unsigned int i = 0; i < threads.size(); i++ )
+    {
+        threads[ i ].join();
+    }
+
+    for ( Jobs::iterator it = jobs.begin(); it != jobs.end(); ++it )
+    {
+        Job *job = *it;
+
+        // closes recording file
+        DELPTR( job->session );
+
+        if ( job->ready )
+        {
+            std::string file_golden = _dataDir + job->result.name + ".csv";
+            std::string file_record = _outDir  + job->result.name + ".csv";
+
+            if ( update )
+            {
+                job->result.accuracyPassed = copy( file_record, file_golden );
+
+                if ( !job->result.accuracyPassed )
+                {
+                    job->result.info = "cannot write golden recording";
+                }
+            }
+            else if ( job->result.info.empty() )
+            {
+                compare( file_golden, file_record, &job->result );
+            }
+
+            job->result.budgetPassed = job->result.cpuPerSec <= job->result.budget;
+        }
+
+        _results.push_back( job->result );
+
+        DELPTR( job );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Golden::print() const
+{
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        fdm::Log::out() << std::setfill( ' ' );
+        fdm::Log::out() << std::left  << std::setw( 16 ) << it->name;
+        fdm::Log::out() << std::right << std::fixed << std::setprecision( 2 );
+        fdm::Log::out() << std::setw( 6 ) << it->simTime << " s sim";
+        fdm::Log::out() << std::setprecision( 3 );
+        fdm::Log::out() << std::setw( 9 ) << 1000.0 * it->wallPerSec << " ms/s wall";
+        fdm::Log::out() << std::setw( 9 ) << 1000.0 * it->cpuPerSec  << " ms/s cpu";
+        fdm::Log::out() << " (max " << 1000.0 * it->budget << " ms/s)";
+
+        if ( it->worstName.length() > 0 )
+        {
+            fdm::Log::out() << " worst: " << it->worstName;
+            fdm::Log::out() << std::setprecision( 2 ) << " " << 100.0 * it->worstRatio << "%";
+        }
+
+        if ( !it->accuracyPassed ) fdm::Log::out() << " ACCURACY FAILED";
+        if ( !it->budgetPassed   ) fdm::Log::out() << " BUDGET FAILED";
+
+        if ( it->info.length() > 0 )
+        {
+            fdm::Log::out() << " (" << it->info << ")";
+        }
+
+        fdm::Log::out() << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Golden::isPassed() const
+{
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        if ( !it->accuracyPassed || !it->budgetPassed )
+        {
+            return false;
+        }
+    }
+
+    return _results.size() > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Golden::Job* Golden::createJob( Session::AircraftType type, const std::string &name ) const
+{
+    Job *job = new Job();
+
+    job->session = NULLPTR;
+    job->ready   = false;
+
+    job->result.name           = name;
+    job->result.simTime        = 0.0;
+    job->result.wallTime       = 0.0;
+    job->result.wallPerSec     = 0.0;
+    job->result.cpuPerSec      = 0.0;
+    job->result.budget         = 0.0;
+    job->result.worstRatio     = 0.0;
+    job->result.accuracyPassed = false;
+    job->result.budgetPassed   = false;
+
+    try
+    {
+        std::string file_script = _dataDir + name + ".xml";
+        std::string file_record = _outDir  + name + ".csv";
+
+        job->script.readFile( file_script.c_str() );
+        job->result.budget = _budgetFactor * job->script.getBudget();
+
+        job->session = new Session( type );
+
+        fdm::DataInp *dataInp = job->session->getDataInp();
+
+        dataInp->recording.mode = fdm::DataInp::Recording::Record;
+        strncpy( dataInp->recording.file, file_record.c_str(), sizeof(dataInp->recording.file) - 1 );
+
+        // initial controls, e.g. landing gear extended for ground scenarios
+        job->script.apply( 0.0, dataInp );
+
+        job->ready = job->session->initialize( job->script.getAltitudeAGL(),
+                                               job->script.getAirspeed(),
+                                               job->script.getHeading() );
+
+        if ( !job->ready )
+        {
+            job->result.info = "initialization failed";
+        }
+    }
+    catch ( const fdm::Exception &e )
+    {
+        job->result.info = e.getInfo();
+    }
+
+    return job;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Golden::fly( Job *job )
+{
+    fdm::DataInp *dataInp = job->session->getDataInp();
+
+    unsigned int steps = (unsigned int)floor( job->script.getDuration() / FDM_TIME_STEP + 0.5 );
+    unsigned int step = 0;
+
+    double t_0 = fdm::Time::get();
+    double c_0 = getThreadTime();
+
+    for ( step = 0; step < steps; step++ )
+    {
+        job->script.apply( step * FDM_TIME_STEP, dataInp );
+        job->session->step( FDM_TIME_STEP );
+
+        if ( !job->session->isWorking() )
+        {
+            job->result.info = "flight terminated";
+            break;
+        }
+    }
+
+    double t_1 = fdm::Time::get();
+    double c_1 = getThreadTime();
+
+    job->result.simTime  = step * FDM_TIME_STEP;
+    job->result.wallTime = t_1 - t_0;
+
+    if ( job->result.simTime > 0.0 )
+    {
+        job->result.wallPerSec = job->result.wallTime / job->result.simTime;
+        job->result.cpuPerSec  = ( c_1 - c_0 ) / job->result.simTime;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Golden::getThreadTime()
+{
+#   ifdef _LINUX_
+    timespec ts;
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+    return (double)ts.tv_sec + 1.0e-9 * (double)ts.tv_nsec;
+#   else
+    return fdm::Time::get();
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Golden::compare( const std::string &golden, const std::string &actual,
+                      Result *result ) const
+{
+    Trajectory trajectory_g;
+    Trajectory trajectory_a;
+
+    if ( !trajectory_g.readFile( golden.c_str() ) )
+    {
+        result->info = "cannot read golden recording \"" + golden + "\"";
+        return;
+    }
+
+    if ( !trajectory_a.readFile( actual.c_str() ) )
+    {
+        result->info = "cannot read recording \"" + actual + "\"";
+        return;
+    }
+
+    if ( trajectory_g.getRecordsCount() != trajectory_a.getRecordsCount() )
+    {
+        result->info = "records count mismatch";
+        return;
+    }
+
+    result->worstRatio = 0.0;
+
+    for ( Tolerances::const_iterator it = _tolerances.begin(); it != _tolerances.end(); ++it )
+    {
+        int index_g = trajectory_g.getIndex( it->first );
+        int index_a = trajectory_a.getIndex( it->first );
+
+        if ( index_g < 0 || index_a < 0 )
+        {
+            result->info = "missing variable \"" + it->first + "\"";
+            return;
+        }
+
+        for ( unsigned int i = 0; i < trajectory_g.getRecordsCount(); i++ )
+        {
+            double diff = trajectory_a.getValue( i, index_a ) - trajectory_g.getValue( i, index_g );
+
+            if ( it->second.angle )
+            {
+                diff = atan2( sin( diff ), cos( diff ) );
+            }
+
+            double ratio = fabs( diff ) / fdm::Misc::max( it->second.value, 1.0e-12 );
+
+            if ( ratio > result->worstRatio )
+            {
+                result->worstRatio = ratio;
+                result->worstName  = it->first;
+            }
+        }
+    }
+
+    result->accuracyPassed = result->worstRatio <= 1.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Golden::copy( const std::string &src, const std::string &dst )
+{
+    std::ifstream ifs( src.c_str(), std::ios_base::binary );
+    std::ofstream ofs( dst.c_str(), std::ios_base::binary | std::ios_base::trunc );
+
+    if ( ifs.is_open() && ofs.is_open() )
+    {
+        ofs << ifs.rdbuf();
+        return ofs.good();
+    }
+
+    return false;
+}
@@ -0,0 +1,193 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_GOLDEN_H
+#define BENCH_GOLDEN_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <bench/bench_Script.h>
+#include <bench/bench_Session.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Golden trajectories regression runner class.
+ *
+ * For every aircraft type control input script "{ name }.xml" is replayed
+ * headless with flight recording enabled and the recording is compared
+ * against the golden recording "{ name }.csv", both files placed in golden
+ * data directory. Ground contact scenarios "{ name }_takeoff.xml" and
+ * "{ name }_touchdown.xml" are flown the same way if their scripts exist.
+ * Cases are flown in parallel, one thread per case.
+ * Case fails if any compared variable differs from the golden recording
+ * by more than its tolerance or if time per simulated second exceeds the
+ * script budget. Both wall time and thread CPU time are recorded, budget is
+ * checked against the latter, so running more aircraft than there are CPU
+ * cores does not make cases fail.
+ *
+ * XML tolerances file format:
+ * @code
+ * <golden_tolerances>
+ *   <tolerance name="{ recorded variable name }" [angle="{ 0 or 1 }"]> { maximum absolute difference } </tolerance>
+ *   ... { more entries }
+ * </golden_tolerances>
+ * @endcode
+ */
+class Golden
+{
+public:
+
+    /** Variable tolerance. */
+    struct Tolerance
+    {
+        double value;               ///< maximum absolute difference
+        bool angle;                 ///< specifies if difference should be wrapped to [-pi;pi]
+    };
+
+    /** Case result. */
+    struct Result
+    {
+        std::string name;           ///< case name
+        std::string info;           ///< failure info
+
+        double simTime;             ///< [s] simulated time
+        double wallTime;            ///< [s] wall time
+        double wallPerSec;          ///< [s] wall time per simulated second
+        double cpuPerSec;           ///< [s] thread CPU time per simulated second
+        double budget;              ///< [s] maximum thread CPU time per simulated second
+
+        std::string worstName;      ///< name of the variable closest to its tolerance
+        double worstRatio;          ///< greatest difference to tolerance ratio
+
+        bool accuracyPassed;        ///< specifies if accuracy check passed
+        bool budgetPassed;          ///< specifies if performance budget check passed
+    };
+
+    typedef std::map< std::string, Tolerance > Tolerances;
+    typedef std::vector< Result > Results;
+
+    /**
+     * @brief Constructor.
+     * @param dataDir golden data directory (scripts, recordings and tolerances)
+     * @param outDir output directory (recordings written during run)
+     */
+    Golden( const std::string &dataDir, const std::string &outDir );
+
+    /** @brief Destructor. */
+    virtual ~Golden();
+
+    /**
+     * @brief Reads variables tolerances.
+     * @param file tolerances file path
+     * @return true on success, false on failure
+     */
+    bool readTolerances( const char *file );
+
+    /**
+     * @brief Runs all cases which names start with filter.
+     * @param filter case name prefix
+     * @param update if true golden recordings are replaced with new ones
+     */
+    void run( const std::string &filter = "", bool update = false );
+
+    /** @brief Prints results. */
+    void print() const;
+
+    /** @brief Returns true if all cases passed. */
+    bool isPassed() const;
+
+    inline void setBudgetFactor( double factor ) { _budgetFactor = factor; }
+
+private:
+
+    /** Single aircraft run. */
+    struct Job
+    {
+        Session *session;           ///< simulation session
+        Script script;              ///< control input script
+        Result result;              ///< result
+        bool ready;                 ///< specifies if job is initialized
+    };
+
+    typedef std::vector< Job* > Jobs;
+
+    static const char *_scenarios[];            ///< optional scenarios names
+    static const unsigned int _scenarios_count; ///< number of optional scenarios
+
+    const std::string _dataDir;     ///< golden data directory
+    const std::string _outDir;      ///< output directory
+
+    Tolerances _tolerances;         ///< variables tolerances
+    Results _results;               ///< results
+
+    double _budgetFactor;           ///< performance budget scaling factor
+
+    /**
+     * @brief Creates and initializes job.
+     * @param type aircraft type
+     * @param name case name
+     * @return job
+     */
+    Job* createJob( Session::AircraftType type, const std::string &name ) const;
+
+    /**
+     * @brief Flies aircraft according to script, executed in a worker thread.
+     * @param job job
+     */
+    static void fly( Job *job );
+
+    /**
+     * @brief Returns calling thread CPU time.
+     * @return [s] calling thread CPU time
+     */
+    static double getThreadTime();
+
+    /**
+     * @brief Compares recordings.
+     * @param golden golden recording file path
+     * @param actual actual recording file path
+     * @param result result
+     */
+    void compare( const std::string &golden, const std::string &actual,
+                  Result *result ) const;
+
+    /**
+     * @brief Copies file.
+     * @param src source file path
+     * @param dst destination file path
+     * @return true on success, false on failure
+     */
+    static bool copy( const std::string &src, const std::string &dst );
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_GOLDEN_H
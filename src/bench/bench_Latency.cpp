@@ -0,0 +1,251 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Latency.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include <cgi/cgi_Defines.h>
+
+#include <fdm/fdm_Log.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_LATENCY_POLL_PERIOD  0.001   /* event loops poll period [s] */
+#define BENCH_LATENCY_INPUT_PERIOD 0.001   /* joystick events period [s]  */
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+typedef std::chrono::steady_clock Clock;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static Clock::duration toDuration( double seconds )
+{
+    return std::chrono::duration_cast< Clock::duration >( std::chrono::duration< double >( seconds ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Latency::Latency( AircraftType type, double drawTime ) :
+    _session ( NULLPTR ),
+    _drawTime ( drawTime ),
+    _running ( false )
+{
+    _session = new Session( type );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Latency::~Latency()
+{
+    DELPTR( _session );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Latency::run( double duration )
+{
+    if ( !_session->initialize( 500.0, 60.0 ) )
+    {
+        fdm::Log::e() << "Cannot initialize " << Session::getName( _session->getType() ) << std::endl;
+        return false;
+    }
+
+    fdm::LatencyTrace::setEnabled( true );
+    fdm::LatencyTrace::reset();
+
+    _running = true;
+
+    std::thread inp( &Latency::runInput      , this );
+    std::thread sim( &Latency::runSimulation , this );
+    std::thread gui( &Latency::runManager    , this );
+    std::thread sfx( &Latency::runSound      , this );
+
+    std::this_thread::sleep_for( toDuration( duration ) );
+
+    _running = false;
+
+    inp.join();
+    sim.join();
+    gui.join();
+    sfx.join();
+
+    fdm::LatencyTrace::setEnabled( false );
+
+    fdm::Log::out() << Session::getName( _session->getType() ) << std::endl;
+    fdm::LatencyTrace::print( fdm::Log::out() );
+
+    bool result = true;
+
+    for ( unsigned int i = 0; i < fdm::LatencyTrace::_stages_count; i++ )
+    {
+        fdm::LatencyTrace::Histogram histogram;
+        fdm::LatencyTrace::getHistogram( (fdm::LatencyTrace::Stage)i, &histogram );
+
+        if ( histogram.count == 0 )
+        {
+            fdm::Log::e() << "No latency trace stamps recorded at stage: "
+                          << fdm::LatencyTrace::getName( (fdm::LatencyTrace::Stage)i ) << std::endl;
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Latency::runInput()
+{
+    Input input;
+
+    input.events = 0;
+
+    Clock::time_point next = Clock::now();
+
+    while ( _running )
+    {
+        // stick moved continuously with 1 Hz frequency
+        input.time = fdm::LatencyTrace::now();
+        input.roll = 0.2 * sin( 2.0 * M_PI * 1.0e-9 * input.time );
+        input.events++;
+
+        _input.write( input );
+
+        next += toDuration( BENCH_LATENCY_INPUT_PERIOD );
+        std::this_thread::sleep_until( next );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Latency::runSimulation()
+{
+    unsigned int events = 0;
+
+    Clock::time_point next = Clock::now();
+
+    while ( _running )
+    {
+        Input input;
+        _input.read( &input );
+
+        if ( input.events != events )
+        {
+            events = input.events;
+
+            _session->getDataInp()->controls.roll = input.roll;
+            _session->getDataInp()->trace = fdm::LatencyTrace::stamp( input.time );
+        }
+
+        _session->step( FDM_TIME_STEP );
+
+        _dataOut.write( _session->getDataOut() );
+
+        next += toDuration( FDM_TIME_STEP );
+        std::this_thread::sleep_until( next );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Latency::runManager()
+{
+    fdm::DataOut dataOut;
+    fdm::LatencyTrace::Stamp trace;
+
+    trace.seq  = 0;
+    trace.time = 0;
+
+    unsigned int seq = _dataOut.getSequence();
+
+    Clock::time_point next = Clock::now();
+    Clock::time_point next_timer = next;
+    Clock::time_point next_frame = next;
+
+    while ( _running )
+    {
+        // queued FDM output
+        if ( _dataOut.getSequence() != seq )
+        {
+            seq = _dataOut.read( &dataOut );
+
+            trace = dataOut.trace;
+            fdm::LatencyTrace::record( fdm::LatencyTrace::Publish, trace );
+        }
+
+        // manager timer
+        if ( Clock::now() >= next_timer )
+        {
+            _dataSFX.write( trace );
+            next_timer += toDuration( FDM_TIME_STEP );
+        }
+
+        // OTW widget timer
+        if ( Clock::now() >= next_frame )
+        {
+            fdm::LatencyTrace::Stamp shown = trace;
+            fdm::LatencyTrace::record( fdm::LatencyTrace::Update, shown );
+
+            std::this_thread::sleep_for( toDuration( _drawTime ) );
+            fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, shown );
+
+            next_frame += toDuration( CGI_TIME_STEP );
+        }
+
+        next += toDuration( BENCH_LATENCY_POLL_PERIOD );
+        std::this_thread::sleep_until( next );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Latency::runSound()
+{
+    fdm::LatencyTrace::Stamp trace;
+
+    unsigned int seq = _dataSFX.getSequence();
+
+    Clock::time_point next = Clock::now();
+
+    while ( _running )
+    {
+        // queued data copy
+        if ( _dataSFX.getSequence() != seq )
+        {
+            seq = _dataSFX.read( &trace );
+            fdm::LatencyTrace::record( fdm::LatencyTrace::Sound, trace );
+        }
+
+        next += toDuration( BENCH_LATENCY_POLL_PERIOD );
+        std::this_thread::sleep_until( next );
+    }
+}
@@ -0,0 +1,117 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_LATENCY_H
+#define BENCH_LATENCY_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#include <fdm/utils/fdm_LatencyTrace.h>
+#include <fdm/utils/fdm_SeqLock.h>
+
+#include <bench/bench_Session.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Headless input latency tracing runner class.
+ *
+ * Synthetic stick input is replayed through threads arranged the same way
+ * as in the application:
+ * - input thread produces joystick events at 1 kHz and publishes the latest
+ *   state, as hid::InputReader does,
+ * - simulation thread samples input and steps FDM at FDM_TIME_STEP,
+ *   as Simulation class does,
+ * - GUI thread copies the FDM output (Manager::onDataOutUpdated()), updates
+ *   CGI and draws OTW frames at CGI_TIME_STEP and passes data to SFX at
+ *   FDM_TIME_STEP (Manager::timerEvent()),
+ * - SFX thread copies data passed by GUI thread (sfx::Thread).
+ *
+ * Queued signals are replaced with seqlocks polled by the receiving thread
+ * event loop every millisecond. Drawing is replaced with a sleep.
+ * Latency trace stamps are recorded at each stage, see fdm::LatencyTrace.
+ */
+class Latency
+{
+public:
+
+    typedef Session::AircraftType AircraftType;
+
+    /**
+     * @brief Constructor.
+     * @param type aircraft type
+     * @param drawTime [s] simulated OTW frame drawing time
+     */
+    Latency( AircraftType type, double drawTime );
+
+    /** @brief Destructor. */
+    virtual ~Latency();
+
+    /**
+     * @brief Runs pipeline.
+     * @param duration [s] run duration
+     * @return true if stamps were recorded at every stage, false otherwise
+     */
+    bool run( double duration );
+
+private:
+
+    /** Synthetic joystick state. */
+    struct Input
+    {
+        double roll;                    ///< -1.0 ... 1.0 normalized axis position
+        long long time;                 ///< [ns] monotonic time of the last event
+        unsigned int events;            ///< number of events so far
+    };
+
+    Session *_session;                  ///< headless simulation session
+
+    const double _drawTime;             ///< [s] simulated OTW frame drawing time
+
+    fdm::SeqLock< Input > _input;                       ///< joystick state
+    fdm::SeqLock< fdm::DataOut > _dataOut;              ///< FDM output passed to GUI thread
+    fdm::SeqLock< fdm::LatencyTrace::Stamp > _dataSFX;  ///< data passed to SFX thread
+
+    std::atomic< bool > _running;       ///< specifies if threads are running
+
+    /** Input thread function. */
+    void runInput();
+
+    /** Simulation thread function. */
+    void runSimulation();
+
+    /** GUI thread function. */
+    void runManager();
+
+    /** SFX thread function. */
+    void runSound();
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_LATENCY_H
@@ -0,0 +1,156 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Script.h>
+
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Script::Script() :
+    _altitude_agl ( 0.0 ),
+    _airspeed ( 0.0 ),
+    _heading ( 0.0 ),
+    _duration ( 0.0 ),
+    _budget ( 0.0 )
+{
+    _roll       .defined = false;
+    _pitch      .defined = false;
+    _yaw        .defined = false;
+    _collective .defined = false;
+    _throttle   .defined = false;
+
+    _landing_gear .defined = false;
+    _brakes       .defined = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Script::~Script() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Script::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() )
+        {
+            int result = FDM_SUCCESS;
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_altitude_agl , "altitude_agl" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_airspeed     , "airspeed"     );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_heading      , "heading", true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_duration     , "duration"     );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_budget       , "budget"       );
+
+            if ( result == FDM_SUCCESS )
+            {
+                fdm::XmlNode nodeControls = rootNode.getFirstChildElement( "controls" );
+
+                readChannel( nodeControls, "roll"       , &_roll       );
+                readChannel( nodeControls, "pitch"      , &_pitch      );
+                readChannel( nodeControls, "yaw"        , &_yaw        );
+                readChannel( nodeControls, "collective" , &_collective );
+                readChannel( nodeControls, "throttle"   , &_throttle   );
+
+                readChannel( nodeControls, "landing_gear" , &_landing_gear );
+                readChannel( nodeControls, "brakes"       , &_brakes       );
+            }
+            else
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+
+            return;
+        }
+    }
+
+    fdm::Exception e;
+
+    e.setType( fdm::Exception::FileReadingError );
+    e.setInfo( "Cannot open script file \"" + std::string( file ) + "\"." );
+
+    FDM_THROW( e );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Script::apply( double time, fdm::DataInp *dataInp ) const
+{
+    if ( _roll       .defined ) dataInp->controls.roll       = _roll       .table.getValue( time );
+    if ( _pitch      .defined ) dataInp->controls.pitch      = _pitch      .table.getValue( time );
+    if ( _yaw        .defined ) dataInp->controls.yaw        = _yaw        .table.getValue( time );
+    if ( _collective .defined ) dataInp->controls.collective = _collective .table.getValue( time );
+
+    if ( _throttle.defined )
+    {
+        double throttle = _throttle.table.getValue( time );
+
+        for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            dataInp->engine[ i ].throttle = throttle;
+        }
+    }
+
+    if ( _landing_gear.defined ) dataInp->controls.landing_gear = _landing_gear.table.getValue( time );
+
+    if ( _brakes.defined )
+    {
+        double brakes = _brakes.table.getValue( time );
+
+        dataInp->controls.brake_l = brakes;
+        dataInp->controls.brake_r = brakes;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Script::readChannel( const fdm::XmlNode &parent, const char *name, Channel *channel )
+{
+    fdm::XmlNode node = parent.getFirstChildElement( name );
+
+    channel->defined = false;
+
+    if ( node.isValid() )
+    {
+        if ( FDM_SUCCESS == fdm::XmlUtils::read( node, &channel->table ) )
+        {
+            channel->defined = true;
+        }
+        else
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, node );
+        }
+    }
+}
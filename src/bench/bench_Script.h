@@ -0,0 +1,129 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_SCRIPT_H
+#define BENCH_SCRIPT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_DataInp.h>
+
+#include <fdm/utils/fdm_Table1.h>
+
+#include <fdm/xml/fdm_XmlNode.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Control input script class.
+ *
+ * Control inputs are given as time histories (linearly interpolated),
+ * channels which are not given are left at session defaults.
+ *
+ * XML script file format:
+ * @code
+ * <golden_script>
+ *   <altitude_agl> { [m] initial altitude above ground level } </altitude_agl>
+ *   <airspeed> { [m/s] initial airspeed } </airspeed>
+ *   [<heading> { [rad] initial heading } </heading>]
+ *   <duration> { [s] simulated time } </duration>
+ *   <budget> { [s] maximum wall time per simulated second } </budget>
+ *   <controls>
+ *     [<roll> { [s] time } { [-1.0;1.0] roll control } ... </roll>]
+ *     [<pitch> { [s] time } { [-1.0;1.0] pitch control } ... </pitch>]
+ *     [<yaw> { [s] time } { [-1.0;1.0] yaw control } ... </yaw>]
+ *     [<collective> { [s] time } { [0.0;1.0] collective } ... </collective>]
+ *     [<throttle> { [s] time } { [0.0;1.0] throttle (all engines) } ... </throttle>]
+ *     [<landing_gear> { [s] time } { [0.0;1.0] landing gear } ... </landing_gear>]
+ *     [<brakes> { [s] time } { [0.0;1.0] wheel brakes (left and right) } ... </brakes>]
+ *   </controls>
+ * </golden_script>
+ * @endcode
+ */
+class Script
+{
+public:
+
+    /** @brief Constructor. */
+    Script();
+
+    /** @brief Destructor. */
+    virtual ~Script();
+
+    /**
+     * @brief Reads script file.
+     * @param file script file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Applies control inputs for given time.
+     * @param time [s] simulation time
+     * @param dataInp input data
+     */
+    void apply( double time, fdm::DataInp *dataInp ) const;
+
+    inline double getAltitudeAGL() const { return _altitude_agl; }
+    inline double getAirspeed()    const { return _airspeed;     }
+    inline double getHeading()     const { return _heading;      }
+    inline double getDuration()    const { return _duration;     }
+    inline double getBudget()      const { return _budget;       }
+
+private:
+
+    /** Control channel. */
+    struct Channel
+    {
+        fdm::Table1 table;              ///< time history
+        bool defined;                   ///< specifies if channel is defined
+    };
+
+    double _altitude_agl;               ///< [m] initial altitude above ground level
+    double _airspeed;                   ///< [m/s] initial airspeed
+    double _heading;                    ///< [rad] initial heading
+    double _duration;                   ///< [s] simulated time
+    double _budget;                     ///< [s] maximum wall time per simulated second
+
+    Channel _roll;                      ///< roll control channel
+    Channel _pitch;                     ///< pitch control channel
+    Channel _yaw;                       ///< yaw control channel
+    Channel _collective;                ///< collective channel
+    Channel _throttle;                  ///< throttle channel
+    Channel _landing_gear;              ///< landing gear channel
+    Channel _brakes;                    ///< wheel brakes channel
+
+    /**
+     * @brief Reads control channel.
+     * @param parent controls XML node
+     * @param name channel name
+     * @param channel channel
+     */
+    void readChannel( const fdm::XmlNode &parent, const char *name, Channel *channel );
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_SCRIPT_H
@@ -0,0 +1,190 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Session.h>
+
+#include <cstring>
+
+#include <fdm/utils/fdm_Units.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Session::AircraftType Session::_types[] =
+{
+    fdm::DataInp::AW101,
+    fdm::DataInp::C130,
+    fdm::DataInp::C172,
+    fdm::DataInp::F16,
+    fdm::DataInp::F35A,
+    fdm::DataInp::P51,
+    fdm::DataInp::PW5,
+    fdm::DataInp::R44,
+    fdm::DataInp::UH60
+};
+
+const unsigned int Session::_types_count = sizeof( _types ) / sizeof( _types[ 0 ] );
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* Session::getName( AircraftType type )
+{
+    switch ( type )
+    {
+        case fdm::DataInp::AW101: return "aw101";
+        case fdm::DataInp::C130:  return "c130";
+        case fdm::DataInp::C172:  return "c172";
+        case fdm::DataInp::F16:   return "f16";
+        case fdm::DataInp::F35A:  return "f35a";
+        case fdm::DataInp::P51:   return "p51";
+        case fdm::DataInp::PW5:   return "pw5";
+        case fdm::DataInp::R44:   return "r44";
+        case fdm::DataInp::UH60:  return "uh60";
+        default: break;
+    }
+
+    return "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Session::setDefaults( fdm::DataInp *dataInp, AircraftType type )
+{
+    memset( dataInp, 0, sizeof(fdm::DataInp) );
+
+    dataInp->aircraftType = type;
+
+    // Honolulu International Airport (PHNL)
+    dataInp->initial.latitude  = fdm::Units::deg2rad(   21.318 );
+    dataInp->initial.longitude = fdm::Units::deg2rad( -157.925 );
+    dataInp->initial.engineOn  = true;
+
+    dataInp->environment.temperature_0 = 288.15;
+    dataInp->environment.pressure_0    = 101325.0;
+
+    dataInp->controls.collective = 0.5;
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dataInp->engine[ i ].throttle  = 0.7;
+        dataInp->engine[ i ].mixture   = 1.0;
+        dataInp->engine[ i ].propeller = 1.0;
+        dataInp->engine[ i ].fuel      = true;
+        dataInp->engine[ i ].ignition  = true;
+        dataInp->engine[ i ].starter   = false;
+    }
+
+    dataInp->masses.pilot[ 0 ] = 80.0;
+
+    for ( unsigned int i = 0; i < FDM_MAX_TANKS; i++ )
+    {
+        dataInp->masses.tank[ i ] = 100.0;
+    }
+
+    dataInp->recording.mode = fdm::DataInp::Recording::Disabled;
+
+    dataInp->stateInp = fdm::DataInp::Idle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Session::Session( AircraftType type ) :
+    _type ( type ),
+    _manager ( NULLPTR )
+{
+    setDefaults( &_dataInp, _type );
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+
+    _manager = new fdm::Manager( &_dataInp, &_dataOut );
+    _manager->setVerbose( false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Session::~Session()
+{
+    stop();
+
+    DELPTR( _manager );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Session::initialize( double altitude_agl, double airspeed, double heading )
+{
+    stop();
+
+    _dataInp.initial.altitude_agl = altitude_agl;
+    _dataInp.initial.airspeed     = airspeed;
+    _dataInp.initial.heading      = heading;
+
+    _dataInp.stateInp = fdm::DataInp::Idle;
+    _manager->step( FDM_TIME_STEP );
+
+    _dataInp.stateInp = fdm::DataInp::Init;
+
+    for ( unsigned int i = 0; i < FDM_MAX_INIT_STEPS && _dataOut.stateOut != fdm::DataOut::Ready; i++ )
+    {
+        _manager->step( FDM_TIME_STEP );
+
+        if ( _dataOut.stateOut == fdm::DataOut::Stopped ) break;
+    }
+
+    if ( _dataOut.stateOut == fdm::DataOut::Ready )
+    {
+        _dataInp.stateInp = fdm::DataInp::Work;
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Session::step( double timeStep )
+{
+    _manager->step( timeStep );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Session::stop()
+{
+    if ( _dataOut.stateOut != fdm::DataOut::Idle )
+    {
+        _dataInp.stateInp = fdm::DataInp::Stop;
+        _manager->step( FDM_TIME_STEP );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Session::isWorking() const
+{
+    return _dataOut.stateOut == fdm::DataOut::Working
+        || _dataOut.stateOut == fdm::DataOut::Ready;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_SESSION_H
+#define BENCH_SESSION_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Manager.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Headless simulation session class.
+ *
+ * Drives fdm::Manager without GUI, CGI and SFX, the same way Simulation
+ * class does in the application.
+ */
+class Session
+{
+public:
+
+    typedef fdm::DataInp::AircraftType AircraftType;
+
+    /** Aircraft types list. */
+    static const AircraftType _types[];
+
+    /** Number of aircraft types. */
+    static const unsigned int _types_count;
+
+    /**
+     * @brief Returns aircraft type name.
+     * @param type aircraft type
+     * @return aircraft type name
+     */
+    static const char* getName( AircraftType type );
+
+    /**
+     * @brief Sets default benchmark input data.
+     * @param dataInp input data
+     * @param type aircraft type
+     */
+    static void setDefaults( fdm::DataInp *dataInp, AircraftType type );
+
+    /**
+     * @brief Constructor.
+     * @param type aircraft type
+     */
+    Session( AircraftType type );
+
+    /** @brief Destructor. */
+    virtual ~Session();
+
+    /**
+     * @brief Initializes flight, reinitializes if already initialized.
+     * @param altitude_agl [m] initial altitude above ground level
+     * @param airspeed [m/s] initial airspeed
+     * @param heading [rad] initial heading
+     * @return true on success, false on failure
+     */
+    bool initialize( double altitude_agl, double airspeed, double heading = 0.0 );
+
+    /**
+     * @brief Performs simulation step.
+     * @param timeStep [s] time step
+     */
+    void step( double timeStep = FDM_TIME_STEP );
+
+    /** @brief Stops simulation. */
+    void stop();
+
+    /** @brief Returns true if simulation is working. */
+    bool isWorking() const;
+
+    inline AircraftType getType() const { return _type; }
+
+    inline fdm::Manager* getManager() { return _manager; }
+    inline fdm::DataInp* getDataInp() { return &_dataInp; }
+
+    inline const fdm::DataOut& getDataOut() const { return _dataOut; }
+
+private:
+
+    const AircraftType _type;   ///< aircraft type
+
+    fdm::Manager *_manager;     ///< flight dynamics model manager
+
+    fdm::DataInp _dataInp;      ///< flight dynamics model input data
+    fdm::DataOut _dataOut;      ///< flight dynamics model output data
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_SESSION_H
@@ -0,0 +1,341 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_SharedState.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#ifdef _LINUX_
+#   include <sys/wait.h>
+#   include <unistd.h>
+#endif
+
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_LatencyTrace.h>
+#include <fdm/utils/fdm_SharedStateReader.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_SHAREDSTATE_BLOCK_STEPS  500      /* steps per cost measurement block */
+#define BENCH_SHAREDSTATE_WRITES       100000   /* number of snapshot writes timed  */
+#define BENCH_SHAREDSTATE_IDLE_TIME    0.5      /* client stops after no snapshot for this time [s] */
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+typedef std::chrono::steady_clock Clock;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static Clock::duration toDuration( double seconds )
+{
+    return std::chrono::duration_cast< Clock::duration >( std::chrono::duration< double >( seconds ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static double toSeconds( Clock::duration duration )
+{
+    return std::chrono::duration< double >( duration ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedState::SharedState( AircraftType type, double pollPeriod ) :
+    _session ( NULLPTR ),
+    _pollPeriod ( pollPeriod )
+{
+    _session = new Session( type );
+
+    // segment used by the running application is not touched
+    _name = std::string( FDM_SHARED_STATE_NAME ) + "_bench";
+#   ifdef _LINUX_
+    _name += "_" + std::to_string( getpid() );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedState::~SharedState()
+{
+    DELPTR( _session );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedState::measureCost( unsigned int blocks, Cost *cost )
+{
+    double time_off = 0.0;
+    double time_on  = 0.0;
+
+    // blocks alternate so that both modes share the same flight conditions,
+    // flight is reinitialized before each pair as aircraft is not controlled
+    for ( unsigned int i = 0; i < 2 * blocks; i++ )
+    {
+        bool publish = ( i % 2 ) == 1;
+
+        if ( !publish && !_session->initialize( 500.0, 60.0 ) )
+        {
+            fdm::Log::e() << "Cannot initialize " << Session::getName( _session->getType() ) << std::endl;
+            return false;
+        }
+
+        if ( publish )
+        {
+            if ( !_session->getManager()->openSharedState( _name.c_str() ) ) return false;
+        }
+        else
+        {
+            _session->getManager()->closeSharedState();
+        }
+
+        Clock::time_point t0 = Clock::now();
+
+        for ( unsigned int j = 0; j < BENCH_SHAREDSTATE_BLOCK_STEPS; j++ )
+        {
+            _session->step();
+        }
+
+        double time = toSeconds( Clock::now() - t0 );
+
+        if ( publish )
+            time_on += time;
+        else
+            time_off += time;
+
+        if ( !_session->isWorking() )
+        {
+            fdm::Log::e() << "Simulation stopped" << std::endl;
+            _session->getManager()->closeSharedState();
+            return false;
+        }
+    }
+
+    _session->getManager()->closeSharedState();
+
+    unsigned int steps = blocks * BENCH_SHAREDSTATE_BLOCK_STEPS;
+
+    cost->step_off = time_off / (double)steps;
+    cost->step_on  = time_on  / (double)steps;
+
+    fdm::SharedState state;
+
+    if ( !state.open( _name.c_str() ) ) return false;
+
+    Clock::time_point t0 = Clock::now();
+
+    for ( unsigned int i = 0; i < BENCH_SHAREDSTATE_WRITES; i++ )
+    {
+        state.write( *_session->getDataInp(), _session->getDataOut(), 0.0 );
+    }
+
+    cost->write = toSeconds( Clock::now() - t0 ) / (double)BENCH_SHAREDSTATE_WRITES;
+
+    state.close();
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedState::measureDelivery( double duration, Delivery *delivery )
+{
+#   ifdef _LINUX_
+    if ( !_session->initialize( 500.0, 60.0 ) )
+    {
+        fdm::Log::e() << "Cannot initialize " << Session::getName( _session->getType() ) << std::endl;
+        return false;
+    }
+
+    // segment is created before the client is started
+    if ( !_session->getManager()->openSharedState( _name.c_str() ) ) return false;
+
+    int fds[ 2 ];
+
+    if ( pipe( fds ) != 0 ) return false;
+
+    pid_t pid = fork();
+
+    if ( pid < 0 )
+    {
+        ::close( fds[ 0 ] );
+        ::close( fds[ 1 ] );
+        return false;
+    }
+
+    if ( pid == 0 )
+    {
+        Delivery result;
+        runClient( duration, &result );
+
+        ssize_t size = ::write( fds[ 1 ], &result, sizeof(Delivery) );
+
+        // client process must not run writer destructors
+        _exit( size == sizeof(Delivery) ? EXIT_SUCCESS : EXIT_FAILURE );
+    }
+
+    ::close( fds[ 1 ] );
+
+    // time for client to map the segment
+    std::this_thread::sleep_for( toDuration( 0.1 ) );
+
+    // snapshots are published at each step even after uncontrolled flight
+    // has been stopped, so run duration is not limited
+    unsigned int steps = (unsigned int)( duration / FDM_TIME_STEP + 0.5 );
+
+    Clock::time_point next = Clock::now();
+
+    for ( unsigned int i = 0; i < steps; i++ )
+    {
+        _session->step();
+
+        next += toDuration( FDM_TIME_STEP );
+        std::this_thread::sleep_until( next );
+    }
+
+    ssize_t size = ::read( fds[ 0 ], delivery, sizeof(Delivery) );
+
+    ::close( fds[ 0 ] );
+
+    int status = 0;
+    waitpid( pid, &status, 0 );
+
+    _session->getManager()->closeSharedState();
+
+    if ( size != sizeof(Delivery) || !WIFEXITED( status ) || WEXITSTATUS( status ) != EXIT_SUCCESS )
+    {
+        fdm::Log::e() << "Test client failed" << std::endl;
+        return false;
+    }
+
+    delivery->written = steps;
+
+    return true;
+#   else
+    fdm::Log::e() << "Shared memory state is not supported on this platform" << std::endl;
+    return false;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedState::runClient( double duration, Delivery *delivery )
+{
+    delivery->written  = 0;
+    delivery->received = 0;
+    delivery->missed   = 0;
+    delivery->torn     = 0;
+    delivery->retries  = 0;
+    delivery->schema   = false;
+    delivery->rate     = 0.0;
+    delivery->gap_max  = 0.0;
+    delivery->age_mean = 0.0;
+    delivery->age_max  = 0.0;
+
+    fdm::SharedStateReader reader;
+
+    if ( !reader.open( _name.c_str() ) ) return;
+
+    const fdm::SharedState::Field *field = reader.getField( "altitude_asl" );
+
+    delivery->schema = field != NULLPTR
+                    && field->type   == fdm::SharedState::Float64
+                    && field->offset == offsetof( fdm::SharedState::Snapshot, altitude_asl );
+
+    fdm::SharedState::Snapshot snapshot;
+
+    long long time_0     = fdm::LatencyTrace::now();
+    long long time_first = 0;
+    long long time_last  = 0;
+
+    double age_sum = 0.0;
+
+    while ( true )
+    {
+        long long time = fdm::LatencyTrace::now();
+
+        if ( reader.read( &snapshot ) )
+        {
+            time = fdm::LatencyTrace::now();
+
+            if ( snapshot.step != snapshot.step_end ) delivery->torn++;
+
+            if ( delivery->schema && fdm::SharedStateReader::getValue( &snapshot, field ) != snapshot.altitude_asl )
+            {
+                delivery->schema = false;
+            }
+
+            double age = 1.0e-9 * ( time - snapshot.time_mono );
+
+            age_sum += age;
+            delivery->age_max = std::max( delivery->age_max, age );
+
+            if ( delivery->received > 0 )
+            {
+                delivery->gap_max = std::max( delivery->gap_max, 1.0e-9 * ( time - time_last ) );
+            }
+            else
+            {
+                time_first = time;
+            }
+
+            time_last = time;
+            delivery->received++;
+
+            // snapshots queued in the ring are read without waiting
+            continue;
+        }
+
+        if ( delivery->received > 0 )
+        {
+            if ( 1.0e-9 * ( time - time_last ) > BENCH_SHAREDSTATE_IDLE_TIME ) break;
+        }
+        else if ( 1.0e-9 * ( time - time_0 ) > duration + BENCH_SHAREDSTATE_IDLE_TIME )
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for( toDuration( _pollPeriod ) );
+    }
+
+    delivery->missed  = reader.getMissed();
+    delivery->retries = reader.getRetries();
+
+    if ( delivery->received > 0 )
+    {
+        delivery->age_mean = age_sum / (double)delivery->received;
+    }
+
+    if ( delivery->received > 1 )
+    {
+        delivery->rate = (double)( delivery->received - 1 ) / ( 1.0e-9 * ( time_last - time_first ) );
+    }
+}
@@ -0,0 +1,122 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_SHAREDSTATE_H
+#define BENCH_SHAREDSTATE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+#include <bench/bench_Session.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief Headless shared memory state broadcast test class.
+ *
+ * Simulation is stepped in real time at FDM_TIME_STEP with state published
+ * to shared memory by fdm::Manager, while test client running in a separate
+ * process polls the segment with fdm::SharedStateReader, as an instructor
+ * station or an extra display would do. Cost added to the FDM step by
+ * publishing is measured separately.
+ */
+class SharedState
+{
+public:
+
+    typedef fdm::DataInp::AircraftType AircraftType;
+
+    /** Writer cost results. */
+    struct Cost
+    {
+        double step_off;                ///< [s] mean FDM step time, state not published
+        double step_on;                 ///< [s] mean FDM step time, state published
+        double write;                   ///< [s] mean snapshot write time
+    };
+
+    /** Delivery results. */
+    struct Delivery
+    {
+        unsigned int written;           ///< number of snapshots written
+        unsigned int received;          ///< number of snapshots received
+        unsigned int missed;            ///< number of snapshots overwritten before being received
+        unsigned int torn;              ///< number of torn snapshots received
+        unsigned int retries;           ///< number of copies retried by the reader
+
+        bool schema;                    ///< specifies if values read using schema matched snapshot
+
+        double rate;                    ///< [Hz] delivery rate
+        double gap_max;                 ///< [s] max interval between received snapshots
+        double age_mean;                ///< [s] mean snapshot age when received
+        double age_max;                 ///< [s] max snapshot age when received
+    };
+
+    /**
+     * @brief Constructor.
+     * @param type aircraft type
+     * @param pollPeriod [s] test client poll period
+     */
+    SharedState( AircraftType type, double pollPeriod );
+
+    /** @brief Destructor. */
+    virtual ~SharedState();
+
+    /**
+     * @brief Measures cost added to the FDM step by publishing state.
+     * @param blocks number of alternating blocks of steps with and without publishing
+     * @param cost output results
+     * @return true on success, false on failure
+     */
+    bool measureCost( unsigned int blocks, Cost *cost );
+
+    /**
+     * @brief Measures state delivery to the test client process.
+     * @param duration [s] run duration
+     * @param delivery output results
+     * @return true on success, false on failure
+     */
+    bool measureDelivery( double duration, Delivery *delivery );
+
+private:
+
+    Session *_session;                  ///< headless simulation session
+
+    const double _pollPeriod;           ///< [s] test client poll period
+
+    std::string _name;                  ///< shared memory segment name
+
+    /**
+     * @brief Reads snapshots until the writer stops, runs in the test client process.
+     * @param duration [s] writer run duration
+     * @param delivery output results
+     */
+    void runClient( double duration, Delivery *delivery );
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_SHAREDSTATE_H
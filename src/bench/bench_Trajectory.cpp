@@ -0,0 +1,106 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <bench/bench_Trajectory.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace bench;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trajectory::Trajectory() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trajectory::~Trajectory() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Trajectory::readFile( const char *file )
+{
+    _names.clear();
+    _records.clear();
+
+    std::ifstream fs( file );
+
+    if ( fs.is_open() )
+    {
+        std::string line;
+        std::string item;
+
+        if ( getline( fs, line ) )
+        {
+            std::istringstream ss( line );
+
+            while ( getline( ss, item, ';' ) )
+            {
+                if ( item.length() > 1 && item[ 0 ] == '"' )
+                {
+                    item = item.substr( 1, item.length() - 2 );
+                }
+
+                _names.push_back( item );
+            }
+        }
+
+        while ( getline( fs, line ) )
+        {
+            if ( line.length() == 0 ) continue;
+
+            std::istringstream ss( line );
+            Record record;
+
+            while ( getline( ss, item, ';' ) )
+            {
+                record.push_back( atof( item.c_str() ) );
+            }
+
+            if ( record.size() != _names.size() )
+            {
+                return false;
+            }
+
+            _records.push_back( record );
+        }
+
+        return _names.size() > 0;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Trajectory::getIndex( const std::string &name ) const
+{
+    for ( unsigned int i = 0; i < _names.size(); i++ )
+    {
+        if ( _names[ i ] == name ) return i;
+    }
+
+    return -1;
+}
@@ -0,0 +1,96 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BENCH_TRAJECTORY_H
+#define BENCH_TRAJECTORY_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+
+/**
+ * @brief State trajectory class.
+ *
+ * Reads flight recordings written by fdm::Recorder (CSV file, semicolon
+ * separated values, quoted variables names in the first line).
+ *
+ * @see fdm::Recorder
+ */
+class Trajectory
+{
+public:
+
+    typedef std::vector< std::string > Names;
+    typedef std::vector< double > Record;
+    typedef std::vector< Record > Records;
+
+    /** @brief Constructor. */
+    Trajectory();
+
+    /** @brief Destructor. */
+    virtual ~Trajectory();
+
+    /**
+     * @brief Reads recording file.
+     * @param file recording file path
+     * @return true on success, false on failure
+     */
+    bool readFile( const char *file );
+
+    /**
+     * @brief Returns variable index.
+     * @param name variable name
+     * @return variable index or -1 if variable does not exist
+     */
+    int getIndex( const std::string &name ) const;
+
+    /**
+     * @brief Returns recorded value.
+     * @param record record index
+     * @param index variable index
+     * @return recorded value
+     */
+    inline double getValue( unsigned int record, unsigned int index ) const
+    {
+        return _records[ record ][ index ];
+    }
+
+    inline unsigned int getRecordsCount() const { return _records.size(); }
+
+    inline const Names& getNames() const { return _names; }
+
+private:
+
+    Names _names;           ///< variables names
+    Records _records;       ///< records
+};
+
+} // end of bench namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BENCH_TRAJECTORY_H
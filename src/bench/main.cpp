@@ -0,0 +1,123 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <bench/bench_Benchmark.h>
+#include <bench/bench_Cases.h>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Path.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRCDIR
+#   define SRCDIR ""
+#endif
+
+#ifndef DATADIR
+#   define DATADIR ""
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -D <dir>     data directory (default: " << DATADIR << ")" << std::endl;
+    fdm::Log::out() << "  -o <file>    write results to JSON file" << std::endl;
+    fdm::Log::out() << "  -t <file>    read thresholds from XML file (default: " << SRCDIR << "bench_thresholds.xml)" << std::endl;
+    fdm::Log::out() << "  -f <prefix>  run only cases which names start with prefix" << std::endl;
+    fdm::Log::out() << "  -s <factor>  thresholds scaling factor (default: 1.0)" << std::endl;
+    fdm::Log::out() << "  -b <number>  number of timed batches (default: 7)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is benchmark main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_data = DATADIR;
+    std::string file_out;
+    std::string file_thr = SRCDIR "bench_thresholds.xml";
+    std::string filter;
+
+    double factor = 1.0;
+    int batches = 7;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-D" ) && hasValue ) dir_data = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-o" ) && hasValue ) file_out = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-t" ) && hasValue ) file_thr = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-f" ) && hasValue ) filter   = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-s" ) && hasValue ) factor   = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-b" ) && hasValue ) batches  = atoi( argv[ ++i ] );
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    fdm::Path::setBase( dir_data );
+
+    fdm::Log::out() << SIM_APP_NAME << " ";
+    fdm::Log::out() << SIM_APP_VER  << " benchmark ";
+    fdm::Log::out() << __DATE__ << " ";
+    fdm::Log::out() << __TIME__ << std::endl;
+
+    bench::Benchmark *benchmark = new bench::Benchmark( batches > 0 ? batches : 1 );
+
+    bench::addCasesUtils         ( benchmark );
+    bench::addCasesModels        ( benchmark );
+    bench::addCasesAircraft      ( benchmark );
+    bench::addCasesMap           ( benchmark );
+    bench::addCasesIntersections ( benchmark );
+
+    benchmark->setThresholdFactor( factor );
+    benchmark->readThresholds( file_thr.c_str() );
+
+    benchmark->run( filter );
+    benchmark->print();
+
+    bool passed = benchmark->isPassed();
+
+    if ( file_out.length() > 0 )
+    {
+        passed = benchmark->writeJSON( file_out.c_str() ) && passed;
+    }
+
+    DELPTR( benchmark );
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <libxml/parser.h>
+
+#include <bench/bench_AutopilotLoop.h>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Path.h>
+
+#include <fdm/utils/fdm_Units.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DATADIR
+#   define DATADIR ""
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -D <dir>     data directory (default: " << DATADIR << ")" << std::endl;
+    fdm::Log::out() << "  -d <steps>   FDM steps per autopilot update (default: " << SIM_AVIONICS_DIVISOR << ")" << std::endl;
+    fdm::Log::out() << "  -t <time>    [s] run duration after heading change (default: 60)" << std::endl;
+    fdm::Log::out() << "  -r <time>    [ms] simulated frame drawing time (default: 5)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints result row. */
+void printResult( bench::AutopilotLoop::Schedule schedule,
+                  const bench::AutopilotLoop::Result &result )
+{
+    char line[ 256 ];
+
+    snprintf( line, sizeof(line),
+              "%-10s %8u %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.4f",
+              bench::AutopilotLoop::getName( schedule ),
+              result.updates,
+              1.0e3 * result.interval_mean,
+              1.0e3 * result.interval_std,
+              1.0e3 * result.interval_max,
+              1.0e3 * result.age_mean,
+              1.0e3 * result.age_max,
+              fdm::Units::rad2deg( result.overshoot ),
+              result.rise,
+              fdm::Units::rad2deg( result.error ),
+              result.alt_dev,
+              result.ctrl_rate );
+
+    fdm::Log::out() << line << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is headless autopilot control loop comparison main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_data = DATADIR;
+
+    int divisor = SIM_AVIONICS_DIVISOR;
+
+    double duration = 60.0;
+    double drawTime = 5.0;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-D" ) && hasValue ) dir_data = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-d" ) && hasValue ) divisor  = std::max( 1, atoi( argv[ ++i ] ) );
+        else if ( 0 == strcmp( argv[ i ], "-t" ) && hasValue ) duration = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-r" ) && hasValue ) drawTime = atof( argv[ ++i ] );
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    fdm::Path::setBase( dir_data );
+
+    xmlInitParser();
+
+    bench::AutopilotLoop *loop = new bench::AutopilotLoop( divisor, 1.0e-3 * drawTime );
+
+    bench::AutopilotLoop::Result result_gui;
+    bench::AutopilotLoop::Result result_fdm;
+
+    bool passed = loop->run( bench::AutopilotLoop::GuiTimer , duration, &result_gui )
+               && loop->run( bench::AutopilotLoop::FdmStep  , duration, &result_fdm );
+
+    DELPTR( loop );
+
+    xmlCleanupParser();
+
+    if ( passed )
+    {
+        fdm::Log::out() << "schedule    updates  int_mean   int_std   int_max  age_mean   age_max"
+                        << " overshoot      rise     error   alt_dev ctrl_rate" << std::endl;
+        fdm::Log::out() << "                          [ms]      [ms]      [ms]      [ms]      [ms]"
+                        << "     [deg]       [s]     [deg]       [m]     [1/s]" << std::endl;
+
+        printResult( bench::AutopilotLoop::GuiTimer , result_gui );
+        printResult( bench::AutopilotLoop::FdmStep  , result_fdm );
+
+        // in-step loop has to be regular, use fresh data and turn to the heading
+        if ( result_fdm.interval_std > 1.0e-9
+          || result_fdm.age_max      > ( divisor - 1 ) * FDM_TIME_STEP + 1.0e-9
+          || result_fdm.rise         < 0.0 )
+        {
+            fdm::Log::e() << "Autopilot updated inside the FDM step failed" << std::endl;
+            passed = false;
+        }
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
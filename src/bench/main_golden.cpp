@@ -0,0 +1,121 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <libxml/parser.h>
+
+#include <bench/bench_Golden.h>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Path.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRCDIR
+#   define SRCDIR ""
+#endif
+
+#ifndef DATADIR
+#   define DATADIR ""
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -D <dir>     data directory (default: " << DATADIR << ")" << std::endl;
+    fdm::Log::out() << "  -d <dir>     golden data directory (default: " << SRCDIR << "golden/)" << std::endl;
+    fdm::Log::out() << "  -o <dir>     recordings output directory (default: ./)" << std::endl;
+    fdm::Log::out() << "  -f <prefix>  fly only cases which names start with prefix" << std::endl;
+    fdm::Log::out() << "  -s <factor>  performance budgets scaling factor (default: 1.0)" << std::endl;
+    fdm::Log::out() << "  -u           update golden recordings" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is golden trajectories regression main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_base = DATADIR;
+    std::string dir_data = SRCDIR "golden/";
+    std::string dir_out  = "./";
+    std::string filter;
+
+    double factor = 1.0;
+    bool update = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-D" ) && hasValue ) dir_base = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-d" ) && hasValue ) dir_data = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-o" ) && hasValue ) dir_out  = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-f" ) && hasValue ) filter   = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-s" ) && hasValue ) factor   = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-u" ) ) update = true;
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( dir_data.length() > 0 && dir_data[ dir_data.length() - 1 ] != '/' ) dir_data += "/";
+    if ( dir_out.length()  > 0 && dir_out[ dir_out.length() - 1 ]   != '/' ) dir_out  += "/";
+
+    fdm::Path::setBase( dir_base );
+
+    // aircraft are flown in separate threads
+    xmlInitParser();
+
+    bench::Golden *golden = new bench::Golden( dir_data, dir_out );
+
+    golden->setBudgetFactor( factor );
+
+    if ( !golden->readTolerances( ( dir_data + "tolerances.xml" ).c_str() ) )
+    {
+        DELPTR( golden );
+        return EXIT_FAILURE;
+    }
+
+    golden->run( filter, update );
+    golden->print();
+
+    bool passed = golden->isPassed();
+
+    DELPTR( golden );
+
+    xmlCleanupParser();
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
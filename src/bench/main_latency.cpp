@@ -0,0 +1,114 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <libxml/parser.h>
+
+#include <bench/bench_Latency.h>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Path.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DATADIR
+#   define DATADIR ""
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -D <dir>     data directory (default: " << DATADIR << ")" << std::endl;
+    fdm::Log::out() << "  -a <name>    aircraft name (default: c172)" << std::endl;
+    fdm::Log::out() << "  -t <time>    [s] run duration (default: 10)" << std::endl;
+    fdm::Log::out() << "  -r <time>    [ms] simulated frame drawing time (default: 5)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is headless input latency tracing main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_data = DATADIR;
+    std::string name = "c172";
+
+    double duration = 10.0;
+    double drawTime = 5.0;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-D" ) && hasValue ) dir_data = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-a" ) && hasValue ) name     = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-t" ) && hasValue ) duration = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-r" ) && hasValue ) drawTime = atof( argv[ ++i ] );
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench::Latency::AircraftType type = bench::Session::_types[ 0 ];
+    bool found = false;
+
+    for ( unsigned int i = 0; i < bench::Session::_types_count && !found; i++ )
+    {
+        if ( name == bench::Session::getName( bench::Session::_types[ i ] ) )
+        {
+            type = bench::Session::_types[ i ];
+            found = true;
+        }
+    }
+
+    if ( !found )
+    {
+        fdm::Log::e() << "Unknown aircraft: " << name << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fdm::Path::setBase( dir_data );
+
+    xmlInitParser();
+
+    bench::Latency *latency = new bench::Latency( type, 1.0e-3 * drawTime );
+
+    bool passed = latency->run( duration );
+
+    DELPTR( latency );
+
+    xmlCleanupParser();
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,168 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <libxml/parser.h>
+
+#include <bench/bench_SharedState.h>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Path.h>
+
+#include <defs.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DATADIR
+#   define DATADIR ""
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -D <dir>     data directory (default: " << DATADIR << ")" << std::endl;
+    fdm::Log::out() << "  -a <name>    aircraft name (default: c172)" << std::endl;
+    fdm::Log::out() << "  -t <time>    [s] delivery run duration (default: 10)" << std::endl;
+    fdm::Log::out() << "  -p <time>    [ms] test client poll period (default: 1)" << std::endl;
+    fdm::Log::out() << "  -b <count>   number of writer cost measurement blocks (default: 10)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is headless shared memory state broadcast test main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_data = DATADIR;
+    std::string name = "c172";
+
+    double duration   = 10.0;
+    double pollPeriod = 1.0;
+
+    int blocks = 10;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-D" ) && hasValue ) dir_data   = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-a" ) && hasValue ) name       = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-t" ) && hasValue ) duration   = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-p" ) && hasValue ) pollPeriod = atof( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-b" ) && hasValue ) blocks     = std::max( 1, atoi( argv[ ++i ] ) );
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench::SharedState::AircraftType type = bench::Session::_types[ 0 ];
+    bool found = false;
+
+    for ( unsigned int i = 0; i < bench::Session::_types_count && !found; i++ )
+    {
+        if ( name == bench::Session::getName( bench::Session::_types[ i ] ) )
+        {
+            type = bench::Session::_types[ i ];
+            found = true;
+        }
+    }
+
+    if ( !found )
+    {
+        fdm::Log::e() << "Unknown aircraft: " << name << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fdm::Path::setBase( dir_data );
+
+    xmlInitParser();
+
+    bench::SharedState *test = new bench::SharedState( type, 1.0e-3 * pollPeriod );
+
+    bench::SharedState::Cost     cost;
+    bench::SharedState::Delivery delivery;
+
+    bool passed = test->measureCost( blocks, &cost )
+               && test->measureDelivery( duration, &delivery );
+
+    DELPTR( test );
+
+    xmlCleanupParser();
+
+    if ( passed )
+    {
+        char line[ 256 ];
+
+        fdm::Log::out() << name << std::endl;
+
+        snprintf( line, sizeof(line),
+                  "writer    step_off [us] %9.3f  step_on [us] %9.3f  added [us] %9.3f  write [us] %9.3f",
+                  1.0e6 * cost.step_off,
+                  1.0e6 * cost.step_on,
+                  1.0e6 * ( cost.step_on - cost.step_off ),
+                  1.0e6 * cost.write );
+        fdm::Log::out() << line << std::endl;
+
+        snprintf( line, sizeof(line),
+                  "delivery  written %u  received %u  missed %u  torn %u  retries %u  schema %s",
+                  delivery.written,
+                  delivery.received,
+                  delivery.missed,
+                  delivery.torn,
+                  delivery.retries,
+                  delivery.schema ? "ok" : "mismatch" );
+        fdm::Log::out() << line << std::endl;
+
+        snprintf( line, sizeof(line),
+                  "delivery  rate [Hz] %7.2f  gap_max [ms] %7.2f  age_mean [ms] %7.3f  age_max [ms] %7.3f",
+                  delivery.rate,
+                  1.0e3 * delivery.gap_max,
+                  1.0e3 * delivery.age_mean,
+                  1.0e3 * delivery.age_max );
+        fdm::Log::out() << line << std::endl;
+
+        // every step has to be delivered untorn at the FDM rate
+        if ( delivery.torn     != 0
+          || delivery.missed   != 0
+          || delivery.received != delivery.written
+          || !delivery.schema
+          || fabs( delivery.rate * FDM_TIME_STEP - 1.0 ) > 0.02 )
+        {
+            fdm::Log::e() << "Shared memory state delivery failed" << std::endl;
+            passed = false;
+        }
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -17,6 +17,8 @@ HEADERS += \
     $$PWD/cgi_Models.h \
     $$PWD/cgi_Module.h \
     $$PWD/cgi_Textures.h \
+    $$PWD/cgi_Trace.h \
+    $$PWD/cgi_TriangleBVH.h \
     $$PWD/cgi_Utils.h \
     $$PWD/cgi_WGS84.h
 
@@ -38,6 +40,8 @@ SOURCES += \
     $$PWD/cgi_Models.cpp \
     $$PWD/cgi_Module.cpp \
     $$PWD/cgi_Textures.cpp \
+    $$PWD/cgi_Trace.cpp \
+    $$PWD/cgi_TriangleBVH.cpp \
     $$PWD/cgi_Utils.cpp \
     $$PWD/cgi_WGS84.cpp
 
@@ -53,14 +57,20 @@ SOURCES += \
 
 HEADERS += \
     $$PWD/map/cgi_Icons.h \
+    $$PWD/map/cgi_ImageryBuilder.h \
     $$PWD/map/cgi_Layers.h \
     $$PWD/map/cgi_Map.h \
+    $$PWD/map/cgi_QuadTree.h \
+    $$PWD/map/cgi_Symbols.h \
     $$PWD/map/cgi_Traces.h
 
 SOURCES += \
     $$PWD/map/cgi_Icons.cpp \
+    $$PWD/map/cgi_ImageryBuilder.cpp \
     $$PWD/map/cgi_Layers.cpp \
     $$PWD/map/cgi_Map.cpp \
+    $$PWD/map/cgi_QuadTree.cpp \
+    $$PWD/map/cgi_Symbols.cpp \
     $$PWD/map/cgi_Traces.cpp
 
 ################################################################################
@@ -22,6 +22,9 @@
 
 #include <cgi/cgi_GeoTIFF.h>
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef WIN32
 #   include <ogrsf_frmts.h>
 #   include <ogr_spatialref.h>
@@ -262,3 +265,63 @@ double GeoTIFF::getMapH() const
 
     return std::numeric_limits< double >::quiet_NaN();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool GeoTIFF::readImage( double x_px, double y_ln, double w_px, double h_px,
+                         int buf_w, int buf_h, unsigned char *rgba ) const
+{
+    if ( _dataset && _dataset->GetRasterCount() > 0 && buf_w > 0 && buf_h > 0 )
+    {
+        const int bands = _dataset->GetRasterCount();
+
+        // integer window enclosing the floating point one
+        int x_0 = std::max( 0, (int)floor( x_px ) );
+        int y_0 = std::max( 0, (int)floor( y_ln ) );
+        int x_1 = std::min( (int)_w_px, (int)ceil( x_px + w_px ) );
+        int y_1 = std::min( (int)_h_px, (int)ceil( y_ln + h_px ) );
+
+        if ( x_1 <= x_0 || y_1 <= y_0 ) return false;
+
+        GDALRasterIOExtraArg arg;
+        INIT_RASTERIO_EXTRA_ARG( arg );
+
+        arg.eResampleAlg = GRIORA_Bilinear;
+        arg.bFloatingPointWindowValidity = TRUE;
+        arg.dfXOff  = x_px;
+        arg.dfYOff  = y_ln;
+        arg.dfXSize = w_px;
+        arg.dfYSize = h_px;
+
+        int band_a = 0;
+
+        if      ( bands >= 4 ) band_a = 4;
+        else if ( bands == 2 ) band_a = 2;
+
+        for ( int c = 0; c < 4; c++ )
+        {
+            int band = ( c < 3 ) ? ( bands >= 3 ? c + 1 : 1 ) : band_a;
+
+            if ( band == 0 ) continue;
+
+            CPLErr result = _dataset->GetRasterBand( band )->RasterIO( GF_Read,
+                                                                       x_0, y_0, x_1 - x_0, y_1 - y_0,
+                                                                       rgba + c, buf_w, buf_h, GDT_Byte,
+                                                                       4, 4 * buf_w, &arg );
+
+            if ( result != CE_None ) return false;
+        }
+
+        if ( band_a == 0 )
+        {
+            for ( int i = 0; i < buf_w * buf_h; i++ )
+            {
+                rgba[ 4 * i + 3 ] = 255;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
@@ -140,6 +140,34 @@ public:
      */
     double getMapH() const;
 
+    /**
+     * @brief Returns raster width.
+     * @return [px] raster width
+     */
+    inline int getRasterW() const { return (int)_w_px; }
+
+    /**
+     * @brief Returns raster height.
+     * @return [px] raster height
+     */
+    inline int getRasterH() const { return (int)_h_px; }
+
+    /**
+     * @brief Reads resampled raster window as 8-bit RGBA pixels.
+     * Window has to be inside the raster. Single band rasters are read as
+     * grey, fourth (or second for grey) band is used as alpha if present.
+     * @param x_px window left pixel
+     * @param y_ln window top line
+     * @param w_px [px] window width
+     * @param h_px [px] window height
+     * @param buf_w [px] output buffer width
+     * @param buf_h [px] output buffer height
+     * @param rgba output buffer of buf_w*buf_h RGBA pixels, top line first
+     * @return true on success, false on failure
+     */
+    bool readImage( double x_px, double y_ln, double w_px, double h_px,
+                    int buf_w, int buf_h, unsigned char *rgba ) const;
+
 private:
 
     GDALDataset *_dataset { nullptr };  ///< dataset
@@ -22,97 +22,276 @@
 
 #include <cgi/cgi_Intersections.h>
 
+#include <algorithm>
 #include <limits>
 
-#include <osgDB/ReadFile>
+#include <osg/Geode>
+#include <osg/PagedLOD>
+#include <osg/Timer>
+#include <osg/Transform>
+#include <osg/TriangleFunctor>
 
-#include <osgUtil/LineSegmentIntersector>
+#include <osgDB/FileNameUtils>
+#include <osgDB/ReadFile>
 
 #include <cgi/cgi_WGS84.h>
 
+#include <sim/Log.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#if OPENSCENEGRAPH_SOVERSION < 140
-osg::Node* Intersections::ReadCallback::readNodeFile( const std::string& filename )
+const unsigned int Intersections::_maxCached = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
 {
-    return osgDB::readRefNodeFile( filename ).release();
-}
-#else
-osg::ref_ptr<osg::Node> Intersections::ReadCallback::readNodeFile( const std::string& filename )
+
+/** Triangles collector. */
+struct Collector
 {
-    return osgDB::readRefNodeFile( filename );
+    const osg::Matrixd *matrix;
+    TriangleBVH *bvh;
+
+    void operator()( const osg::Vec3 &v1, const osg::Vec3 &v2, const osg::Vec3 &v3, bool = false )
+    {
+        osg::Vec3d w1 = osg::Vec3d( v1 ) * (*matrix);
+        osg::Vec3d w2 = osg::Vec3d( v2 ) * (*matrix);
+        osg::Vec3d w3 = osg::Vec3d( v3 ) * (*matrix);
+
+        bvh->insert( w1.ptr(), w2.ptr(), w3.ptr() );
+    }
+};
+
+/** Checks if segment intersects sphere. */
+bool intersects( const TriangleBVH::Ray &ray, const osg::Vec3d &center, double radius )
+{
+    osg::Vec3d b( ray.b[ 0 ], ray.b[ 1 ], ray.b[ 2 ] );
+    osg::Vec3d e( ray.e[ 0 ], ray.e[ 1 ], ray.e[ 2 ] );
+
+    osg::Vec3d d = e - b;
+
+    double len2 = d.length2();
+    double t = ( len2 > 0.0 ) ? ( ( center - b ) * d ) / len2 : 0.0;
+
+    t = std::max( 0.0, std::min( 1.0, t ) );
+
+    return ( b + d * t - center ).length2() <= radius * radius;
 }
-#endif
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Intersections::Intersections()
+/**
+ * Scenery triangles extracting visitor. Paged nodes become tiles, all the
+ * other triangles are gathered in a single leaf tile.
+ */
+class Intersections::Extractor : public osg::NodeVisitor
 {
-    _rc = new ReadCallback();
+public:
+
+    Extractor( const osg::Matrixd &matrix = osg::Matrixd::identity() ) :
+        osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ACTIVE_CHILDREN ),
+        _bvh ( new TriangleBVH() ),
+        _matrix ( matrix )
+    {}
+
+    virtual void apply( osg::Transform &transform )
+    {
+        osg::Matrixd matrix = _matrix;
+        transform.computeLocalToWorldMatrix( _matrix, this );
+        traverse( transform );
+        _matrix = matrix;
+    }
+
+    virtual void apply( osg::LOD &lod )
+    {
+        // highest level of detail only
+        int index = -1;
+
+        for ( unsigned int i = 0; i < lod.getNumChildren() && i < lod.getNumRanges(); i++ )
+        {
+            if ( index < 0 ) { index = i; continue; }
+
+            if ( lod.getRangeMode() == osg::LOD::DISTANCE_FROM_EYE_POINT )
+            {
+                if ( lod.getMinRange( i ) < lod.getMinRange( index ) ) index = i;
+            }
+            else
+            {
+                if ( lod.getMaxRange( i ) > lod.getMaxRange( index ) ) index = i;
+            }
+        }
+
+        if ( index >= 0 ) lod.getChild( index )->accept( *this );
+    }
+
+    virtual void apply( osg::PagedLOD &plod )
+    {
+        Tile tile;
+
+        // resident geometry, children loaded by the viewer pager are skipped
+        Extractor extractor( _matrix );
+
+        for ( unsigned int i = 0; i < plod.getNumChildren(); i++ )
+        {
+            if ( i >= plod.getNumFileNames() || plod.getFileName( i ).empty() )
+            {
+                plod.getChild( i )->accept( extractor );
+            }
+        }
+
+        for ( unsigned int i = 0; i < plod.getNumFileNames(); i++ )
+        {
+            if ( !plod.getFileName( i ).empty() )
+            {
+                tile.file = osgDB::concatPaths( plod.getDatabasePath(), plod.getFileName( i ) );
+            }
+        }
+
+        if ( extractor._bvh->getCountInserted() > 0 )
+        {
+            extractor._bvh->build();
+            tile.bvh = extractor._bvh;
+        }
+
+        _tiles.insert( _tiles.end(), extractor._tiles.begin(), extractor._tiles.end() );
+
+        const osg::BoundingSphere &bs = plod.getBound();
+        osg::Vec3d scale = _matrix.getScale();
 
-//    _iv = new osgUtil::IntersectionVisitor();
-//    _iv->setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-//    _iv->setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-//    _iv->setReadCallback( _rc.get() );
+        tile.center = osg::Vec3d( bs.center() ) * _matrix;
+        tile.radius = bs.radius() * std::max( scale.x(), std::max( scale.y(), scale.z() ) );
 
-//    _ig = new osgUtil::IntersectorGroup();
-//    _iv->setIntersector( _ig.get() );
+        if ( tile.bvh || !tile.file.empty() )
+        {
+            _tiles.push_back( tile );
+        }
+    }
+
+    virtual void apply( osg::Geode &geode )
+    {
+        osg::TriangleFunctor< Collector > collector;
+
+        collector.matrix = &_matrix;
+        collector.bvh = _bvh.get();
+
+        for ( unsigned int i = 0; i < geode.getNumDrawables(); i++ )
+        {
+            geode.getDrawable( i )->accept( collector );
+        }
+    }
+
+    /** Builds leaf tile of the gathered triangles and appends all the tiles. */
+    void getTiles( Tiles *tiles )
+    {
+        if ( _bvh->getCountInserted() > 0 )
+        {
+            std::shared_ptr< TriangleBVH > bvh = _bvh;
+            _bvh = std::make_shared< TriangleBVH >();
+
+            bvh->build();
+
+            double min[ 3 ];
+            double max[ 3 ];
+
+            bvh->getBounds( min, max );
+
+            osg::Vec3d v_min( min[ 0 ], min[ 1 ], min[ 2 ] );
+            osg::Vec3d v_max( max[ 0 ], max[ 1 ], max[ 2 ] );
+
+            Tile tile;
+
+            tile.bvh = bvh;
+            tile.center = ( v_min + v_max ) * 0.5;
+            tile.radius = ( v_max - v_min ).length() * 0.5;
+
+            tiles->push_back( tile );
+        }
+
+        tiles->insert( tiles->end(), _tiles.begin(), _tiles.end() );
+        _tiles.clear();
+    }
+
+    std::shared_ptr< TriangleBVH > _bvh;    ///< gathered triangles
+
+private:
+
+    Tiles _tiles;                           ///< gathered tiles
+    osg::Matrixd _matrix;                   ///< current local to WGS matrix
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+Intersections::Intersections() :
+    _scenery ( 0 ),
+    _stop ( false )
+{
+    _thread = std::thread( &Intersections::run, this );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Intersections::~Intersections() {}
+Intersections::~Intersections()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stop = true;
+    }
+
+    _condition.notify_one();
+    _thread.join();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 bool Intersections::findFirst( const osg::Vec3d &b, const osg::Vec3d &e,
                                osg::Vec3d &r, osg::Vec3d &n )
 {
-//    _iv->reset();
-//    _ig->clear();
-
-    if ( _scenery.valid() )
+    if ( ( e - b ).length2() > 1.0e-6 )
     {
-        if ( ( e - b ).length2() > 1.0e-6 )
+        Ray ray = { { b.x(), b.y(), b.z() }, { e.x(), e.y(), e.z() } };
+        Hit hit;
+
+        if ( findFirst( &ray, &hit, 1 ) > 0 )
         {
-            //osgUtil::LineSegmentIntersector tmp( b, e );
-            //osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector = &tmp;
+            r.set( hit.r[ 0 ], hit.r[ 1 ], hit.r[ 2 ] );
+            n.set( hit.n[ 0 ], hit.n[ 1 ], hit.n[ 2 ] );
 
-            osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector =
-                    new osgUtil::LineSegmentIntersector( b, e );
+            return true;
+        }
+    }
 
-            osgUtil::IntersectionVisitor iv( intersector.get(), _rc.get() );
-            iv.setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-            iv.setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-            _scenery->accept( iv );
+    return false;
+}
 
-//            osg::ref_ptr<osgUtil::IntersectionVisitor> iv = new osgUtil::IntersectionVisitor( intersector.get(), _rc.get() );
-//            iv->setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-//            iv->setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-//            _scenery->accept( *iv );
+////////////////////////////////////////////////////////////////////////////////
 
-//            _iv->setIntersector( intersector.get() );
-//            _ig->addIntersector( intersector.get() );
+unsigned int Intersections::findFirst( const Ray rays[], Hit hits[], unsigned int count )
+{
+    std::shared_ptr< const Tiles > tiles;
 
-//            _scenery->accept( *_iv );
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        tiles = _tiles;
+    }
 
-            if ( intersector->containsIntersections() )
-            {
-                osgUtil::LineSegmentIntersector::Intersection intersection = intersector->getFirstIntersection();
+    unsigned int result = 0;
 
-                r = intersection.getWorldIntersectPoint();
-                n = intersection.getWorldIntersectNormal();
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        hits[ i ].valid = false;
 
-                return true;
-            }
-        }
+        if ( tiles ) findFirst( *tiles, rays[ i ], &hits[ i ] );
+        if ( hits[ i ].valid ) result++;
     }
 
-    return false;
+    return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -131,3 +310,174 @@ double Intersections::getElevation( double lat, double lon )
 
     return std::numeric_limits< double >::quiet_NaN();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::setScenery( osg::Node *scenery )
+{
+    osg::Timer_t t_0 = osg::Timer::instance()->tick();
+
+    std::shared_ptr< const Tiles > tiles = extract( scenery );
+
+    unsigned int count = 0;
+
+    for ( Tiles::const_iterator it = tiles->begin(); it != tiles->end(); ++it )
+    {
+        if ( it->bvh ) count += it->bvh->getCount();
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _tiles = tiles;
+        _cache.clear();
+        _used.clear();
+        _pending.clear();
+        _requests.clear();
+        _scenery++;
+    }
+
+    // top level tiles without resident geometry have nothing to fall back to
+    for ( Tiles::const_iterator it = tiles->begin(); it != tiles->end(); ++it )
+    {
+        if ( !it->bvh && !it->file.empty() ) getChildren( it->file );
+    }
+
+    Log::i() << count << " scenery triangles extracted in "
+             << osg::Timer::instance()->delta_s( t_0, osg::Timer::instance()->tick() )
+             << " s" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::findFirst( const Tiles &tiles, const Ray &ray, Hit *hit )
+{
+    hit->valid = false;
+
+    for ( Tiles::const_iterator it = tiles.begin(); it != tiles.end(); ++it )
+    {
+        if ( !intersects( ray, it->center, it->radius ) ) continue;
+
+        Hit tileHit;
+        tileHit.valid = false;
+
+        if ( !it->file.empty() )
+        {
+            std::shared_ptr< const Tiles > children = getChildren( it->file );
+
+            if ( children ) findFirst( *children, ray, &tileHit );
+        }
+
+        // children are finer than the tile itself, but until they are read
+        // the tile resident geometry is used
+        if ( !tileHit.valid && it->bvh )
+        {
+            it->bvh->intersect( ray.b, ray.e, &tileHit );
+        }
+
+        if ( tileHit.valid && ( !hit->valid || tileHit.t < hit->t ) )
+        {
+            *hit = tileHit;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr< const Intersections::Tiles > Intersections::getChildren( const std::string &file )
+{
+    bool requested = false;
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        Cache::iterator it = _cache.find( file );
+
+        if ( it != _cache.end() )
+        {
+            _used.splice( _used.begin(), _used, it->second.used );
+            return it->second.tiles;
+        }
+
+        if ( _pending.insert( file ).second )
+        {
+            Request request = { file, _scenery };
+            _requests.push_back( request );
+
+            requested = true;
+        }
+    }
+
+    if ( requested ) _condition.notify_one();
+
+    return std::shared_ptr< const Tiles >();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::load( const Request &request )
+{
+    // files which cannot be read are cached as well, so they are not read again
+    osg::ref_ptr<osg::Node> node = osgDB::readRefNodeFile( request.file );
+
+    std::shared_ptr< const Tiles > tiles = extract( node.get() );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    // scenery has been changed in the meantime
+    if ( request.scenery != _scenery ) return;
+
+    _pending.erase( request.file );
+
+    if ( _cache.size() >= _maxCached )
+    {
+        _cache.erase( _used.back() );
+        _used.pop_back();
+    }
+
+    _used.push_front( request.file );
+
+    Entry &entry = _cache[ request.file ];
+
+    entry.tiles = tiles;
+    entry.used = _used.begin();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::run()
+{
+    while ( true )
+    {
+        Request request;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+
+            _condition.wait( lock, [ this ]() { return _stop || !_requests.empty(); } );
+
+            if ( _stop ) return;
+
+            request = _requests.front();
+            _requests.pop_front();
+        }
+
+        load( request );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr< const Intersections::Tiles > Intersections::extract( osg::Node *node )
+{
+    std::shared_ptr< Tiles > tiles = std::make_shared< Tiles >();
+
+    if ( node )
+    {
+        Extractor extractor;
+        node->accept( extractor );
+        extractor.getTiles( tiles.get() );
+    }
+
+    return tiles;
+}
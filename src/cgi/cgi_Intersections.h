@@ -24,11 +24,21 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <osg/Node>
 #include <osg/Vec3d>
-#include <osg/Version>
 
-#include <osgUtil/IntersectionVisitor>
+#include <cgi/cgi_TriangleBVH.h>
 
 #include <sim/Singleton.h>
 
@@ -39,6 +49,20 @@ namespace cgi
 
 /**
  * @brief Intersections class.
+ *
+ * Scenery triangles are extracted once, when the scenery is set, into
+ * triangles bounding volume hierarchies in WGS. Highest level of detail of
+ * plain LOD nodes is used. Every osg::PagedLOD node becomes a tile with its
+ * resident geometry, tiles children files are read and extracted on demand
+ * by a background thread, when a query first reaches them, and are
+ * cached, least recently used files are dropped. Queries never wait for
+ * files being read, until tile children are resident its own coarser
+ * geometry is used instead. Children of top level tiles without resident
+ * geometry are requested as soon as the scenery is set. Query result is
+ * the nearest of the intersections with the finest resident tiles and
+ * the rest of the scenery.
+ *
+ * Queries can be done by any number of threads at the same time.
  */
 class Intersections : public Singleton< Intersections >
 {
@@ -46,16 +70,46 @@ class Intersections : public Singleton< Intersections >
 
 public:
 
-    struct ReadCallback : public osgUtil::IntersectionVisitor::ReadCallback
+    typedef TriangleBVH::Ray Ray;
+    typedef TriangleBVH::Hit Hit;
+
+    static const unsigned int _maxCached;   ///< maximum number of cached tiles children files
+
+private:
+
+    /** Scenery tile. */
+    struct Tile
     {
-#       if OPENSCENEGRAPH_SOVERSION < 140
-        virtual osg::Node* readNodeFile( const std::string& filename );
-#       else
-        virtual osg::ref_ptr<osg::Node> readNodeFile( const std::string& filename );
-#       endif
+        std::shared_ptr< const TriangleBVH > bvh;   ///< tile triangles
+        osg::Vec3d center;                          ///< bounding sphere center
+        double radius;                              ///< bounding sphere radius
+        std::string file;                           ///< children file, empty for leaves
     };
 
-private:
+    typedef std::vector< Tile > Tiles;
+
+    typedef std::list< std::string > Used;
+
+    /** Cached tiles children file. */
+    struct Entry
+    {
+        std::shared_ptr< const Tiles > tiles;       ///< children tiles
+        Used::iterator used;                        ///< position in the use order list
+    };
+
+    typedef std::unordered_map< std::string, Entry > Cache;
+    typedef std::unordered_set< std::string > Pending;
+
+    /** Children file read request. */
+    struct Request
+    {
+        std::string file;                           ///< children file path
+        unsigned int scenery;                       ///< scenery counter at the time of request
+    };
+
+    typedef std::deque< Request > Requests;
+
+    class Extractor;
 
     /**
      * You should use static function instance() due to get refernce
@@ -82,22 +136,62 @@ public:
     bool findFirst( const osg::Vec3d &b, const osg::Vec3d &e,
                     osg::Vec3d &r, osg::Vec3d &n );
 
+    /**
+     * @brief Finds intersections of many segments at once.
+     * @param rays segments expressed in WGS
+     * @param hits output intersections
+     * @param count number of segments
+     * @return number of intersections found
+     */
+    unsigned int findFirst( const Ray rays[], Hit hits[], unsigned int count );
+
     /** */
     double getElevation( double lat, double lon );
 
-    /** */
-    inline void setScenery( osg::Node *scenery )
-    {
-        _scenery = scenery;
-    }
+    /**
+     * @brief Sets scenery and extracts its triangles.
+     * @param scenery scenery root node, expressed in WGS
+     */
+    void setScenery( osg::Node *scenery );
 
 private:
 
-    osg::ref_ptr<osg::Node> _scenery;
-    osg::ref_ptr<ReadCallback> _rc;
+    std::shared_ptr< const Tiles > _tiles;  ///< scenery top level tiles
+
+    Cache _cache;                           ///< tiles children files cache
+    Used _used;                             ///< cached files, most recently used first
+    Pending _pending;                       ///< files being read
+
+    Requests _requests;                     ///< read requests queue
+
+    unsigned int _scenery;                  ///< scenery counter, stale reads are dropped
+
+    std::thread _thread;                    ///< background reading thread
+
+    std::mutex _mutex;                      ///< tiles, cache and requests mutex
+    std::condition_variable _condition;     ///< requests queue condition
+
+    bool _stop;                             ///< specifies if background thread should stop
+
+    void findFirst( const Tiles &tiles, const Ray &ray, Hit *hit );
+
+    /**
+     * @brief Returns cached children tiles or requests reading the file.
+     * @param file children file path
+     * @return children tiles or null pointer if not resident yet
+     */
+    std::shared_ptr< const Tiles > getChildren( const std::string &file );
+
+    /**
+     * @brief Reads and extracts children file and caches its tiles,
+     * executed by the background thread.
+     * @param request read request
+     */
+    void load( const Request &request );
+
+    void run();
 
-//    osg::ref_ptr<osgUtil::IntersectionVisitor> _iv;
-//    osg::ref_ptr<osgUtil::IntersectorGroup>    _ig;
+    static std::shared_ptr< const Tiles > extract( osg::Node *node );
 };
 
 } // end of cgi namespace
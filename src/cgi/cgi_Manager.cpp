@@ -26,6 +26,10 @@
 #include <cgi/cgi_Intersections.h>
 #include <cgi/cgi_WGS84.h>
 
+#include <cgi/otw/cgi_Ownship.h>
+
+#include <Data.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -44,6 +48,9 @@ Manager::Manager() :
     _otw = new OTW();
 
     _camera = new Camera();
+
+    _trace.seq  = 0;
+    _trace.time = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -79,6 +86,16 @@ void Manager::updateOTW()
 
     _camera->update();
     updateGround();
+
+    _trace = Data::get()->trace;
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Update, _trace );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::recordFrame()
+{
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, _trace );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -152,6 +169,13 @@ void Manager::setMapScale( double scale )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Manager::setMapView( double left, double right, double bottom, double top )
+{
+    _map->setView( left, right, bottom, top );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Manager::updateGround()
 {
     WGS84 wgs_b( Data::get()->ownship.latitude, Data::get()->ownship.longitude, 10000.0 );
@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_LatencyTrace.h>
+
 #include <sim/Singleton.h>
 
 #include <cgi/hud/cgi_HUD.h>
@@ -107,6 +109,12 @@ public:
         return _otw->getNode();
     }
 
+    /**
+     * @brief Records latency trace stamp of the data shown in the frame drawn.
+     * Should be called when drawing of the OTW frame is finished.
+     */
+    void recordFrame();
+
     /** */
     void setCameraManipulatorChase();
 
@@ -128,6 +136,9 @@ public:
     /** @brief Sets map scale factor. */
     void setMapScale( double scale );
 
+    /** @brief Sets map view edges Mercator coordinates. */
+    void setMapView( double left, double right, double bottom, double top );
+
     inline void setVisibilityCrops     ( bool visible ) { _map->setVisibilityCrops     ( visible ); }
     inline void setVisibilityGrassland ( bool visible ) { _map->setVisibilityGrassland ( visible ); }
     inline void setVisibilityWoodland  ( bool visible ) { _map->setVisibilityWoodland  ( visible ); }
@@ -148,6 +159,8 @@ private:
 
     Camera *_camera;            ///< camera object
 
+    fdm::LatencyTrace::Stamp _trace;    ///< latency trace stamp of the data shown
+
     /** */
     void updateGround();
 };
@@ -61,6 +61,11 @@ public:
 
     double getScale() const { return _scale; }
 
+    double getMapLeft()   const { return _map_left;   }
+    double getMapRight()  const { return _map_right;  }
+    double getMapBottom() const { return _map_bottom; }
+    double getMapTop()    const { return _map_top;    }
+
     void registerScaleChangeCallback( void(*fun)(double) );
 
     void setCenterX( double x );
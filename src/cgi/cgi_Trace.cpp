@@ -0,0 +1,306 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_Trace.h>
+
+#include <algorithm>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::simplify( Points *points, double tolerance )
+{
+    if ( points->size() < 3 ) return;
+
+    std::vector< bool > keep( points->size(), false );
+
+    keep[ 0 ] = true;
+    keep[ points->size() - 1 ] = true;
+
+    std::vector< std::pair< size_t, size_t > > stack;
+    stack.push_back( std::make_pair( 0, points->size() - 1 ) );
+
+    double tolerance2 = tolerance * tolerance;
+
+    while ( stack.size() > 0 )
+    {
+        size_t i_0 = stack.back().first;
+        size_t i_1 = stack.back().second;
+        stack.pop_back();
+
+        osg::Vec3d p_0 = (*points)[ i_0 ];
+        osg::Vec3d seg = osg::Vec3d( (*points)[ i_1 ] ) - p_0;
+
+        double len2 = seg.length2();
+
+        double d2_max = 0.0;
+        size_t i_max = i_0;
+
+        for ( size_t i = i_0 + 1; i < i_1; i++ )
+        {
+            osg::Vec3d r = osg::Vec3d( (*points)[ i ] ) - p_0;
+
+            // distance from the segment
+            double t = ( len2 > 0.0 ) ? std::max( 0.0, std::min( 1.0, ( r * seg ) / len2 ) ) : 0.0;
+            double d2 = ( r - seg * t ).length2();
+
+            if ( d2 > d2_max )
+            {
+                d2_max = d2;
+                i_max = i;
+            }
+        }
+
+        if ( d2_max > tolerance2 )
+        {
+            keep[ i_max ] = true;
+
+            stack.push_back( std::make_pair( i_0, i_max ) );
+            stack.push_back( std::make_pair( i_max, i_1 ) );
+        }
+    }
+
+    size_t j = 0;
+
+    for ( size_t i = 0; i < points->size(); i++ )
+    {
+        if ( keep[ i ] ) (*points)[ j++ ] = (*points)[ i ];
+    }
+
+    points->resize( j );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trace::Trace( osg::Group *parent, const osg::Vec3 &color,
+              unsigned int chunkSize, unsigned int maxPoints, double tolerance ) :
+    _chunkSize ( std::max( chunkSize, 2U ) ),
+    _maxPoints ( std::max( maxPoints, 4 * _chunkSize ) ),
+    _tolerance_0 ( tolerance ),
+    _tolerance ( tolerance ),
+    _count ( 0 )
+{
+    _geode = new osg::Geode();
+    parent->addChild( _geode.get() );
+
+    _colors  = new osg::Vec4Array();
+    _normals = new osg::Vec3Array();
+
+    _colors->push_back( osg::Vec4( color, 1.0f ) );
+    _normals->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trace::~Trace() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::addPoint( const osg::Vec3 &point )
+{
+    if ( _chunks.size() == 0 )
+    {
+        addChunk();
+    }
+    else if ( _chunks.back().vertices->size() >= _chunkSize )
+    {
+        closeChunk();
+    }
+
+    Chunk &chunk = _chunks.back();
+
+    chunk.vertices->push_back( point );
+    chunk.vertices->dirty();
+    chunk.drawArrays->setCount( chunk.vertices->size() );
+    chunk.geometry->dirtyBound();
+
+    _count++;
+
+    if ( _count > _maxPoints )
+    {
+        decimate();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::reset()
+{
+    _geode->removeDrawables( 0, _geode->getNumDrawables() );
+
+    _chunks.clear();
+
+    _tolerance = _tolerance_0;
+    _count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::setColor( const osg::Vec3 &color )
+{
+    osg::Vec4 c( color, 1.0f );
+
+    if ( (*_colors)[ 0 ] != c )
+    {
+        (*_colors)[ 0 ] = c;
+        _colors->dirty();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::addChunk()
+{
+    Chunk chunk;
+
+    chunk.geometry   = new osg::Geometry();
+    chunk.vertices   = new osg::Vec3Array();
+    chunk.drawArrays = new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, 0 );
+
+    // pre-allocated, so appending never reallocates
+    chunk.vertices->reserve( _chunkSize );
+
+    chunk.geometry->setDataVariance( osg::Object::DYNAMIC );
+    chunk.geometry->setUseDisplayList( false );
+    chunk.geometry->setUseVertexBufferObjects( true );
+
+    chunk.geometry->setVertexArray( chunk.vertices.get() );
+    chunk.geometry->addPrimitiveSet( chunk.drawArrays.get() );
+    chunk.geometry->setNormalArray( _normals.get() );
+    chunk.geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+    chunk.geometry->setColorArray( _colors.get() );
+    chunk.geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+
+    _geode->addDrawable( chunk.geometry.get() );
+
+    _chunks.push_back( chunk );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::closeChunk()
+{
+    Points points( _chunks.back().vertices->begin(), _chunks.back().vertices->end() );
+
+    simplify( &points, _tolerance );
+
+    unsigned int size = _chunks.size();
+
+    if ( size > 1 && _chunks[ size - 2 ].vertices->size() + points.size() - 1 <= _chunkSize )
+    {
+        // merges into the previous chunk, first point is shared
+        Chunk &prev = _chunks[ size - 2 ];
+
+        prev.vertices->insert( prev.vertices->end(), points.begin() + 1, points.end() );
+        prev.vertices->dirty();
+        prev.drawArrays->setCount( prev.vertices->size() );
+        prev.geometry->dirtyBound();
+
+        _geode->removeDrawable( _chunks.back().geometry.get() );
+        _chunks.pop_back();
+    }
+    else
+    {
+        setPoints( &_chunks.back(), points.begin(), points.end() );
+    }
+
+    // next chunk starts where the previous one ends
+    addChunk();
+    setPoints( &_chunks.back(), points.end() - 1, points.end() );
+
+    updateCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::decimate()
+{
+    // reduces to the half of the budget, so decimation is not repeated too often
+    while ( _count > _maxPoints / 2 && _chunks.size() > 1 )
+    {
+        unsigned int count_prev = _count;
+
+        _tolerance *= 2.0;
+
+        Points points;
+
+        for ( unsigned int i = 0; i < _chunks.size() - 1; i++ )
+        {
+            const osg::Vec3Array *v = _chunks[ i ].vertices.get();
+
+            // chunks share their boundary points
+            points.insert( points.end(), v->begin() + ( i > 0 ? 1 : 0 ), v->end() );
+        }
+
+        simplify( &points, _tolerance );
+
+        Chunk last = _chunks.back();
+
+        _geode->removeDrawables( 0, _geode->getNumDrawables() );
+        _chunks.clear();
+
+        Points::const_iterator begin = points.begin();
+
+        while ( begin + 1 < points.end() )
+        {
+            Points::const_iterator end = begin + std::min( (long)_chunkSize, (long)( points.end() - begin ) );
+
+            addChunk();
+            setPoints( &_chunks.back(), begin, end );
+
+            begin = end - 1;
+        }
+
+        _geode->addDrawable( last.geometry.get() );
+        _chunks.push_back( last );
+
+        updateCount();
+
+        if ( _count >= count_prev ) break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::setPoints( Chunk *chunk, Points::const_iterator begin, Points::const_iterator end )
+{
+    chunk->vertices->assign( begin, end );
+    chunk->vertices->dirty();
+    chunk->drawArrays->setCount( chunk->vertices->size() );
+    chunk->geometry->dirtyBound();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::updateCount()
+{
+    _count = 0;
+
+    for ( Chunks::const_iterator it = _chunks.begin(); it != _chunks.end(); ++it )
+    {
+        _count += (*it).vertices->size();
+    }
+}
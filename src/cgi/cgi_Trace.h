@@ -0,0 +1,141 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_TRACE_H
+#define CGI_TRACE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Incremental polyline trace class.
+ *
+ * Points are appended into chunks of pre-allocated vertex buffer object
+ * backed arrays, so only the last chunk is dirtied when a point is added.
+ * Every filled chunk is simplified using Douglas-Peucker algorithm. If the
+ * total number of points exceeds the budget, the simplification tolerance
+ * is doubled and all filled chunks are simplified again until the half of
+ * the budget is reached, which keeps both
+ * memory and per frame cost bounded during long flights.
+ *
+ * @see Douglas D., Peucker T.: Algorithms for the reduction of the number of points required to represent a digitized line or its caricature, 1973
+ */
+class Trace
+{
+public:
+
+    typedef std::vector< osg::Vec3 > Points;
+
+    /**
+     * @brief Simplifies polyline using Douglas-Peucker algorithm.
+     * First and last points are always kept.
+     * @param points polyline points to be simplified
+     * @param tolerance maximum distance of a removed point from the simplified polyline
+     */
+    static void simplify( Points *points, double tolerance );
+
+    /**
+     * @brief Constructor.
+     * @param parent parent group
+     * @param color trace color
+     * @param chunkSize maximum number of points in a single chunk
+     * @param maxPoints points budget
+     * @param tolerance initial simplification tolerance
+     */
+    Trace( osg::Group *parent, const osg::Vec3 &color,
+           unsigned int chunkSize = 1024,
+           unsigned int maxPoints = 65536,
+           double tolerance = 1.0 );
+
+    /** @brief Destructor. */
+    virtual ~Trace();
+
+    /**
+     * @brief Appends point to the trace.
+     * @param point point coordinates
+     */
+    void addPoint( const osg::Vec3 &point );
+
+    /** @brief Removes all points. */
+    void reset();
+
+    /** @brief Sets trace color. */
+    void setColor( const osg::Vec3 &color );
+
+    /** @brief Returns trace geode. */
+    inline osg::Geode* getNode() { return _geode.get(); }
+
+    inline unsigned int getCount() const { return _count; }
+
+    inline double getTolerance() const { return _tolerance; }
+
+private:
+
+    /** Chunk data. */
+    struct Chunk
+    {
+        osg::ref_ptr<osg::Geometry>   geometry;     ///< chunk geometry
+        osg::ref_ptr<osg::Vec3Array>  vertices;     ///< chunk vertices
+        osg::ref_ptr<osg::DrawArrays> drawArrays;   ///< chunk primitive set
+    };
+
+    typedef std::vector< Chunk > Chunks;
+
+    osg::ref_ptr<osg::Geode> _geode;            ///< trace geode
+    osg::ref_ptr<osg::Vec4Array> _colors;       ///< trace color array shared by chunks
+    osg::ref_ptr<osg::Vec3Array> _normals;      ///< trace normal array shared by chunks
+
+    Chunks _chunks;                 ///< chunks, the last one is open for appending
+
+    const unsigned int _chunkSize;  ///< maximum number of points in a single chunk
+    const unsigned int _maxPoints;  ///< points budget
+
+    const double _tolerance_0;      ///< initial simplification tolerance
+
+    double _tolerance;              ///< current simplification tolerance
+
+    unsigned int _count;            ///< total number of points
+
+    void addChunk();
+
+    void closeChunk();
+
+    void decimate();
+
+    void setPoints( Chunk *chunk, Points::const_iterator begin, Points::const_iterator end );
+
+    void updateCount();
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_TRACE_H
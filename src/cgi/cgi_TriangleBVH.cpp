@@ -0,0 +1,655 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_TriangleBVH.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#   define CGI_TRIANGLEBVH_SSE
+#   include <xmmintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int TriangleBVH::_maxDepth = 60;
+const unsigned int TriangleBVH::_bins     = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// barycentric coordinates tolerance, so rays do not slip between triangles
+const float tolerance = 1.0e-5f;
+
+float area( const float min[], const float max[] )
+{
+    float dx = max[ 0 ] - min[ 0 ];
+    float dy = max[ 1 ] - min[ 1 ];
+    float dz = max[ 2 ] - min[ 2 ];
+
+    return 2.0f * ( dx * dy + dy * dz + dz * dx );
+}
+
+void expand( float min[], float max[], const float p_min[], const float p_max[] )
+{
+    for ( int k = 0; k < 3; k++ )
+    {
+        min[ k ] = std::min( min[ k ], p_min[ k ] );
+        max[ k ] = std::max( max[ k ], p_max[ k ] );
+    }
+}
+
+unsigned int blocks( unsigned int count )
+{
+    return ( count + 3 ) / 4;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TriangleBVH::TriangleBVH( unsigned int leafSize ) :
+    _leafSize ( leafSize > 4 ? leafSize : 4 ),
+    _count ( 0 )
+{
+    _origin[ 0 ] = 0.0;
+    _origin[ 1 ] = 0.0;
+    _origin[ 2 ] = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TriangleBVH::~TriangleBVH() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::clear()
+{
+    _vertices.clear();
+    _nodes.clear();
+    _blocks.clear();
+
+    _count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::insert( const double v0[], const double v1[], const double v2[] )
+{
+    _vertices.insert( _vertices.end(), v0, v0 + 3 );
+    _vertices.insert( _vertices.end(), v1, v1 + 3 );
+    _vertices.insert( _vertices.end(), v2, v2 + 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::build()
+{
+    _nodes.clear();
+    _blocks.clear();
+
+    _count = (unsigned int)( _vertices.size() / 9 );
+
+    if ( _count == 0 ) return;
+
+    double min[ 3 ] = { DBL_MAX, DBL_MAX, DBL_MAX };
+    double max[ 3 ] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+
+    for ( unsigned int i = 0; i < _vertices.size(); i++ )
+    {
+        min[ i % 3 ] = std::min( min[ i % 3 ], _vertices[ i ] );
+        max[ i % 3 ] = std::max( max[ i % 3 ], _vertices[ i ] );
+    }
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        _origin[ k ] = 0.5 * ( min[ k ] + max[ k ] );
+    }
+
+    std::vector< float > local( _vertices.size() );
+
+    for ( unsigned int i = 0; i < _vertices.size(); i++ )
+    {
+        local[ i ] = (float)( _vertices[ i ] - _origin[ i % 3 ] );
+    }
+
+    std::vector< double >().swap( _vertices );
+
+    Refs refs( _count );
+
+    for ( unsigned int i = 0; i < _count; i++ )
+    {
+        const float *v = &local[ 9 * i ];
+
+        for ( int k = 0; k < 3; k++ )
+        {
+            refs[ i ].min[ k ] = std::min( v[ k ], std::min( v[ 3 + k ], v[ 6 + k ] ) );
+            refs[ i ].max[ k ] = std::max( v[ k ], std::max( v[ 3 + k ], v[ 6 + k ] ) );
+            refs[ i ].c[ k ] = ( v[ k ] + v[ 3 + k ] + v[ 6 + k ] ) / 3.0f;
+        }
+
+        refs[ i ].index = i;
+    }
+
+    _nodes.reserve( 2 * blocks( _count ) );
+    _nodes.push_back( Node() );
+
+    split( 0, refs, 0, _count, local, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVH::intersect( const double b[], const double e[], Hit *hit ) const
+{
+    hit->valid = false;
+
+    if ( _nodes.empty() ) return false;
+
+    // segment in local coordinates, parameter t from 0 to 1
+    float o[ 3 ];
+    float d[ 3 ];
+    float d_inv[ 3 ];
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        o[ k ] = (float)( b[ k ] - _origin[ k ] );
+        d[ k ] = (float)( e[ k ] - b[ k ] );
+        d_inv[ k ] = ( fabs( d[ k ] ) > 1.0e-30f ) ? 1.0f / d[ k ] : FLT_MAX;
+    }
+
+    float t_max = 1.0f;
+
+    const Block *block = nullptr;
+    unsigned int lane = 0;
+
+    struct Entry
+    {
+        unsigned int node;
+        float t;
+    };
+
+    Entry stack[ _maxDepth + 4 ];
+    unsigned int size = 0;
+
+    stack[ size++ ] = { 0, 0.0f };
+
+    while ( size > 0 )
+    {
+        const Entry &entry = stack[ --size ];
+
+        // closer intersection found since the node was pushed
+        if ( entry.t > t_max ) continue;
+
+        const Node &node = _nodes[ entry.node ];
+
+        float t_entry = 0.0f;
+
+        if ( entry.node == 0 )
+        {
+            // root box is the only one not tested before pushing
+            float t_exit = t_max;
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                float t_0 = ( node.min[ k ] - o[ k ] ) * d_inv[ k ];
+                float t_1 = ( node.max[ k ] - o[ k ] ) * d_inv[ k ];
+
+                if ( t_0 > t_1 ) std::swap( t_0, t_1 );
+
+                t_entry = std::max( t_entry, t_0 );
+                t_exit  = std::min( t_exit , t_1 );
+            }
+
+            if ( t_entry > t_exit ) continue;
+        }
+
+        if ( node.count > 0 )
+        {
+            for ( unsigned int i = node.index; i < node.index + node.count; i++ )
+            {
+                unsigned int l = 0;
+
+                if ( intersect( _blocks[ i ], o, d, &t_max, &l ) )
+                {
+                    block = &_blocks[ i ];
+                    lane = l;
+                }
+            }
+        }
+        else
+        {
+            Entry children[ 2 ];
+            unsigned int count = 0;
+
+            for ( unsigned int c = node.index; c < node.index + 2; c++ )
+            {
+                const Node &child = _nodes[ c ];
+
+                float t_0_max = 0.0f;
+                float t_1_min = t_max;
+
+                for ( int k = 0; k < 3; k++ )
+                {
+                    float t_0 = ( child.min[ k ] - o[ k ] ) * d_inv[ k ];
+                    float t_1 = ( child.max[ k ] - o[ k ] ) * d_inv[ k ];
+
+                    if ( t_0 > t_1 ) std::swap( t_0, t_1 );
+
+                    t_0_max = std::max( t_0_max, t_0 );
+                    t_1_min = std::min( t_1_min, t_1 );
+                }
+
+                if ( t_0_max <= t_1_min )
+                {
+                    children[ count++ ] = { c, t_0_max };
+                }
+            }
+
+            // nearer child is popped first
+            if ( count == 2 && children[ 0 ].t < children[ 1 ].t )
+            {
+                std::swap( children[ 0 ], children[ 1 ] );
+            }
+
+            for ( unsigned int i = 0; i < count; i++ )
+            {
+                stack[ size++ ] = children[ i ];
+            }
+        }
+    }
+
+    if ( block )
+    {
+        double e1[ 3 ] = { block->e1[ 0 ][ lane ], block->e1[ 1 ][ lane ], block->e1[ 2 ][ lane ] };
+        double e2[ 3 ] = { block->e2[ 0 ][ lane ], block->e2[ 1 ][ lane ], block->e2[ 2 ][ lane ] };
+
+        double n[ 3 ] =
+        {
+            e1[ 1 ] * e2[ 2 ] - e1[ 2 ] * e2[ 1 ],
+            e1[ 2 ] * e2[ 0 ] - e1[ 0 ] * e2[ 2 ],
+            e1[ 0 ] * e2[ 1 ] - e1[ 1 ] * e2[ 0 ]
+        };
+
+        double n_len = sqrt( n[ 0 ] * n[ 0 ] + n[ 1 ] * n[ 1 ] + n[ 2 ] * n[ 2 ] );
+
+        hit->valid = true;
+        hit->t = t_max;
+
+        for ( int k = 0; k < 3; k++ )
+        {
+            hit->r[ k ] = b[ k ] + hit->t * ( e[ k ] - b[ k ] );
+            hit->n[ k ] = ( n_len > 0.0 ) ? n[ k ] / n_len : 0.0;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int TriangleBVH::intersect( const Ray rays[], Hit hits[], unsigned int count ) const
+{
+    unsigned int result = 0;
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        if ( intersect( rays[ i ].b, rays[ i ].e, &hits[ i ] ) ) result++;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVH::getBounds( double min[], double max[] ) const
+{
+    if ( _nodes.empty() ) return false;
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        min[ k ] = _origin[ k ] + _nodes[ 0 ].min[ k ];
+        max[ k ] = _origin[ k ] + _nodes[ 0 ].max[ k ];
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::split( unsigned int node, Refs &refs, unsigned int begin, unsigned int end,
+                         const std::vector< float > &local, unsigned int depth )
+{
+    float min[ 3 ] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[ 3 ] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    float c_min[ 3 ] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float c_max[ 3 ] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for ( unsigned int i = begin; i < end; i++ )
+    {
+        expand( min, max, refs[ i ].min, refs[ i ].max );
+        expand( c_min, c_max, refs[ i ].c, refs[ i ].c );
+    }
+
+    memcpy( _nodes[ node ].min, min, sizeof( min ) );
+    memcpy( _nodes[ node ].max, max, sizeof( max ) );
+
+    const unsigned int count = end - begin;
+
+    if ( count <= 4 || depth >= _maxDepth )
+    {
+        createLeaf( node, refs, begin, end, local );
+        return;
+    }
+
+    // binned surface area heuristic, costs in four triangles blocks
+    // tested at once, with node traversal cost equal to a block test
+    float cost_best = FLT_MAX;
+    int axis_best = -1;
+    unsigned int bin_best = 0;
+
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        float extent = c_max[ axis ] - c_min[ axis ];
+
+        if ( !( extent > 0.0f ) ) continue;
+
+        float scale = (float)_bins * ( 1.0f - 1.0e-6f ) / extent;
+
+        unsigned int bin_count[ _bins ] = { 0 };
+        float bin_min[ _bins ][ 3 ];
+        float bin_max[ _bins ][ 3 ];
+
+        for ( unsigned int b = 0; b < _bins; b++ )
+        {
+            for ( int k = 0; k < 3; k++ )
+            {
+                bin_min[ b ][ k ] =  FLT_MAX;
+                bin_max[ b ][ k ] = -FLT_MAX;
+            }
+        }
+
+        for ( unsigned int i = begin; i < end; i++ )
+        {
+            unsigned int b = std::min( _bins - 1, (unsigned int)( ( refs[ i ].c[ axis ] - c_min[ axis ] ) * scale ) );
+
+            bin_count[ b ]++;
+            expand( bin_min[ b ], bin_max[ b ], refs[ i ].min, refs[ i ].max );
+        }
+
+        // right side sweep
+        float right_area[ _bins ];
+        unsigned int right_count[ _bins ];
+
+        float r_min[ 3 ] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float r_max[ 3 ] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        unsigned int r_count = 0;
+
+        for ( unsigned int b = _bins - 1; b > 0; b-- )
+        {
+            if ( bin_count[ b ] > 0 ) expand( r_min, r_max, bin_min[ b ], bin_max[ b ] );
+            r_count += bin_count[ b ];
+
+            right_area [ b ] = ( r_count > 0 ) ? area( r_min, r_max ) : 0.0f;
+            right_count[ b ] = r_count;
+        }
+
+        // left side sweep, split between bins b and b+1
+        float l_min[ 3 ] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float l_max[ 3 ] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        unsigned int l_count = 0;
+
+        for ( unsigned int b = 0; b < _bins - 1; b++ )
+        {
+            if ( bin_count[ b ] > 0 ) expand( l_min, l_max, bin_min[ b ], bin_max[ b ] );
+            l_count += bin_count[ b ];
+
+            if ( l_count == 0 || right_count[ b + 1 ] == 0 ) continue;
+
+            float cost = area( l_min, l_max ) * blocks( l_count )
+                       + right_area[ b + 1 ] * blocks( right_count[ b + 1 ] );
+
+            if ( cost < cost_best )
+            {
+                cost_best = cost;
+                axis_best = axis;
+                bin_best  = b;
+            }
+        }
+    }
+
+    float node_area = area( min, max );
+    float cost_leaf = node_area * blocks( count );
+    float cost_split = node_area + cost_best;
+
+    if ( count <= _leafSize && ( axis_best < 0 || cost_leaf <= cost_split ) )
+    {
+        createLeaf( node, refs, begin, end, local );
+        return;
+    }
+
+    unsigned int mid = begin;
+
+    if ( axis_best >= 0 )
+    {
+        float scale = (float)_bins * ( 1.0f - 1.0e-6f ) / ( c_max[ axis_best ] - c_min[ axis_best ] );
+        float c_0 = c_min[ axis_best ];
+
+        Ref *it = std::partition( &refs[ begin ], &refs[ begin ] + count,
+            [ axis_best, bin_best, scale, c_0 ]( const Ref &ref )
+            {
+                return std::min( _bins - 1, (unsigned int)( ( ref.c[ axis_best ] - c_0 ) * scale ) ) <= bin_best;
+            });
+
+        mid = (unsigned int)( it - &refs[ 0 ] );
+    }
+
+    if ( mid == begin || mid == end )
+    {
+        // all centroids in a single bin, median split along the longest box axis
+        int axis = 0;
+
+        for ( int k = 1; k < 3; k++ )
+        {
+            if ( max[ k ] - min[ k ] > max[ axis ] - min[ axis ] ) axis = k;
+        }
+
+        mid = begin + count / 2;
+
+        std::nth_element( refs.begin() + begin, refs.begin() + mid, refs.begin() + end,
+            [ axis ]( const Ref &r_1, const Ref &r_2 )
+            {
+                return r_1.c[ axis ] < r_2.c[ axis ];
+            });
+    }
+
+    unsigned int left = (unsigned int)_nodes.size();
+
+    _nodes.push_back( Node() );
+    _nodes.push_back( Node() );
+
+    _nodes[ node ].index = left;
+    _nodes[ node ].count = 0;
+
+    split( left     , refs, begin, mid, local, depth + 1 );
+    split( left + 1 , refs, mid  , end, local, depth + 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::createLeaf( unsigned int node, const Refs &refs, unsigned int begin, unsigned int end,
+                              const std::vector< float > &local )
+{
+    _nodes[ node ].index = (unsigned int)_blocks.size();
+    _nodes[ node ].count = blocks( end - begin );
+
+    for ( unsigned int i = begin; i < end; i += 4 )
+    {
+        // unused lanes are degenerate triangles which are never intersected
+        Block block;
+        memset( &block, 0, sizeof( Block ) );
+
+        for ( unsigned int lane = 0; lane < 4 && i + lane < end; lane++ )
+        {
+            const float *v = &local[ 9 * refs[ i + lane ].index ];
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                block.v0[ k ][ lane ] = v[ k ];
+                block.e1[ k ][ lane ] = v[ 3 + k ] - v[ k ];
+                block.e2[ k ][ lane ] = v[ 6 + k ] - v[ k ];
+            }
+        }
+
+        _blocks.push_back( block );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVH::intersect( const Block &block, const float o[], const float d[],
+                             float *t, unsigned int *lane ) const
+{
+    // Moller-Trumbore test of four triangles at once
+    float t_lane[ 4 ];
+    int mask = 0;
+
+#   ifdef CGI_TRIANGLEBVH_SSE
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 d_x = _mm_set1_ps( d[ 0 ] );
+    const __m128 d_y = _mm_set1_ps( d[ 1 ] );
+    const __m128 d_z = _mm_set1_ps( d[ 2 ] );
+
+    const __m128 e1_x = _mm_loadu_ps( block.e1[ 0 ] );
+    const __m128 e1_y = _mm_loadu_ps( block.e1[ 1 ] );
+    const __m128 e1_z = _mm_loadu_ps( block.e1[ 2 ] );
+    const __m128 e2_x = _mm_loadu_ps( block.e2[ 0 ] );
+    const __m128 e2_y = _mm_loadu_ps( block.e2[ 1 ] );
+    const __m128 e2_z = _mm_loadu_ps( block.e2[ 2 ] );
+
+    // p = d x e2
+    __m128 p_x = _mm_sub_ps( _mm_mul_ps( d_y, e2_z ), _mm_mul_ps( d_z, e2_y ) );
+    __m128 p_y = _mm_sub_ps( _mm_mul_ps( d_z, e2_x ), _mm_mul_ps( d_x, e2_z ) );
+    __m128 p_z = _mm_sub_ps( _mm_mul_ps( d_x, e2_y ), _mm_mul_ps( d_y, e2_x ) );
+
+    __m128 det = _mm_add_ps( _mm_add_ps( _mm_mul_ps( e1_x, p_x ), _mm_mul_ps( e1_y, p_y ) ), _mm_mul_ps( e1_z, p_z ) );
+    __m128 det_inv = _mm_div_ps( _mm_set1_ps( 1.0f ), det );
+
+    // s = o - v0
+    __m128 s_x = _mm_sub_ps( _mm_set1_ps( o[ 0 ] ), _mm_loadu_ps( block.v0[ 0 ] ) );
+    __m128 s_y = _mm_sub_ps( _mm_set1_ps( o[ 1 ] ), _mm_loadu_ps( block.v0[ 1 ] ) );
+    __m128 s_z = _mm_sub_ps( _mm_set1_ps( o[ 2 ] ), _mm_loadu_ps( block.v0[ 2 ] ) );
+
+    __m128 u = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( s_x, p_x ), _mm_mul_ps( s_y, p_y ) ), _mm_mul_ps( s_z, p_z ) ), det_inv );
+
+    // q = s x e1
+    __m128 q_x = _mm_sub_ps( _mm_mul_ps( s_y, e1_z ), _mm_mul_ps( s_z, e1_y ) );
+    __m128 q_y = _mm_sub_ps( _mm_mul_ps( s_z, e1_x ), _mm_mul_ps( s_x, e1_z ) );
+    __m128 q_z = _mm_sub_ps( _mm_mul_ps( s_x, e1_y ), _mm_mul_ps( s_y, e1_x ) );
+
+    __m128 v  = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( d_x , q_x ), _mm_mul_ps( d_y , q_y ) ), _mm_mul_ps( d_z , q_z ) ), det_inv );
+    __m128 tt = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( e2_x, q_x ), _mm_mul_ps( e2_y, q_y ) ), _mm_mul_ps( e2_z, q_z ) ), det_inv );
+
+    __m128 valid = _mm_cmpneq_ps( det, zero );
+    valid = _mm_and_ps( valid, _mm_cmpge_ps( u, _mm_set1_ps( -tolerance ) ) );
+    valid = _mm_and_ps( valid, _mm_cmpge_ps( v, _mm_set1_ps( -tolerance ) ) );
+    valid = _mm_and_ps( valid, _mm_cmple_ps( _mm_add_ps( u, v ), _mm_set1_ps( 1.0f + tolerance ) ) );
+    valid = _mm_and_ps( valid, _mm_cmpge_ps( tt, zero ) );
+    valid = _mm_and_ps( valid, _mm_cmplt_ps( tt, _mm_set1_ps( *t ) ) );
+
+    mask = _mm_movemask_ps( valid );
+
+    if ( mask == 0 ) return false;
+
+    _mm_storeu_ps( t_lane, tt );
+#   else
+    for ( int i = 0; i < 4; i++ )
+    {
+        const float e1[ 3 ] = { block.e1[ 0 ][ i ], block.e1[ 1 ][ i ], block.e1[ 2 ][ i ] };
+        const float e2[ 3 ] = { block.e2[ 0 ][ i ], block.e2[ 1 ][ i ], block.e2[ 2 ][ i ] };
+
+        const float p[ 3 ] =
+        {
+            d[ 1 ] * e2[ 2 ] - d[ 2 ] * e2[ 1 ],
+            d[ 2 ] * e2[ 0 ] - d[ 0 ] * e2[ 2 ],
+            d[ 0 ] * e2[ 1 ] - d[ 1 ] * e2[ 0 ]
+        };
+
+        float det = e1[ 0 ] * p[ 0 ] + e1[ 1 ] * p[ 1 ] + e1[ 2 ] * p[ 2 ];
+
+        if ( det == 0.0f ) continue;
+
+        float det_inv = 1.0f / det;
+
+        const float s[ 3 ] =
+        {
+            o[ 0 ] - block.v0[ 0 ][ i ],
+            o[ 1 ] - block.v0[ 1 ][ i ],
+            o[ 2 ] - block.v0[ 2 ][ i ]
+        };
+
+        float u = ( s[ 0 ] * p[ 0 ] + s[ 1 ] * p[ 1 ] + s[ 2 ] * p[ 2 ] ) * det_inv;
+
+        const float q[ 3 ] =
+        {
+            s[ 1 ] * e1[ 2 ] - s[ 2 ] * e1[ 1 ],
+            s[ 2 ] * e1[ 0 ] - s[ 0 ] * e1[ 2 ],
+            s[ 0 ] * e1[ 1 ] - s[ 1 ] * e1[ 0 ]
+        };
+
+        float v  = ( d[ 0 ] * q[ 0 ] + d[ 1 ] * q[ 1 ] + d[ 2 ] * q[ 2 ] ) * det_inv;
+        float tt = ( e2[ 0 ] * q[ 0 ] + e2[ 1 ] * q[ 1 ] + e2[ 2 ] * q[ 2 ] ) * det_inv;
+
+        if ( u >= -tolerance && v >= -tolerance && u + v <= 1.0f + tolerance
+          && tt >= 0.0f && tt < *t )
+        {
+            t_lane[ i ] = tt;
+            mask |= 1 << i;
+        }
+    }
+
+    if ( mask == 0 ) return false;
+#   endif
+
+    for ( unsigned int i = 0; i < 4; i++ )
+    {
+        if ( ( mask & ( 1 << i ) ) && t_lane[ i ] < *t )
+        {
+            *t = t_lane[ i ];
+            *lane = i;
+        }
+    }
+
+    return true;
+}
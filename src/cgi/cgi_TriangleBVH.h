@@ -0,0 +1,187 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_TRIANGLEBVH_H
+#define CGI_TRIANGLEBVH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Triangles bounding volume hierarchy class.
+ *
+ * Triangles are inserted in double precision (e.g. WGS coordinates) and are
+ * stored in single precision relative to the bounding box center, which keeps
+ * centimeter accuracy for scenery of a few hundred kilometers. Tree is built
+ * with binned surface area heuristic. Leaf triangles are packed four at
+ * a time in structure of arrays blocks, so ray-triangle tests are done for
+ * four triangles at once with SSE instructions when available.
+ *
+ * Tree is not modified by queries, so it can be queried by any number of
+ * threads at the same time once built.
+ */
+class TriangleBVH
+{
+public:
+
+    /** Ray given as a line segment. */
+    struct Ray
+    {
+        double b[ 3 ];      ///< segment beginning coordinates
+        double e[ 3 ];      ///< segment ending coordinates
+    };
+
+    /** Ray-triangle intersection. */
+    struct Hit
+    {
+        bool   valid;       ///< specifies if intersection was found
+        double t;           ///< [-] segment parameter, 0 at the beginning and 1 at the end
+        double r[ 3 ];      ///< intersection coordinates
+        double n[ 3 ];      ///< triangle unit normal (right handed vertices order)
+    };
+
+    /**
+     * @brief Constructor.
+     * @param leafSize maximum number of triangles in a leaf node
+     */
+    TriangleBVH( unsigned int leafSize = 8 );
+
+    /** @brief Destructor. */
+    virtual ~TriangleBVH();
+
+    /** @brief Removes all triangles. */
+    void clear();
+
+    /**
+     * @brief Inserts triangle. Tree has to be rebuilt afterwards.
+     * @param v0 first vertex coordinates
+     * @param v1 second vertex coordinates
+     * @param v2 third vertex coordinates
+     */
+    void insert( const double v0[], const double v1[], const double v2[] );
+
+    /**
+     * @brief Builds tree. Inserted triangles are released.
+     */
+    void build();
+
+    /**
+     * @brief Finds the first intersection along the segment.
+     * @param b segment beginning coordinates
+     * @param e segment ending coordinates
+     * @param hit output intersection
+     * @return true if intersection was found, false otherwise
+     */
+    bool intersect( const double b[], const double e[], Hit *hit ) const;
+
+    /**
+     * @brief Finds the first intersections along the segments.
+     * @param rays segments
+     * @param hits output intersections
+     * @param count number of segments
+     * @return number of intersections found
+     */
+    unsigned int intersect( const Ray rays[], Hit hits[], unsigned int count ) const;
+
+    /**
+     * @brief Returns number of triangles in the built tree.
+     * @return number of triangles
+     */
+    inline unsigned int getCount() const { return _count; }
+
+    /**
+     * @brief Returns number of triangles inserted since the last build.
+     * @return number of triangles
+     */
+    inline unsigned int getCountInserted() const { return (unsigned int)( _vertices.size() / 9 ); }
+
+    /**
+     * @brief Returns tree bounding box.
+     * @param min box minimum coordinates
+     * @param max box maximum coordinates
+     * @return false if tree is empty, true otherwise
+     */
+    bool getBounds( double min[], double max[] ) const;
+
+private:
+
+    /** Tree node. */
+    struct Node
+    {
+        float min[ 3 ];         ///< bounding box minimum coordinates
+        float max[ 3 ];         ///< bounding box maximum coordinates
+        unsigned int index;     ///< first child index (inner node) or first block index (leaf)
+        unsigned int count;     ///< number of blocks, 0 for inner nodes
+    };
+
+    /** Four triangles in structure of arrays layout. */
+    struct Block
+    {
+        float v0[ 3 ][ 4 ];     ///< first vertices
+        float e1[ 3 ][ 4 ];     ///< first edges (v1-v0)
+        float e2[ 3 ][ 4 ];     ///< second edges (v2-v0)
+    };
+
+    /** Triangle reference used while building. */
+    struct Ref
+    {
+        float min[ 3 ];         ///< bounding box minimum coordinates
+        float max[ 3 ];         ///< bounding box maximum coordinates
+        float c[ 3 ];           ///< centroid coordinates
+        unsigned int index;     ///< triangle index
+    };
+
+    typedef std::vector< Ref > Refs;
+
+    static const unsigned int _maxDepth;    ///< maximum tree depth
+    static const unsigned int _bins;        ///< number of surface area heuristic bins
+
+    const unsigned int _leafSize;           ///< maximum number of triangles in a leaf node
+
+    std::vector< double > _vertices;        ///< inserted triangles vertices
+    std::vector< Node   > _nodes;           ///< tree nodes, root first
+    std::vector< Block  > _blocks;          ///< leaves triangles
+
+    double _origin[ 3 ];                    ///< local coordinates origin
+
+    unsigned int _count;                    ///< number of triangles
+
+    void split( unsigned int node, Refs &refs, unsigned int begin, unsigned int end,
+                const std::vector< float > &local, unsigned int depth );
+
+    void createLeaf( unsigned int node, const Refs &refs, unsigned int begin, unsigned int end,
+                     const std::vector< float > &local );
+
+    bool intersect( const Block &block, const float o[], const float d[],
+                    float *t, unsigned int *lane ) const;
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_TRIANGLEBVH_H
@@ -45,24 +45,36 @@ using namespace cgi;
 ////////////////////////////////////////////////////////////////////////////////
 
 Icons::Icons( const Module *parent ) :
-    Module( parent )
+    Module( parent ),
+
+    _aerodromes    ( NULLPTR ),
+    _navaidsVOR    ( NULLPTR ),
+    _navaidsVORTAC ( NULLPTR ),
+    _navaidsVORDME ( NULLPTR ),
+    _localizers    ( NULLPTR ),
+    _runways       ( NULLPTR ),
+
+    _scale  ( 1.0 ),
+    _left   ( -Mercator::_max_x ),
+    _right  (  Mercator::_max_x ),
+    _bottom ( -Mercator::_max_y ),
+    _top    (  Mercator::_max_y ),
+
+    _dirty ( true )
 {
-    _symbolAerodrome    = Models::get( "map/icons/aerodrome.stl" );
-    _symbolNavaidVOR    = Models::get( "map/icons/vor.stl" );
-    _symbolNavaidVORTAC = Models::get( "map/icons/vortac.stl" );
-    _symbolNavaidVORDME = Models::get( "map/icons/vor_dme.stl" );
-    _symbolNavaidILSLOC = createSymbolILS();
-
-    osg::ref_ptr<osg::Material> material = new osg::Material();
-
-    material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
-    material->setAmbient( osg::Material::FRONT, osg::Vec4( Map::_colorAeroData, 1.0f ) );
-    material->setDiffuse( osg::Material::FRONT, osg::Vec4( Map::_colorAeroData, 1.0f ) );
-
-    _symbolAerodrome    ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVOR    ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVORTAC ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVORDME ->getOrCreateStateSet()->setAttribute( material.get() );
+    osg::ref_ptr<osg::Node> symbolAerodrome    = Models::get( "map/icons/aerodrome.stl" );
+    osg::ref_ptr<osg::Node> symbolNavaidVOR    = Models::get( "map/icons/vor.stl" );
+    osg::ref_ptr<osg::Node> symbolNavaidVORTAC = Models::get( "map/icons/vortac.stl" );
+    osg::ref_ptr<osg::Node> symbolNavaidVORDME = Models::get( "map/icons/vor_dme.stl" );
+    osg::ref_ptr<osg::Node> symbolNavaidILSLOC = createSymbolILS();
+    osg::ref_ptr<osg::Node> symbolRunway       = createRunway( 1.0, 1.0 );
+
+    _aerodromes    = new Symbols( _root.get(), symbolAerodrome.get()    , Map::_zAerodromes , Map::_colorAeroData , true  );
+    _navaidsVOR    = new Symbols( _root.get(), symbolNavaidVOR.get()    , Map::_zNavaids    , Map::_colorAeroData , true  );
+    _navaidsVORTAC = new Symbols( _root.get(), symbolNavaidVORTAC.get() , Map::_zNavaids    , Map::_colorAeroData , true  );
+    _navaidsVORDME = new Symbols( _root.get(), symbolNavaidVORDME.get() , Map::_zNavaids    , Map::_colorAeroData , true  );
+    _localizers    = new Symbols( _root.get(), symbolNavaidILSLOC.get() , Map::_zNavaids    , Map::_colorAeroData , false );
+    _runways       = new Symbols( _root.get(), symbolRunway.get()       , Map::_zAirports   , Map::_colorAirports , false );
 
     createOwnship();
 
@@ -76,13 +88,26 @@ Icons::Icons( const Module *parent ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Icons::~Icons() {}
+Icons::~Icons()
+{
+    DELPTR( _aerodromes    );
+    DELPTR( _navaidsVOR    );
+    DELPTR( _navaidsVORTAC );
+    DELPTR( _navaidsVORDME );
+    DELPTR( _localizers    );
+    DELPTR( _runways       );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::update()
 {
     updateOwnship();
+
+    if ( _dirty )
+    {
+        updateSymbols();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,18 +115,28 @@ void Icons::update()
 void Icons::setScale( double scale )
 {
     double s = 1.5 * 1.0e6 * scale;
-    osg::Vec3d sv( s, s, 1.0 );
 
-    _ownship.pat->setScale( sv );
+    _ownship.pat->setScale( osg::Vec3d( s, s, 1.0 ) );
 
-    for ( PATs::iterator it = _aerodromes.begin(); it != _aerodromes.end(); ++it )
+    if ( s != _scale )
     {
-        (*it)->setScale( sv );
+        _scale = s;
+        _dirty = true;
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-    for ( PATs::iterator it = _navaids.begin(); it != _navaids.end(); ++it )
+void Icons::setView( double left, double right, double bottom, double top )
+{
+    if ( left != _left || right != _right || bottom != _bottom || top != _top )
     {
-        (*it)->setScale( sv );
+        _left   = left;
+        _right  = right;
+        _bottom = bottom;
+        _top    = top;
+
+        _dirty = true;
     }
 }
 
@@ -228,93 +263,80 @@ osg::Node* Icons::createSymbolILS()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* Icons::getNavaidSymbol( int type )
+Symbols* Icons::getNavaidSymbols( int type )
 {
     switch ( type )
     {
-        case nav::DataBase::NAV::VOR:     return _symbolNavaidVOR.get();
-        case nav::DataBase::NAV::VORTAC:  return _symbolNavaidVORTAC.get();
-//        case nav::DataBase::NAV::TACAN:   return _symbolNavaidTACAN.get();
-        case nav::DataBase::NAV::VOR_DME: return _symbolNavaidVORDME.get();
-//        case nav::DataBase::NAV::NDB:     return _symbolNavaidNDB.get();
-//        case nav::DataBase::NAV::NDB_DME: return _symbolNavaidNDB_DME.get();
-//        case nav::DataBase::NAV::LOCATOR: return _symbolNavaidLOCATOR.get();
-//        case nav::DataBase::NAV::DME:     return _symbolNavaidDME.get();
+        case nav::DataBase::NAV::VOR:     return _navaidsVOR;
+        case nav::DataBase::NAV::VORTAC:  return _navaidsVORTAC;
+//        case nav::DataBase::NAV::TACAN:   return _navaidsTACAN;
+        case nav::DataBase::NAV::VOR_DME: return _navaidsVORDME;
+//        case nav::DataBase::NAV::NDB:     return _navaidsNDB;
+//        case nav::DataBase::NAV::NDB_DME: return _navaidsNDB_DME;
+//        case nav::DataBase::NAV::LOCATOR: return _navaidsLOCATOR;
+//        case nav::DataBase::NAV::DME:     return _navaidsDME;
     }
 
-    return _symbolNavaidVOR.get();;
+    return _navaidsVOR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initAerodromes()
 {
-    nav::DataBase::ListAPT list = nav::DataBase::instance()->getListAPT();
+    const nav::DataBase::ListAPT &list = nav::DataBase::instance()->getListAPT();
 
-    for ( nav::DataBase::ListAPT::iterator it = list.begin(); it != list.end(); ++it )
+    for ( nav::DataBase::ListAPT::const_iterator it = list.begin(); it != list.end(); ++it )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( _symbolAerodrome.get() );
-        pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                       Mercator::y( (*it).lat ),
-                                       Map::_zAerodromes ) );
-        _aerodromes.push_back( pat.get() );
+        _aerodromes->insert( Mercator::x( (*it).lon ), Mercator::y( (*it).lat ) );
     }
+
+    _aerodromes->build();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initLocalizers()
 {
-    nav::DataBase::ListILS listILS = nav::DataBase::instance()->getListILS();
+    const nav::DataBase::ListILS &listILS = nav::DataBase::instance()->getListILS();
 
-    for ( nav::DataBase::ListILS::iterator it = listILS.begin(); it != listILS.end(); ++it )
+    for ( nav::DataBase::ListILS::const_iterator it = listILS.begin(); it != listILS.end(); ++it )
     {
         if ( (*it).type == nav::DataBase::ILS::LOC )
         {
-            osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-            _root->addChild( pat.get() );
-            pat->addChild( _symbolNavaidILSLOC.get() );
-            pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                           Mercator::y( (*it).lat ),
-                                           Map::_zNavaids ) );
-            pat->setAttitude( osg::Quat( -(*it).true_bearing, osg::Z_AXIS ) );
-            _localizers.push_back( pat.get() );
+            _localizers->insert( Mercator::x( (*it).lon ), Mercator::y( (*it).lat ),
+                                 (*it).true_bearing );
         }
     }
+
+    _localizers->build();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initNavaids()
 {
-    nav::DataBase::ListNAV listNAV = nav::DataBase::instance()->getListNAV();
+    const nav::DataBase::ListNAV &listNAV = nav::DataBase::instance()->getListNAV();
 
-    for ( nav::DataBase::ListNAV::iterator it = listNAV.begin(); it != listNAV.end(); ++it )
+    for ( nav::DataBase::ListNAV::const_iterator it = listNAV.begin(); it != listNAV.end(); ++it )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( getNavaidSymbol( (*it).type ) );
-        pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                       Mercator::y( (*it).lat ),
-                                       Map::_zNavaids ) );
-        _navaids.push_back( pat.get() );
+        getNavaidSymbols( (*it).type )->insert( Mercator::x( (*it).lon ),
+                                                Mercator::y( (*it).lat ) );
     }
+
+    _navaidsVOR    ->build();
+    _navaidsVORTAC ->build();
+    _navaidsVORDME ->build();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initRunways()
 {
-    nav::DataBase::ListRWY listRWY = nav::DataBase::instance()->getListRWY();
+    const nav::DataBase::ListRWY &listRWY = nav::DataBase::instance()->getListRWY();
 
-    for ( nav::DataBase::ListRWY::iterator it = listRWY.begin(); it != listRWY.end(); ++it )
+    for ( nav::DataBase::ListRWY::const_iterator it = listRWY.begin(); it != listRWY.end(); ++it )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( createRunway( (*it).length, (*it).width ) );
-
         double he_x = Mercator::x( (*it).he_lon );
         double he_y = Mercator::y( (*it).he_lat );
         double le_x = Mercator::x( (*it).le_lon );
@@ -343,12 +365,25 @@ void Icons::initRunways()
 
         double heading = atan2( v_delta_ned.v(), v_delta_ned.u() );
 
-        pat->setPosition( osg::Vec3d( 0.5 * ( he_x + le_x ),
-                                      0.5 * ( he_y + le_y ),
-                                      Map::_zAirports ) );
-        pat->setAttitude( osg::Quat( -heading, osg::Z_AXIS ) );
-        _runways.push_back( pat.get() );
+        _runways->insert( 0.5 * ( he_x + le_x ), 0.5 * ( he_y + le_y ), heading,
+                          (*it).width, (*it).length );
     }
+
+    _runways->build();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Icons::updateSymbols()
+{
+    _aerodromes    ->update( _left, _right, _bottom, _top, _scale );
+    _navaidsVOR    ->update( _left, _right, _bottom, _top, _scale );
+    _navaidsVORTAC ->update( _left, _right, _bottom, _top, _scale );
+    _navaidsVORDME ->update( _left, _right, _bottom, _top, _scale );
+    _localizers    ->update( _left, _right, _bottom, _top, _scale );
+    _runways       ->update( _left, _right, _bottom, _top, _scale );
+
+    _dirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,12 +28,19 @@
 
 #include <cgi/cgi_Module.h>
 
+#include <cgi/map/cgi_Symbols.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace cgi
 {
 
-/** Icons class. */
+/**
+ * @brief Icons class.
+ *
+ * Aerodromes, navaids, localizers and runways are drawn as instanced
+ * symbols, one drawable per symbol type, see Symbols.
+ */
 class Icons : public Module
 {
 public:
@@ -44,8 +51,6 @@ public:
         osg::ref_ptr<osg::Group> speedLeader;
     };
 
-    typedef std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > PATs;
-
     /** @brief Constructor. */
     Icons( const Module *parent = NULLPTR );
 
@@ -58,20 +63,34 @@ public:
     /** */
     void setScale( double scale );
 
+    /**
+     * @brief Sets current map view.
+     * @param left   [m] view left edge Mercator x-coordinate
+     * @param right  [m] view right edge Mercator x-coordinate
+     * @param bottom [m] view bottom edge Mercator y-coordinate
+     * @param top    [m] view top edge Mercator y-coordinate
+     */
+    void setView( double left, double right, double bottom, double top );
+
 private:
 
     Ownship _ownship;
 
-    PATs _aerodromes;
-    PATs _navaids;
-    PATs _localizers;
-    PATs _runways;
+    Symbols *_aerodromes;           ///< aerodromes symbols
+    Symbols *_navaidsVOR;           ///< VOR symbols
+    Symbols *_navaidsVORTAC;        ///< VORTAC symbols
+    Symbols *_navaidsVORDME;        ///< VOR-DME symbols
+    Symbols *_localizers;           ///< localizers symbols
+    Symbols *_runways;              ///< runways symbols
+
+    double _scale;                  ///< symbols scale
+
+    double _left;                   ///< [m] view left edge Mercator x-coordinate
+    double _right;                  ///< [m] view right edge Mercator x-coordinate
+    double _bottom;                 ///< [m] view bottom edge Mercator y-coordinate
+    double _top;                    ///< [m] view top edge Mercator y-coordinate
 
-    osg::ref_ptr<osg::Node> _symbolAerodrome;
-    osg::ref_ptr<osg::Node> _symbolNavaidVOR;
-    osg::ref_ptr<osg::Node> _symbolNavaidVORTAC;
-    osg::ref_ptr<osg::Node> _symbolNavaidVORDME;
-    osg::ref_ptr<osg::Node> _symbolNavaidILSLOC;
+    bool _dirty;                    ///< specifies if visible symbols have to be updated
 
     void createIcon( osg::Group *parent, float z, const char *textureFile );
 
@@ -80,7 +99,7 @@ private:
     osg::Node* createRunway( double length, double width );
     osg::Node* createSymbolILS();
 
-    osg::Node* getNavaidSymbol( int type );
+    Symbols* getNavaidSymbols( int type );
 
     void initAerodromes();
     void initLocalizers();
@@ -88,6 +107,7 @@ private:
     void initRunways();
 
     void updateOwnship();
+    void updateSymbols();
 };
 
 } // end of cgi namespace
@@ -0,0 +1,460 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/map/cgi_ImageryBuilder.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/MatrixTransform>
+#include <osg/PagedLOD>
+#include <osg/Texture2D>
+
+#include <osgDB/FileNameUtils>
+#include <osgDB/FileUtils>
+#include <osgDB/WriteFile>
+
+#include <cgi/cgi_Defines.h>
+#include <cgi/cgi_Geometry.h>
+#include <cgi/cgi_Mercator.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char ImageryBuilder::_rootFile[] = "imagery.osgb";
+
+////////////////////////////////////////////////////////////////////////////////
+
+ImageryBuilder::ImageryBuilder( int tileSize, int maxLevel ) :
+    _tileSize ( tileSize > 2 ? 2 * ( tileSize / 2 ) : 2 ),
+    _maxLevel ( maxLevel ),
+    _tiles ( 0 ),
+    _success ( true )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ImageryBuilder::~ImageryBuilder()
+{
+    closeSources();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImageryBuilder::build( const std::vector< std::string > &files, const char *outputDir )
+{
+    // images should be in World Mercator WGS-84 (EPSG:3395) projection
+    char proj4_merc[] = { "+proj=merc +lon_0=0 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +no_defs" };
+
+    closeSources();
+
+    double res_min = DBL_MAX;
+
+    for ( std::vector< std::string >::const_iterator it = files.begin(); it != files.end(); ++it )
+    {
+        GeoTIFF *image = new GeoTIFF( it->c_str() );
+
+        if ( !image->isOpen() )
+        {
+            Log::e() << "Cannot open dataset: " << (*it) << std::endl;
+            DELPTR( image );
+            continue;
+        }
+
+        if ( !image->compareSRS_PROJ4( proj4_merc ) )
+        {
+            Log::e() << "File: " << (*it) << " projection is not EPSG:3395" << std::endl;
+            image->close();
+            DELPTR( image );
+            continue;
+        }
+
+        // only north-up images are supported
+        if ( image->getMapX( 0.0, 1.0 ) != image->getMapX( 0.0, 0.0 )
+          || image->getMapY( 1.0, 0.0 ) != image->getMapY( 0.0, 0.0 ) )
+        {
+            Log::e() << "File: " << (*it) << " is rotated" << std::endl;
+            image->close();
+            DELPTR( image );
+            continue;
+        }
+
+        Source source;
+
+        source.image = image;
+        source.x_min = image->getMapUpperLeftX();
+        source.x_max = image->getMapUpperLeftX() + image->getMapW();
+        source.y_max = image->getMapUpperLeftY();
+        source.y_min = image->getMapUpperLeftY() + image->getMapH();
+        source.res   = image->getMapW() / image->getRasterW();
+
+        res_min = std::min( res_min, source.res );
+
+        _sources.push_back( source );
+    }
+
+    if ( _sources.empty() ) return false;
+
+    if ( _maxLevel < 0 )
+    {
+        // deepest level tiles are not coarser than the finest source image
+        _maxLevel = 0;
+
+        while ( 2.0 * Mercator::_max_x / ( (double)_tileSize * ( 1 << _maxLevel ) ) > res_min
+             && _maxLevel < 24 )
+        {
+            _maxLevel++;
+        }
+    }
+
+    _outputDir = outputDir;
+
+    if ( !osgDB::makeDirectory( _outputDir ) )
+    {
+        closeSources();
+        return false;
+    }
+
+    _options = new osgDB::Options( "WriteImageHint=IncludeData Compressor=zlib" );
+
+    _tiles = 0;
+    _success = true;
+
+    osg::ref_ptr<osg::Image> image;
+    osg::ref_ptr<osg::Node> root = createTile( 0, 0, 0, image );
+
+    if ( root.valid() )
+    {
+        _success = _success && osgDB::writeNodeFile( *root, osgDB::concatPaths( _outputDir, _rootFile ), _options.get() );
+    }
+
+    closeSources();
+
+    return root.valid() && _success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ImageryBuilder::closeSources()
+{
+    for ( Sources::iterator it = _sources.begin(); it != _sources.end(); ++it )
+    {
+        it->image->close();
+        DELPTR( it->image );
+    }
+
+    _sources.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* ImageryBuilder::createTile( int level, int x, int y, osg::ref_ptr<osg::Image> &image )
+{
+    if ( level == _maxLevel )
+    {
+        image = readSources( level, x, y );
+        _tiles++;
+
+        return createGeometry( level, x, y, image.get() );
+    }
+
+    image = new osg::Image();
+    image->allocateImage( _tileSize, _tileSize, 1, GL_RGBA, GL_UNSIGNED_BYTE );
+    memset( image->data(), 0, image->getTotalSizeInBytes() );
+
+    // children are written depth first, so only a single branch is kept in memory
+    osg::ref_ptr<osg::Group> children = new osg::Group();
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        int c_x = 2 * x + i % 2;
+        int c_y = 2 * y + i / 2;
+
+        if ( isCovered( level + 1, c_x, c_y ) )
+        {
+            osg::ref_ptr<osg::Image> childImage;
+            osg::ref_ptr<osg::Node> child = createTile( level + 1, c_x, c_y, childImage );
+            children->addChild( child.get() );
+
+            downsample( image.get(), childImage.get(), i );
+        }
+    }
+
+    std::string file = getFileName( level, x, y );
+    std::string path = osgDB::concatPaths( _outputDir, file );
+
+    _success = _success && osgDB::makeDirectoryForFile( path )
+                        && osgDB::writeNodeFile( *children, path, _options.get() );
+
+    osg::ref_ptr<osg::Node> geometry = createGeometry( level, x, y, image.get() );
+    _tiles++;
+
+    const osg::BoundingSphere &bs = geometry->getBound();
+
+    // children are paged in as soon as tile is magnified on screen
+    float range = (float)_tileSize;
+
+    osg::ref_ptr<osg::PagedLOD> plod = new osg::PagedLOD();
+
+    plod->setRangeMode( osg::LOD::PIXEL_SIZE_ON_SCREEN );
+    plod->setCenterMode( osg::LOD::USER_DEFINED_CENTER );
+    plod->setCenter( bs.center() );
+    plod->setRadius( bs.radius() );
+
+    plod->addChild( geometry.get(), 0.0f, range );
+
+    // file names are relative to the file containing the tile,
+    // tiles deeper than root are stored in "{level}/{x}/{y}.osgb" files
+    plod->setFileName( 1, ( level > 0 ? "../../" : "" ) + file );
+    plod->setRange( 1, range, FLT_MAX );
+
+    return plod.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* ImageryBuilder::createGeometry( int level, int x, int y, osg::Image *image )
+{
+    double x_min = 0.0;
+    double x_max = 0.0;
+    double y_min = 0.0;
+    double y_max = 0.0;
+
+    getBounds( level, x, y, &x_min, &x_max, &y_min, &y_max );
+
+    double size = x_max - x_min;
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geode->addDrawable( geometry.get() );
+
+    // vertices relative to the south-west corner to keep single precision accuracy
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+
+    v->push_back( osg::Vec3( 0.0 , 0.0  , 0.0 ) );
+    v->push_back( osg::Vec3( size, 0.0  , 0.0 ) );
+    v->push_back( osg::Vec3( size, size , 0.0 ) );
+    v->push_back( osg::Vec3( 0.0 , size , 0.0 ) );
+
+    Geometry::createQuad( geometry.get(), v.get(), true );
+
+    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D();
+
+    texture->setImage( image );
+    texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+    texture->setWrap( osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE );
+    texture->setWrap( osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE );
+    texture->setUnRefImageDataAfterApply( true );
+
+    geode->getOrCreateStateSet()->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
+
+    osg::ref_ptr<osg::MatrixTransform> transform = new osg::MatrixTransform();
+    transform->setMatrix( osg::Matrixd::translate( x_min, y_min, 0.0 ) );
+    transform->addChild( geode.get() );
+
+    std::stringstream name;
+    name << "L" << level << "_X" << x << "_Y" << y;
+    transform->setName( name.str() );
+
+    return transform.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Image* ImageryBuilder::readSources( int level, int x, int y )
+{
+    const int n = _tileSize;
+
+    double x_min = 0.0;
+    double x_max = 0.0;
+    double y_min = 0.0;
+    double y_max = 0.0;
+
+    getBounds( level, x, y, &x_min, &x_max, &y_min, &y_max );
+
+    double res = ( x_max - x_min ) / n;
+
+    // top line first, as read from sources
+    std::vector< unsigned char > tile( 4 * n * n, 0 );
+    std::vector< unsigned char > part;
+
+    for ( Sources::const_iterator it = _sources.begin(); it != _sources.end(); ++it )
+    {
+        double i_x_min = std::max( x_min, it->x_min );
+        double i_x_max = std::min( x_max, it->x_max );
+        double i_y_min = std::max( y_min, it->y_min );
+        double i_y_max = std::min( y_max, it->y_max );
+
+        if ( i_x_max <= i_x_min || i_y_max <= i_y_min ) continue;
+
+        int c_0 = (int)floor( ( i_x_min - x_min ) / res + 0.5 );
+        int c_1 = (int)floor( ( i_x_max - x_min ) / res + 0.5 );
+        int r_0 = (int)floor( ( y_max - i_y_max ) / res + 0.5 );
+        int r_1 = (int)floor( ( y_max - i_y_min ) / res + 0.5 );
+
+        int w = c_1 - c_0;
+        int h = r_1 - r_0;
+
+        if ( w <= 0 || h <= 0 ) continue;
+
+        part.resize( 4 * w * h );
+
+        bool result = it->image->readImage( ( i_x_min - it->x_min ) / it->res,
+                                            ( it->y_max - i_y_max ) / it->res,
+                                            ( i_x_max - i_x_min ) / it->res,
+                                            ( i_y_max - i_y_min ) / it->res,
+                                            w, h, part.data() );
+
+        if ( !result )
+        {
+            _success = false;
+            continue;
+        }
+
+        for ( int r = 0; r < h; r++ )
+        {
+            for ( int c = 0; c < w; c++ )
+            {
+                const unsigned char *src = &part[ 4 * ( r * w + c ) ];
+
+                if ( src[ 3 ] > 0 )
+                {
+                    memcpy( &tile[ 4 * ( ( r_0 + r ) * n + c_0 + c ) ], src, 4 );
+                }
+            }
+        }
+    }
+
+    osg::ref_ptr<osg::Image> image = new osg::Image();
+    image->allocateImage( n, n, 1, GL_RGBA, GL_UNSIGNED_BYTE );
+
+    // image bottom row is the south edge
+    for ( int r = 0; r < n; r++ )
+    {
+        memcpy( image->data( 0, n - 1 - r ), &tile[ 4 * r * n ], 4 * n );
+    }
+
+    return image.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ImageryBuilder::downsample( osg::Image *image, const osg::Image *child, int index )
+{
+    const int n = _tileSize;
+    const int h = n / 2;
+
+    // children are ordered west to east and north to south
+    int c_0 = ( index % 2 ) * h;
+    int r_0 = ( index / 2 == 0 ) ? h : 0;
+
+    for ( int r = 0; r < h; r++ )
+    {
+        for ( int c = 0; c < h; c++ )
+        {
+            const unsigned char *p[ 4 ] =
+            {
+                child->data( 2 * c     , 2 * r     ),
+                child->data( 2 * c + 1 , 2 * r     ),
+                child->data( 2 * c     , 2 * r + 1 ),
+                child->data( 2 * c + 1 , 2 * r + 1 )
+            };
+
+            unsigned char *dst = image->data( c_0 + c, r_0 + r );
+
+            // alpha weighted average, so transparent pixels do not darken edges
+            int sum_a = p[ 0 ][ 3 ] + p[ 1 ][ 3 ] + p[ 2 ][ 3 ] + p[ 3 ][ 3 ];
+
+            if ( sum_a > 0 )
+            {
+                for ( int k = 0; k < 3; k++ )
+                {
+                    int sum = p[ 0 ][ k ] * p[ 0 ][ 3 ] + p[ 1 ][ k ] * p[ 1 ][ 3 ]
+                            + p[ 2 ][ k ] * p[ 2 ][ 3 ] + p[ 3 ][ k ] * p[ 3 ][ 3 ];
+
+                    dst[ k ] = (unsigned char)( ( sum + sum_a / 2 ) / sum_a );
+                }
+
+                dst[ 3 ] = (unsigned char)( ( sum_a + 2 ) / 4 );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ImageryBuilder::getBounds( int level, int x, int y,
+                                double *x_min, double *x_max,
+                                double *y_min, double *y_max ) const
+{
+    // square world, tiles rows are counted from the north edge
+    double size = 2.0 * Mercator::_max_x / (double)( 1 << level );
+
+    *x_min = -Mercator::_max_x + x * size;
+    *x_max = *x_min + size;
+    *y_max =  Mercator::_max_x - y * size;
+    *y_min = *y_max - size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string ImageryBuilder::getFileName( int level, int x, int y ) const
+{
+    std::stringstream ss;
+    ss << level << "/" << x << "/" << y << ".osgb";
+    return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImageryBuilder::isCovered( int level, int x, int y ) const
+{
+    double x_min = 0.0;
+    double x_max = 0.0;
+    double y_min = 0.0;
+    double y_max = 0.0;
+
+    getBounds( level, x, y, &x_min, &x_max, &y_min, &y_max );
+
+    for ( Sources::const_iterator it = _sources.begin(); it != _sources.end(); ++it )
+    {
+        if ( it->x_min < x_max && it->x_max > x_min
+          && it->y_min < y_max && it->y_max > y_min )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
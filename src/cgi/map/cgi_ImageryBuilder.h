@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_IMAGERYBUILDER_H
+#define CGI_IMAGERYBUILDER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <osg/Image>
+#include <osg/Node>
+
+#include <osgDB/Options>
+
+#include <cgi/cgi_GeoTIFF.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Paged satellite imagery pyramid builder class.
+ *
+ * Builds quadtree of osg::PagedLOD map tiles from GeoTIFF images in World
+ * Mercator WGS-84 (EPSG:3395) projection. Level 0 tile covers the whole
+ * square Mercator world and every level halves tile edge. The deepest level
+ * matches the finest source image resolution and is resampled from source
+ * images, every level above is averaged from the four tiles below, so
+ * building keeps only a single quadtree branch in memory.
+ *
+ * Tiles are switched by their size in pixels on screen, so only tiles
+ * matching map scale and viewport are paged in.
+ *
+ * Output directory contains the root tile file "imagery.osgb" and the
+ * "{level}/{x}/{y}.osgb" files, each with the four children of the given
+ * tile. Tile images are embedded in the tile files.
+ */
+class ImageryBuilder
+{
+public:
+
+    static const char _rootFile[];  ///< root tile file name
+
+    /**
+     * @brief Constructor.
+     * @param tileSize [px] tile image size
+     * @param maxLevel deepest level, if negative it is computed from source images resolution
+     */
+    ImageryBuilder( int tileSize = 256, int maxLevel = -1 );
+
+    /** @brief Destructor. */
+    virtual ~ImageryBuilder();
+
+    /**
+     * @brief Builds tiles.
+     * @param files source GeoTIFF files paths
+     * @param outputDir output directory path
+     * @return true on success, false on failure
+     */
+    bool build( const std::vector< std::string > &files, const char *outputDir );
+
+    inline int getLevels() const { return _maxLevel + 1; }
+    inline int getTiles()  const { return _tiles; }
+
+private:
+
+    /** Source image. */
+    struct Source
+    {
+        GeoTIFF *image;             ///< GeoTIFF image
+        double x_min;               ///< [m] west edge Mercator x-coordinate
+        double x_max;               ///< [m] east edge Mercator x-coordinate
+        double y_min;               ///< [m] south edge Mercator y-coordinate
+        double y_max;               ///< [m] north edge Mercator y-coordinate
+        double res;                 ///< [m/px] resolution
+    };
+
+    typedef std::vector< Source > Sources;
+
+    Sources _sources;               ///< source images
+
+    std::string _outputDir;         ///< output directory path
+
+    osg::ref_ptr<osgDB::Options> _options;  ///< tile files writing options
+
+    const int _tileSize;            ///< [px] tile image size
+
+    int _maxLevel;                  ///< deepest level
+    int _tiles;                     ///< number of tiles written
+
+    bool _success;                  ///< specifies if all files were written
+
+    void closeSources();
+
+    osg::Node* createTile( int level, int x, int y, osg::ref_ptr<osg::Image> &image );
+    osg::Node* createGeometry( int level, int x, int y, osg::Image *image );
+
+    osg::Image* readSources( int level, int x, int y );
+
+    void downsample( osg::Image *image, const osg::Image *child, int index );
+
+    void getBounds( int level, int x, int y,
+                    double *x_min, double *x_max,
+                    double *y_min, double *y_max ) const;
+
+    std::string getFileName( int level, int x, int y ) const;
+
+    bool isCovered( int level, int x, int y ) const;
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_IMAGERYBUILDER_H
@@ -28,6 +28,9 @@
 #include <osg/PositionAttitudeTransform>
 #include <osg/Material>
 
+#include <osgDB/DatabasePager>
+#include <osgDB/ReadFile>
+
 #include <cgi/cgi_Geometry.h>
 #include <cgi/cgi_GeoTIFF.h>
 #include <cgi/cgi_Mercator.h>
@@ -377,6 +380,24 @@ void Layers::readLayerSatellite( const fdm::XmlNode &node, osg::Group *parent )
 
         fileNode = fileNode.getNextSiblingElement( "file" );
     }
+
+    // paged imagery pyramids built with imagery_compiler
+    fdm::XmlNode tilesNode = node.getFirstChildElement( "tiles" );
+
+    while ( tilesNode.isValid() )
+    {
+        fdm::XmlNode tilesTextNode = tilesNode.getFirstChild();
+
+        if ( tilesTextNode.isValid() && tilesTextNode.isText() )
+        {
+            int maxTiles = fdm::String::toInt( tilesNode.getAttribute( "max-tiles" ), 0 );
+
+            readSatelliteTiles( parent, tilesTextNode.getText().c_str(),
+                                maxTiles > 0 ? maxTiles : 0 );
+        }
+
+        tilesNode = tilesNode.getNextSiblingElement( "tiles" );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -447,3 +468,66 @@ void Layers::readSatelliteImage( osg::Group *parent, const char *file )
         Log::e() << "Cannot open dataset: " << file << std::endl;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Layers::readSatelliteTiles( osg::Group *parent, const char *file, unsigned int maxTiles )
+{
+    // paged tiles are not cached, database pager owns them
+    osg::ref_ptr<osg::Node> tiles = osgDB::readNodeFile( Path::get( file ) );
+
+    if ( tiles.valid() )
+    {
+        parent->addChild( tiles.get() );
+
+        osg::ref_ptr<osg::StateSet> stateSet = tiles->getOrCreateStateSet();
+
+        stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
+        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+
+        // material
+        osg::ref_ptr<osg::Material> material = new osg::Material();
+
+        material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
+        material->setAmbient( osg::Material::FRONT, osg::Vec4( 1.0f, 1.0f, 1.0f, 1.0f ) );
+        material->setDiffuse( osg::Material::FRONT, osg::Vec4( 1.0f, 1.0f, 1.0f, 1.0f ) );
+
+        stateSet->setAttribute( material.get() );
+
+        // least recently used tiles are expired above the limit
+        tiles->setCullCallback( new PagingCallback( maxTiles ) );
+    }
+    else
+    {
+        Log::e() << "Cannot open file: " << Path::get( file ) << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Layers::PagingCallback::PagingCallback( unsigned int maxTiles ) :
+    _maxTiles ( maxTiles ),
+    _inited ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Layers::PagingCallback::operator()( osg::Node *node, osg::NodeVisitor *nv )
+{
+    if ( !_inited )
+    {
+        osgDB::DatabasePager *pager = dynamic_cast< osgDB::DatabasePager* >( nv->getDatabaseRequestHandler() );
+
+        if ( pager )
+        {
+            if ( _maxTiles > 0 )
+            {
+                pager->setTargetMaximumNumberOfPageLOD( _maxTiles );
+            }
+
+            _inited = true;
+        }
+    }
+
+    traverse( node, nv );
+}
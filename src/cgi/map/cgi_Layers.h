@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <osg/PositionAttitudeTransform>
+#include <osg/NodeCallback>
 #include <osg/Switch>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -60,6 +61,21 @@ public:
 
 private:
 
+    /** Database pager setup callback. */
+    class PagingCallback : public osg::NodeCallback
+    {
+    public:
+
+        PagingCallback( unsigned int maxTiles );
+
+        virtual void operator()( osg::Node *node, osg::NodeVisitor *nv );
+
+    private:
+
+        unsigned int _maxTiles;         ///< maximum number of resident paged tiles
+        bool _inited;                   ///< specifies if database pager is set up
+    };
+
     osg::ref_ptr<osg::Switch> _switchCrops;
     osg::ref_ptr<osg::Switch> _switchGrassland;
     osg::ref_ptr<osg::Switch> _switchWoodland;
@@ -96,6 +112,7 @@ private:
     void readLayerSatellite( const fdm::XmlNode &node, osg::Group *parent );
 
     void readSatelliteImage( osg::Group *parent, const char *file );
+    void readSatelliteTiles( osg::Group *parent, const char *file, unsigned int maxTiles );
 };
 
 } // end of cgi namespace
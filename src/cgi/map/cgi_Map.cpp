@@ -181,6 +181,13 @@ void Map::setScale( double scale )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Map::setView( double left, double right, double bottom, double top )
+{
+    _icons->setView( left, right, bottom, top );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Map::setVisibilityCrops( bool visible )
 {
     _layers->setVisibilityCrops( visible );
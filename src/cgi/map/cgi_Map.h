@@ -90,6 +90,15 @@ public:
     /** */
     void setScale( double scale );
 
+    /**
+     * @brief Sets current map view.
+     * @param left   [m] view left edge Mercator x-coordinate
+     * @param right  [m] view right edge Mercator x-coordinate
+     * @param bottom [m] view bottom edge Mercator y-coordinate
+     * @param top    [m] view top edge Mercator y-coordinate
+     */
+    void setView( double left, double right, double bottom, double top );
+
     void setVisibilityCrops     ( bool visible );
     void setVisibilityGrassland ( bool visible );
     void setVisibilityWoodland  ( bool visible );
@@ -0,0 +1,255 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/map/cgi_QuadTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+QuadTree::QuadTree( unsigned int leafSize, unsigned int maxDepth ) :
+    _leafSize ( leafSize > 0 ? leafSize : 1 ),
+    _maxDepth ( maxDepth )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QuadTree::~QuadTree() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::clear()
+{
+    _points.clear();
+    _nodes.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::insert( unsigned int item, double x, double y )
+{
+    Point point;
+
+    point.x = x;
+    point.y = y;
+    point.item = item;
+
+    _points.push_back( point );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::build()
+{
+    _nodes.clear();
+
+    if ( _points.size() > 0 )
+    {
+        Node root;
+
+        root.min_x = root.max_x = _points[ 0 ].x;
+        root.min_y = root.max_y = _points[ 0 ].y;
+
+        for ( Points::const_iterator it = _points.begin(); it != _points.end(); ++it )
+        {
+            root.min_x = std::min( root.min_x, (*it).x );
+            root.min_y = std::min( root.min_y, (*it).y );
+            root.max_x = std::max( root.max_x, (*it).x );
+            root.max_y = std::max( root.max_y, (*it).y );
+        }
+
+        root.first = 0;
+        root.count = (unsigned int)_points.size();
+
+        _nodes.push_back( root );
+
+        buildNode( 0, 0 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::find( Items *items, double min_x, double min_y, double max_x, double max_y,
+                     double spacing ) const
+{
+    items->clear();
+
+    if ( _nodes.size() > 0 )
+    {
+        // collects points indices first
+        findNode( items, 0, min_x, min_y, max_x, max_y );
+
+        // restores items order, so lower index means higher priority
+        std::sort( items->begin(), items->end(),
+                   [ this ]( unsigned int i1, unsigned int i2 )
+                   {
+                       return _points[ i1 ].item < _points[ i2 ].item;
+                   } );
+
+        if ( spacing > 0.0 )
+        {
+            declutter( items, spacing );
+        }
+
+        for ( Items::iterator it = items->begin(); it != items->end(); ++it )
+        {
+            (*it) = _points[ (*it) ].item;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::buildNode( unsigned int index, unsigned int depth )
+{
+    Node node = _nodes[ index ];
+
+    node.children[ 0 ] = -1;
+    node.children[ 1 ] = -1;
+    node.children[ 2 ] = -1;
+    node.children[ 3 ] = -1;
+
+    bool leaf = node.count <= _leafSize || depth >= _maxDepth
+             || ( node.max_x - node.min_x <= 0.0 && node.max_y - node.min_y <= 0.0 );
+
+    if ( !leaf )
+    {
+        double mid_x = 0.5 * ( node.min_x + node.max_x );
+        double mid_y = 0.5 * ( node.min_y + node.max_y );
+
+        Points::iterator b = _points.begin() + node.first;
+        Points::iterator e = b + node.count;
+
+        // partitions points into quadrants: SW, SE, NW, NE
+        Points::iterator m_y = std::partition( b, e, [ mid_y ]( const Point &p ) { return p.y < mid_y; } );
+        Points::iterator m_s = std::partition( b, m_y, [ mid_x ]( const Point &p ) { return p.x < mid_x; } );
+        Points::iterator m_n = std::partition( m_y, e, [ mid_x ]( const Point &p ) { return p.x < mid_x; } );
+
+        Points::iterator bounds[ 5 ] = { b, m_s, m_y, m_n, e };
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            unsigned int count = (unsigned int)( bounds[ i + 1 ] - bounds[ i ] );
+
+            if ( count > 0 )
+            {
+                Node child;
+
+                child.min_x = ( i % 2 == 0 ) ? node.min_x : mid_x;
+                child.max_x = ( i % 2 == 0 ) ? mid_x : node.max_x;
+                child.min_y = ( i / 2 == 0 ) ? node.min_y : mid_y;
+                child.max_y = ( i / 2 == 0 ) ? mid_y : node.max_y;
+
+                child.first = (unsigned int)( bounds[ i ] - _points.begin() );
+                child.count = count;
+
+                node.children[ i ] = (int)_nodes.size();
+                _nodes.push_back( child );
+            }
+        }
+    }
+
+    // _nodes might have been reallocated
+    _nodes[ index ] = node;
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        if ( node.children[ i ] >= 0 )
+        {
+            buildNode( node.children[ i ], depth + 1 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::findNode( Items *items, unsigned int index,
+                         double min_x, double min_y, double max_x, double max_y ) const
+{
+    const Node &node = _nodes[ index ];
+
+    if ( node.max_x < min_x || node.min_x > max_x
+      || node.max_y < min_y || node.min_y > max_y )
+    {
+        return;
+    }
+
+    bool inside = min_x <= node.min_x && node.max_x <= max_x
+               && min_y <= node.min_y && node.max_y <= max_y;
+
+    bool leaf = node.children[ 0 ] < 0 && node.children[ 1 ] < 0
+             && node.children[ 2 ] < 0 && node.children[ 3 ] < 0;
+
+    if ( inside || leaf )
+    {
+        for ( unsigned int i = node.first; i < node.first + node.count; i++ )
+        {
+            const Point &p = _points[ i ];
+
+            if ( inside || ( min_x <= p.x && p.x <= max_x && min_y <= p.y && p.y <= max_y ) )
+            {
+                items->push_back( i );
+            }
+        }
+    }
+    else
+    {
+        for ( int i = 0; i < 4; i++ )
+        {
+            if ( node.children[ i ] >= 0 )
+            {
+                findNode( items, node.children[ i ], min_x, min_y, max_x, max_y );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void QuadTree::declutter( Items *items, double spacing ) const
+{
+    std::unordered_set< long long > cells;
+
+    Items::iterator out = items->begin();
+
+    for ( Items::const_iterator it = items->begin(); it != items->end(); ++it )
+    {
+        const Point &p = _points[ (*it) ];
+
+        long long col = (long long)floor( p.x / spacing );
+        long long row = (long long)floor( p.y / spacing );
+
+        if ( cells.insert( ( col << 32 ) ^ ( row & 0xffffffffLL ) ).second )
+        {
+            (*out) = (*it);
+            ++out;
+        }
+    }
+
+    items->erase( out, items->end() );
+}
@@ -0,0 +1,133 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_QUADTREE_H
+#define CGI_QUADTREE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Point quadtree class.
+ *
+ * Items are 2D points (e.g. map symbols Mercator coordinates). Points are
+ * stored in a single array sorted so that every tree node covers
+ * a contiguous range of it, which makes nodes fully inside the queried
+ * rectangle cheap to collect.
+ *
+ * Query can optionally declutter results. Decluttering keeps only the first
+ * item (the one with the lowest index) in every cell of a fixed world
+ * aligned grid, so the selection does not change while panning.
+ */
+class QuadTree
+{
+public:
+
+    typedef std::vector< unsigned int > Items;
+
+    /**
+     * @brief Constructor.
+     * @param leafSize maximum number of points in a leaf node
+     * @param maxDepth maximum tree depth
+     */
+    QuadTree( unsigned int leafSize = 16, unsigned int maxDepth = 16 );
+
+    /** @brief Destructor. */
+    virtual ~QuadTree();
+
+    /** @brief Removes all items. */
+    void clear();
+
+    /**
+     * @brief Inserts item. Tree has to be rebuilt afterwards.
+     * @param item item index
+     * @param x point x-coordinate
+     * @param y point y-coordinate
+     */
+    void insert( unsigned int item, double x, double y );
+
+    /** @brief Builds tree. */
+    void build();
+
+    /**
+     * @brief Finds items within the given rectangle.
+     * @param items output items sorted in ascending order
+     * @param min_x rectangle minimum x-coordinate
+     * @param min_y rectangle minimum y-coordinate
+     * @param max_x rectangle maximum x-coordinate
+     * @param max_y rectangle maximum y-coordinate
+     * @param spacing declutter grid cell size, no decluttering if not positive
+     */
+    void find( Items *items, double min_x, double min_y, double max_x, double max_y,
+               double spacing = 0.0 ) const;
+
+    inline unsigned int getCount() const { return (unsigned int)_points.size(); }
+
+private:
+
+    /** Point data. */
+    struct Point
+    {
+        double x;                   ///< x-coordinate
+        double y;                   ///< y-coordinate
+        unsigned int item;          ///< item index
+    };
+
+    /** Tree node data. */
+    struct Node
+    {
+        double min_x;               ///< node bounds minimum x-coordinate
+        double min_y;               ///< node bounds minimum y-coordinate
+        double max_x;               ///< node bounds maximum x-coordinate
+        double max_y;               ///< node bounds maximum y-coordinate
+        unsigned int first;         ///< first point index
+        unsigned int count;         ///< number of points
+        int children[ 4 ];          ///< children nodes indices, -1 if leaf
+    };
+
+    typedef std::vector< Point > Points;
+    typedef std::vector< Node  > Nodes;
+
+    Points _points;                 ///< points
+    Nodes  _nodes;                  ///< tree nodes, root node is the first one
+
+    unsigned int _leafSize;         ///< maximum number of points in a leaf node
+    unsigned int _maxDepth;         ///< maximum tree depth
+
+    void buildNode( unsigned int index, unsigned int depth );
+
+    void findNode( Items *items, unsigned int index,
+                   double min_x, double min_y, double max_x, double max_y ) const;
+
+    void declutter( Items *items, double spacing ) const;
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_QUADTREE_H
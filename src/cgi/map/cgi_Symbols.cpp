@@ -0,0 +1,346 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/map/cgi_Symbols.h>
+
+#include <algorithm>
+
+#include <osg/GLExtensions>
+#include <osg/Program>
+#include <osg/VertexAttribDivisor>
+
+#include <cgi/cgi_Mercator.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define CGI_SYMBOLS_ATTRIB_POS  6
+#define CGI_SYMBOLS_ATTRIB_SIZE 7
+
+#ifndef GL_CONTEXT_PROFILE_MASK
+#   define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#ifndef GL_CONTEXT_CORE_PROFILE_BIT
+#   define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Finds first geometry within the given node. */
+class FindGeometry : public osg::NodeVisitor
+{
+public:
+
+    FindGeometry() :
+        osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN )
+    {}
+
+    virtual void apply( osg::Geode &geode )
+    {
+        for ( unsigned int i = 0; i < geode.getNumDrawables() && !_geometry.valid(); i++ )
+        {
+            _geometry = geode.getDrawable( i )->asGeometry();
+        }
+
+        if ( !_geometry.valid() ) traverse( geode );
+    }
+
+    virtual void apply( osg::Node &node )
+    {
+        if ( !_geometry.valid() ) traverse( node );
+    }
+
+    osg::ref_ptr<osg::Geometry> _geometry;
+};
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+class Symbols::DrawCallback : public osg::Drawable::DrawCallback
+{
+public:
+
+    DrawCallback() :
+        _checked ( false ),
+        _supported ( false )
+    {}
+
+    virtual void drawImplementation( osg::RenderInfo &renderInfo,
+                                     const osg::Drawable *drawable ) const
+    {
+        if ( !_checked )
+        {
+            osg::State *state = renderInfo.getState();
+            const osg::GLExtensions *ext = state->get< osg::GLExtensions >();
+
+            _checked = true;
+            _supported = ext->isGlslSupported
+                      && ext->glVertexAttribDivisor
+                      && ext->glDrawArraysInstanced
+                      && ext->glDrawElementsInstanced;
+
+            // core profile lacks gl_Vertex and gl_ModelViewProjectionMatrix,
+            // unless OSG substitutes them with its own aliases
+            if ( _supported && ext->glVersion >= 3.2f && !state->getUseVertexAttributeAliasing() )
+            {
+                GLint mask = 0;
+                glGetIntegerv( GL_CONTEXT_PROFILE_MASK, &mask );
+                _supported = ( mask & GL_CONTEXT_CORE_PROFILE_BIT ) == 0;
+            }
+
+            if ( !_supported )
+            {
+                Log::w() << "Instanced map symbols not supported by the OpenGL context" << std::endl;
+            }
+        }
+
+        if ( _supported ) drawable->drawImplementation( renderInfo );
+    }
+
+private:
+
+    mutable bool _checked;          ///< specifies if context has been checked
+    mutable bool _supported;        ///< specifies if context supports instanced symbols
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char Symbols::_frag[] =
+    "uniform vec4 color;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+const char Symbols::_vert[] =
+    "attribute vec3 instPos;\n"
+    "attribute vec2 instSize;\n"
+    "uniform float scale;\n"
+    "uniform float z;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 v = scale * instSize * gl_Vertex.xy;\n"
+    "    float s = sin( instPos.z );\n"
+    "    float c = cos( instPos.z );\n"
+    "    vec2 r = vec2( c * v.x + s * v.y, c * v.y - s * v.x );\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4( instPos.xy + r, z + gl_Vertex.z, 1.0 );\n"
+    "}\n";
+
+////////////////////////////////////////////////////////////////////////////////
+
+Symbols::Symbols( osg::Group *parent, osg::Node *symbol, double z,
+                  const osg::Vec3 &color, bool scaled ) :
+    _radius  ( 0.0 ),
+    _sizeMax ( 0.0 ),
+    _x_min ( 0.0 ),
+    _x_max ( 0.0 ),
+    _y_min ( 0.0 ),
+    _y_max ( 0.0 ),
+    _width ( 0.0 ),
+    _queriedScale ( 0.0 ),
+    _scaled  ( scaled ),
+    _queried ( false )
+{
+    _transform = new osg::MatrixTransform();
+    parent->addChild( _transform.get() );
+
+    _geode = new osg::Geode();
+    _transform->addChild( _geode.get() );
+
+    createGeometry( symbol, z, color );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Symbols::~Symbols() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Symbols::insert( double x, double y, double heading,
+                      double size_x, double size_y )
+{
+    Instance instance;
+
+    instance.x = x;
+    instance.y = y;
+    instance.heading = heading;
+    instance.size_x  = size_x;
+    instance.size_y  = size_y;
+
+    _sizeMax = std::max( _sizeMax, std::max( size_x, size_y ) );
+
+    _quadTree.insert( (unsigned int)_instances.size(), x, y );
+    _instances.push_back( instance );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Symbols::build()
+{
+    _quadTree.build();
+    _queried = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Symbols::update( double left, double right, double bottom, double top, double scale )
+{
+    double s = _scaled ? scale : 1.0;
+
+    // symbols partly within the view have to be drawn as well
+    double margin  = _radius * s * _sizeMax;
+    double spacing = _scaled ? 2.0 * _radius * s : 0.0;
+
+    double w = right - left;
+    double h = top - bottom;
+
+    if ( _queried && s == _queriedScale && w > 0.25 * _width
+      && left   - margin >= _x_min && right + margin <= _x_max
+      && bottom - margin >= _y_min && top   + margin <= _y_max )
+    {
+        // uploaded instances still cover the view
+        return;
+    }
+
+    _x_min = left   - margin - 0.5 * w;
+    _x_max = right  + margin + 0.5 * w;
+    _y_min = bottom - margin - 0.5 * h;
+    _y_max = top    + margin + 0.5 * h;
+
+    _width = w;
+    _queriedScale = s;
+    _queried = true;
+
+    _quadTree.find( &_visible, _x_min, _y_min, _x_max, _y_max, spacing );
+
+    // origin is subtracted in double precision, instances positions relative
+    // to the region center are small enough to be passed as floats
+    double x0 = 0.5 * ( _x_min + _x_max );
+    double y0 = 0.5 * ( _y_min + _y_max );
+
+    _transform->setMatrix( osg::Matrixd::translate( x0, y0, 0.0 ) );
+
+    _instPos  ->clear();
+    _instSize ->clear();
+
+    for ( QuadTree::Items::const_iterator it = _visible.begin(); it != _visible.end(); ++it )
+    {
+        const Instance &instance = _instances[ (*it) ];
+
+        _instPos  ->push_back( osg::Vec3( instance.x - x0, instance.y - y0, instance.heading ) );
+        _instSize ->push_back( osg::Vec2( instance.size_x, instance.size_y ) );
+    }
+
+    _instPos  ->dirty();
+    _instSize ->dirty();
+
+    for ( unsigned int i = 0; i < _geometry->getNumPrimitiveSets(); i++ )
+    {
+        _geometry->getPrimitiveSet( i )->setNumInstances( _visible.size() );
+    }
+
+    _scale->set( (float)s );
+
+    // zero instances count means non-instanced drawing
+    _geode->setNodeMask( _visible.size() > 0 ? 0xffffffff : 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Symbols::createGeometry( osg::Node *symbol, double z, const osg::Vec3 &color )
+{
+    _geometry = new osg::Geometry();
+    _geometry->setDataVariance( osg::Object::DYNAMIC );
+    _geometry->setUseDisplayList( false );
+    _geometry->setUseVertexBufferObjects( true );
+
+    _geometry->setDrawCallback( new DrawCallback() );
+
+    _geode->addDrawable( _geometry.get() );
+
+    FindGeometry findGeometry;
+    symbol->accept( findGeometry );
+
+    osg::ref_ptr<osg::Geometry> mesh = findGeometry._geometry;
+
+    if ( mesh.valid() )
+    {
+        _geometry->setVertexArray( mesh->getVertexArray() );
+
+        for ( unsigned int i = 0; i < mesh->getNumPrimitiveSets(); i++ )
+        {
+            osg::ref_ptr<osg::PrimitiveSet> primitiveSet =
+                    dynamic_cast< osg::PrimitiveSet* >( mesh->getPrimitiveSet( i )->clone( osg::CopyOp::SHALLOW_COPY ) );
+
+            if ( primitiveSet.valid() )
+            {
+                primitiveSet->setNumInstances( 0 );
+                _geometry->addPrimitiveSet( primitiveSet.get() );
+            }
+        }
+
+        osg::BoundingBox bb = mesh->getBoundingBox();
+
+        _radius = 0.5 * std::max( bb.xMax() - bb.xMin(), bb.yMax() - bb.yMin() );
+    }
+
+    _instPos  = new osg::Vec3Array();
+    _instSize = new osg::Vec2Array();
+
+    _geometry->setVertexAttribArray( CGI_SYMBOLS_ATTRIB_POS  , _instPos.get()  , osg::Array::BIND_PER_VERTEX );
+    _geometry->setVertexAttribArray( CGI_SYMBOLS_ATTRIB_SIZE , _instSize.get() , osg::Array::BIND_PER_VERTEX );
+
+    // culling is done by the spatial index, so the whole map seen from
+    // any origin within the map is the bound
+    _geometry->setInitialBound( osg::BoundingBox( -2.0 * Mercator::_max_x, -2.0 * Mercator::_max_y, z - 1.0,
+                                                   2.0 * Mercator::_max_x,  2.0 * Mercator::_max_y, z + 1.0 ) );
+
+    osg::ref_ptr<osg::StateSet> stateSet = _geode->getOrCreateStateSet();
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+    program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+    program->addBindAttribLocation( "instPos"  , CGI_SYMBOLS_ATTRIB_POS  );
+    program->addBindAttribLocation( "instSize" , CGI_SYMBOLS_ATTRIB_SIZE );
+    stateSet->setAttributeAndModes( program.get() );
+
+    stateSet->setAttribute( new osg::VertexAttribDivisor( CGI_SYMBOLS_ATTRIB_POS  , 1 ) );
+    stateSet->setAttribute( new osg::VertexAttribDivisor( CGI_SYMBOLS_ATTRIB_SIZE , 1 ) );
+
+    _scale = new osg::Uniform( "scale", 1.0f );
+
+    stateSet->addUniform( _scale.get() );
+    stateSet->addUniform( new osg::Uniform( "z", (float)z ) );
+    stateSet->addUniform( new osg::Uniform( "color", osg::Vec4( color, 1.0f ) ) );
+
+    _geode->setNodeMask( 0 );
+}
@@ -0,0 +1,160 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_SYMBOLS_H
+#define CGI_SYMBOLS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/MatrixTransform>
+
+#include <cgi/map/cgi_QuadTree.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Instanced map symbols class.
+ *
+ * All symbols of a single type are drawn by a single drawable. Symbol mesh
+ * is drawn instanced, while per instance Mercator position, heading and size
+ * are passed as vertex attributes. Only symbols within the region around
+ * the current view are uploaded, optionally decluttered depending on map
+ * scale. Region extends the view by half of its size on every side and
+ * instances are queried and uploaded again only when the view leaves it,
+ * the view shrinks a lot or the symbols scale changes, so a panned map
+ * does not refill the instances arrays every frame.
+ *
+ * Instances positions are expressed relative to the region center, which
+ * is subtracted in double precision and passed as the transform
+ * translation, so single precision positions stay accurate at any map zoom.
+ *
+ * Drawing requires instanced arrays and, as the shader uses compatibility
+ * profile built-ins, either compatibility profile or OSG vertex attributes
+ * aliasing. This is checked when symbols are first drawn and, if the
+ * OpenGL context does not fulfill these requirements, symbols are not
+ * drawn at all and warning is logged.
+ */
+class Symbols
+{
+public:
+
+    static const char _frag[];      ///< fragment shader
+    static const char _vert[];      ///< vertex shader
+
+    /**
+     * @brief Constructor.
+     * @param parent parent group
+     * @param symbol symbol model, first geometry found is used as a mesh
+     * @param z z-coordinate
+     * @param color symbol color
+     * @param scaled specifies if symbol size depends on map scale
+     */
+    Symbols( osg::Group *parent, osg::Node *symbol, double z,
+             const osg::Vec3 &color, bool scaled );
+
+    /** @brief Destructor. */
+    virtual ~Symbols();
+
+    /**
+     * @brief Adds symbol instance. Call build() when all instances are added.
+     * @param x [m] Mercator x-coordinate
+     * @param y [m] Mercator y-coordinate
+     * @param heading [rad] heading
+     * @param size_x symbol x-axis scale factor
+     * @param size_y symbol y-axis scale factor
+     */
+    void insert( double x, double y, double heading = 0.0,
+                 double size_x = 1.0, double size_y = 1.0 );
+
+    /** @brief Builds spatial index. */
+    void build();
+
+    /**
+     * @brief Updates visible instances.
+     * @param left   [m] view left edge Mercator x-coordinate
+     * @param right  [m] view right edge Mercator x-coordinate
+     * @param bottom [m] view bottom edge Mercator y-coordinate
+     * @param top    [m] view top edge Mercator y-coordinate
+     * @param scale symbols scale
+     */
+    void update( double left, double right, double bottom, double top, double scale );
+
+    inline unsigned int getCount() const { return _quadTree.getCount(); }
+    inline unsigned int getCountVisible() const { return (unsigned int)_visible.size(); }
+
+private:
+
+    /** Instance data. */
+    struct Instance
+    {
+        double x;                   ///< [m] Mercator x-coordinate
+        double y;                   ///< [m] Mercator y-coordinate
+        float heading;              ///< [rad] heading
+        float size_x;               ///< symbol x-axis scale factor
+        float size_y;               ///< symbol y-axis scale factor
+    };
+
+    typedef std::vector< Instance > Instances;
+
+    /** Checks OpenGL context capabilities before drawing. */
+    class DrawCallback;
+
+    osg::ref_ptr<osg::MatrixTransform> _transform; ///< instances origin transform
+
+    osg::ref_ptr<osg::Geode> _geode;            ///< symbols geode
+    osg::ref_ptr<osg::Geometry> _geometry;      ///< instanced symbol geometry
+
+    osg::ref_ptr<osg::Vec3Array> _instPos;      ///< instances relative positions and headings
+    osg::ref_ptr<osg::Vec2Array> _instSize;     ///< instances sizes
+
+    osg::ref_ptr<osg::Uniform> _scale;          ///< symbols scale uniform
+
+    Instances _instances;           ///< all instances
+    QuadTree  _quadTree;            ///< instances spatial index
+
+    QuadTree::Items _visible;       ///< visible instances
+
+    double _radius;                 ///< symbol mesh bounding radius
+    double _sizeMax;                ///< maximum instance scale factor
+
+    double _x_min;                  ///< [m] queried region left edge Mercator x-coordinate
+    double _x_max;                  ///< [m] queried region right edge Mercator x-coordinate
+    double _y_min;                  ///< [m] queried region bottom edge Mercator y-coordinate
+    double _y_max;                  ///< [m] queried region top edge Mercator y-coordinate
+    double _width;                  ///< [m] view width at the time of query
+    double _queriedScale;           ///< symbols scale at the time of query
+
+    bool _scaled;                   ///< specifies if symbol size depends on map scale
+    bool _queried;                  ///< specifies if instances have been queried
+
+    void createGeometry( osg::Node *symbol, double z, const osg::Vec3 &color );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_SYMBOLS_H
@@ -58,6 +58,9 @@ Ownship::Ownship( const Module *parent, Scenery *scenery ) :
     _rotor  ( NULLPTR ),
     _vector ( NULLPTR ),
 
+    _trace_1 ( NULLPTR ),
+    _trace_2 ( NULLPTR ),
+
     _ab_angle ( 0.0 )
 {
     _vector = new Vector();
@@ -78,8 +81,13 @@ Ownship::Ownship( const Module *parent, Scenery *scenery ) :
     _switchRibbons = new osg::Switch();
     _patRibbons->addChild( _switchRibbons.get() );
 
-    _trace_1 = new osg::Vec3Array();
-    _trace_2 = new osg::Vec3Array();
+    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
+    lineWidth->setWidth( 2.0f );
+
+    _switchRibbons->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
+
+    _trace_1 = new Trace( _switchRibbons.get(), Colors::_black );
+    _trace_2 = new Trace( _switchRibbons.get(), Colors::_lime  );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +96,9 @@ Ownship::~Ownship()
 {
     DELPTR( _rotor  );
     DELPTR( _vector );
+
+    DELPTR( _trace_1 );
+    DELPTR( _trace_2 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -592,11 +603,6 @@ void Ownship::reset()
     _patOffset->setPosition( osg::Vec3() );
     _patOffset->setAttitude( osg::Quat() );
 
-    if ( _switchRibbons->getNumChildren() > 0 )
-    {
-        _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-    }
-
     _aileronL  = NULLPTR;
     _aileronR  = NULLPTR;
     _elevatorL = NULLPTR;
@@ -636,8 +642,8 @@ void Ownship::reset()
 
     _rotor_center = osg::Vec3( 0.0, 0.0, 0.0 );
 
-    _trace_1->clear();
-    _trace_2->clear();
+    _trace_1->reset();
+    _trace_2->reset();
 
     _ab_angle = 0.0;
 
@@ -869,20 +875,10 @@ void Ownship::updateAfterburner( double value, osg::Switch *afterburner,
 
 void Ownship::updateTraces()
 {
-    if ( _switchRibbons->getNumChildren() > 0 )
-    {
-        _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-    }
-
     if ( Data::get()->stateOut == fdm::DataOut::Idle )
     {
-        _trace_1->clear();
-        _trace_2->clear();
-
-        if ( _switchRibbons->getNumChildren() > 0 )
-        {
-            _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-        }
+        _trace_1->reset();
+        _trace_2->reset();
     }
     else if ( Data::get()->stateOut == fdm::DataOut::Ready )
     {
@@ -893,12 +889,12 @@ void Ownship::updateTraces()
     {
         if ( _double_trace )
         {
-            _trace_1->push_back( _pos_wgs + _att_wgs * _wing_tip_l - _pos_0_wgs );
-            _trace_2->push_back( _pos_wgs + _att_wgs * _wing_tip_r - _pos_0_wgs );
+            _trace_1->addPoint( _pos_wgs + _att_wgs * _wing_tip_l - _pos_0_wgs );
+            _trace_2->addPoint( _pos_wgs + _att_wgs * _wing_tip_r - _pos_0_wgs );
         }
         else
         {
-            _trace_1->push_back( _pos_wgs - _pos_0_wgs );
+            _trace_1->addPoint( _pos_wgs - _pos_0_wgs );
         }
     }
 
@@ -906,49 +902,10 @@ void Ownship::updateTraces()
     {
         _switchRibbons->setAllChildrenOn();
 
-        if ( _double_trace )
-        {
-            updateTrace( _switchRibbons.get(), _trace_1.get(), Colors::_red  );
-            updateTrace( _switchRibbons.get(), _trace_2.get(), Colors::_lime );
-        }
-        else
-        {
-            updateTrace( _switchRibbons.get(), _trace_1.get(), Colors::_black );
-        }
+        _trace_1->setColor( _double_trace ? Colors::_red : Colors::_black );
     }
     else
     {
         _switchRibbons->setAllChildrenOff();
     }
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Ownship::updateTrace( osg::Group *parent, osg::Vec3Array *positions,
-                           const osg::Vec3 &color )
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-    c->push_back( osg::Vec4( color, 1.0f ) );
-
-    geometry->setVertexArray( positions );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, positions->size() ) );
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
-    lineWidth->setWidth( 2.0f );
-
-    geode->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
-}
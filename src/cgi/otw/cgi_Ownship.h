@@ -31,6 +31,7 @@
 #include <fdm/xml/fdm_XmlNode.h>
 
 #include <cgi/cgi_Module.h>
+#include <cgi/cgi_Trace.h>
 
 #include <cgi/otw/cgi_Rotor.h>
 #include <cgi/otw/cgi_Scenery.h>
@@ -151,8 +152,8 @@ private:
 
     osg::Vec3 _rotor_center;                                    ///< [m] rotor hub center
 
-    osg::ref_ptr<osg::Vec3Array> _trace_1;                      ///<
-    osg::ref_ptr<osg::Vec3Array> _trace_2;                      ///<
+    Trace *_trace_1;                                            ///< left wing tip (or single) trace
+    Trace *_trace_2;                                            ///< right wing tip trace
 
     double _ab_angle;                                           ///< [rad]
 
@@ -182,8 +183,6 @@ private:
                             osg::PositionAttitudeTransform *exhaust );
 
     void updateTraces();
-    void updateTrace( osg::Group *parent, osg::Vec3Array *positions,
-                      const osg::Vec3 &color );
 };
 
 } // end of cgi namespace
@@ -0,0 +1,92 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <osg/Timer>
+
+#include <fdm/fdm_Log.h>
+
+#include <cgi/map/cgi_ImageryBuilder.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options] <output directory> <image file> [<image file> ...]" << std::endl;
+    fdm::Log::out() << "  -s <size>    tile image size in pixels (default: 256)" << std::endl;
+    fdm::Log::out() << "  -l <level>   deepest level (default: computed from images resolution)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This is imagery compiler main function. It builds paged map imagery tiles
+ * from GeoTIFF images in World Mercator (EPSG:3395) projection.
+ */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string dir_out;
+    std::vector< std::string > files;
+
+    int tileSize = 256;
+    int maxLevel = -1;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if      ( 0 == strcmp( argv[ i ], "-s" ) && hasValue ) tileSize = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-l" ) && hasValue ) maxLevel = atoi( argv[ ++i ] );
+        else if ( dir_out.empty() ) dir_out = argv[ i ];
+        else files.push_back( argv[ i ] );
+    }
+
+    if ( dir_out.empty() || files.empty() )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    osg::Timer_t t_0 = osg::Timer::instance()->tick();
+
+    cgi::ImageryBuilder builder( tileSize, maxLevel );
+
+    if ( !builder.build( files, dir_out.c_str() ) )
+    {
+        fdm::Log::e() << "Cannot build imagery tiles" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fdm::Log::i() << builder.getTiles() << " tiles in " << builder.getLevels() << " levels written to \""
+                  << dir_out << "\" in "
+                  << osg::Timer::instance()->delta_s( t_0, osg::Timer::instance()->tick() )
+                  << " s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
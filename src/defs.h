@@ -31,6 +31,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#define SIM_AVIONICS_DIVISOR 1   /* FDM steps per autopilot and avionics update */
+
+////////////////////////////////////////////////////////////////////////////////
+
 #ifndef NULLPTR
 #   if __cplusplus >= 201103L
 #       define NULLPTR nullptr
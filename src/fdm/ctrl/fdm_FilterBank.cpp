@@ -0,0 +1,300 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/ctrl/fdm_FilterBank.h>
+
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+FilterBank::FilterBank() :
+    _dt ( 0.0 ),
+    _valid ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLag( double tc, double y )
+{
+    _lag.tc .push_back( tc  );
+    _lag.k  .push_back( 0.0 );
+    _lag.u  .push_back( y   );
+    _lag.y  .push_back( y   );
+
+    return addElement( TypeLag, static_cast< unsigned int >( _lag.y.size() ) - 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLeadLag( double c1, double c2, double c3, double c4,
+                                     double y )
+{
+    _ll.c1     .push_back( c1  );
+    _ll.c2     .push_back( c2  );
+    _ll.c3     .push_back( c3  );
+    _ll.c4     .push_back( c4  );
+    _ll.ca     .push_back( 0.0 );
+    _ll.cb     .push_back( 0.0 );
+    _ll.cc     .push_back( 0.0 );
+    _ll.u      .push_back( 0.0 );
+    _ll.u_prev .push_back( 0.0 );
+    _ll.y_prev .push_back( y   );
+    _ll.y      .push_back( y   );
+
+    return addElement( TypeLeadLag, static_cast< unsigned int >( _ll.y.size() ) - 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addFilter2( double c1, double c2, double c3,
+                                     double c4, double c5, double c6,
+                                     double y )
+{
+    _f2.c1       .push_back( c1  );
+    _f2.c2       .push_back( c2  );
+    _f2.c3       .push_back( c3  );
+    _f2.c4       .push_back( c4  );
+    _f2.c5       .push_back( c5  );
+    _f2.c6       .push_back( c6  );
+    _f2.ca       .push_back( 0.0 );
+    _f2.cb       .push_back( 0.0 );
+    _f2.cc       .push_back( 0.0 );
+    _f2.cd       .push_back( 0.0 );
+    _f2.ce       .push_back( 0.0 );
+    _f2.u        .push_back( 0.0 );
+    _f2.u_prev_1 .push_back( 0.0 );
+    _f2.u_prev_2 .push_back( 0.0 );
+    _f2.y_prev_1 .push_back( y   );
+    _f2.y_prev_2 .push_back( y   );
+    _f2.y        .push_back( y   );
+
+    return addElement( TypeFilter2, static_cast< unsigned int >( _f2.y.size() ) - 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::setValue( unsigned int index, double y )
+{
+    const Element &e = _elements[ index ];
+
+    switch ( e.type )
+    {
+        case TypeLag:     _lag.y [ e.slot ] = y; break;
+        case TypeLeadLag: _ll.y  [ e.slot ] = y; break;
+        case TypeFilter2: _f2.y  [ e.slot ] = y; break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::setInput( unsigned int index, double u )
+{
+    const Element &e = _elements[ index ];
+
+    switch ( e.type )
+    {
+        case TypeLag:     _lag.u [ e.slot ] = u; break;
+        case TypeLeadLag: _ll.u  [ e.slot ] = u; break;
+        case TypeFilter2: _f2.u  [ e.slot ] = u; break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::setTimeConst( unsigned int index, double tc )
+{
+    const Element &e = _elements[ index ];
+
+    if ( e.type == TypeLag && tc > 0.0 && tc != _lag.tc[ e.slot ] )
+    {
+        _lag.tc[ e.slot ] = tc;
+        _valid = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::update( double dt )
+{
+    if ( dt > 0.0 )
+    {
+        updateCoefs( dt );
+
+        // first order lags
+        {
+            const unsigned int n = static_cast< unsigned int >( _lag.y.size() );
+
+            const double *k = _lag.k.data();
+            const double *u = _lag.u.data();
+            double       *y = _lag.y.data();
+
+            for ( unsigned int i = 0; i < n; i++ )
+            {
+                y[ i ] = y[ i ] + k[ i ] * ( u[ i ] - y[ i ] );
+            }
+        }
+
+        // lead-lags
+        {
+            const unsigned int n = static_cast< unsigned int >( _ll.y.size() );
+
+            const double *ca = _ll.ca.data();
+            const double *cb = _ll.cb.data();
+            const double *cc = _ll.cc.data();
+            const double *u  = _ll.u.data();
+            double *u_prev   = _ll.u_prev.data();
+            double *y_prev   = _ll.y_prev.data();
+            double *y        = _ll.y.data();
+
+            for ( unsigned int i = 0; i < n; i++ )
+            {
+                y[ i ] = u[ i ] * ca[ i ] + u_prev[ i ] * cb[ i ] + y_prev[ i ] * cc[ i ];
+
+                u_prev[ i ] = u[ i ];
+                y_prev[ i ] = y[ i ];
+            }
+        }
+
+        // second order filters
+        {
+            const unsigned int n = static_cast< unsigned int >( _f2.y.size() );
+
+            const double *ca = _f2.ca.data();
+            const double *cb = _f2.cb.data();
+            const double *cc = _f2.cc.data();
+            const double *cd = _f2.cd.data();
+            const double *ce = _f2.ce.data();
+            const double *u  = _f2.u.data();
+            double *u_prev_1 = _f2.u_prev_1.data();
+            double *u_prev_2 = _f2.u_prev_2.data();
+            double *y_prev_1 = _f2.y_prev_1.data();
+            double *y_prev_2 = _f2.y_prev_2.data();
+            double *y        = _f2.y.data();
+
+            for ( unsigned int i = 0; i < n; i++ )
+            {
+                y[ i ] = u[ i ] * ca[ i ] + u_prev_1[ i ] * cb[ i ] + u_prev_2[ i ] * cc[ i ]
+                                          - y_prev_1[ i ] * cd[ i ] - y_prev_2[ i ] * ce[ i ];
+
+                u_prev_2[ i ] = u_prev_1[ i ];
+                u_prev_1[ i ] = u[ i ];
+
+                y_prev_2[ i ] = y_prev_1[ i ];
+                y_prev_1[ i ] = y[ i ];
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::update( double dt, unsigned int index, double u )
+{
+    if ( dt > 0.0 )
+    {
+        updateCoefs( dt );
+
+        const unsigned int i = _elements[ index ].slot;
+
+        switch ( _elements[ index ].type )
+        {
+        case TypeLag:
+            _lag.u[ i ] = u;
+            _lag.y[ i ] = _lag.y[ i ] + _lag.k[ i ] * ( u - _lag.y[ i ] );
+            break;
+
+        case TypeLeadLag:
+            _ll.u[ i ] = u;
+            _ll.y[ i ] = u * _ll.ca[ i ] + _ll.u_prev[ i ] * _ll.cb[ i ] + _ll.y_prev[ i ] * _ll.cc[ i ];
+            _ll.u_prev[ i ] = u;
+            _ll.y_prev[ i ] = _ll.y[ i ];
+            break;
+
+        case TypeFilter2:
+            _f2.u[ i ] = u;
+            _f2.y[ i ] = u * _f2.ca[ i ] + _f2.u_prev_1[ i ] * _f2.cb[ i ] + _f2.u_prev_2[ i ] * _f2.cc[ i ]
+                                         - _f2.y_prev_1[ i ] * _f2.cd[ i ] - _f2.y_prev_2[ i ] * _f2.ce[ i ];
+            _f2.u_prev_2[ i ] = _f2.u_prev_1[ i ];
+            _f2.u_prev_1[ i ] = u;
+            _f2.y_prev_2[ i ] = _f2.y_prev_1[ i ];
+            _f2.y_prev_1[ i ] = _f2.y[ i ];
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::computeCoefs( double dt )
+{
+    const double dt2 = dt * dt;
+
+    // first order lags - exact discretization (zero order hold)
+    for ( unsigned int i = 0; i < _lag.y.size(); i++ )
+    {
+        _lag.k[ i ] = 1.0 - exp( -dt / _lag.tc[ i ] );
+    }
+
+    // lead-lags - bilinear transform (Tustin)
+    for ( unsigned int i = 0; i < _ll.y.size(); i++ )
+    {
+        double den = 2.0 * _ll.c3[ i ] + dt * _ll.c4[ i ];
+
+        _ll.ca[ i ] = ( 2.0 * _ll.c1[ i ] + dt  * _ll.c2[ i ] ) / den;
+        _ll.cb[ i ] = ( dt  * _ll.c2[ i ] - 2.0 * _ll.c1[ i ] ) / den;
+        _ll.cc[ i ] = ( 2.0 * _ll.c3[ i ] - dt  * _ll.c4[ i ] ) / den;
+    }
+
+    // second order filters - bilinear transform (Tustin)
+    for ( unsigned int i = 0; i < _f2.y.size(); i++ )
+    {
+        double den = 4.0*_f2.c4[ i ] + 2.0*_f2.c5[ i ]*dt + _f2.c6[ i ]*dt*dt;
+
+        _f2.ca[ i ] = ( 4.0 * _f2.c1[ i ]       + 2.0 * _f2.c2[ i ] * dt + _f2.c3[ i ] * dt2 ) / den;
+        _f2.cb[ i ] = ( 2.0 * _f2.c3[ i ] * dt2 - 8.0 * _f2.c1[ i ]                          ) / den;
+        _f2.cc[ i ] = ( 4.0 * _f2.c1[ i ]       - 2.0 * _f2.c2[ i ] * dt + _f2.c3[ i ] * dt2 ) / den;
+        _f2.cd[ i ] = ( 2.0 * _f2.c6[ i ] * dt2 - 8.0 * _f2.c4[ i ]                          ) / den;
+        _f2.ce[ i ] = ( 4.0 * _f2.c4[ i ]       - 2.0 * _f2.c5[ i ] * dt + _f2.c6[ i ] * dt2 ) / den;
+    }
+
+    _dt = dt;
+    _valid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addElement( Type type, unsigned int slot )
+{
+    Element e;
+
+    e.type = type;
+    e.slot = slot;
+
+    _elements.push_back( e );
+    _valid = false;
+
+    return static_cast< unsigned int >( _elements.size() ) - 1;
+}
@@ -0,0 +1,246 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_FILTERBANK_H
+#define FDM_FILTERBANK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Bank of linear filters with precomputed discrete coefficients.
+ *
+ * Holds first order lags, lead-lags and second order filters in structure
+ * of arrays layout. Discrete coefficients are computed once per time step
+ * value and reused as long as time step and filters parameters remain
+ * unchanged. Discretization is the same as in Lag (exact exponential),
+ * LeadLag (Tustin) and Filter2 (Tustin) classes, so bank elements give the
+ * same outputs as standalone objects.
+ *
+ * Elements can be updated all at once, which is a single contiguous loop
+ * per filter type, or one by one when element input depends on output of
+ * another element.
+ *
+ * @see Lag
+ * @see LeadLag
+ * @see Filter2
+ */
+class FDMEXPORT FilterBank
+{
+public:
+
+    /** @brief Constructor. */
+    FilterBank();
+
+    /**
+     * @brief Adds first order lag element.
+     * @param tc time constant
+     * @param y initial output value
+     * @return element index
+     */
+    unsigned int addLag( double tc, double y = 0.0 );
+
+    /**
+     * @brief Adds lead-lag element.
+     * G(s) = ( c1*s + c2 ) / ( c3*s + c4 )
+     * @param c1 coefficient of the transfer function
+     * @param c2 coefficient of the transfer function
+     * @param c3 coefficient of the transfer function
+     * @param c4 coefficient of the transfer function
+     * @param y initial output value
+     * @return element index
+     */
+    unsigned int addLeadLag( double c1, double c2, double c3, double c4,
+                             double y = 0.0 );
+
+    /**
+     * @brief Adds second order filter element.
+     * G(s) = ( c1*s^2 + c2*s + c3 ) / ( c4*s^2 + c5*s + c6 )
+     * @param c1 coefficient of the transfer function
+     * @param c2 coefficient of the transfer function
+     * @param c3 coefficient of the transfer function
+     * @param c4 coefficient of the transfer function
+     * @param c5 coefficient of the transfer function
+     * @param c6 coefficient of the transfer function
+     * @param y initial output value
+     * @return element index
+     */
+    unsigned int addFilter2( double c1, double c2, double c3,
+                             double c4, double c5, double c6,
+                             double y = 0.0 );
+
+    /** @return number of elements */
+    inline unsigned int getCount() const { return static_cast< unsigned int >( _elements.size() ); }
+
+    /**
+     * @brief Returns element output value.
+     * @param index element index
+     * @return element output value
+     */
+    inline double getValue( unsigned int index ) const
+    {
+        const Element &e = _elements[ index ];
+
+        switch ( e.type )
+        {
+            case TypeLag:     return _lag.y[ e.slot ];
+            case TypeLeadLag: return _ll.y[ e.slot ];
+            case TypeFilter2: return _f2.y[ e.slot ];
+        }
+
+        return 0.0;
+    }
+
+    /**
+     * @brief Sets element output value.
+     * @param index element index
+     * @param y output value
+     */
+    void setValue( unsigned int index, double y );
+
+    /**
+     * @brief Sets element input value used by bank update.
+     * @param index element index
+     * @param u input value
+     */
+    void setInput( unsigned int index, double u );
+
+    /**
+     * @brief Sets lag element time constant.
+     * @param index element index
+     * @param tc time constant
+     */
+    void setTimeConst( unsigned int index, double tc );
+
+    /**
+     * @brief Updates all elements due to time step and previously set inputs.
+     * @param dt [s] time step
+     */
+    void update( double dt );
+
+    /**
+     * @brief Updates single element due to time step and input value.
+     * @param dt [s] time step
+     * @param index element index
+     * @param u input value
+     */
+    void update( double dt, unsigned int index, double u );
+
+private:
+
+    /** Element types. */
+    enum Type
+    {
+        TypeLag = 0,            ///< first order lag
+        TypeLeadLag,            ///< lead-lag
+        TypeFilter2             ///< second order filter
+    };
+
+    /** Element handle. */
+    struct Element
+    {
+        Type type;              ///< element type
+        unsigned int slot;      ///< index within type arrays
+    };
+
+    /** First order lags arrays. */
+    struct LagArrays
+    {
+        std::vector< double > tc;       ///< time constants
+        std::vector< double > k;        ///< discrete gains
+        std::vector< double > u;        ///< inputs
+        std::vector< double > y;        ///< outputs
+    };
+
+    /** Lead-lags arrays. */
+    struct LeadLagArrays
+    {
+        std::vector< double > c1;       ///< transfer function coefficients
+        std::vector< double > c2;       ///< transfer function coefficients
+        std::vector< double > c3;       ///< transfer function coefficients
+        std::vector< double > c4;       ///< transfer function coefficients
+        std::vector< double > ca;       ///< discrete coefficients
+        std::vector< double > cb;       ///< discrete coefficients
+        std::vector< double > cc;       ///< discrete coefficients
+        std::vector< double > u;        ///< inputs
+        std::vector< double > u_prev;   ///< previous inputs
+        std::vector< double > y_prev;   ///< previous outputs
+        std::vector< double > y;        ///< outputs
+    };
+
+    /** Second order filters arrays. */
+    struct Filter2Arrays
+    {
+        std::vector< double > c1;       ///< transfer function coefficients
+        std::vector< double > c2;       ///< transfer function coefficients
+        std::vector< double > c3;       ///< transfer function coefficients
+        std::vector< double > c4;       ///< transfer function coefficients
+        std::vector< double > c5;       ///< transfer function coefficients
+        std::vector< double > c6;       ///< transfer function coefficients
+        std::vector< double > ca;       ///< discrete coefficients
+        std::vector< double > cb;       ///< discrete coefficients
+        std::vector< double > cc;       ///< discrete coefficients
+        std::vector< double > cd;       ///< discrete coefficients
+        std::vector< double > ce;       ///< discrete coefficients
+        std::vector< double > u;        ///< inputs
+        std::vector< double > u_prev_1; ///< previous inputs
+        std::vector< double > u_prev_2; ///< previous inputs
+        std::vector< double > y_prev_1; ///< previous outputs
+        std::vector< double > y_prev_2; ///< previous outputs
+        std::vector< double > y;        ///< outputs
+    };
+
+    std::vector< Element > _elements;   ///< elements handles
+
+    LagArrays     _lag;                 ///< first order lags
+    LeadLagArrays _ll;                  ///< lead-lags
+    Filter2Arrays _f2;                  ///< second order filters
+
+    double _dt;                         ///< [s] time step discrete coefficients are valid for
+    bool _valid;                        ///< specifies if discrete coefficients are valid
+
+    /**
+     * @brief Computes discrete coefficients if time step or parameters changed.
+     * @param dt [s] time step
+     */
+    inline void updateCoefs( double dt )
+    {
+        if ( !_valid || dt != _dt ) computeCoefs( dt );
+    }
+
+    void computeCoefs( double dt );
+
+    unsigned int addElement( Type type, unsigned int slot );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_FILTERBANK_H
@@ -7,6 +7,7 @@ HEADERS += \
     $$PWD/fdm_Aerodynamics.h \
     $$PWD/fdm_Aircraft.h \
     $$PWD/fdm_Base.h \
+    $$PWD/fdm_Collisions.h \
     $$PWD/fdm_Controls.h \
     $$PWD/fdm_DataInp.h \
     $$PWD/fdm_DataOut.h \
@@ -18,6 +19,7 @@ HEADERS += \
     $$PWD/fdm_Intersections.h \
     $$PWD/fdm_LandingGear.h \
     $$PWD/fdm_Log.h \
+    $$PWD/fdm_LogWriter.h \
     $$PWD/fdm_Mass.h \
     $$PWD/fdm_Module.h \
     $$PWD/fdm_Path.h \
@@ -30,6 +32,7 @@ SOURCES += \
     $$PWD/fdm_Aerodynamics.cpp \
     $$PWD/fdm_Aircraft.cpp \
     $$PWD/fdm_Base.cpp \
+    $$PWD/fdm_Collisions.cpp \
     $$PWD/fdm_Controls.cpp \
     $$PWD/fdm_Environment.cpp \
     $$PWD/fdm_FDM.cpp \
@@ -37,6 +40,7 @@ SOURCES += \
     $$PWD/fdm_Intersections.cpp \
     $$PWD/fdm_LandingGear.cpp \
     $$PWD/fdm_Log.cpp \
+    $$PWD/fdm_LogWriter.cpp \
     $$PWD/fdm_Mass.cpp \
     $$PWD/fdm_Propulsion.cpp \
     $$PWD/fdm_Recorder.cpp \
@@ -58,6 +62,7 @@ HEADERS += \
     $$PWD/ctrl/fdm_BPF.h \
     $$PWD/ctrl/fdm_BSF.h \
     $$PWD/ctrl/fdm_Filter2.h \
+    $$PWD/ctrl/fdm_FilterBank.h \
     $$PWD/ctrl/fdm_HPF.h \
     $$PWD/ctrl/fdm_Lag.h \
     $$PWD/ctrl/fdm_Lag2.h \
@@ -70,6 +75,7 @@ SOURCES += \
     $$PWD/ctrl/fdm_BPF.cpp \
     $$PWD/ctrl/fdm_BSF.cpp \
     $$PWD/ctrl/fdm_Filter2.cpp \
+    $$PWD/ctrl/fdm_FilterBank.cpp \
     $$PWD/ctrl/fdm_HPF.cpp \
     $$PWD/ctrl/fdm_Lag.cpp \
     $$PWD/ctrl/fdm_Lag2.cpp \
@@ -98,8 +104,10 @@ HEADERS += \
     $$PWD/models/fdm_TailOff.h \
     $$PWD/models/fdm_TailRotor.h \
     $$PWD/models/fdm_Turbofan.h \
+    $$PWD/models/fdm_Turbulence.h \
     $$PWD/models/fdm_Wheel.h \
     $$PWD/models/fdm_WinchLauncher.h \
+    $$PWD/models/fdm_WindField.h \
     $$PWD/models/fdm_WindShear.h \
     $$PWD/models/fdm_WingRunner.h
 
@@ -121,8 +129,10 @@ SOURCES += \
     $$PWD/models/fdm_TailOff.cpp \
     $$PWD/models/fdm_TailRotor.cpp \
     $$PWD/models/fdm_Turbofan.cpp \
+    $$PWD/models/fdm_Turbulence.cpp \
     $$PWD/models/fdm_Wheel.cpp \
     $$PWD/models/fdm_WinchLauncher.cpp \
+    $$PWD/models/fdm_WindField.cpp \
     $$PWD/models/fdm_WindShear.cpp \
     $$PWD/models/fdm_WingRunner.cpp
 
@@ -138,6 +148,7 @@ HEADERS += \
     $$PWD/utils/fdm_Geo.h \
     $$PWD/utils/fdm_Geom.h \
     $$PWD/utils/fdm_Integrator.h \
+    $$PWD/utils/fdm_LatencyTrace.h \
     $$PWD/utils/fdm_Map.h \
     $$PWD/utils/fdm_Matrix.h \
     $$PWD/utils/fdm_Matrix3x3.h \
@@ -148,11 +159,16 @@ HEADERS += \
     $$PWD/utils/fdm_Oscillation.h \
     $$PWD/utils/fdm_Quaternion.h \
     $$PWD/utils/fdm_Random.h \
+    $$PWD/utils/fdm_RingBuffer.h \
     $$PWD/utils/fdm_RungeKutta4.h \
+    $$PWD/utils/fdm_SeqLock.h \
+    $$PWD/utils/fdm_SharedState.h \
+    $$PWD/utils/fdm_SharedStateReader.h \
     $$PWD/utils/fdm_Singleton.h \
     $$PWD/utils/fdm_String.h \
     $$PWD/utils/fdm_Table1.h \
     $$PWD/utils/fdm_Table2.h \
+    $$PWD/utils/fdm_TableN.h \
     $$PWD/utils/fdm_Time.h \
     $$PWD/utils/fdm_Units.h \
     $$PWD/utils/fdm_Vector.h \
@@ -167,6 +183,7 @@ SOURCES += \
     $$PWD/utils/fdm_DataNode.cpp \
     $$PWD/utils/fdm_Endianness.cpp \
     $$PWD/utils/fdm_Geom.cpp \
+    $$PWD/utils/fdm_LatencyTrace.cpp \
     $$PWD/utils/fdm_Matrix3x3.cpp \
     $$PWD/utils/fdm_Matrix4x4.cpp \
     $$PWD/utils/fdm_Matrix6x6.cpp \
@@ -174,6 +191,8 @@ SOURCES += \
     $$PWD/utils/fdm_Oscillation.cpp \
     $$PWD/utils/fdm_Quaternion.cpp \
     $$PWD/utils/fdm_Random.cpp \
+    $$PWD/utils/fdm_SharedState.cpp \
+    $$PWD/utils/fdm_SharedStateReader.cpp \
     $$PWD/utils/fdm_String.cpp \
     $$PWD/utils/fdm_Table1.cpp \
     $$PWD/utils/fdm_Table2.cpp \
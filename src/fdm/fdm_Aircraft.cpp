@@ -25,6 +25,7 @@
 #include <cstring>
 
 #include <fdm/utils/fdm_GaussJordan.h>
+#include <fdm/utils/fdm_String.h>
 
 
 #include <fdm/xml/fdm_XmlDoc.h>
@@ -59,6 +60,7 @@ Aircraft::Aircraft( Input *input ) :
 
     _envir ( FDM_NULLPTR ),
     _isect ( FDM_NULLPTR ),
+    _collisions ( FDM_NULLPTR ),
 
     _aero ( FDM_NULLPTR ),
     _ctrl ( FDM_NULLPTR ),
@@ -74,17 +76,19 @@ Aircraft::Aircraft( Input *input ) :
     _stateVect ( FDM_STATE_DIMENSION ),
     _statePrev ( FDM_STATE_DIMENSION ),
     _derivVect ( FDM_STATE_DIMENSION ),
+    _stateSave ( FDM_STATE_DIMENSION ),
 
     _integrator ( FDM_NULLPTR ),
 
     _timeStep ( 0.0 ),
 
+    _contactSteps ( 1 ),
+    _contactStepsMax ( FDM_MAX_CONTACT_STEPS ),
+
     _crash ( DataOut::NoCrash ),
 
     _initPropState ( Stopped ),
 
-    _cp_index ( 0 ),
-
     _elevation     ( 0.0 ),
     _altitude_asl  ( 0.0 ),
     _altitude_agl  ( 0.0 ),
@@ -113,6 +117,8 @@ Aircraft::Aircraft( Input *input ) :
     _envir = new Environment();
     _isect = new Intersections();
 
+    _collisions = new Collisions( _isect );
+
     _integrator = new Aircraft::Integrator( this, &Aircraft::computeStateDeriv );
 }
 
@@ -123,6 +129,8 @@ Aircraft::~Aircraft()
     FDM_DELPTR( _envir );
     FDM_DELPTR( _isect );
 
+    FDM_DELPTR( _collisions );
+
     FDM_DELPTR( _integrator );
 }
 
@@ -138,6 +146,8 @@ void Aircraft::initialize( bool engineOn )
     _mass->initialize();
     _prop->initialize();
 
+    _collisions->reset();
+
     updateVariables( _stateVect, _derivVect );
 }
 
@@ -153,9 +163,9 @@ void Aircraft::update( double timeStep, bool integrate )
 
         if ( integrate )
         {
-            /////////////////////////////////////////////////
-            _integrator->integrate( _timeStep, &_stateVect );
-            /////////////////////////////////////////////////
+            ////////////////
+            integrateStep();
+            ////////////////
         }
 
         postIntegration();
@@ -174,11 +184,40 @@ void Aircraft::update( double timeStep, bool integrate )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Aircraft::Rates Aircraft::getRates() const
+{
+    Rates rates;
+
+    rates.aero = _aero->getRate();
+    rates.ctrl = _ctrl->getRate();
+    rates.gear = _gear->getRate();
+    rates.mass = _mass->getRate();
+    rates.prop = _prop->getRate();
+
+    return rates;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::setRates( const Rates &rates )
+{
+    _aero->setRate( rates.aero );
+    _ctrl->setRate( rates.ctrl );
+    _gear->setRate( rates.gear );
+    _mass->setRate( rates.mass );
+    _prop->setRate( rates.prop );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::setStateVector( const StateVector &stateVector )
 {
     _stateVect = stateVector;
     _statePrev = _stateVect;
 
+    // aircraft is moved, not swept
+    _collisions->reset();
+
     anteIntegration();
     computeStateDeriv( _stateVect, &_derivVect );
 }
@@ -245,6 +284,38 @@ void Aircraft::readData( XmlNode &dataNode )
                     nodeCollisionPoint = nodeCollisionPoint.getNextSiblingElement( "collision_point" );
                 }
             }
+
+            // terrain clearance used by collisions detection broad phase
+            if ( nodeCollisionPoints.hasAttribute( "clearance" ) )
+            {
+                double clearance = String::toDouble( nodeCollisionPoints.getAttribute( "clearance" ) );
+
+                if ( Misc::isValid( clearance ) && clearance >= 0.0 )
+                {
+                    _collisions->setClearance( clearance );
+                }
+                else
+                {
+                    XmlUtils::throwError( __FILE__, __LINE__, nodeCollisionPoints );
+                }
+            }
+        }
+
+        _collisions->setPoints( _cp );
+
+        // collision points lateral extent is used as span by turbulence model
+        double y_min = 0.0;
+        double y_max = 0.0;
+
+        for ( unsigned int i = 0; i < _cp.size(); i++ )
+        {
+            y_min = Misc::min( y_min, _cp[ i ].y() );
+            y_max = Misc::max( y_max, _cp[ i ].y() );
+        }
+
+        if ( y_max - y_min > 0.0 )
+        {
+            _envir->getTurbulence()->setSpan( y_max - y_min );
         }
 
         // limitations
@@ -275,6 +346,12 @@ void Aircraft::readData( XmlNode &dataNode )
             _gear->readData( nodeGear );
             _mass->readData( nodeMass );
             _prop->readData( nodeProp );
+
+            readRate( nodeAero, _aero );
+            readRate( nodeCtrl, _ctrl );
+            readRate( nodeGear, _gear );
+            readRate( nodeMass, _mass );
+            readRate( nodeProp, _prop );
         }
     }
     else
@@ -289,11 +366,17 @@ void Aircraft::anteIntegration()
 {
     updateVariables( _stateVect, _derivVect );
 
-    _aero->update();
-    _ctrl->update();
-    _gear->update();
-    _mass->update();
-    _prop->update();
+    _envir->getWindField()->update( _timeStep );
+
+    // gusts are held constant within integration step
+    _envir->getTurbulence()->update( _timeStep, _altitude_agl,
+                                     ( _vel_air_bas + _envir->getTurbulence()->getVel_BAS() ).getLength() );
+
+    _aero->step( _timeStep );
+    _ctrl->step( _timeStep );
+    _gear->step( _timeStep );
+    _mass->step( _timeStep );
+    _prop->step( _timeStep );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -340,14 +423,10 @@ void Aircraft::detectCrash()
     // detect collisions
     if ( _crash == DataOut::NoCrash )
     {
-        if ( _isect->isIntersection( _pos_wgs, _pos_wgs + _bas2wgs * _cp.at( _cp_index ), true ) )
+        if ( _collisions->update( _pos_wgs, _bas2wgs ) )
         {
             _crash = DataOut::Collision;
         }
-
-        _cp_index++;
-
-        if ( !( _cp_index < _cp.size() ) ) _cp_index = 0;
     }
 
     // detect overspeed
@@ -378,6 +457,109 @@ void Aircraft::detectCrash()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Aircraft::integrateStep()
+{
+    unsigned int steps = getContactStepsRequired();
+
+    if ( steps > 1 )
+    {
+        integrateSubSteps( steps );
+    }
+    else
+    {
+        bool airborne = !_gear->getOnGround();
+
+        if ( airborne )
+        {
+            _stateSave = _stateVect;
+            _gear->saveState();
+        }
+
+        _gear->integrate( _timeStep );
+
+        /////////////////////////////////////////////////
+        _integrator->integrate( _timeStep, &_stateVect );
+        /////////////////////////////////////////////////
+
+        _contactSteps = 1;
+
+        // touchdown within the step, repeat it with contact sub-steps
+        if ( airborne )
+        {
+            steps = getContactStepsRequired();
+
+            if ( steps > 1 )
+            {
+                _stateVect = _stateSave;
+                _gear->restoreState();
+                updateVariables( _stateVect, _derivVect );
+
+                integrateSubSteps( steps );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::integrateSubSteps( unsigned int steps )
+{
+    double timeStep = _timeStep / (double)steps;
+
+    for ( unsigned int i = 0; i < steps; i++ )
+    {
+        if ( i > 0 ) updateVariables( _stateVect, _derivVect );
+
+        _gear->integrate( timeStep );
+        _integrator->integrate( timeStep, &_stateVect );
+    }
+
+    _contactSteps = steps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Aircraft::getContactStepsRequired() const
+{
+    if ( _contactStepsMax > 1 )
+    {
+        double stepLimit = _gear->getStepLimit();
+
+        if ( stepLimit < _timeStep )
+        {
+            double steps = ceil( _timeStep / stepLimit );
+
+            if ( steps < (double)_contactStepsMax )
+                return static_cast< unsigned int >( steps );
+
+            return _contactStepsMax;
+        }
+    }
+
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::readRate( const XmlNode &dataNode, Module *module )
+{
+    if ( dataNode.hasAttribute( "rate" ) )
+    {
+        double rate = String::toDouble( dataNode.getAttribute( "rate" ) );
+
+        if ( Misc::isValid( rate ) && rate >= 0.0 )
+        {
+            module->setRate( rate );
+        }
+        else
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::computeStateDeriv( const StateVector &stateVect,
                                   StateVector *derivVect )
 {
@@ -530,8 +712,10 @@ void Aircraft::updateVariables( const StateVector &stateVect,
 
     _vel_ned = _bas2ned * _vel_bas;
 
-    _vel_air_bas = _vel_bas - _ned2bas * _envir->getWind_NED();
-    _omg_air_bas = _omg_bas;
+    _vel_air_bas = _vel_bas - _ned2bas * _envir->getWind_NED()
+                 - _wgs2bas * _envir->getWindField()->getWind_WGS( _pos_wgs )
+                 - _envir->getTurbulence()->getVel_BAS();
+    _omg_air_bas = _omg_bas - _envir->getTurbulence()->getOmg_BAS();
 
     _acc_bas.u() = derivVect( _i_u );
     _acc_bas.v() = derivVect( _i_v );
@@ -30,6 +30,7 @@
 #include <fdm/fdm_Base.h>
 
 #include <fdm/fdm_Environment.h>
+#include <fdm/fdm_Collisions.h>
 #include <fdm/fdm_Intersections.h>
 
 #include <fdm/fdm_Input.h>
@@ -93,7 +94,7 @@ namespace fdm
  *
  * @code
  * <fdm>
- *   <collision_points>
+ *   <collision_points [clearance="{ [m] terrain clearance }"]>
  *     <collision_point> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </collision_point>
  *     ... { more entries }
  *   </collision_points>
@@ -104,24 +105,36 @@ namespace fdm
  *     <load_gear_max> { [-] maximum absolute load factor due to landing gear (exceeding this value causes crash) } </load_gear_max>
  *   </limitations>
  *   <pilot_position> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </pilot_position>
- *   <aerodynamics>
+ *   <aerodynamics [rate="{ [Hz] update rate }"]>
  *     { aerodynamics data }
  *   </aerodynamics>
- *   <controls>
+ *   <controls [rate="{ [Hz] update rate }"]>
  *     { controls data }
  *   </controls>
- *   <landing_gear>
+ *   <landing_gear [rate="{ [Hz] update rate }"]>
  *     { landing gear data }
  *   </landing_gear>
- *   <mass>
+ *   <mass [rate="{ [Hz] update rate }"]>
  *     { mass data }
  *   </mass>
- *   <propulsion>
+ *   <propulsion [rate="{ [Hz] update rate }"]>
  *     { propulsion data }
  *   </propulsion>
  * </fdm>
  * @endcode
  *
+ * Optional "rate" attribute specifies module update rate. Modules without
+ * this attribute are updated every time step. Module update rate affects
+ * only module update() function, forces and moments are computed within
+ * every integration stage regardless of it.
+ *
+ * Optional "clearance" attribute specifies maximum height of obstacles and
+ * unsampled terrain features above the collisions detection terrain bound.
+ * Aircraft higher than this above the terrain bound skips the scenery query.
+ *
+ * @see fdm::Module
+ * @see fdm::Collisions
+ *
  * @see Taylor J.: Classical Mechanics, 2005
  * @see Osinski Z.: Mechanika ogolna, 1997, [in Polish]
  * @see Allerton D.: Principles of Flight Simulation, 2009
@@ -140,6 +153,16 @@ public:
     typedef std::vector< Vector3 > CollisionPoints; ///< collision points
     typedef VectorN StateVector;                    ///< state vector
 
+    /** Modules update rates, zero means every time step. */
+    struct Rates
+    {
+        double aero;            ///< [Hz] aerodynamics update rate
+        double ctrl;            ///< [Hz] controls update rate
+        double gear;            ///< [Hz] landing gear update rate
+        double mass;            ///< [Hz] mass update rate
+        double prop;            ///< [Hz] propulsion update rate
+    };
+
     /** Propuslion state enum. */
     enum PropState
     {
@@ -189,6 +212,8 @@ public:
     inline const Environment*   getEnvir() const { return _envir; }
     inline const Intersections* getIsect() const { return _isect; }
 
+    inline const Collisions* getCollisions() const { return _collisions; }
+
     virtual inline const Aerodynamics* getAero() const { return _aero; }
     virtual inline const Controls*     getCtrl() const { return _ctrl; }
     virtual inline const LandingGear*  getGear() const { return _gear; }
@@ -204,6 +229,30 @@ public:
 
     inline double getTimeStep() const { return _timeStep; }
 
+    /** @return modules update rates */
+    Rates getRates() const;
+
+    /**
+     * @brief Sets modules update rates overriding values read from data file.
+     * @param rates modules update rates
+     */
+    void setRates( const Rates &rates );
+
+    /** @return number of contact sub-steps of the last integration step */
+    inline unsigned int getContactSteps() const { return _contactSteps; }
+
+    /** @return maximum number of contact sub-steps per integration step */
+    inline unsigned int getContactStepsMax() const { return _contactStepsMax; }
+
+    /**
+     * @brief Sets maximum number of contact sub-steps per integration step.
+     * @param steps maximum number of contact sub-steps, 1 disables sub-stepping
+     */
+    inline void setContactStepsMax( unsigned int steps )
+    {
+        _contactStepsMax = ( steps > 1 ) ? steps : 1;
+    }
+
     inline const Vector3&    getPos_WGS() const { return _pos_wgs; }
     inline const Quaternion& getAtt_WGS() const { return _att_wgs; }
     inline const Vector3&    getVel_BAS() const { return _vel_bas; }
@@ -301,6 +350,7 @@ protected:
 
     Environment   *_envir;      ///< environment interface
     Intersections *_isect;      ///< intersections interface
+    Collisions    *_collisions; ///< collisions detection
 
     Aerodynamics *_aero;        ///< aerodynamics model
     Controls     *_ctrl;        ///< controls model
@@ -320,11 +370,15 @@ protected:
     StateVector _stateVect;     ///< aircraft state vector
     StateVector _statePrev;     ///< aircraft state vector (previous)
     StateVector _derivVect;     ///< aircraft state vector derivative (for output purposes only)
+    StateVector _stateSave;     ///< aircraft state vector saved at the beginning of the integration step
 
     Integrator *_integrator;    ///< integration procedure object
 
     double _timeStep;           ///< [s] simulation time step
 
+    unsigned int _contactSteps;     ///< number of contact sub-steps of the last integration step
+    unsigned int _contactStepsMax;  ///< maximum number of contact sub-steps per integration step
+
     Vector3    _pos_wgs;        ///< [m] aircraft position expressed in WGS
     Quaternion _att_wgs;        ///< aircraft attitude expressed as quaternion of rotation from WGS to BAS
     Vector3    _vel_bas;        ///< [m/s] aircraft linear velocity vector expressed in BAS
@@ -366,8 +420,6 @@ protected:
 
     PropState _initPropState;   ///< initial propulsion state
 
-    UInt32 _cp_index;           ///< current collision point index
-
     double _elevation;          ///< [m] ground elevation above mean sea level
     double _altitude_asl;       ///< [m] altitude above sea level
     double _altitude_agl;       ///< [m] altitude above ground level
@@ -414,6 +466,32 @@ protected:
     /** @brief This function checks collisions. */
     virtual void detectCrash();
 
+    /**
+     * @brief Integrates state vector over the simulation time step.
+     * Step is split into contact sub-steps if landing gear contact is too
+     * stiff for it. Step in which contact has been made is repeated with
+     * sub-steps if needed, starting from the aircraft state vector and
+     * landing gear state saved at the beginning of the step.
+     */
+    virtual void integrateStep();
+
+    /**
+     * @brief Integrates state vector over the simulation time step in sub-steps.
+     * Landing gear friction states are advanced every sub-step.
+     * @param steps number of sub-steps
+     */
+    void integrateSubSteps( unsigned int steps );
+
+    /** @return number of contact sub-steps required by the landing gear */
+    unsigned int getContactStepsRequired() const;
+
+    /**
+     * @brief Reads module update rate from the module data node attribute.
+     * @param dataNode module XML node
+     * @param module module to set update rate to
+     */
+    void readRate( const XmlNode &dataNode, Module *module );
+
     /**
      * @brief Computes state vector derivatives due to given state vector.
      * @param stateVect state vector
@@ -0,0 +1,223 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/fdm_Collisions.h>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const double Collisions::_clearance_default = 1000.0;
+const double Collisions::_bound_size = 1000.0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Collisions::Collisions( const Intersections *isect ) :
+    _isect ( isect ),
+
+    _clearance ( _clearance_default ),
+    _bound ( 0.0 ),
+    _toi ( 0.0 ),
+
+    _index ( 0 ),
+
+    _contact ( false ),
+    _swept ( false ),
+    _sampled ( false ),
+    _bounded ( false )
+{
+    _bound_b_wgs.resize( _bound_samples * _bound_samples );
+    _bound_e_wgs.resize( _bound_samples * _bound_samples );
+    _bound_hits.resize( _bound_samples * _bound_samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Collisions::~Collisions() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Collisions::reset()
+{
+    _swept   = false;
+    _sampled = false;
+    _bounded = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Collisions::update( const Vector3 &pos_wgs, const Matrix3x3 &bas2wgs )
+{
+    _contact = false;
+
+    for ( unsigned int i = 0; i < _points_bas.size(); i++ )
+    {
+        _b_wgs[ i ] = _swept ? _e_wgs[ i ] : pos_wgs;
+        _e_wgs[ i ] = pos_wgs + bas2wgs * _points_bas[ i ];
+    }
+
+    bool swept = _swept;
+
+    _swept = true;
+
+    if ( _points_bas.size() == 0 )
+    {
+        return false;
+    }
+
+    updateBound( pos_wgs );
+
+    if ( isClear() )
+    {
+        return false;
+    }
+
+    if ( _isect->getIntersections( &_b_wgs[ 0 ], &_e_wgs[ 0 ], &_hits[ 0 ],
+                                   _points_bas.size(), true ) > 0 )
+    {
+        double t_min = 1.0;
+
+        for ( unsigned int i = 0; i < _hits.size(); i++ )
+        {
+            if ( _hits[ i ].valid && ( !_contact || _hits[ i ].t < t_min ) )
+            {
+                _contact = true;
+
+                _index = i;
+                t_min = _hits[ i ].t;
+
+                _contact_wgs = _hits[ i ].r;
+                _normal_wgs  = _hits[ i ].n;
+            }
+        }
+
+        // segments from the aircraft origin test the current position only
+        _toi = swept ? t_min : 1.0;
+    }
+
+    return _contact;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Collisions::setPoints( const Points &points_bas )
+{
+    _points_bas = points_bas;
+
+    _b_wgs.resize( _points_bas.size() );
+    _e_wgs.resize( _points_bas.size() );
+    _hits.resize( _points_bas.size() );
+
+    _swept = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Collisions::updateBound( const Vector3 &pos_wgs )
+{
+    if ( _sampled )
+    {
+        Vector3 d_wgs = pos_wgs - _bound_center_wgs;
+        Vector3 h_wgs = d_wgs - ( _bound_normal_wgs * d_wgs ) * _bound_normal_wgs;
+
+        if ( h_wgs.getLength() < 0.5 * _bound_size ) return;
+    }
+
+    WGS84 wgs( pos_wgs );
+
+    Geo center_geo = wgs.getPos_Geo();
+    center_geo.alt = 0.0;
+
+    _bound_center_wgs = WGS84::geo2wgs( center_geo );
+    _bound_normal_wgs = wgs.getNorm_WGS();
+
+    Vector3 north_wgs = wgs.getNED2WGS() * Vector3( 1.0, 0.0, 0.0 );
+    Vector3 east_wgs  = wgs.getNED2WGS() * Vector3( 0.0, 1.0, 0.0 );
+
+    const double spacing = 2.0 * _bound_size / (double)( _bound_samples - 1 );
+
+    // vertical segments as used for ground elevation
+    for ( unsigned int i = 0; i < _bound_samples; i++ )
+    {
+        for ( unsigned int j = 0; j < _bound_samples; j++ )
+        {
+            unsigned int k = i * _bound_samples + j;
+
+            Vector3 r_wgs = _bound_center_wgs
+                          + ( i * spacing - _bound_size ) * north_wgs
+                          + ( j * spacing - _bound_size ) * east_wgs;
+
+            _bound_b_wgs[ k ] = r_wgs + 10000.0 * _bound_normal_wgs;
+            _bound_e_wgs[ k ] = r_wgs -  1000.0 * _bound_normal_wgs;
+        }
+    }
+
+    _sampled = true;
+    _bounded = false;
+
+    if ( _isect->getIntersections( &_bound_b_wgs[ 0 ], &_bound_e_wgs[ 0 ], &_bound_hits[ 0 ],
+                                   _bound_hits.size(), true ) > 0 )
+    {
+        for ( unsigned int i = 0; i < _bound_hits.size(); i++ )
+        {
+            if ( _bound_hits[ i ].valid )
+            {
+                double h = _bound_normal_wgs * ( _bound_hits[ i ].r - _bound_center_wgs );
+
+                _bound = _bounded ? Misc::max( _bound, h ) : h;
+                _bounded = true;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Collisions::isClear() const
+{
+    double bound = _bound;
+
+    // ground under the aircraft is always known, even if not sampled
+    if ( _isect->isInited() )
+    {
+        double h = _bound_normal_wgs * ( _isect->getGroundWGS() - _bound_center_wgs );
+
+        bound = _bounded ? Misc::max( bound, h ) : h;
+    }
+    else if ( !_bounded )
+    {
+        return false;
+    }
+
+    // swept segments are straight, so their lowest points are their ends
+    for ( unsigned int i = 0; i < _points_bas.size(); i++ )
+    {
+        if ( _bound_normal_wgs * ( _b_wgs[ i ] - _bound_center_wgs ) - bound < _clearance ) return false;
+        if ( _bound_normal_wgs * ( _e_wgs[ i ] - _bound_center_wgs ) - bound < _clearance ) return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,177 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_COLLISIONS_H
+#define FDM_COLLISIONS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Intersections.h>
+
+#include <fdm/utils/fdm_Matrix3x3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Collisions detection class.
+ *
+ * All collision points are tested every step. Each point is tested as
+ * a segment swept from its previous to its current position, so thin
+ * obstacles cannot be passed through between steps. All segments are
+ * intersected with the scenery in one batched query. Query is skipped
+ * when the whole swept volume is higher than the coarse terrain bound
+ * plus clearance.
+ *
+ * Terrain bound is the highest terrain point found by a grid of vertical
+ * segments around the aircraft, also queried in one batch. It is sampled
+ * again when the aircraft moves away from the grid center by more than
+ * half of the grid size. Clearance has to cover obstacles and terrain
+ * features narrower than the grid spacing.
+ *
+ * The first step after reset has no previous position, segments from
+ * the aircraft origin to the collision points are tested instead and time
+ * of impact of the detected contact is 1, i.e. contact is at the current
+ * position.
+ *
+ * Swept segments are straight, rotation within a single step is
+ * neglected.
+ */
+class FDMEXPORT Collisions
+{
+public:
+
+    typedef std::vector< Vector3 > Points;  ///< collision points
+
+    static const double _clearance_default; ///< [m] default terrain clearance
+
+    static const unsigned int _bound_samples = 5;   ///< number of terrain bound samples along grid side
+    static const double _bound_size;                ///< [m] terrain bound grid half size
+
+    /**
+     * @brief Constructor.
+     * @param isect intersections interface
+     */
+    Collisions( const Intersections *isect );
+
+    /** @brief Destructor. */
+    virtual ~Collisions();
+
+    /** @brief Discards collision points previous positions and terrain bound. */
+    void reset();
+
+    /**
+     * @brief Updates collisions detection.
+     * @param pos_wgs [m] aircraft position expressed in WGS
+     * @param bas2wgs matrix of rotation from BAS to WGS
+     * @return true if contact was detected, false otherwise
+     */
+    bool update( const Vector3 &pos_wgs, const Matrix3x3 &bas2wgs );
+
+    inline bool getContact() const { return _contact; }
+
+    /** @brief Returns index of the first collision point in contact. */
+    inline unsigned int getIndex() const { return _index; }
+
+    /**
+     * @brief Returns time of impact.
+     * @return [-] time of impact as a fraction of the last step (0 at the
+     * previous position, 1 at the current position)
+     */
+    inline double getTimeOfImpact() const { return _toi; }
+
+    inline const Vector3& getContact_WGS() const { return _contact_wgs; }
+    inline const Vector3& getNormal_WGS()  const { return _normal_wgs;  }
+
+    inline double getClearance() const { return _clearance; }
+
+    /**
+     * @brief Returns terrain bound height.
+     * @return [m] height of the highest sampled terrain point above the ellipsoid along the grid center normal
+     */
+    inline double getBound() const { return _bound; }
+
+    /**
+     * @brief Sets collision points.
+     * @param points_bas [m] collision points expressed in BAS
+     */
+    void setPoints( const Points &points_bas );
+
+    /**
+     * @brief Sets terrain clearance used by the broad phase.
+     * @param clearance [m] maximum height of obstacles and unsampled terrain above the terrain bound
+     */
+    inline void setClearance( double clearance ) { _clearance = clearance; }
+
+private:
+
+    const Intersections *_isect;        ///< intersections interface
+
+    Points _points_bas;                 ///< [m] collision points expressed in BAS
+
+    std::vector< Vector3 > _b_wgs;      ///< [m] swept segments beginnings expressed in WGS
+    std::vector< Vector3 > _e_wgs;      ///< [m] swept segments ends expressed in WGS
+
+    std::vector< Intersections::Hit > _hits;    ///< swept segments intersections
+
+    std::vector< Vector3 > _bound_b_wgs;        ///< [m] terrain bound samples beginnings expressed in WGS
+    std::vector< Vector3 > _bound_e_wgs;        ///< [m] terrain bound samples ends expressed in WGS
+    std::vector< Intersections::Hit > _bound_hits;  ///< terrain bound samples intersections
+
+    Vector3 _bound_center_wgs;          ///< [m] terrain bound grid center (on the ellipsoid) expressed in WGS
+    Vector3 _bound_normal_wgs;          ///< [-] terrain bound grid normal vector expressed in WGS
+
+    Vector3 _contact_wgs;               ///< [m] contact point expressed in WGS
+    Vector3 _normal_wgs;                ///< [-] contact normal vector expressed in WGS
+
+    double _clearance;                  ///< [m] terrain clearance
+    double _bound;                      ///< [m] terrain bound height
+    double _toi;                        ///< [-] time of impact
+
+    unsigned int _index;                ///< index of the first collision point in contact
+
+    bool _contact;                      ///< specifies if contact was detected
+    bool _swept;                        ///< specifies if previous positions are valid
+    bool _sampled;                      ///< specifies if terrain bound grid has been sampled
+    bool _bounded;                      ///< specifies if terrain was found by the grid samples
+
+    /**
+     * @brief Samples terrain bound if aircraft has left the current grid.
+     * @param pos_wgs [m] aircraft position expressed in WGS
+     */
+    void updateBound( const Vector3 &pos_wgs );
+
+    /**
+     * @brief Checks if swept volume is above the coarse terrain bound.
+     * @return true if no contact is possible, false otherwise
+     */
+    bool isClear() const;
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_COLLISIONS_H
@@ -26,6 +26,8 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_LatencyTrace.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -204,6 +206,8 @@ struct DataInp
     Masses      masses;                     ///< masses data
     Recording   recording;                  ///< recording data
 
+    LatencyTrace::Stamp trace;              ///< input sample latency trace stamp
+
     AircraftType aircraftType;              ///< input aircraft type
     StateInp stateInp;                      ///< input state
 
@@ -26,6 +26,8 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_LatencyTrace.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -204,6 +206,8 @@ struct DataOut
     Rotor       rotor;                      ///< rotor data
     Blade       blade[ FDM_MAX_BLADES ];    ///< blades data
 
+    LatencyTrace::Stamp trace;              ///< latency trace stamp of the input data used
+
     Crash crash;                            ///< crash cause
     StateOut stateOut;                      ///< output state
 };
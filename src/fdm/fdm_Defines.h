@@ -72,6 +72,8 @@
 #define FDM_MIN_INIT_ALTITUDE 30.0
 #define FDM_MAX_INIT_STEPS 20000
 
+#define FDM_MAX_CONTACT_STEPS 8
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define FDM_SUCCESS 0
@@ -30,6 +30,8 @@ using namespace fdm;
 
 Environment::Environment() :
     _atmosphere ( FDM_NULLPTR ),
+    _turbulence ( FDM_NULLPTR ),
+    _windField  ( FDM_NULLPTR ),
 
     _temperature     ( 0.0 ),
     _pressure        ( 0.0 ),
@@ -41,6 +43,8 @@ Environment::Environment() :
     _wind_speed     ( 0.0 )
 {
     _atmosphere = new AtmosphereUS76();
+    _turbulence = new Turbulence();
+    _windField  = new WindField();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +52,8 @@ Environment::Environment() :
 Environment::~Environment()
 {
     FDM_DELPTR( _atmosphere );
+    FDM_DELPTR( _turbulence );
+    FDM_DELPTR( _windField );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
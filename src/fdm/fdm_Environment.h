@@ -25,6 +25,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/models/fdm_AtmosphereUS76.h>
+#include <fdm/models/fdm_Turbulence.h>
+#include <fdm/models/fdm_WindField.h>
 
 #include <fdm/utils/fdm_Vector3.h>
 
@@ -60,6 +62,14 @@ public:
 
     inline Vector3 getWind_NED() const { return _wind_ned; }
 
+    inline Turbulence* getTurbulence() { return _turbulence; }
+
+    inline const Turbulence* getTurbulence() const { return _turbulence; }
+
+    inline WindField* getWindField() { return _windField; }
+
+    inline const WindField* getWindField() const { return _windField; }
+
     /**
      * @brief Sets sea level air temperature value.
      * @param slAirTemperature [K] sea level air temperature
@@ -88,9 +98,19 @@ public:
         _wind_speed = wind_speed;
     }
 
+    inline void setTurbulence( Turbulence::Intensity intensity )
+    {
+        if ( intensity != _turbulence->getIntensity() )
+        {
+            _turbulence->setIntensity( intensity );
+        }
+    }
+
 protected:
 
     AtmosphereUS76 *_atmosphere;    ///< atmosphere object
+    Turbulence *_turbulence;        ///< turbulence object
+    WindField  *_windField;         ///< gridded wind field object
 
     double _temperature;            ///< [K] air temperature
     double _pressure;               ///< [Pa] air static pressure
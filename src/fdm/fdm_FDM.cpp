@@ -596,6 +596,19 @@ void FDM::updateEnvironment()
 
         _aircraft->getEnvir()->setWindDirection( _dataInp.environment.wind_direction );
         _aircraft->getEnvir()->setWindSpeed( _dataInp.environment.wind_speed );
+
+        Turbulence::Intensity turbulence = Turbulence::None;
+
+        switch ( _dataInp.environment.turbulence )
+        {
+            case DataInp::Environment::TurbulenceNone:     turbulence = Turbulence::None;     break;
+            case DataInp::Environment::TurbulenceMild:     turbulence = Turbulence::Light;    break;
+            case DataInp::Environment::TurbulenceModerate: turbulence = Turbulence::Moderate; break;
+            case DataInp::Environment::TurbulenceSevere:   turbulence = Turbulence::Severe;   break;
+            case DataInp::Environment::TurbulenceExtreme:  turbulence = Turbulence::Extreme;  break;
+        }
+
+        _aircraft->getEnvir()->setTurbulence( turbulence );
     }
 }
 
@@ -177,6 +177,78 @@ bool Intersections::isIntersection( const Vector3 &b, const Vector3 &e,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+unsigned int Intersections::getIntersections( const Vector3 b[], const Vector3 e[],
+                                              Hit hits[], unsigned int count,
+                                              bool update ) const
+{
+    unsigned int result = 0;
+
+#   ifdef SIM_INTERSECTIONS
+    if ( update )
+    {
+        // segments are passed in chunks so no allocation is needed
+        const unsigned int size = 16;
+
+        cgi::Intersections::Ray rays_tmp[ size ];
+        cgi::Intersections::Hit hits_tmp[ size ];
+
+        for ( unsigned int i = 0; i < count; i += size )
+        {
+            unsigned int n = ( count - i < size ) ? count - i : size;
+
+            for ( unsigned int j = 0; j < n; j++ )
+            {
+                b[ i + j ].getArray( rays_tmp[ j ].b );
+                e[ i + j ].getArray( rays_tmp[ j ].e );
+            }
+
+            result += cgi::Intersections::instance()->findFirst( rays_tmp, hits_tmp, n );
+
+            for ( unsigned int j = 0; j < n; j++ )
+            {
+                Hit &hit = hits[ i + j ];
+
+                hit.valid = hits_tmp[ j ].valid;
+                hit.t = hits_tmp[ j ].t;
+                hit.r.set( hits_tmp[ j ].r[ 0 ], hits_tmp[ j ].r[ 1 ], hits_tmp[ j ].r[ 2 ] );
+                hit.n.set( hits_tmp[ j ].n[ 0 ], hits_tmp[ j ].n[ 1 ], hits_tmp[ j ].n[ 2 ] );
+            }
+        }
+    }
+    else
+#   endif
+    {
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            hits[ i ].valid = false;
+
+            if ( _inited )
+            {
+                double num = _normal_wgs * ( _ground_wgs - b[ i ] );
+                double den = _normal_wgs * ( e[ i ] - b[ i ] );
+
+                double u = 0.0;
+
+                if ( fabs( den ) > 10e-15 ) u = num / den;
+
+                if ( 0.0 < u && u < 1.0 )
+                {
+                    hits[ i ].valid = true;
+                    hits[ i ].t = u;
+                    hits[ i ].r = b[ i ] + u * ( e[ i ] - b[ i ] );
+                    hits[ i ].n = _normal_wgs;
+
+                    result++;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Vector3 Intersections::getNormal( double lat, double lon, bool update ) const
 {
     Geo b_geo;
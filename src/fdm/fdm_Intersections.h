@@ -38,6 +38,15 @@ class FDMEXPORT Intersections
 {
 public:
 
+    /** Segment intersection. */
+    struct Hit
+    {
+        bool valid;             ///< specifies if intersection was found
+        double t;               ///< [-] segment parameter, 0 at the beginning and 1 at the end
+        Vector3 r;              ///< [m] intersection point coordinates expressed in WGS
+        Vector3 n;              ///< [-] intersection normal vector expressed in WGS
+    };
+
     /** @brief Constructor. */
     Intersections();
 
@@ -77,6 +86,19 @@ public:
     virtual bool isIntersection( const Vector3 &b, const Vector3 &e,
                                  bool update = false ) const;
 
+    /**
+     * @brief Gets intersections of many segments at once.
+     * @param b [m] beginnings of intersection lines expressed in WGS
+     * @param e [m] ends of intersection lines expressed in WGS
+     * @param hits output intersections, first along each segment
+     * @param count number of segments
+     * @param update specifies if ground intersection data should be updated
+     * @return number of intersections found
+     */
+    virtual unsigned int getIntersections( const Vector3 b[], const Vector3 e[],
+                                           Hit hits[], unsigned int count,
+                                           bool update = false ) const;
+
     /**
      * @brief Returns ground normal vector expressed in WGS.
      * @param lat [rad] input latitude
@@ -86,6 +108,11 @@ public:
      */
     virtual Vector3 getNormal( double lat, double lon, bool update = false ) const;
 
+    inline bool isInited() const { return _inited; }
+
+    inline const Vector3& getGroundWGS() const { return _ground_wgs; }
+    inline const Vector3& getNormalWGS() const { return _normal_wgs; }
+
     void setGroundWGS( const Vector3 &ground_wgs ) { _ground_wgs = ground_wgs; }
     void setNormalWGS( const Vector3 &normal_wgs ) { _normal_wgs = normal_wgs; }
 
@@ -23,6 +23,11 @@
 #include <fdm/fdm_LandingGear.h>
 #include <fdm/fdm_Aircraft.h>
 
+#include <cfloat>
+#include <complex>
+
+#include <fdm/utils/fdm_GaussJordan.h>
+
 #include <fdm/utils/fdm_String.h>
 #include <fdm/xml/fdm_XmlUtils.h>
 
@@ -82,6 +87,96 @@ void LandingGear::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void LandingGear::integrate( double timeStep )
+{
+    for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
+    {
+        Wheel &wheel = (*it).second.wheel;
+
+        Vector3 r_c_bas;
+        Vector3 n_c_bas;
+
+        getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
+
+        wheel.integrate( timeStep,
+                         _aircraft->getVel_BAS(),
+                         _aircraft->getOmg_BAS(),
+                         r_c_bas,
+                         n_c_bas,
+                         _steering );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::saveState()
+{
+    for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
+    {
+        (*it).second.saved = (*it).second.wheel.getState();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::restoreState()
+{
+    for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
+    {
+        (*it).second.wheel.setState( (*it).second.saved );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double LandingGear::getStepLimit() const
+{
+    // sums of stiffness and damping to effective mass ratios
+    double k_n_m = 0.0;
+    double c_n_m = 0.0;
+    double k_t_m = 0.0;
+    double c_t_m = 0.0;
+
+    Vector3 r_cm_bas = _aircraft->getMass()->getCenterOfMass();
+
+    for ( Wheels::const_iterator it = _wheels.begin(); it != _wheels.end(); ++it )
+    {
+        const Wheel &wheel = (*it).second.wheel;
+
+        double k_n = 0.0;
+        double c_n = 0.0;
+        double k_t = 0.0;
+        double c_t = 0.0;
+
+        wheel.getContactCoefs( &k_n, &c_n, &k_t, &c_t );
+
+        if ( k_n > 0.0 )
+        {
+            Vector3 r_bas = wheel.getRc_BAS() - r_cm_bas;
+            Vector3 n_bas = wheel.getNc_BAS();
+
+            double m_n = getMassEff( r_bas, n_bas );
+            double m_t = Misc::min( getMassEff( r_bas, ( n_bas % Vector3::ey() ).getNormalized() ),
+                                    getMassEff( r_bas, ( Vector3::ex() % n_bas ).getNormalized() ) );
+
+            k_n_m += k_n / m_n;
+            c_n_m += c_n / m_n;
+            k_t_m += k_t / m_t;
+            c_t_m += c_t / m_t;
+        }
+    }
+
+    if ( k_n_m > 0.0 )
+    {
+        return Misc::min( getStepLimitRK4( k_n_m, c_n_m ),
+                          getStepLimitRK4( k_t_m, c_t_m ) );
+    }
+
+    return DBL_MAX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool LandingGear::getIsect( const Vector3 &r_a_bas, const Vector3 &r_u_bas,
                             Vector3 *r_c_bas, Vector3 *n_c_bas )
 {
@@ -131,3 +226,81 @@ int LandingGear::readWheelsData( XmlNode &dataNode, Wheels &wheels )
 
     return result;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+double LandingGear::getMassEff( const Vector3 &r_bas, const Vector3 &d_bas ) const
+{
+    Vector3 rd_bas = r_bas % d_bas;
+    Vector3 ii_rd_bas;
+
+    // angular acceleration per unit impulse, I * x = r x d
+    if ( FDM_SUCCESS != GaussJordan< 3 >::solve( _aircraft->getMass()->getInertiaTensor(),
+                                                 rd_bas, &ii_rd_bas ) )
+    {
+        ii_rd_bas.zeroize();
+    }
+
+    double m_inv = 1.0 / _aircraft->getMass()->getMass() + rd_bas * ii_rd_bas;
+
+    return 1.0 / m_inv;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double LandingGear::getStepLimitRK4( double k, double c )
+{
+    // fastest eigenvalue of x'' + c*x' + k*x = 0
+    double delta = 0.25 * c * c - k;
+
+    std::complex< double > lambda( -0.5 * c, 0.0 );
+
+    if ( delta > 0.0 )
+        lambda -= sqrt( delta );
+    else
+        lambda += std::complex< double >( 0.0, sqrt( -delta ) );
+
+    double lambda_abs = std::abs( lambda );
+
+    if ( !( lambda_abs > 0.0 ) ) return DBL_MAX;
+
+    std::complex< double > dir = lambda / lambda_abs;
+
+    // stability function of the Runge-Kutta 4th order method
+    // R(z) = 1 + z + z^2/2 + z^3/6 + z^4/24, stable for |R(z)| <= 1
+    const double step_max = 4.0;
+    const double step_inc = 0.05;
+
+    double s_stable = 0.0;
+    double s_unstable = step_max;
+
+    for ( double s = step_inc; s < step_max; s += step_inc )
+    {
+        std::complex< double > z = s * dir;
+        std::complex< double > r = 1.0 + z * ( 1.0 + z * ( 1.0 + z * ( 1.0 + z / 4.0 ) / 3.0 ) / 2.0 );
+
+        if ( std::abs( r ) > 1.0 )
+        {
+            s_unstable = s;
+            break;
+        }
+
+        s_stable = s;
+    }
+
+    // bisection between the last stable and the first unstable point
+    for ( unsigned int i = 0; i < 16; i++ )
+    {
+        double s = 0.5 * ( s_stable + s_unstable );
+
+        std::complex< double > z = s * dir;
+        std::complex< double > r = 1.0 + z * ( 1.0 + z * ( 1.0 + z * ( 1.0 + z / 4.0 ) / 3.0 ) / 2.0 );
+
+        if ( std::abs( r ) > 1.0 )
+            s_unstable = s;
+        else
+            s_stable = s;
+    }
+
+    return s_stable / lambda_abs;
+}
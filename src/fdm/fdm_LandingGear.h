@@ -39,6 +39,10 @@ namespace fdm
 
 /**
  * @brief Landing gear base class.
+ *
+ * Wheels friction states are advanced by integrate(), which the aircraft
+ * calls once per integration step, or once per contact sub-step when stiff
+ * ground contact requires the step to be split, see getStepLimit().
  */
 class FDMEXPORT LandingGear : public Module
 {
@@ -49,6 +53,7 @@ public:
     {
         DataRef input;      ///< input data reference
         Wheel   wheel;      ///< wheel model object
+        Wheel::State saved; ///< wheel state saved by saveState()
     };
 
     typedef Map< std::string, WheelAndInput > Wheels;
@@ -74,6 +79,32 @@ public:
     /** @brief Updates landing gear. */
     virtual void update();
 
+    /**
+     * @brief Integrates wheels friction states.
+     * @param timeStep [s] time step
+     */
+    virtual void integrate( double timeStep );
+
+    /**
+     * @brief Saves wheels friction states.
+     * Struts have no state of their own, their deflections follow from
+     * the aircraft state vector.
+     */
+    virtual void saveState();
+
+    /** @brief Restores wheels friction states saved by saveState(). */
+    virtual void restoreState();
+
+    /**
+     * @brief Returns maximum integration step for the current ground contact.
+     * Contact stiffness and damping of all wheels in contact, referred to
+     * the aircraft effective mass at contact points, bound the magnitude of
+     * the fastest contact eigenvalues. Step limit keeps their products with
+     * the time step within the Runge-Kutta 4th order stability region.
+     * @return [s] maximum time step, DBL_MAX if no wheel is in contact
+     */
+    virtual double getStepLimit() const;
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -86,6 +117,8 @@ protected:
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
     Vector3 _mom_bas;           ///< [N*m] total moment vector expressed in BAS
 
+    Wheels _wheels;             ///< wheels container
+
     double _ctrlAngle;          ///< [rad] wheel turn angle
 
     double _brake_l;            ///< <0.0;1.0> normalized brake force (left brake group)
@@ -119,6 +152,24 @@ protected:
 
     virtual int readWheelsData( XmlNode &dataNode, Wheels &wheels );
 
+    /**
+     * @brief Returns aircraft effective mass at the given point and direction.
+     * @param r_bas [m] point coordinates relative to the center of mass expressed in BAS
+     * @param d_bas [-] unit direction vector expressed in BAS
+     * @return [kg] effective mass
+     */
+    double getMassEff( const Vector3 &r_bas, const Vector3 &d_bas ) const;
+
+    /**
+     * @brief Returns maximum Runge-Kutta 4th order step for an oscillator.
+     * Step is the distance along the fastest eigenvalue direction of
+     * x'' + c*x' + k*x = 0 to the boundary of the stability region.
+     * @param k [1/s^2] stiffness to mass ratio
+     * @param c [1/s] damping to mass ratio
+     * @return [s] maximum time step, DBL_MAX if both coefficients are zero
+     */
+    static double getStepLimitRK4( double k, double c );
+
 private:
 
     /** Using this constructor is forbidden. */
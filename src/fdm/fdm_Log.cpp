@@ -22,18 +22,9 @@
 
 #include <fdm/fdm_Log.h>
 
-#include <ctime>
-#include <iomanip>
 #include <iostream>
-#include <cmath>
 
-#ifdef _LINUX_
-#   include <sys/time.h>
-#endif
-
-#ifdef WIN32
-#   include <Windows.h>
-#endif
+#include <fdm/fdm_LogWriter.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -45,58 +36,67 @@ std::ostream& Log::_out = std::cerr;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static LogWriter writer( Log::_out );
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Log::start()
+{
+    writer.start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Log::stop()
+{
+    writer.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Log::flush()
+{
+    writer.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Log::isAsync()
+{
+    return writer.isRunning();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned long Log::getDropped()
+{
+    return writer.getDropped();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 std::ostream& Log::timeTag()
 {
-    int year = 2000;
-    int mon  = 1;
-    int day  = 1;
-    int hour = 0;
-    int min  = 0;
-    int sec  = 0;
-    int msec = 0;
-
-#   ifdef _LINUX_
-    struct timeval tp;
-    gettimeofday( &tp, NULL );
-    std::tm *tm = std::localtime( &tp.tv_sec );
-
-    year = 1900 + tm->tm_year;
-    mon  = tm->tm_mon + 1;
-    day  = tm->tm_mday;
-    hour = tm->tm_hour;
-    min  = tm->tm_min;
-    sec  = tm->tm_sec;
-    msec = floor( tp.tv_usec * 0.001 );
-#   endif
-
-#   ifdef WIN32
-    SYSTEMTIME st;
-    GetLocalTime( &st );
-
-    year = st.wYear;
-    mon  = st.wMonth;
-    day  = st.wDay;
-    hour = st.wHour;
-    min  = st.wMinute;
-    sec  = st.wSecond;
-    msec = st.wMilliseconds;
-#   endif
-
-    _out << "[";
-    _out << year;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << mon;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << day;
-    _out << " ";
-    _out << std::setfill('0') << std::setw( 2 ) << hour;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << min;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << sec;
-    _out << ".";
-    _out << std::setfill('0') << std::setw( 3 ) << msec;
-    _out << "]";
+    return LogWriter::timeTag( _out, LogWriter::now() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& Log::stream( Level level )
+{
+    if ( writer.isRunning() )
+    {
+        thread_local LogWriter::Stream stream( &writer );
+
+        stream.begin( level );
+
+        return stream;
+    }
+
+    if ( level != Out )
+    {
+        return timeTag() << LogWriter::levelTag( level );
+    }
 
     return _out;
 }
@@ -35,25 +35,80 @@ namespace fdm
 
 /**
  * @brief Logging class.
+ *
+ * By default messages are written synchronously to the log output stream.
+ * After calling start() each thread streams its messages into its own
+ * thread local buffer, complete messages (terminated with std::endl or
+ * std::flush) are pushed as fixed size records into the thread lock-free
+ * ring buffer and formatted and written by the background thread, so the
+ * logging thread never waits for the output stream.
+ *
+ * @see LogWriter
  */
 class FDMEXPORT Log
 {
 public:
 
+    /** Message levels. */
+    enum Level
+    {
+        Out = 0,                ///< plain output, no time tag
+        Info,                   ///< information
+        Warning,                ///< warning
+        Error                   ///< error
+    };
+
     static std::ostream &_out;  ///< log output stream
 
-    inline static std::ostream& i() { return ( timeTag() << "[INFO] "    ); }
-    inline static std::ostream& w() { return ( timeTag() << "[WARNING] " ); }
-    inline static std::ostream& e() { return ( timeTag() << "[ERROR] "   ); }
-    inline static std::ostream& o() { return _out; }
+    inline static std::ostream& i() { return stream( Info    ); }
+    inline static std::ostream& w() { return stream( Warning ); }
+    inline static std::ostream& e() { return stream( Error   ); }
+    inline static std::ostream& o() { return stream( Out     ); }
+
+    inline static std::ostream& out() { return stream( Out ); }
+
+    /**
+     * @brief Starts asynchronous logging background thread.
+     * Does nothing if it is already running.
+     */
+    static void start();
+
+    /**
+     * @brief Writes all pending messages and stops asynchronous logging
+     * background thread. Logging falls back to synchronous mode.
+     */
+    static void stop();
+
+    /**
+     * @brief Waits until all messages completed before this call are written.
+     * Does nothing in synchronous mode.
+     */
+    static void flush();
 
-    inline static std::ostream& out() { return _out; }
+    /**
+     * @brief Checks if asynchronous logging is running.
+     * @return true if asynchronous logging is running, false otherwise
+     */
+    static bool isAsync();
+
+    /**
+     * @brief Returns number of messages dropped so far due to full buffers.
+     * @return number of dropped messages
+     */
+    static unsigned long getDropped();
 
     /**
      * @brief Creates time tag.
      * @return output stream
      */
     static std::ostream& timeTag();
+
+    /**
+     * @brief Returns message stream of the given level.
+     * @param level message level
+     * @return output stream
+     */
+    static std::ostream& stream( Level level );
 };
 
 } // end of fdm namespace
@@ -0,0 +1,499 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/fdm_LogWriter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogWriter::Stream::Stream( LogWriter *writer ) :
+    std::ostream ( this ),
+    _writer ( writer ),
+    _channel ( writer->attach() ),
+    _level ( 0 ),
+    _head ( true )
+{
+    setp( _text, _text + _text_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogWriter::Stream::~Stream()
+{
+    push( true );
+    _channel->closed.store( true, std::memory_order_release );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::Stream::begin( int level )
+{
+    push( true );
+
+    _level = level;
+    _head  = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::streambuf::int_type LogWriter::Stream::overflow( std::streambuf::int_type c )
+{
+    push( false );
+    _head = false;
+
+    if ( !std::streambuf::traits_type::eq_int_type( c, std::streambuf::traits_type::eof() ) )
+    {
+        *pptr() = std::streambuf::traits_type::to_char_type( c );
+        pbump( 1 );
+    }
+
+    return std::streambuf::traits_type::not_eof( c );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int LogWriter::Stream::sync()
+{
+    push( true );
+    _head = true;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::Stream::push( bool tail )
+{
+    unsigned int size = (unsigned int)( pptr() - pbase() );
+
+    // empty tail record ends message which has already been split
+    if ( size > 0 || ( tail && !_head ) )
+    {
+        Record *record = _channel->ring.reserve();
+
+        if ( record )
+        {
+            record->seq   = _writer->_seq.fetch_add( 1, std::memory_order_relaxed );
+            record->time  = now();
+            record->size  = size;
+            record->level = _level;
+            record->head  = _head;
+            record->tail  = tail;
+
+            memcpy( record->text, _text, size );
+
+            _channel->ring.commit();
+        }
+        else
+        {
+            _channel->dropped.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        setp( _text, _text + _text_size );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+long long LogWriter::now()
+{
+    return std::chrono::duration_cast< std::chrono::microseconds >(
+                std::chrono::system_clock::now().time_since_epoch() ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& LogWriter::timeTag( std::ostream &out, long long time )
+{
+    std::time_t sec = (std::time_t)( time / 1000000 );
+    int msec = (int)( ( time % 1000000 ) / 1000 );
+
+    std::tm tm;
+
+#   ifdef WIN32
+    localtime_s( &tm, &sec );
+#   else
+    localtime_r( &sec, &tm );
+#   endif
+
+    char fill = out.fill( '0' );
+
+    out << "[";
+    out << 1900 + tm.tm_year;
+    out << "-";
+    out << std::setw( 2 ) << tm.tm_mon + 1;
+    out << "-";
+    out << std::setw( 2 ) << tm.tm_mday;
+    out << " ";
+    out << std::setw( 2 ) << tm.tm_hour;
+    out << ":";
+    out << std::setw( 2 ) << tm.tm_min;
+    out << ":";
+    out << std::setw( 2 ) << tm.tm_sec;
+    out << ".";
+    out << std::setw( 3 ) << msec;
+    out << "]";
+
+    out.fill( fill );
+
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* LogWriter::levelTag( int level )
+{
+    switch ( level )
+    {
+        case 1: return "[INFO] ";
+        case 2: return "[WARNING] ";
+        case 3: return "[ERROR] ";
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogWriter::LogWriter( std::ostream &out ) :
+    _out ( out ),
+    _seq ( 0 ),
+    _dropped ( 0 ),
+    _running ( false ),
+    _passes ( 0 ),
+    _flush ( false ),
+    _stop ( false ),
+    _last_level ( -1 ),
+    _repeats ( 0 ),
+    _repeat_first ( 0 ),
+    _repeat_last ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogWriter::~LogWriter()
+{
+    stop();
+    process( true );
+
+    // channels of threads still running are left for them to use
+    for ( unsigned int i = 0; i < _channels.size(); i++ )
+    {
+        if ( _channels[ i ]->closed.load( std::memory_order_acquire ) )
+        {
+            FDM_DELPTR( _channels[ i ] );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::start()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    if ( !_thread.joinable() )
+    {
+        _stop = false;
+        _thread = std::thread( &LogWriter::run, this );
+        _running.store( true, std::memory_order_release );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::stop()
+{
+    if ( _thread.joinable() )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _running.store( false, std::memory_order_release );
+            _stop = true;
+        }
+
+        _condition.notify_all();
+        _thread.join();
+
+        // records pushed by threads which have not noticed stop yet
+        process( true );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::flush()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    if ( _thread.joinable() && !_stop )
+    {
+        unsigned long passes = _passes;
+
+        _flush = true;
+        _condition.notify_all();
+        _flushed.wait( lock, [ this, passes ]() { return _stop || _passes >= passes + 2; } );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogWriter::Channel* LogWriter::attach()
+{
+    Channel *channel = new Channel();
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    _channels.push_back( channel );
+
+    return channel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::run()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    while ( !_stop )
+    {
+        bool flush = _flush;
+        _flush = false;
+
+        lock.unlock();
+        process( flush );
+        lock.lock();
+
+        _passes++;
+        _flushed.notify_all();
+
+        if ( !_stop && !_flush )
+        {
+            _condition.wait_for( lock, std::chrono::microseconds( _period ) );
+        }
+    }
+
+    _flushed.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::process( bool flush )
+{
+    unsigned long dropped = 0;
+
+    // taking snapshot of channels, closed and drained channels are removed
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        std::vector< Channel* >::iterator it = _channels.begin();
+
+        while ( it != _channels.end() )
+        {
+            if ( (*it)->closed.load( std::memory_order_acquire ) && (*it)->ring.isEmpty() )
+            {
+                dropped += (*it)->dropped.load();
+                delete (*it);
+                it = _channels.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        _active = _channels;
+    }
+
+    // incomplete messages are not waited for when writer is stopping
+    const bool final = !isRunning();
+    const long long time = now();
+
+    // messages newer than the oldest incomplete one are held back
+    unsigned long long limit = ULLONG_MAX;
+
+    _messages.clear();
+    _counts.assign( _active.size(), 0 );
+
+    for ( unsigned int i = 0; i < _active.size(); i++ )
+    {
+        dropped += _active[ i ]->dropped.exchange( 0 );
+
+        // closed flag is read before records, so no record can follow it
+        const bool closed = _active[ i ]->closed.load( std::memory_order_acquire );
+
+        // records are read in place and released after being written
+        unsigned int count = 0;
+        const Record *record = _active[ i ]->ring.front( count );
+
+        Message message;
+        bool open = false;
+        long long head_time = 0;
+
+        while ( record )
+        {
+            // continuation record without its head (dropped or written
+            // partially) is treated as a separate message
+            if ( record->head || !open )
+            {
+                // new head ends previous message even if its tail was dropped
+                if ( open ) _messages.push_back( message );
+
+                message.seq     = record->seq;
+                message.channel = i;
+                message.first   = count;
+                message.count   = 0;
+
+                head_time = record->time;
+                open = true;
+            }
+
+            message.count++;
+
+            if ( record->tail )
+            {
+                _messages.push_back( message );
+                open = false;
+            }
+
+            record = _active[ i ]->ring.front( ++count );
+        }
+
+        if ( open )
+        {
+            if ( closed || final || time - head_time >= _hold )
+            {
+                _messages.push_back( message );
+            }
+            else
+            {
+                limit = std::min( limit, message.seq );
+            }
+        }
+    }
+
+    std::sort( _messages.begin(), _messages.end(),
+               []( const Message &m1, const Message &m2 )
+               {
+                   return m1.seq < m2.seq;
+               } );
+
+    unsigned int written = 0;
+
+    // sequence numbers of a channel messages are increasing, so messages
+    // written from every channel are always leading ones
+    while ( written < _messages.size() && _messages[ written ].seq < limit )
+    {
+        const Message &message = _messages[ written ];
+
+        write( message );
+        _counts[ message.channel ] = message.first + message.count;
+
+        written++;
+    }
+
+    for ( unsigned int i = 0; i < _active.size(); i++ )
+    {
+        _active[ i ]->ring.pop( _counts[ i ] );
+    }
+
+    if ( _repeats > 0 && ( flush || now() - _repeat_first >= _repeat ) )
+    {
+        writeRepeats();
+    }
+
+    if ( dropped > 0 )
+    {
+        _dropped.fetch_add( dropped );
+        timeTag( _out, now() ) << levelTag( 2 ) << dropped << " log messages dropped" << "\n";
+    }
+
+    if ( written > 0 || dropped > 0 || flush )
+    {
+        _out.flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::write( const Message &message )
+{
+    const Ring &ring = _active[ message.channel ]->ring;
+    const Record *head = ring.front( message.first );
+
+    _text.clear();
+
+    for ( unsigned int i = 0; i < message.count; i++ )
+    {
+        const Record *record = ring.front( message.first + i );
+        _text.append( record->text, record->size );
+    }
+
+    if ( head->head && head->level != 0 )
+    {
+        if ( head->level == _last_level && _text == _last )
+        {
+            if ( _repeats == 0 ) _repeat_first = head->time;
+            _repeat_last = head->time;
+            _repeats++;
+            return;
+        }
+
+        writeRepeats();
+
+        _last = _text;
+        _last_level = head->level;
+
+        timeTag( _out, head->time ) << levelTag( head->level );
+    }
+    else
+    {
+        writeRepeats();
+
+        _last.clear();
+        _last_level = -1;
+    }
+
+    _out.write( _text.data(), _text.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogWriter::writeRepeats()
+{
+    if ( _repeats > 0 )
+    {
+        timeTag( _out, _repeat_last ) << levelTag( _last_level );
+        _out << "last message repeated " << _repeats << " times" << "\n";
+
+        _repeats = 0;
+    }
+}
@@ -0,0 +1,265 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_LOGWRITER_H
+#define FDM_LOGWRITER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_RingBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Asynchronous log writer class.
+ *
+ * Each logging thread owns a channel with a single producer single consumer
+ * ring buffer of fixed size records. Channel is registered once, when
+ * the thread logs for the first time, afterwards logging thread only copies
+ * message text into the ring buffer. When ring buffer is full the message
+ * is dropped and counted instead of blocking the logging thread.
+ *
+ * Messages longer than a single record are split into continuation
+ * records, the last record of a message is marked as its tail.
+ *
+ * Background thread groups records of each channel into messages and
+ * merges messages of all channels in order of their first records global
+ * sequence numbers, creates time tags and writes messages to the output
+ * stream as a whole. Message which has not been completed yet holds back
+ * all newer messages, also across passes, but no longer than _hold,
+ * afterwards it is written partially. Repeated messages of the same level
+ * and whole text are collapsed into "last message repeated N times" notice
+ * written when a different message arrives, on flush or at least once
+ * per second.
+ *
+ * @see Log
+ */
+class FDMEXPORT LogWriter
+{
+public:
+
+    static const unsigned int _text_size = 236;     ///< record text size
+    static const unsigned int _ring_size = 1024;    ///< channel ring buffer size
+
+    static const long long _period = 5000;          ///< [us] background thread wake up period
+    static const long long _repeat = 1000000;       ///< [us] repeated messages notice interval
+    static const long long _hold   = 100000;        ///< [us] maximum time incomplete message holds back newer ones
+
+    /** Log record. */
+    struct Record
+    {
+        unsigned long long seq;                     ///< global sequence number
+        long long time;                             ///< [us] time since epoch
+        unsigned short size;                        ///< text size
+        unsigned char level;                        ///< message level
+        bool head;                                  ///< specifies if record starts a message
+        bool tail;                                  ///< specifies if record ends a message
+        char text[ _text_size ];                    ///< message text
+    };
+
+    typedef RingBuffer< Record, _ring_size > Ring;
+
+    /** Logging thread channel. */
+    struct Channel
+    {
+        Ring ring;                                  ///< records ring buffer
+        std::atomic< unsigned long > dropped;       ///< number of dropped records
+        std::atomic< bool > closed;                 ///< specifies if logging thread has exited
+
+        Channel() : dropped ( 0 ), closed ( false ) {}
+    };
+
+    /**
+     * @brief Logging thread message stream.
+     * Text is collected in the local buffer and pushed into the channel
+     * ring buffer on flush (e.g. std::endl) or when local buffer is full.
+     */
+    class FDMEXPORT Stream : private std::streambuf, public std::ostream
+    {
+    public:
+
+        /**
+         * @brief Constructor. Registers new channel.
+         * @param writer log writer
+         */
+        Stream( LogWriter *writer );
+
+        /** @brief Destructor. Pushes pending text and closes channel. */
+        virtual ~Stream();
+
+        /**
+         * @brief Starts new message, pending text is pushed as a separate one.
+         * @param level message level
+         */
+        void begin( int level );
+
+    protected:
+
+        std::streambuf::int_type overflow( std::streambuf::int_type c );
+
+        int sync();
+
+    private:
+
+        LogWriter *_writer;                         ///< log writer
+        Channel   *_channel;                        ///< logging thread channel
+
+        char _text[ _text_size ];                   ///< local text buffer
+
+        unsigned char _level;                       ///< current message level
+        bool _head;                                 ///< specifies if next record starts a message
+
+        /**
+         * @brief Pushes local text buffer into the ring buffer.
+         * @param tail specifies if pushed text ends a message
+         */
+        void push( bool tail );
+    };
+
+    /**
+     * @brief Returns current time.
+     * @return [us] time since epoch
+     */
+    static long long now();
+
+    /**
+     * @brief Writes time tag.
+     * @param out output stream
+     * @param time [us] time since epoch
+     * @return output stream
+     */
+    static std::ostream& timeTag( std::ostream &out, long long time );
+
+    /**
+     * @brief Returns level tag.
+     * @param level message level
+     * @return level tag
+     */
+    static const char* levelTag( int level );
+
+    /**
+     * @brief Constructor.
+     * @param out output stream
+     */
+    LogWriter( std::ostream &out );
+
+    /** @brief Destructor. Stops background thread and writes pending records. */
+    virtual ~LogWriter();
+
+    /** @brief Starts background thread. */
+    void start();
+
+    /** @brief Stops background thread and writes pending records. */
+    void stop();
+
+    /** @brief Waits until all records pushed before this call are written. */
+    void flush();
+
+    inline bool isRunning() const { return _running.load( std::memory_order_acquire ); }
+
+    inline unsigned long getDropped() const { return _dropped.load(); }
+
+private:
+
+    /** Message, consecutive records of a single channel. */
+    struct Message
+    {
+        unsigned long long seq;                     ///< first record global sequence number
+        unsigned int channel;                       ///< channel index
+        unsigned int first;                         ///< first record index in the channel ring buffer
+        unsigned int count;                         ///< number of records
+    };
+
+    std::ostream &_out;                             ///< output stream
+
+    std::vector< Channel* > _channels;              ///< registered channels
+    std::vector< Channel* > _active;                ///< channels being processed (background thread)
+    std::vector< Message > _messages;               ///< messages being written
+    std::vector< unsigned int > _counts;            ///< numbers of records written from channels
+
+    std::thread _thread;                            ///< background thread
+
+    std::mutex _mutex;                              ///< channels and requests mutex
+    std::condition_variable _condition;             ///< background thread wake up condition
+    std::condition_variable _flushed;               ///< pass completed condition
+
+    std::atomic< unsigned long long > _seq;         ///< global sequence number
+    std::atomic< unsigned long > _dropped;          ///< total number of dropped records
+    std::atomic< bool > _running;                   ///< specifies if background thread is running
+
+    unsigned long _passes;                          ///< number of completed passes
+    bool _flush;                                    ///< flush request
+    bool _stop;                                     ///< stop request
+
+    std::string _text;                              ///< message text being written
+    std::string _last;                              ///< last written message text
+    int _last_level;                                ///< last written message level, -1 if none
+    unsigned long _repeats;                         ///< number of suppressed repeats
+    long long _repeat_first;                        ///< [us] time of the first suppressed repeat
+    long long _repeat_last;                         ///< [us] time of the last suppressed repeat
+
+    /**
+     * @brief Registers new channel.
+     * @return new channel
+     */
+    Channel* attach();
+
+    /** @brief Background thread function. */
+    void run();
+
+    /**
+     * @brief Writes records pending in all channels.
+     * @param flush specifies if repeated messages notice should be written
+     */
+    void process( bool flush );
+
+    /**
+     * @brief Writes single message.
+     * @param message message to be written
+     */
+    void write( const Message &message );
+
+    /** @brief Writes repeated messages notice if any. */
+    void writeRepeats();
+
+    /** Using this constructor is forbidden. */
+    LogWriter( const LogWriter &writer ) : _out ( writer._out ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_LOGWRITER_H
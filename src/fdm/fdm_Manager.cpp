@@ -26,6 +26,7 @@
 
 #include <fdm/fdm_Log.h>
 
+#include <fdm/utils/fdm_LatencyTrace.h>
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Time.h>
 #include <fdm/utils/fdm_Units.h>
@@ -57,6 +58,8 @@ Manager::Manager( const DataInp *dataInpPtr, DataOut *dataOutPtr ) :
 
     _fdm ( FDM_NULLPTR ),
 
+    _sharedState ( FDM_NULLPTR ),
+
     _stateInp ( DataInp::Idle ),
     _stateOut ( DataOut::Idle ),
 
@@ -86,6 +89,7 @@ Manager::Manager( const DataInp *dataInpPtr, DataOut *dataOutPtr ) :
 Manager::~Manager()
 {
     FDM_DELPTR( _fdm );
+    FDM_DELPTR( _sharedState );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +119,39 @@ void Manager::step( double timeStep )
     }
 
     _dataOutPtr->stateOut = _stateOut;
+
+    _dataOutPtr->trace = _dataInpPtr->trace;
+    LatencyTrace::record( LatencyTrace::Step, _dataOutPtr->trace );
+
+    if ( _sharedState )
+    {
+        _sharedState->write( *_dataInpPtr, *_dataOutPtr, _realTime );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Manager::openSharedState( const char *name )
+{
+    if ( !_sharedState )
+    {
+        _sharedState = new SharedState();
+    }
+
+    if ( !_sharedState->open( name ) )
+    {
+        FDM_DELPTR( _sharedState );
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::closeSharedState()
+{
+    FDM_DELPTR( _sharedState );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,8 @@
 
 #include <fdm/fdm_FDM.h>
 
+#include <fdm/utils/fdm_SharedState.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -53,6 +55,16 @@ public:
      */
     void step( double timeStep );
 
+    /**
+     * @brief Starts publishing state to shared memory at each step.
+     * @param name shared memory segment name
+     * @return true on success, false on failure
+     */
+    bool openSharedState( const char *name = FDM_SHARED_STATE_NAME );
+
+    /** @brief Stops publishing state to shared memory. */
+    void closeSharedState();
+
     inline bool getVerbose() const { return _verbose; }
 
     inline void setVerbose( bool verbose ) { _verbose = verbose; }
@@ -69,6 +81,8 @@ private:
 
     FDM *_fdm;                      ///< flight dynamics model object
 
+    SharedState *_sharedState;      ///< shared memory state publisher, null if not published
+
     AircraftType _aircraftType;     ///< aircraft type
 
     StateInp _stateInp;             ///< internal state input
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/fdm_Base.h>
+#include <fdm/fdm_Log.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -37,6 +38,14 @@ class Aircraft; // aircraft class forward declaration
 
 /**
  * @brief Module base class.
+ *
+ * Module can be updated at its own rate. Module which rate is lower than
+ * the simulation rate is updated once per its period and its outputs are
+ * held in between (zero-order hold). Module is never updated more than
+ * once per simulation step, as its input state does not change within
+ * the step, so module which rate is higher than the actual simulation rate
+ * is updated every time step. Module update rate equal to zero means it is
+ * updated every time step.
  */
 class FDMEXPORT Module : public Base
 {
@@ -45,7 +54,11 @@ public:
     /** @brief Constructor. */
     Module( const Aircraft *aircraft, Input *input ) :
         Base ( input ),
-        _aircraft ( aircraft )
+        _aircraft ( aircraft ),
+        _rate ( 0.0 ),
+        _elapsed ( 0.0 ),
+        _timeStep ( 0.0 ),
+        _reported ( false )
     {}
 
     /** @brief Destructor. */
@@ -63,12 +76,80 @@ public:
     /** @brief Updates module. */
     virtual void update() = 0;
 
+    /**
+     * @brief Updates module if its update period has elapsed.
+     * @param timeStep [s] simulation time step
+     */
+    void step( double timeStep )
+    {
+        if ( advance( timeStep ) ) update();
+    }
+
+    /** @return [Hz] module update rate, zero means every time step */
+    inline double getRate() const { return _rate; }
+
+    /** @return [s] time step of the current module update */
+    inline double getTimeStep() const { return _timeStep; }
+
+    /**
+     * @brief Sets module update rate.
+     * @param rate [Hz] module update rate, zero means every time step
+     */
+    inline void setRate( double rate )
+    {
+        _rate = ( rate > 0.0 ) ? rate : 0.0;
+        _elapsed = 0.0;
+        _reported = false;
+    }
+
 protected:
 
     const Aircraft *_aircraft;  ///< aircraft model main object
 
+    double _rate;               ///< [Hz] update rate, zero means every time step
+    double _elapsed;            ///< [s] time elapsed since the last update
+    double _timeStep;           ///< [s] time step of the current update
+
 private:
 
+    bool _reported;             ///< specifies if rate higher than simulation rate has been reported
+
+    /**
+     * @brief Advances module time.
+     * @param timeStep [s] simulation time step
+     * @return true if module has to be updated, false otherwise
+     */
+    bool advance( double timeStep )
+    {
+        if ( _rate > 0.0 && timeStep > 0.0 )
+        {
+            _elapsed += timeStep;
+
+            // checked against the actual time step, which is not fixed
+            if ( !_reported && timeStep * _rate > 1.0 + 1.0e-6 )
+            {
+                Log::w() << "Module update rate " << _rate << " Hz exceeds simulation rate "
+                         << 1.0 / timeStep << " Hz, module is updated every time step" << std::endl;
+                _reported = true;
+            }
+
+            // at most one update per step, covering the whole elapsed time
+            if ( _elapsed * _rate + 1.0e-6 >= 1.0 )
+            {
+                _timeStep = _elapsed;
+                _elapsed  = 0.0;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        _timeStep = timeStep;
+
+        return true;
+    }
+
     /** Using this constructor is forbidden. */
     Module( const Module & ) : Base() {}
 };
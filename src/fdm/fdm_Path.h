@@ -55,6 +55,11 @@ public:
      */
     inline static std::string get( const std::string &path )
     {
+        if ( base().length() > 0 )
+        {
+            return base() + path;
+        }
+
 #       ifdef SIM_TEST
         return "../data/" + path;
 #       else
@@ -69,6 +74,30 @@ public:
 
 #       endif // SIM_TEST
     }
+
+    /**
+     * @brief Sets base path overriding the default one, e.g. to use data
+     * from the source tree rather than installed data.
+     * @param path base path, empty string restores the default one
+     */
+    inline static void setBase( const std::string &path )
+    {
+        base() = path;
+
+        if ( path.length() > 0 && path[ path.length() - 1 ] != '/' )
+        {
+            base() += "/";
+        }
+    }
+
+private:
+
+    /** Returns base path set at runtime. */
+    inline static std::string& base()
+    {
+        static std::string path;
+        return path;
+    }
 };
 
 } // end of fdm namespace
@@ -40,6 +40,8 @@ using namespace fdm;
 
 MainRotor::MainRotor() :
     _ccw ( false ),
+    _dynamicInflow ( false ),
+    _inflowInit ( false ),
 
     _nb ( 0 ),
 
@@ -101,7 +103,12 @@ MainRotor::MainRotor() :
 
     _vel_i ( 0.0 ),
 
-    _wakeSkew ( 0.0 )
+    _wakeSkew ( 0.0 ),
+
+    _lambda_i ( 0.0 ),
+    _v_t ( 0.0 ),
+
+    _iterations ( 0 )
 {
     _bas2ras  = Matrix3x3::identityMatrix();
     _ras2bas  = Matrix3x3::identityMatrix();
@@ -130,6 +137,9 @@ void MainRotor::readData( XmlNode &dataNode )
 
         _ccw = String::toBool( dataNode.getAttribute( "counter-clockwise" ), false );
 
+        _dynamicInflow = String::toBool( dataNode.getAttribute( "dynamic-inflow" ), false );
+        _inflowInit = false;
+
         double blade_mass  = 0.0;
         double inclination = 0.0;
 
@@ -285,16 +295,23 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
     // thrust coefficient
     _ct = 0.0;
 
+    // dynamic inflow state is initialized with quasi-steady solution
+    const bool dynamicInflow = _dynamicInflow && _inflowInit;
+
     // rotor inflow
-    double lambda_i = _vel_i / omegaR;
+    double lambda_i = dynamicInflow ? _lambda_i : ( _vel_i / omegaR );
 
     if ( fabs( lambda_i ) < 10e-14 ) lambda_i = 10e-14;
 
     // TODO Young approximation
 
     // iteration loop
+    _iterations = 0;
+
     for ( int i = 0; i < 100; i++ )
     {
+        _iterations++;
+
         lambda = mu_z - lambda_i;
 
         // flapping coefficients
@@ -343,6 +360,14 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
 
         // zero function (Padfield p.124)
         double lambda_d = mu2 + lambda * lambda;
+
+        // inflow is a state, no need to iterate
+        if ( dynamicInflow )
+        {
+            _v_t = sqrt( lambda_d );
+            break;
+        }
+
         double g_0 = lambda_i - _ct / ( 2.0 * sqrt( lambda_d ) );
 
         // break condition
@@ -410,6 +435,13 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
     //double beta_das = Aerodynamics::getSideslipAngle( vel_air_das );
     //Matrix3x3 dwas2das = Matrix3x3( Angles( 0.0, 0.0, beta_das ) ).getTransposed();
 
+    if ( _dynamicInflow && !_inflowInit )
+    {
+        _lambda_i = lambda_i;
+        _v_t = sqrt( mu2 + lambda * lambda );
+        _inflowInit = true;
+    }
+
     // induced velocity (Padfield p.117)
     _vel_i = _vel_i_factor * lambda_i * omegaR;
 
@@ -461,3 +493,19 @@ void MainRotor::update( double omega,
     _theta_1s =  cyclicLon;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotor::integrate( double timeStep )
+{
+    if ( _dynamicInflow && _inflowInit && _omega > 0.0 && _v_t > 0.0 )
+    {
+        // Pitt-Peters uniform inflow equation
+        // M * d(lambda_i)/d(psi) + 2 * V_T * lambda_i = C_T , M = 8/(3*pi)
+        double lambda_i_ss = _ct / ( 2.0 * _v_t );
+        double tc = 8.0 / ( 3.0 * M_PI * 2.0 * _v_t * _omega );
+
+        double lambda_i_new = Misc::inertia( lambda_i_ss, _lambda_i, timeStep, tc );
+
+        if ( Misc::isValid( lambda_i_new ) ) _lambda_i = lambda_i_new;
+    }
+}
@@ -74,7 +74,7 @@ namespace fdm
  *
  * XML configuration file format:
  * @code
- * <main_rotor>
+ * <main_rotor [counter-clockwise="{ 0|1 }"] [dynamic-inflow="{ 0|1 }"]>
  *   <hub_center> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </hub_center>
  *   <inclination> { [rad] rotor inclination angle (positive if forward) } </inclination>
  *   <number_of_blades> { number of blades } </number_of_blades>
@@ -99,12 +99,18 @@ namespace fdm
  *
  * Optional elements: "thrust_factor", "torque_factor", "vel_i_factor"
  *
+ * By default the rotor inflow is solved iteratively at every evaluation
+ * (Padfield p.124). If "dynamic-inflow" attribute is set the uniform inflow
+ * is a state governed by the Pitt-Peters equation, which is integrated once
+ * per time step (see integrate()), so evaluation cost is constant.
+ *
  * @see Mil M.: Helicopters: Calculation and Design. Volume 1: Aerodynamics, NASA, TM-X-74335, 1967
  * @see Gessow A., Myers G.: Aerodynamics of the Helicopter, 1985
  * @see Bramwell A.: Bramwells Helicopter Dynamics, 2001
  * @see Padfield G.: Helicopter Flight Dynamics, 2007
  * @see Stepniewski W.: Rotary-Wing Aerodynamics. Volume I: Basic Theories of Rotor Aerodynamics, 1984
  * @see Johnson W.: Helicopter Theory, 1980
+ * @see Pitt D., Peters D.: Theoretical Prediction of Dynamic-Inflow Derivatives, 1981
  */
 class FDMEXPORT MainRotor
 {
@@ -156,6 +162,13 @@ public:
                          double cyclicLat,
                          double cyclicLon );
 
+    /**
+     * @brief Integrates dynamic inflow state.
+     * Does nothing if dynamic inflow is disabled.
+     * @param timeStep [s] time step
+     */
+    virtual void integrate( double timeStep );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -193,6 +206,16 @@ public:
 
     inline double getWakeSkew() const { return _wakeSkew; }
 
+    inline bool getDynamicInflow() const { return _dynamicInflow; }
+
+    /**
+     * @brief Returns number of inflow solver iterations of the last evaluation.
+     * @return number of inflow solver iterations (1 if dynamic inflow is used)
+     */
+    inline int getIterations() const { return _iterations; }
+
+    inline void setDynamicInflow( bool dynamicInflow ) { _dynamicInflow = dynamicInflow; }
+
 protected:
 
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
@@ -221,6 +244,8 @@ protected:
     Matrix3x3 _cwas2bas;        ///< matrix of rotation from CWAS to BAS
 
     bool _ccw;                  ///< specifies if rotor rotation direction is counter-clockwise
+    bool _dynamicInflow;        ///< specifies if dynamic inflow model is used
+    bool _inflowInit;           ///< specifies if dynamic inflow state is initialized
 
     int _nb;                    ///< number of rotor blades
 
@@ -285,6 +310,11 @@ protected:
     double _vel_i;              ///< [m/s] rotor induced velocity
 
     double _wakeSkew;           ///< [rad] rotor wake skew angle
+
+    double _lambda_i;           ///< [-] dynamic inflow state (uniform inflow ratio)
+    double _v_t;                ///< [-] mass flow parameter
+
+    int _iterations;            ///< number of inflow solver iterations of the last evaluation
 };
 
 } // end of fdm namespace
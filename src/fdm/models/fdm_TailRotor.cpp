@@ -23,6 +23,8 @@
 #include <fdm/models/fdm_TailRotor.h>
 #include <fdm/fdm_Aerodynamics.h>
 
+#include <fdm/utils/fdm_String.h>
+
 #include <fdm/xml/fdm_XmlUtils.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +34,9 @@ using namespace fdm;
 ////////////////////////////////////////////////////////////////////////////////
 
 TailRotor::TailRotor() :
+    _dynamicInflow ( false ),
+    _inflowInit ( false ),
+
     _nb ( 0 ),
 
     _r ( 0.0 ),
@@ -60,7 +65,14 @@ TailRotor::TailRotor() :
     _theta ( 0.0 ),
 
     _thrust ( 0.0 ),
-    _torque ( 0.0 )
+    _torque ( 0.0 ),
+
+    _ct ( 0.0 ),
+
+    _lambda_i ( 0.0 ),
+    _v_t ( 0.0 ),
+
+    _iterations ( 0 )
 {
     _bas2ras = Matrix3x3::identityMatrix();
     _ras2bas = Matrix3x3::identityMatrix();
@@ -81,6 +93,9 @@ void TailRotor::readData( XmlNode &dataNode )
         double cant_angle = 0.0;
         double blade_mass = 0.0;
 
+        _dynamicInflow = String::toBool( dataNode.getAttribute( "dynamic-inflow" ), false );
+        _inflowInit = false;
+
         _ct_max = DBL_MAX;
         _cq_max = DBL_MAX;
 
@@ -165,14 +180,21 @@ void TailRotor::computeForceAndMoment( const Vector3 &vel_air_bas,
     // thrust coefficient
     double ct = 0.0;
 
+    // dynamic inflow state is initialized with quasi-steady solution
+    const bool dynamicInflow = _dynamicInflow && _inflowInit;
+
     // rotor inflow
-    double lambda_i = _vel_i_bas.getLength() / omegaR;
+    double lambda_i = dynamicInflow ? _lambda_i : ( _vel_i_bas.getLength() / omegaR );
 
     if ( fabs( lambda_i ) < 10e-14 ) lambda_i = 10e-14;
 
     // iteration loopp
+    _iterations = 0;
+
     for ( int i = 0; i < 100; i++ )
     {
+        _iterations++;
+
         lambda = mu_z - lambda_i;
 
         // thrust coefficient
@@ -181,6 +203,14 @@ void TailRotor::computeForceAndMoment( const Vector3 &vel_air_bas,
 
         // zero function (Padfield p.124)
         double lambda_d = mu2 + lambda * lambda;
+
+        // inflow is a state, no need to iterate
+        if ( dynamicInflow )
+        {
+            _v_t = sqrt( lambda_d );
+            break;
+        }
+
         double g_0 = lambda_i - ct / ( 2.0 * sqrt( lambda_d ) );
 
         // break condition
@@ -200,6 +230,15 @@ void TailRotor::computeForceAndMoment( const Vector3 &vel_air_bas,
         if ( Misc::isValid( lambda_i_new ) ) lambda_i = lambda_i_new;
     }
 
+    _ct = ct;
+
+    if ( _dynamicInflow && !_inflowInit )
+    {
+        _lambda_i = lambda_i;
+        _v_t = sqrt( mu2 + lambda * lambda );
+        _inflowInit = true;
+    }
+
     // drag coefficient
     double cd = _delta_0 + _delta_2 * ct*ct;
 
@@ -234,3 +273,20 @@ void TailRotor::update( double omega, double theta )
     _omega = omega;
     _theta = theta;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TailRotor::integrate( double timeStep )
+{
+    if ( _dynamicInflow && _inflowInit && _omega > 0.0 && _v_t > 0.0 )
+    {
+        // Pitt-Peters uniform inflow equation
+        // M * d(lambda_i)/d(psi) + 2 * V_T * lambda_i = C_T , M = 8/(3*pi)
+        double lambda_i_ss = _ct / ( 2.0 * _v_t );
+        double tc = 8.0 / ( 3.0 * M_PI * 2.0 * _v_t * _omega );
+
+        double lambda_i_new = Misc::inertia( lambda_i_ss, _lambda_i, timeStep, tc );
+
+        if ( Misc::isValid( lambda_i_new ) ) _lambda_i = lambda_i_new;
+    }
+}
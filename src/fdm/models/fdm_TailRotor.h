@@ -40,7 +40,7 @@ namespace fdm
  *
  * XML configuration file format:
  * @code
- * <tail_rotor>
+ * <tail_rotor [dynamic-inflow="{ 0|1 }"]>
  *   <hub_center> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </hub_center>
  *   <cant_angle> { [rad] cant angle } </cant_angle>
  *   <number_of_blades> { number of blades } </number_of_blades>
@@ -61,10 +61,13 @@ namespace fdm
  *
  * Optional elements: "thrust_factor", "torque_factor", "vel_i_factor"
  *
+ * Dynamic inflow is optional, see MainRotor.
+ *
  * @see Gessow A., Myers G.: Aerodynamics of the Helicopter, 1985
  * @see Bramwell A.: Bramwells Helicopter Dynamics, 2001
  * @see Padfield G.: Helicopter Flight Dynamics, 2007
  * @see Johnson W.: Helicopter Theory, 1980
+ * @see Pitt D., Peters D.: Theoretical Prediction of Dynamic-Inflow Derivatives, 1981
  */
 class FDMEXPORT TailRotor
 {
@@ -99,6 +102,13 @@ public:
      */
     virtual void update( double omega, double collective );
 
+    /**
+     * @brief Integrates dynamic inflow state.
+     * Does nothing if dynamic inflow is disabled.
+     * @param timeStep [s] time step
+     */
+    virtual void integrate( double timeStep );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -109,6 +119,16 @@ public:
     inline double getThrust() const { return _thrust; }
     inline double getTorque() const { return _torque; }
 
+    inline bool getDynamicInflow() const { return _dynamicInflow; }
+
+    /**
+     * @brief Returns number of inflow solver iterations of the last evaluation.
+     * @return number of inflow solver iterations (1 if dynamic inflow is used)
+     */
+    inline int getIterations() const { return _iterations; }
+
+    inline void setDynamicInflow( bool dynamicInflow ) { _dynamicInflow = dynamicInflow; }
+
 protected:
 
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
@@ -121,6 +141,9 @@ protected:
 
     Vector3 _vel_i_bas;         ///< [m/s] induced velocity
 
+    bool _dynamicInflow;        ///< specifies if dynamic inflow model is used
+    bool _inflowInit;           ///< specifies if dynamic inflow state is initialized
+
     int _nb;                    ///< number of rotor blades
 
     double _r;                  ///< [m] rotor radius
@@ -152,6 +175,13 @@ protected:
 
     double _thrust;             ///< [N] rotor thrust
     double _torque;             ///< [N*m] rotor torque
+
+    double _ct;                 ///< [-] thrust coefficient
+
+    double _lambda_i;           ///< [-] dynamic inflow state (uniform inflow ratio)
+    double _v_t;                ///< [-] mass flow parameter
+
+    int _iterations;            ///< number of inflow solver iterations of the last evaluation
 };
 
 } // end of fdm namespace
@@ -0,0 +1,333 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/models/fdm_Turbulence.h>
+
+#include <cmath>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const double Turbulence::_v_min = 5.0;
+const double Turbulence::_h_min = 3.048;
+
+const double Turbulence::_h_high[] = { 500.0, 1750.0, 3750.0, 7500.0, 15000.0, 25000.0,
+                                       35000.0, 45000.0, 55000.0, 65000.0, 75000.0, 80000.0 };
+
+// MIL-F-8785C, Figure 7, p. 49
+const double Turbulence::_sigma_high[][ 12 ] = {
+    {  6.6,  6.9,  7.4,  6.7,  4.6,  2.7,  0.4,  0.0,  0.0,  0.0, 0.0, 0.0 },   // 10^-2
+    {  8.6,  9.6, 10.6, 10.1,  8.0,  6.6,  5.0,  4.2,  2.7,  0.0, 0.0, 0.0 },   // 10^-3
+    { 15.6, 18.0, 23.0, 23.6, 22.1, 20.0, 16.0, 15.1, 12.1,  7.9, 6.2, 5.1 },   // 10^-5
+    { 18.7, 21.5, 28.4, 30.2, 30.7, 31.0, 25.2, 23.1, 17.5, 10.7, 8.4, 7.2 }    // 10^-6
+};
+
+const double Turbulence::_w_20_kts[] = { 15.0, 30.0, 45.0, 60.0 };
+
+const double Turbulence::Stream::_d_xi = 0.02;
+const unsigned int Turbulence::Stream::_block_size = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Turbulence::Stream::Stream() :
+    _order ( 1 ),
+    _pos ( 0.0 )
+{
+    _phi[ 0 ][ 0 ] = 0.0; _phi[ 0 ][ 1 ] = 0.0; _phi[ 1 ][ 0 ] = 0.0; _phi[ 1 ][ 1 ] = 0.0;
+    _l[ 0 ][ 0 ] = 0.0; _l[ 0 ][ 1 ] = 0.0; _l[ 1 ][ 0 ] = 0.0; _l[ 1 ][ 1 ] = 0.0;
+    _x[ 0 ] = 0.0; _x[ 1 ] = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::Stream::reset( unsigned int seed, unsigned int index, int order )
+{
+    std::seed_seq seq { seed, index };
+    _gen.seed( seq );
+
+    _order = order;
+
+    double e_1 = exp( -_d_xi );
+    double e_2 = exp( -2.0 * _d_xi );
+
+    if ( _order == 1 )
+    {
+        // first order Gauss-Markov process: y' = -y + sqrt(2)*n
+        _phi[ 0 ][ 0 ] = e_1;
+        _l[ 0 ][ 0 ] = sqrt( 1.0 - e_2 );
+
+        _x[ 0 ] = getNormal();
+        _x[ 1 ] = 0.0;
+    }
+    else
+    {
+        // second order: x1' = x2, x2' = -x1 - 2*x2 + n, y = x1 + sqrt(3)*x2
+        _phi[ 0 ][ 0 ] = e_1 * ( 1.0 + _d_xi );
+        _phi[ 0 ][ 1 ] = e_1 * _d_xi;
+        _phi[ 1 ][ 0 ] = e_1 * ( -_d_xi );
+        _phi[ 1 ][ 1 ] = e_1 * ( 1.0 - _d_xi );
+
+        // integrals of exp(-2s), s*exp(-2s) and s^2*exp(-2s) over the sample distance
+        double i_0 = 0.5 * ( 1.0 - e_2 );
+        double i_1 = 0.25 - e_2 * ( 0.5 * _d_xi + 0.25 );
+        double i_2 = 0.25 - e_2 * ( 0.5 * _d_xi * _d_xi + 0.5 * _d_xi + 0.25 );
+
+        double q_11 = i_2;
+        double q_12 = i_1 - i_2;
+        double q_22 = i_0 - 2.0 * i_1 + i_2;
+
+        _l[ 0 ][ 0 ] = sqrt( q_11 );
+        _l[ 1 ][ 0 ] = q_12 / _l[ 0 ][ 0 ];
+        _l[ 1 ][ 1 ] = sqrt( q_22 - _l[ 1 ][ 0 ] * _l[ 1 ][ 0 ] );
+
+        // stationary state covariance is diag(1/4,1/4)
+        _x[ 0 ] = 0.5 * getNormal();
+        _x[ 1 ] = 0.5 * getNormal();
+    }
+
+    _samples.resize( _block_size + 1 );
+    _samples[ _block_size ] = _x[ 0 ] + ( _order == 1 ? 0.0 : sqrt( 3.0 ) * _x[ 1 ] );
+
+    generate();
+
+    _pos = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Turbulence::Stream::get( double d_xi )
+{
+    _pos += d_xi / _d_xi;
+
+    while ( _pos >= (double)_block_size )
+    {
+        generate();
+        _pos -= (double)_block_size;
+    }
+
+    unsigned int i = static_cast< unsigned int >( _pos );
+    double coef = _pos - (double)i;
+
+    return _samples[ i ] + coef * ( _samples[ i + 1 ] - _samples[ i ] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::Stream::generate()
+{
+    const double sqrt3 = sqrt( 3.0 );
+
+    _samples[ 0 ] = _samples[ _block_size ];
+
+    for ( unsigned int i = 1; i <= _block_size; i++ )
+    {
+        if ( _order == 1 )
+        {
+            _x[ 0 ] = _phi[ 0 ][ 0 ] * _x[ 0 ] + _l[ 0 ][ 0 ] * getNormal();
+
+            _samples[ i ] = _x[ 0 ];
+        }
+        else
+        {
+            double n_1 = getNormal();
+            double n_2 = getNormal();
+
+            double x_1 = _phi[ 0 ][ 0 ] * _x[ 0 ] + _phi[ 0 ][ 1 ] * _x[ 1 ] + _l[ 0 ][ 0 ] * n_1;
+            double x_2 = _phi[ 1 ][ 0 ] * _x[ 0 ] + _phi[ 1 ][ 1 ] * _x[ 1 ] + _l[ 1 ][ 0 ] * n_1 + _l[ 1 ][ 1 ] * n_2;
+
+            _x[ 0 ] = x_1;
+            _x[ 1 ] = x_2;
+
+            _samples[ i ] = _x[ 0 ] + sqrt3 * _x[ 1 ];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Turbulence::Stream::getNormal()
+{
+    // Box-Muller transform, std::normal_distribution is implementation defined
+    double u_1 = ( (double)_gen() + 0.5 ) / 4294967296.0;
+    double u_2 = (double)_gen() / 4294967296.0;
+
+    return sqrt( -2.0 * log( u_1 ) ) * cos( 2.0 * M_PI * u_2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Turbulence::Turbulence( unsigned int seed ) :
+    _intensity ( None ),
+    _seed ( seed ),
+
+    _span ( 10.0 ),
+    _w_20 ( 0.0 ),
+
+    _v_n ( 0.0 ),
+    _w_n ( 0.0 )
+{
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Turbulence::~Turbulence() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::update( double timeStep, double altitude_agl, double airspeed )
+{
+    if ( _intensity == None ) return;
+
+    double l_uv     = 0.0;
+    double l_w      = 0.0;
+    double sigma_uv = 0.0;
+    double sigma_w  = 0.0;
+
+    getScales( altitude_agl, &l_uv, &l_w, &sigma_uv, &sigma_w );
+
+    double l_p = 4.0 * _span / M_PI;
+    double l_q = 4.0 * _span / M_PI;
+    double l_r = 3.0 * _span / M_PI;
+
+    double vel = Misc::max( airspeed, _v_min );
+    double dist = vel * timeStep;
+
+    double u_n = _stream_u.get( dist / l_uv );
+    double v_n = _stream_v.get( dist / l_uv );
+    double w_n = _stream_w.get( dist / l_w  );
+    double p_n = _stream_p.get( dist / l_p  );
+
+    _vel_bas.u() = sigma_uv * u_n;
+    _vel_bas.v() = sigma_uv * v_n;
+    _vel_bas.w() = sigma_w  * w_n;
+
+    double sigma_p = sigma_w * sqrt( 0.1 * M_PI * M_PI / ( _span * l_w ) )
+                   * pow( M_PI * l_w / ( 4.0 * _span ), 1.0 / 6.0 );
+
+    _omg_bas.p() = sigma_p * p_n;
+
+    if ( dist > 0.0 )
+    {
+        // gust velocities gradients along the flight path
+        double dv_dx = sigma_uv * ( v_n - _v_n ) / dist;
+        double dw_dx = sigma_w  * ( w_n - _w_n ) / dist;
+
+        _omg_bas.q() = Misc::inertia( -dw_dx, _omg_bas.q(), timeStep, l_q / vel );
+        _omg_bas.r() = Misc::inertia(  dv_dx, _omg_bas.r(), timeStep, l_r / vel );
+    }
+
+    _v_n = v_n;
+    _w_n = w_n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::reset()
+{
+    _stream_u.reset( _seed, 0, 1 );
+    _stream_v.reset( _seed, 1, 2 );
+    _stream_w.reset( _seed, 2, 2 );
+    _stream_p.reset( _seed, 3, 1 );
+
+    _v_n = _stream_v.get( 0.0 );
+    _w_n = _stream_w.get( 0.0 );
+
+    _vel_bas.set( 0.0, 0.0, 0.0 );
+    _omg_bas.set( 0.0, 0.0, 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::setIntensity( Intensity intensity )
+{
+    _intensity = intensity;
+
+    if ( _intensity == None )
+    {
+        _vel_bas.set( 0.0, 0.0, 0.0 );
+        _omg_bas.set( 0.0, 0.0, 0.0 );
+    }
+    else
+    {
+        int index = static_cast< int >( _intensity ) - 1;
+
+        std::vector< double > h;
+        std::vector< double > sigma;
+
+        for ( unsigned int i = 0; i < 12; i++ )
+        {
+            h     .push_back( Units::ft2m   ( _h_high[ i ] ) );
+            sigma .push_back( Units::fps2mps( _sigma_high[ index ][ i ] ) );
+        }
+
+        _sigma_w_high = Table1( h, sigma );
+
+        _w_20 = Units::kts2mps( _w_20_kts[ index ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::setSeed( unsigned int seed )
+{
+    _seed = seed;
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::getScales( double h, double *l_uv, double *l_w,
+                            double *sigma_uv, double *sigma_w ) const
+{
+    double h_ft = Units::m2ft( Misc::max( h, _h_min ) );
+
+    // low altitude model is valid below 1000 ft, high altitude model above
+    // 2000 ft, both are linearly interpolated in between
+    double h_lo = Misc::min( h_ft, 1000.0 );
+    double h_hi = Misc::max( h_ft, 2000.0 );
+
+    double coef = Misc::satur( 0.0, 1.0, ( h_ft - 1000.0 ) / 1000.0 );
+
+    double c_lo = 0.177 + 0.000823 * h_lo;
+
+    double l_w_lo  = Units::ft2m( h_lo );
+    double l_uv_lo = l_w_lo / pow( c_lo, 1.2 );
+
+    double sigma_w_lo  = 0.1 * _w_20;
+    double sigma_uv_lo = sigma_w_lo / pow( c_lo, 0.4 );
+
+    double l_hi = Units::ft2m( 1750.0 );
+
+    double sigma_hi = _sigma_w_high.getValue( Units::ft2m( h_hi ) );
+
+    *l_uv = l_uv_lo + coef * ( l_hi - l_uv_lo );
+    *l_w  = l_w_lo  + coef * ( l_hi - l_w_lo  );
+
+    *sigma_uv = sigma_uv_lo + coef * ( sigma_hi - sigma_uv_lo );
+    *sigma_w  = sigma_w_lo  + coef * ( sigma_hi - sigma_w_lo  );
+}
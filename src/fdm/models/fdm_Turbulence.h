@@ -0,0 +1,221 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TURBULENCE_H
+#define FDM_TURBULENCE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <vector>
+
+#include <fdm/utils/fdm_Table1.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Dryden turbulence model class.
+ *
+ * Gust velocities and gust angular rates are computed at the aircraft
+ * position according to the Dryden form of the MIL-F-8785C turbulence model,
+ * scaled with altitude above ground level and turbulence intensity.
+ * Turbulence field is assumed frozen, so gusts are functions of the distance
+ * flown, and are expressed in BAS.
+ *
+ * Unit variance shaped noise streams are generated in blocks as functions of
+ * the distance normalized by the scale length. Since exact discretization of
+ * the shaping filters is used, stream samples are independent of the aircraft
+ * speed and altitude, and a single step costs only table reads. Gust angular
+ * rates are obtained from the gust velocities gradients.
+ *
+ * Streams are generated from a seeded Mersenne Twister, so turbulence is
+ * deterministic for a given seed.
+ *
+ * Intensity levels correspond to probabilities of exceedance of high altitude
+ * intensity and wind speeds at 20 ft as follows:
+ * Light: 10^-2 and 15 kts, Moderate: 10^-3 and 30 kts, Severe: 10^-5 and
+ * 45 kts, Extreme: 10^-6 and 60 kts (extrapolated).
+ *
+ * @see MIL-F-8785C Flying Qualities of Piloted Airplanes, 1980
+ * @see MIL-HDBK-1797 Flying Qualities of Piloted Aircraft, 1997
+ * @see Hoblit F.: Gust Loads on Aircraft: Concepts and Applications, 1988
+ */
+class FDMEXPORT Turbulence
+{
+public:
+
+    /** Turbulence intensity. */
+    enum Intensity
+    {
+        None = 0,                       ///< none
+        Light,                          ///< light
+        Moderate,                       ///< moderate
+        Severe,                         ///< severe
+        Extreme                         ///< extreme
+    };
+
+    static const double _v_min;         ///< [m/s] minimum turbulence field convection velocity
+    static const double _h_min;         ///< [m] minimum altitude above ground level
+
+    /**
+     * @brief Constructor.
+     * @param seed random generator seed
+     */
+    Turbulence( unsigned int seed = 0 );
+
+    /** @brief Destructor. */
+    virtual ~Turbulence();
+
+    /**
+     * @brief Updates turbulence model.
+     * @param timeStep [s] time step
+     * @param altitude_agl [m] altitude above ground level
+     * @param airspeed [m/s] airspeed excluding gusts
+     */
+    virtual void update( double timeStep, double altitude_agl, double airspeed );
+
+    /** @brief Restarts noise streams from the seed. */
+    void reset();
+
+    inline const Vector3& getVel_BAS() const { return _vel_bas; }
+    inline const Vector3& getOmg_BAS() const { return _omg_bas; }
+
+    inline Intensity getIntensity() const { return _intensity; }
+
+    inline unsigned int getSeed() const { return _seed; }
+
+    /**
+     * @brief Sets turbulence intensity.
+     * @param intensity turbulence intensity
+     */
+    void setIntensity( Intensity intensity );
+
+    /**
+     * @brief Sets random generator seed and restarts noise streams.
+     * @param seed random generator seed
+     */
+    void setSeed( unsigned int seed );
+
+    /**
+     * @brief Sets aircraft span used by gust angular rates.
+     * @param span [m] aircraft span
+     */
+    inline void setSpan( double span ) { _span = span; }
+
+private:
+
+    static const double _h_high[ 12 ];          ///< [ft] high altitude intensity table altitudes
+    static const double _sigma_high[ 4 ][ 12 ]; ///< [ft/s] high altitude intensity table values (light, moderate, severe, extreme)
+    static const double _w_20_kts[ 4 ];         ///< [kts] wind speed at 20 ft (light, moderate, severe, extreme)
+
+    /**
+     * @brief Unit variance shaped noise stream.
+     *
+     * Samples are spaced evenly in the distance normalized by the scale length.
+     * First order stream has Dryden longitudinal spectrum, second order stream
+     * has Dryden lateral spectrum.
+     */
+    class Stream
+    {
+    public:
+
+        static const double _d_xi;              ///< [-] normalized distance between samples
+        static const unsigned int _block_size;  ///< number of samples generated at once
+
+        /** @brief Constructor. */
+        Stream();
+
+        /**
+         * @brief Restarts stream.
+         * @param seed random generator seed
+         * @param index stream index, streams of the same seed are independent
+         * @param order shaping filter order (1 or 2)
+         */
+        void reset( unsigned int seed, unsigned int index, int order );
+
+        /**
+         * @brief Moves along the stream.
+         * @param d_xi [-] normalized distance
+         * @return stream value
+         */
+        double get( double d_xi );
+
+    private:
+
+        std::mt19937 _gen;                  ///< random generator
+        std::vector< double > _samples;     ///< current block samples
+
+        int _order;                         ///< shaping filter order
+
+        double _phi[ 2 ][ 2 ];              ///< state transition matrix
+        double _l[ 2 ][ 2 ];                ///< process noise covariance Cholesky factor
+        double _x[ 2 ];                     ///< shaping filter state
+
+        double _pos;                        ///< position within the current block (in samples)
+
+        /** @brief Generates next block of samples. */
+        void generate();
+
+        /** @return standard normal random value */
+        double getNormal();
+    };
+
+    Stream _stream_u;               ///< longitudinal gust velocity stream
+    Stream _stream_v;               ///< lateral gust velocity stream
+    Stream _stream_w;               ///< vertical gust velocity stream
+    Stream _stream_p;               ///< roll gust rate stream
+
+    Table1 _sigma_w_high;           ///< [m/s] high altitude turbulence intensity vs [m] altitude
+
+    Vector3 _vel_bas;               ///< [m/s] gust velocity expressed in BAS
+    Vector3 _omg_bas;               ///< [rad/s] gust angular velocity expressed in BAS
+
+    Intensity _intensity;           ///< turbulence intensity
+
+    unsigned int _seed;             ///< random generator seed
+
+    double _span;                   ///< [m] aircraft span
+    double _w_20;                   ///< [m/s] wind speed at 20 ft
+
+    double _v_n;                    ///< [-] last lateral stream value
+    double _w_n;                    ///< [-] last vertical stream value
+
+    /**
+     * @brief Computes turbulence scale lengths and intensities.
+     * @param h [m] altitude above ground level
+     * @param l_uv [m] longitudinal and lateral scale length
+     * @param l_w [m] vertical scale length
+     * @param sigma_uv [m/s] longitudinal and lateral turbulence intensity
+     * @param sigma_w [m/s] vertical turbulence intensity
+     */
+    void getScales( double h, double *l_uv, double *l_w,
+                    double *sigma_uv, double *sigma_w ) const;
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TURBULENCE_H
@@ -57,6 +57,8 @@ Wheel::Wheel( bool staticFriction ) :
     _delta ( 0.0 ),
     _brake ( 0.0 ),
 
+    _for_norm ( 0.0 ),
+
     _staticFriction ( staticFriction )
 {}
 
@@ -119,6 +121,11 @@ void Wheel::computeForceAndMoment( const Vector3 &vel_bas,
     _for_bas.zeroize();
     _mom_bas.zeroize();
 
+    _r_c_bas = r_c_bas;
+    _n_c_bas = n_c_bas;
+
+    _for_norm = 0.0;
+
     double deflection_norm = n_c_bas * ( r_c_bas - _r_u_bas );
 
     if ( deflection_norm > 1.0e-6 )
@@ -201,6 +208,8 @@ void Wheel::computeForceAndMoment( const Vector3 &vel_bas,
 
         // tire forces
         double for_norm_pos = ( for_norm < 0.0 ) ? 0.0 : for_norm;
+
+        _for_norm = for_norm_pos;
         double for_roll_max = for_norm_pos * mu_roll_t;
         double for_slip_max = for_norm_pos * mu_surf_k;
 
@@ -285,6 +294,29 @@ void Wheel::update( double position, double delta, double brake )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Wheel::getContactCoefs( double *k_n, double *c_n,
+                             double *k_t, double *c_t ) const
+{
+    (*k_n) = 0.0;
+    (*c_n) = 0.0;
+    (*k_t) = 0.0;
+    (*c_t) = 0.0;
+
+    if ( _for_norm > 0.0 )
+    {
+        (*k_n) = _k;
+        (*c_n) = _c;
+
+        // continuous friction model slope
+        if ( _v_max > 0.0 ) (*c_t) = _for_norm * _mu_k / _v_max;
+
+        // static friction logistic function slope at zero distance
+        if ( _staticFriction && _d_max > 0.0 ) (*k_t) = 1.5 * _for_norm * _mu_k / _d_max;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Wheel::calculateVariables( const Vector3 &vel_bas,
                                 const Vector3 &omg_bas,
                                 const Vector3 &r_c_bas,
@@ -72,6 +72,13 @@ public:
         Both                    ///< 3: both brake groups
     };
 
+    /** Static friction model state. */
+    struct State
+    {
+        double d_roll;          ///< [m] roll direction distance
+        double d_slip;          ///< [m] slip direction distance
+    };
+
     /**
      * @brief Constructor.
      * @param staticFriction specifies if static friction model is enabled
@@ -128,12 +135,50 @@ public:
      */
     virtual void update( double position, double delta, double brake );
 
+    /**
+     * @brief Returns contact stiffness and damping coefficients.
+     * Normal coefficients are strut spring and damper, tangent coefficients
+     * are slopes of the friction force linearized about the current normal
+     * load. All coefficients are zero if the wheel is not in contact.
+     * Values refer to the last computeForceAndMoment() call.
+     * @param k_n [N/m] normal stiffness
+     * @param c_n [N/(m/s)] normal damping
+     * @param k_t [N/m] tangent stiffness (static friction)
+     * @param c_t [N/(m/s)] tangent damping (continuous friction)
+     */
+    void getContactCoefs( double *k_n, double *c_n,
+                          double *k_t, double *c_t ) const;
+
+    /** @return static friction model state */
+    inline State getState() const
+    {
+        State state;
+
+        state.d_roll = _d_roll;
+        state.d_slip = _d_slip;
+
+        return state;
+    }
+
+    /**
+     * @brief Sets static friction model state.
+     * @param state static friction model state
+     */
+    inline void setState( const State &state )
+    {
+        _d_roll = state.d_roll;
+        _d_slip = state.d_slip;
+    }
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
     inline Vector3 getRa_BAS() const { return _r_a_bas; }
     inline Vector3 getRu_BAS() const { return _r_u_bas; }
 
+    inline const Vector3& getRc_BAS() const { return _r_c_bas; }
+    inline const Vector3& getNc_BAS() const { return _n_c_bas; }
+
     inline BrakeGroup getBrakeGroup() const { return _brakeGroup; }
 
     inline double getPosition() const { return _position; }
@@ -146,6 +191,9 @@ protected:
     Vector3 _r_a_bas;       ///< [m] strut attachment point coordinates expressed in BAS
     Vector3 _r_u_bas;       ///< [m] unloaded wheel coordinates expressed in BAS
 
+    Vector3 _r_c_bas;       ///< [m] contact point coordinates expressed in BAS
+    Vector3 _n_c_bas;       ///< [-] contact point normal vector expressed in BAS
+
     Vector3 _r_0_wgs;       ///< [m]
 
     double _k;              ///< [N/m] strut stiffness (linear spring) coefficient
@@ -172,6 +220,8 @@ protected:
     double _delta;          ///< [rad] wheel turn angle
     double _brake;          ///< <0.0;1.0> normalized brake force
 
+    double _for_norm;       ///< [N] normal force, zero if wheel is not in contact
+
     bool _staticFriction;   ///< specifies if static friction model is enabled
 
     /**
@@ -0,0 +1,435 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/models/fdm_WindField.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <fdm/utils/fdm_Endianness.h>
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int WindField::_header_size = 88;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeUInt( std::ofstream &fstream, unsigned int val )
+{
+    val = Endianness::hostToNet( val );
+    fstream.write( reinterpret_cast< const char* >( &val ), sizeof(val) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeDouble( std::ofstream &fstream, double val )
+{
+    val = Endianness::hostToNet( val );
+    fstream.write( reinterpret_cast< const char* >( &val ), sizeof(val) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static unsigned int readUInt( std::ifstream &fstream )
+{
+    unsigned int val = 0;
+    fstream.read( reinterpret_cast< char* >( &val ), sizeof(val) );
+    return Endianness::hostToNet( val );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static double readDouble( std::ifstream &fstream )
+{
+    double val = 0.0;
+    fstream.read( reinterpret_cast< char* >( &val ), sizeof(val) );
+    return Endianness::hostToNet( val );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Interpolates trilinearly within the grid cell.
+ * @param slice time slice
+ * @param n index of the cell first node
+ * @param s_x index stride along north axis
+ * @param s_y index stride along east axis
+ * @param s_z index stride along up axis
+ * @param f_x [-] position within the cell along north axis
+ * @param f_y [-] position within the cell along east axis
+ * @param f_z [-] position within the cell along up axis
+ * @return interpolated value
+ */
+static inline Vector3 interpolate( const WindField::Slice &slice,
+                                   unsigned int n,
+                                   unsigned int s_x, unsigned int s_y, unsigned int s_z,
+                                   double f_x, double f_y, double f_z )
+{
+    Vector3 v_00 = slice[ n             ] + ( slice[ n + s_x             ] - slice[ n             ] ) * f_x;
+    Vector3 v_10 = slice[ n + s_y       ] + ( slice[ n + s_x + s_y       ] - slice[ n + s_y       ] ) * f_x;
+    Vector3 v_01 = slice[ n + s_z       ] + ( slice[ n + s_x + s_z       ] - slice[ n + s_z       ] ) * f_x;
+    Vector3 v_11 = slice[ n + s_y + s_z ] + ( slice[ n + s_x + s_y + s_z ] - slice[ n + s_y + s_z ] ) * f_x;
+
+    Vector3 v_0 = v_00 + ( v_10 - v_00 ) * f_y;
+    Vector3 v_1 = v_01 + ( v_11 - v_01 ) * f_y;
+
+    return v_0 + ( v_1 - v_0 ) * f_z;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool WindField::save( const char *file, const Grid &grid,
+                      const std::vector< Slice > &slices )
+{
+    unsigned int size = grid.nx * grid.ny * grid.nz;
+
+    if ( size == 0 || slices.size() != grid.nt || grid.scale <= 0.0 ) return false;
+
+    std::ofstream fstream( file, std::ios_base::out | std::ios_base::binary );
+
+    if ( !fstream.is_open() ) return false;
+
+    fstream.write( "WFLD", 4 );
+
+    writeUInt( fstream, 1 );
+
+    writeUInt( fstream, grid.nx );
+    writeUInt( fstream, grid.ny );
+    writeUInt( fstream, grid.nz );
+    writeUInt( fstream, grid.nt );
+
+    writeDouble( fstream, grid.origin.lat );
+    writeDouble( fstream, grid.origin.lon );
+    writeDouble( fstream, grid.origin.alt );
+
+    writeDouble( fstream, grid.dx );
+    writeDouble( fstream, grid.dy );
+    writeDouble( fstream, grid.dz );
+    writeDouble( fstream, grid.dt );
+
+    writeDouble( fstream, grid.scale );
+
+    std::vector< unsigned short > data( 3 * size );
+
+    for ( unsigned int l = 0; l < grid.nt; l++ )
+    {
+        if ( slices[ l ].size() != size ) return false;
+
+        for ( unsigned int n = 0; n < size; n++ )
+        {
+            for ( unsigned int c = 0; c < 3; c++ )
+            {
+                double val = Misc::satur( -32767.0, 32767.0, floor( slices[ l ][ n ]( c ) / grid.scale + 0.5 ) );
+                short lsb = static_cast< short >( val );
+
+                data[ 3*n + c ] = Endianness::hostToNet( static_cast< unsigned short >( lsb ) );
+            }
+        }
+
+        fstream.write( reinterpret_cast< const char* >( data.data() ),
+                       data.size() * sizeof(unsigned short) );
+    }
+
+    return fstream.good();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+WindField::WindField() :
+    _cur   ( 0 ),
+    _next  ( 1 ),
+    _spare ( 2 ),
+
+    _slice ( 0 ),
+
+    _time ( 0.0 ),
+    _coef ( 0.0 ),
+
+    _loaded ( false ),
+
+    _request ( -1 ),
+    _requestBuffer ( 0 ),
+
+    _ready ( -1 ),
+
+    _stop ( false )
+{
+    memset( &_grid, 0, sizeof(Grid) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+WindField::~WindField()
+{
+    unload();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool WindField::load( const char *file )
+{
+    unload();
+
+    _fstream.open( file, std::ios_base::in | std::ios_base::binary );
+
+    if ( !_fstream.is_open() ) return false;
+
+    char magic[ 4 ];
+    _fstream.read( magic, 4 );
+
+    unsigned int version = readUInt( _fstream );
+
+    _grid.nx = readUInt( _fstream );
+    _grid.ny = readUInt( _fstream );
+    _grid.nz = readUInt( _fstream );
+    _grid.nt = readUInt( _fstream );
+
+    _grid.origin.lat = readDouble( _fstream );
+    _grid.origin.lon = readDouble( _fstream );
+    _grid.origin.alt = readDouble( _fstream );
+
+    _grid.dx = readDouble( _fstream );
+    _grid.dy = readDouble( _fstream );
+    _grid.dz = readDouble( _fstream );
+    _grid.dt = readDouble( _fstream );
+
+    _grid.scale = readDouble( _fstream );
+
+    bool valid = _fstream.good()
+              && 0 == strncmp( magic, "WFLD", 4 ) && version == 1
+              && _grid.nx > 0 && _grid.ny > 0 && _grid.nz > 0 && _grid.nt > 0
+              && _grid.dx > 0.0 && _grid.dy > 0.0 && _grid.dz > 0.0 && _grid.dt > 0.0;
+
+    _cur   = 0;
+    _next  = 1;
+    _spare = 2;
+
+    _slice = 0;
+
+    if ( valid ) valid = readSlice( _fstream, 0, &_slices[ _cur ] );
+    if ( valid ) valid = readSlice( _fstream, _grid.nt > 1 ? 1 : 0, &_slices[ _next ] );
+
+    if ( !valid )
+    {
+        _fstream.close();
+        return false;
+    }
+
+    _slices[ _spare ].resize( _slices[ _cur ].size() );
+
+    WGS84 origin( _grid.origin );
+
+    _origin_wgs = origin.getPos_WGS();
+
+    _wgs2ned = origin.getWGS2NED();
+    _ned2wgs = origin.getNED2WGS();
+
+    _time = 0.0;
+    _coef = 0.0;
+
+    _request = -1;
+    _ready.store( -1 );
+
+    _stop = false;
+    _thread = std::thread( &WindField::run, this );
+
+    if ( _grid.nt > 2 ) request( 2 );
+
+    _loaded = true;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::unload()
+{
+    if ( _thread.joinable() )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _stop = true;
+        }
+
+        _condition.notify_all();
+
+        _thread.join();
+    }
+
+    if ( _fstream.is_open() ) _fstream.close();
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        _slices[ i ].clear();
+    }
+
+    _loaded = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::update( double timeStep )
+{
+    if ( !_loaded ) return;
+
+    _time += timeStep;
+
+    // next slices are taken only if already read, otherwise the last
+    // slice is held
+    while ( _slice + 2 < _grid.nt && _time >= ( _slice + 1 ) * _grid.dt
+         && _ready.load( std::memory_order_acquire ) == (int)( _slice + 2 ) )
+    {
+        unsigned int cur = _cur;
+
+        _cur   = _next;
+        _next  = _spare;
+        _spare = cur;
+
+        _slice++;
+
+        _ready.store( -1, std::memory_order_relaxed );
+
+        if ( _slice + 2 < _grid.nt ) request( _slice + 2 );
+    }
+
+    _coef = Misc::satur( 0.0, 1.0, ( _time - _slice * _grid.dt ) / _grid.dt );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Vector3 WindField::getWind_WGS( const Vector3 &pos_wgs ) const
+{
+    if ( !_loaded ) return Vector3();
+
+    Vector3 r_ned = _wgs2ned * ( pos_wgs - _origin_wgs );
+
+    // grid coordinates limited to the grid boundaries
+    double x = Misc::satur( 0.0, _grid.nx - 1,  r_ned.x() / _grid.dx );
+    double y = Misc::satur( 0.0, _grid.ny - 1,  r_ned.y() / _grid.dy );
+    double z = Misc::satur( 0.0, _grid.nz - 1, -r_ned.z() / _grid.dz );
+
+    unsigned int i = static_cast< unsigned int >( x );
+    unsigned int j = static_cast< unsigned int >( y );
+    unsigned int k = static_cast< unsigned int >( z );
+
+    unsigned int s_x = _grid.nx > 1 ? 1 : 0;
+    unsigned int s_y = _grid.ny > 1 ? _grid.nx : 0;
+    unsigned int s_z = _grid.nz > 1 ? _grid.nx * _grid.ny : 0;
+
+    if ( s_x > 0 && i > _grid.nx - 2 ) i = _grid.nx - 2;
+    if ( s_y > 0 && j > _grid.ny - 2 ) j = _grid.ny - 2;
+    if ( s_z > 0 && k > _grid.nz - 2 ) k = _grid.nz - 2;
+
+    unsigned int n = ( k * _grid.ny + j ) * _grid.nx + i;
+
+    double f_x = x - i;
+    double f_y = y - j;
+    double f_z = z - k;
+
+    Vector3 wind_ned = interpolate( _slices[ _cur ], n, s_x, s_y, s_z, f_x, f_y, f_z );
+
+    if ( _coef > 0.0 )
+    {
+        Vector3 wind_next = interpolate( _slices[ _next ], n, s_x, s_y, s_z, f_x, f_y, f_z );
+        wind_ned += ( wind_next - wind_ned ) * _coef;
+    }
+
+    return _ned2wgs * wind_ned;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::run()
+{
+    while ( true )
+    {
+        int slice = -1;
+        unsigned int buffer = 0;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+
+            _condition.wait( lock, [ this ]() { return _stop || _request >= 0; } );
+
+            if ( _stop ) break;
+
+            slice  = _request;
+            buffer = _requestBuffer;
+
+            _request = -1;
+        }
+
+        if ( readSlice( _fstream, slice, &_slices[ buffer ] ) )
+        {
+            _ready.store( slice, std::memory_order_release );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::request( unsigned int slice )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _request = slice;
+        _requestBuffer = _spare;
+    }
+
+    _condition.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool WindField::readSlice( std::ifstream &fstream, unsigned int slice, Slice *data ) const
+{
+    unsigned int size = _grid.nx * _grid.ny * _grid.nz;
+
+    std::vector< unsigned short > buffer( 3 * size );
+
+    std::streamoff bytes = buffer.size() * sizeof(unsigned short);
+
+    fstream.clear();
+    fstream.seekg( _header_size + slice * bytes, std::ios_base::beg );
+    fstream.read( reinterpret_cast< char* >( buffer.data() ), bytes );
+
+    if ( !fstream.good() ) return false;
+
+    data->resize( size );
+
+    for ( unsigned int n = 0; n < size; n++ )
+    {
+        for ( unsigned int c = 0; c < 3; c++ )
+        {
+            short lsb = static_cast< short >( Endianness::hostToNet( buffer[ 3*n + c ] ) );
+            (*data)[ n ]( c ) = _grid.scale * lsb;
+        }
+    }
+
+    return true;
+}
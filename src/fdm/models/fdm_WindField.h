@@ -0,0 +1,201 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_WINDFIELD_H
+#define FDM_WINDFIELD_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fdm/utils/fdm_Geo.h>
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Gridded time varying wind field class.
+ *
+ * Wind velocity is given on a regular grid aligned with the NED axes at
+ * the grid origin, as a sequence of time slices. Wind is interpolated
+ * trilinearly in space and linearly in time. Outside the grid boundary
+ * values are used.
+ *
+ * Only three time slices are kept in memory: the two being interpolated
+ * and the next one, which is read by a background thread, so update() and
+ * getWind_WGS() never wait for file reading. If the next slice is not ready
+ * when needed, the last one is held until it is.
+ *
+ * Binary file format (network byte order):
+ * @code
+ * char[4]  "WFLD"
+ * uint32   version (1)
+ * uint32   nx, ny, nz, nt             number of nodes north, east, up and slices
+ * float64  lat, lon, alt              [rad, rad, m] grid origin (south-west-bottom corner)
+ * float64  dx, dy, dz, dt             [m, m, m, s] nodes spacing and slices interval
+ * float64  scale                      [m/s] wind velocity least significant bit
+ * int16    u, v, w                    wind velocity NED components, repeated for
+ *                                     i < nx (fastest), j < ny, k < nz, l < nt
+ * @endcode
+ */
+class FDMEXPORT WindField
+{
+public:
+
+    /** Grid description. */
+    struct Grid
+    {
+        unsigned int nx;            ///< number of nodes along north axis
+        unsigned int ny;            ///< number of nodes along east axis
+        unsigned int nz;            ///< number of nodes along up axis
+        unsigned int nt;            ///< number of time slices
+
+        Geo origin;                 ///< grid origin (south-west-bottom corner)
+
+        double dx;                  ///< [m] nodes spacing along north axis
+        double dy;                  ///< [m] nodes spacing along east axis
+        double dz;                  ///< [m] nodes spacing along up axis
+        double dt;                  ///< [s] time slices interval
+
+        double scale;               ///< [m/s] wind velocity least significant bit
+    };
+
+    typedef std::vector< Vector3 > Slice;
+
+    static const unsigned int _header_size;     ///< [B] file header size
+
+    /**
+     * @brief Writes wind field file.
+     * @param file file path
+     * @param grid grid description
+     * @param slices [m/s] wind velocity NED components time slices
+     * @return true on success, false on failure
+     */
+    static bool save( const char *file, const Grid &grid,
+                      const std::vector< Slice > &slices );
+
+    /** @brief Constructor. */
+    WindField();
+
+    /** @brief Destructor. */
+    virtual ~WindField();
+
+    /**
+     * @brief Loads wind field file. Reads header and first two time slices,
+     * following slices are read by background thread.
+     * @param file file path
+     * @return true on success, false on failure
+     */
+    bool load( const char *file );
+
+    /** @brief Unloads wind field and stops background thread. */
+    void unload();
+
+    /**
+     * @brief Advances wind field time. Must be called once per time step.
+     * @param timeStep [s] time step
+     */
+    void update( double timeStep );
+
+    /**
+     * @brief Returns wind velocity at the given position.
+     * @param pos_wgs [m] position expressed in WGS
+     * @return [m/s] wind velocity expressed in WGS, zero if field is not loaded
+     */
+    Vector3 getWind_WGS( const Vector3 &pos_wgs ) const;
+
+    inline const Grid& getGrid() const { return _grid; }
+
+    inline double getTime() const { return _time; }
+
+    inline unsigned int getSlice() const { return _slice; }
+
+    inline bool isLoaded() const { return _loaded; }
+
+private:
+
+    Grid _grid;                             ///< grid description
+
+    Slice _slices[ 3 ];                     ///< time slices buffers
+
+    unsigned int _cur;                      ///< index of the buffer holding slice _slice
+    unsigned int _next;                     ///< index of the buffer holding slice _slice + 1
+    unsigned int _spare;                    ///< index of the buffer being read
+
+    unsigned int _slice;                    ///< current time slice
+
+    Vector3 _origin_wgs;                    ///< [m] grid origin expressed in WGS
+
+    Matrix3x3 _wgs2ned;                     ///< rotation matrix from WGS to grid NED
+    Matrix3x3 _ned2wgs;                     ///< rotation matrix from grid NED to WGS
+
+    double _time;                           ///< [s] wind field time
+    double _coef;                           ///< [-] time interpolation coefficient
+
+    bool _loaded;                           ///< specifies if wind field is loaded
+
+    std::ifstream _fstream;                 ///< file stream (used by background thread)
+
+    std::thread _thread;                    ///< background reading thread
+
+    std::mutex _mutex;                      ///< request mutex
+    std::condition_variable _condition;     ///< request condition
+
+    int _request;                           ///< requested slice, -1 if none
+    unsigned int _requestBuffer;            ///< requested slice buffer
+
+    std::atomic< int > _ready;              ///< slice read into the spare buffer, -1 if none
+
+    bool _stop;                             ///< specifies if background thread should stop
+
+    /** @brief Background thread function. */
+    void run();
+
+    /**
+     * @brief Requests reading slice by background thread.
+     * @param slice slice index
+     */
+    void request( unsigned int slice );
+
+    /**
+     * @brief Reads time slice from the file stream.
+     * @param fstream file stream
+     * @param slice slice index
+     * @param data output buffer
+     * @return true on success, false on failure
+     */
+    bool readSlice( std::ifstream &fstream, unsigned int slice, Slice *data ) const;
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_WINDFIELD_H
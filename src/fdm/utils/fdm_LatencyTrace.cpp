@@ -0,0 +1,275 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_LatencyTrace.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+
+#ifdef _LINUX_
+#   include <ctime>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Stage latency counters. */
+struct Counters
+{
+    std::atomic< unsigned int > last;                                   ///< last recorded sequence number
+    std::atomic< unsigned int > bins[ LatencyTrace::_bins_count ];      ///< bins counts
+    std::atomic< unsigned int > count;                                  ///< number of recorded stamps
+    std::atomic< long long > sum;                                       ///< [ns] sum of latencies
+    std::atomic< long long > max;                                       ///< [ns] maximum latency
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static Counters counters[ LatencyTrace::_stages_count ];
+
+static std::atomic< unsigned int > sequence ( 0 );
+static std::atomic< bool > enabled ( false );
+
+////////////////////////////////////////////////////////////////////////////////
+
+long long LatencyTrace::now()
+{
+#   ifdef _LINUX_
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return 1000000000LL * ts.tv_sec + ts.tv_nsec;
+#   else
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+                std::chrono::steady_clock::now().time_since_epoch() ).count();
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+LatencyTrace::Stamp LatencyTrace::stamp( long long time )
+{
+    Stamp stamp;
+
+    stamp.seq  = 0;
+    stamp.time = time;
+
+    if ( enabled.load( std::memory_order_relaxed ) )
+    {
+        // sequence number 0 is reserved for not stamped data
+        do
+        {
+            stamp.seq = sequence.fetch_add( 1, std::memory_order_relaxed ) + 1;
+        }
+        while ( stamp.seq == 0 );
+    }
+
+    return stamp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTrace::record( Stage stage, const Stamp &stamp )
+{
+    if ( stamp.seq == 0 || !enabled.load( std::memory_order_relaxed ) ) return;
+
+    Counters &c = counters[ stage ];
+
+    // each stamp is counted once, only the first output showing the sample matters
+    unsigned int last = c.last.load( std::memory_order_relaxed );
+
+    do
+    {
+        if ( (int)( stamp.seq - last ) <= 0 ) return;
+    }
+    while ( !c.last.compare_exchange_weak( last, stamp.seq, std::memory_order_relaxed ) );
+
+    long long latency = now() - stamp.time;
+
+    if ( latency < 0 ) latency = 0;
+
+    unsigned int bin = 0;
+    long long us = latency / 1000;
+
+    while ( us > 1 && bin < _bins_count - 1 )
+    {
+        us >>= 1;
+        bin++;
+    }
+
+    c.bins[ bin ].fetch_add( 1, std::memory_order_relaxed );
+    c.count.fetch_add( 1, std::memory_order_relaxed );
+    c.sum.fetch_add( latency, std::memory_order_relaxed );
+
+    long long max = c.max.load( std::memory_order_relaxed );
+
+    while ( latency > max
+         && !c.max.compare_exchange_weak( max, latency, std::memory_order_relaxed ) ) {}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTrace::getHistogram( Stage stage, Histogram *histogram )
+{
+    const Counters &c = counters[ stage ];
+
+    for ( unsigned int i = 0; i < _bins_count; i++ )
+    {
+        histogram->bins[ i ] = c.bins[ i ].load( std::memory_order_relaxed );
+    }
+
+    histogram->count = c.count.load( std::memory_order_relaxed );
+    histogram->sum   = c.sum.load( std::memory_order_relaxed );
+    histogram->max   = c.max.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double LatencyTrace::getPercentile( const Histogram &histogram, double p )
+{
+    unsigned int count = 0;
+
+    for ( unsigned int i = 0; i < _bins_count - 1; i++ )
+    {
+        count += histogram.bins[ i ];
+
+        if ( count > 0 && count >= p * histogram.count )
+        {
+            return (double)( 2 << i );
+        }
+    }
+
+    return 1.0e-3 * histogram.max;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* LatencyTrace::getName( Stage stage )
+{
+    switch ( stage )
+    {
+        case Step:    return "fdm step";
+        case Publish: return "publish";
+        case Update:  return "cgi update";
+        case Frame:   return "frame end";
+        case Sound:   return "sfx copy";
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTrace::print( std::ostream &out )
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "Input latency [us]:" << std::endl;
+    out << std::setw( 12 ) << "stage";
+    out << std::setw( 10 ) << "count";
+    out << std::setw( 10 ) << "mean";
+    out << std::setw( 10 ) << "p50";
+    out << std::setw( 10 ) << "p99";
+    out << std::setw( 10 ) << "max";
+    out << std::endl;
+
+    out << std::fixed << std::setprecision( 0 );
+
+    for ( unsigned int i = 0; i < _stages_count; i++ )
+    {
+        Histogram histogram;
+        getHistogram( (Stage)i, &histogram );
+
+        double mean = histogram.count > 0 ? 1.0e-3 * histogram.sum / histogram.count : 0.0;
+
+        out << std::setw( 12 ) << getName( (Stage)i );
+        out << std::setw( 10 ) << histogram.count;
+        out << std::setw( 10 ) << mean;
+        out << std::setw( 10 ) << getPercentile( histogram, 0.5  );
+        out << std::setw( 10 ) << getPercentile( histogram, 0.99 );
+        out << std::setw( 10 ) << 1.0e-3 * histogram.max;
+        out << std::endl;
+    }
+
+    for ( unsigned int i = 0; i < _stages_count; i++ )
+    {
+        Histogram histogram;
+        getHistogram( (Stage)i, &histogram );
+
+        if ( histogram.count == 0 ) continue;
+
+        out << getName( (Stage)i ) << " histogram:" << std::endl;
+
+        for ( unsigned int j = 0; j < _bins_count; j++ )
+        {
+            if ( histogram.bins[ j ] == 0 ) continue;
+
+            unsigned int width = ( 50 * histogram.bins[ j ] ) / histogram.count;
+
+            out << std::setw( 10 ) << ( j > 0 ? ( 1 << j ) : 0 ) << " - ";
+            out << std::setw( 10 ) << ( 2 << j );
+            out << std::setw( 10 ) << histogram.bins[ j ] << " ";
+            out << std::string( width, '#' );
+            out << std::endl;
+        }
+    }
+
+    out.flags( flags );
+    out.precision( precision );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTrace::reset()
+{
+    for ( unsigned int i = 0; i < _stages_count; i++ )
+    {
+        Counters &c = counters[ i ];
+
+        for ( unsigned int j = 0; j < _bins_count; j++ )
+        {
+            c.bins[ j ].store( 0, std::memory_order_relaxed );
+        }
+
+        c.count.store( 0, std::memory_order_relaxed );
+        c.sum.store( 0, std::memory_order_relaxed );
+        c.max.store( 0, std::memory_order_relaxed );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool LatencyTrace::isEnabled()
+{
+    return enabled.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTrace::setEnabled( bool enabled_new )
+{
+    enabled.store( enabled_new, std::memory_order_relaxed );
+}
@@ -0,0 +1,148 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_LATENCYTRACE_H
+#define FDM_LATENCYTRACE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Input to output latency tracing class.
+ *
+ * Each new input sample gets a stamp made of a sequence number and
+ * the monotonic time of the sample. The stamp is carried along with the data
+ * (DataInp, DataOut and application data buffer) and recorded at each stage
+ * the data passes through. Every stamp is counted only once per stage, so
+ * a stage recording the same data many times (e.g. a frame repainted without
+ * new data) measures the latency of the first output showing the sample.
+ *
+ * Latencies are accumulated in lock-free per stage histograms with
+ * logarithmically spaced bins, stages may be recorded from different threads.
+ * Recording does nothing unless tracing is enabled.
+ */
+class FDMEXPORT LatencyTrace
+{
+public:
+
+    /** Traced stages. */
+    enum Stage
+    {
+        Step = 0,                       ///< FDM step completed
+        Publish,                        ///< FDM output copied to the application data
+        Update,                         ///< CGI updated
+        Frame,                          ///< OTW frame drawn
+        Sound                           ///< SFX data copied
+    };
+
+    static const unsigned int _stages_count = 5;    ///< number of traced stages
+    static const unsigned int _bins_count   = 24;   ///< number of histogram bins
+
+    /** Latency trace stamp. */
+    struct Stamp
+    {
+        unsigned int seq;               ///< sequence number, 0 if not stamped
+        long long time;                 ///< [ns] monotonic time of the input sample
+    };
+
+    /**
+     * Latency histogram. Bin 0 counts latencies below 2 us, bin i counts
+     * latencies within [2^i;2^(i+1)) us, the last bin counts all longer.
+     */
+    struct Histogram
+    {
+        unsigned int bins[ _bins_count ];   ///< bins counts
+        unsigned int count;                 ///< number of recorded stamps
+        long long sum;                      ///< [ns] sum of latencies
+        long long max;                      ///< [ns] maximum latency
+    };
+
+    /**
+     * @brief Returns monotonic time.
+     * On Linux this is CLOCK_MONOTONIC, the same clock as joystick events.
+     * @return [ns] monotonic time
+     */
+    static long long now();
+
+    /**
+     * @brief Creates new stamp.
+     * @param time [ns] monotonic time of the input sample
+     * @return new stamp, not stamped if tracing is disabled
+     */
+    static Stamp stamp( long long time );
+
+    /**
+     * @brief Records stamp at the given stage.
+     * Does nothing if stamp was already recorded at this stage.
+     * @param stage traced stage
+     * @param stamp stamp carried with the data
+     */
+    static void record( Stage stage, const Stamp &stamp );
+
+    /**
+     * @brief Returns histogram of the given stage.
+     * @param stage traced stage
+     * @param histogram output histogram
+     */
+    static void getHistogram( Stage stage, Histogram *histogram );
+
+    /**
+     * @brief Returns latency percentile estimated from the histogram.
+     * @param histogram latency histogram
+     * @param p [-] percentile within range [0.0;1.0]
+     * @return [us] upper bound of the bin containing the percentile
+     */
+    static double getPercentile( const Histogram &histogram, double p );
+
+    /**
+     * @brief Returns stage name.
+     * @param stage traced stage
+     * @return stage name
+     */
+    static const char* getName( Stage stage );
+
+    /**
+     * @brief Prints histograms of all stages.
+     * @param out output stream
+     */
+    static void print( std::ostream &out );
+
+    /** @brief Clears all histograms. */
+    static void reset();
+
+    static bool isEnabled();
+
+    static void setEnabled( bool enabled );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_LATENCYTRACE_H
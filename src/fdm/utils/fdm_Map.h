@@ -42,6 +42,7 @@ class Map
 public:
 
     typedef typename std::map< TYPE_KEY, TYPE_ITEM >::iterator iterator;
+    typedef typename std::map< TYPE_KEY, TYPE_ITEM >::const_iterator const_iterator;
 
     /** @brief Constructor. */
     Map() {}
@@ -92,6 +93,9 @@ public:
     inline iterator begin() { return _map.begin(); }
     inline iterator end()   { return _map.end();   }
 
+    inline const_iterator begin() const { return _map.begin(); }
+    inline const_iterator end()   const { return _map.end();   }
+
 private:
 
     std::map< TYPE_KEY, TYPE_ITEM > _map;    ///< map
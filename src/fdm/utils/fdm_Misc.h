@@ -53,6 +53,33 @@ class FDMEXPORT Misc
 {
 public:
 
+    /**
+     * @brief Finds keys interval bracketing the given value.
+     * Bisection search shared by lookup tables.
+     * @param keys keys values sorted in ascending order
+     * @param size number of keys
+     * @param value value to be bracketed
+     * @return index i of the last key not greater than value, limited to
+     * [0;size-2], so keys[i] and keys[i+1] bracket the value
+     */
+    inline static unsigned int bracket( const double keys[], unsigned int size, double value )
+    {
+        unsigned int i_1 = 0;
+        unsigned int i_2 = ( size > 1 ) ? size - 1 : 0;
+
+        while ( i_2 - i_1 > 1 )
+        {
+            unsigned int i_m = ( i_1 + i_2 ) / 2;
+
+            if ( value >= keys[ i_m ] )
+                i_1 = i_m;
+            else
+                i_2 = i_m;
+        }
+
+        return i_1;
+    }
+
     /**
      * @brief Firt order inertia.
      * @param u desired value
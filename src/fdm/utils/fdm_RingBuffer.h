@@ -0,0 +1,132 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_RINGBUFFER_H
+#define FDM_RINGBUFFER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Lock-free single producer single consumer ring buffer.
+ *
+ * Elements are written in place: producer calls reserve() to get a free
+ * slot, fills it and calls commit(), consumer calls front() to get the
+ * oldest element and pop() to release it. Neither side ever blocks.
+ *
+ * @tparam TYPE element type
+ * @tparam SIZE number of slots, must be a power of two
+ */
+template < class TYPE, unsigned int SIZE >
+class RingBuffer
+{
+public:
+
+    /** @brief Constructor. */
+    RingBuffer() :
+        _head ( 0 ),
+        _tail ( 0 )
+    {
+        static_assert( SIZE > 1 && ( SIZE & ( SIZE - 1 ) ) == 0,
+                       "Ring buffer size must be a power of two." );
+    }
+
+    /**
+     * @brief Returns free slot to be filled by producer.
+     * @return free slot, null pointer if buffer is full
+     */
+    inline TYPE* reserve()
+    {
+        unsigned int head = _head.load( std::memory_order_relaxed );
+
+        if ( head - _tail.load( std::memory_order_acquire ) < SIZE )
+        {
+            return &_data[ head & ( SIZE - 1 ) ];
+        }
+
+        return FDM_NULLPTR;
+    }
+
+    /** @brief Publishes slot returned by the last reserve() call. */
+    inline void commit()
+    {
+        _head.store( _head.load( std::memory_order_relaxed ) + 1,
+                     std::memory_order_release );
+    }
+
+    /**
+     * @brief Returns element to be read by consumer.
+     * @param index element index, 0 is the oldest one
+     * @return element, null pointer if there is no such element
+     */
+    inline const TYPE* front( unsigned int index = 0 ) const
+    {
+        unsigned int tail = _tail.load( std::memory_order_relaxed );
+
+        if ( _head.load( std::memory_order_acquire ) - tail > index )
+        {
+            return &_data[ ( tail + index ) & ( SIZE - 1 ) ];
+        }
+
+        return FDM_NULLPTR;
+    }
+
+    /**
+     * @brief Releases the oldest elements.
+     * @param count number of elements to be released
+     */
+    inline void pop( unsigned int count = 1 )
+    {
+        _tail.store( _tail.load( std::memory_order_relaxed ) + count,
+                     std::memory_order_release );
+    }
+
+    /** @brief Checks if buffer is empty. */
+    inline bool isEmpty() const
+    {
+        return _head.load( std::memory_order_acquire )
+            == _tail.load( std::memory_order_acquire );
+    }
+
+private:
+
+    TYPE _data[ SIZE ];                                 ///< slots
+
+    alignas( 64 ) std::atomic< unsigned int > _head;    ///< write index (producer)
+    alignas( 64 ) std::atomic< unsigned int > _tail;    ///< read index (consumer)
+
+    /** Using this constructor is forbidden. */
+    RingBuffer( const RingBuffer & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_RINGBUFFER_H
@@ -0,0 +1,132 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_SEQLOCK_H
+#define FDM_SEQLOCK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstring>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Sequence lock class template.
+ *
+ * Publishes the latest value from a single writer thread to any number of
+ * reader threads without locks. Writer never waits, reader retries copying
+ * when the value has been modified during the copy. Sequence number is odd
+ * while writing is in progress.
+ *
+ * @tparam TYPE trivially copyable value type
+ */
+template < class TYPE >
+class SeqLock
+{
+public:
+
+    /** @brief Constructor. */
+    SeqLock() :
+        _seq ( 0 )
+    {
+        memset( &_data, 0, sizeof(TYPE) );
+    }
+
+    /**
+     * @brief Publishes value. Must be called by single writer thread only.
+     * @param data value to be published
+     */
+    inline void write( const TYPE &data )
+    {
+        unsigned int seq = _seq.load( std::memory_order_relaxed );
+
+        _seq.store( seq + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        memcpy( &_data, &data, sizeof(TYPE) );
+
+        _seq.store( seq + 2, std::memory_order_release );
+    }
+
+    /**
+     * @brief Tries to read value.
+     * @param data output value
+     * @param seq output sequence number of the value read (optional)
+     * @return true on success, false if value was being written
+     */
+    inline bool tryRead( TYPE *data, unsigned int *seq = FDM_NULLPTR ) const
+    {
+        unsigned int seq_0 = _seq.load( std::memory_order_acquire );
+
+        if ( seq_0 & 1 ) return false;
+
+        memcpy( data, &_data, sizeof(TYPE) );
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        if ( seq ) (*seq) = seq_0;
+
+        return seq_0 == _seq.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * @brief Reads value, retries until consistent copy is made.
+     * @param data output value
+     * @return sequence number of the value read
+     */
+    inline unsigned int read( TYPE *data ) const
+    {
+        unsigned int seq = 0;
+
+        while ( !tryRead( data, &seq ) ) {}
+
+        return seq;
+    }
+
+    /**
+     * @brief Returns sequence number, incremented by 2 with each write.
+     * @return sequence number
+     */
+    inline unsigned int getSequence() const
+    {
+        return _seq.load( std::memory_order_acquire );
+    }
+
+private:
+
+    std::atomic< unsigned int > _seq;   ///< sequence number
+    TYPE _data;                         ///< published value
+
+    /** Using this constructor is forbidden. */
+    SeqLock( const SeqLock & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_SEQLOCK_H
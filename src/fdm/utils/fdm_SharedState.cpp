@@ -0,0 +1,301 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_SharedState.h>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#ifdef _LINUX_
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_LatencyTrace.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FDM_SHARED_FIELD( member, type, unit ) \
+    { #member, unit, SharedState::type, (unsigned int)offsetof( SharedState::Snapshot, member ) }
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static const SharedState::Field fields[] =
+{
+    FDM_SHARED_FIELD( step              , Int64   , "-"      ),
+    FDM_SHARED_FIELD( time_mono         , Int64   , "ns"     ),
+    FDM_SHARED_FIELD( time_sim          , Float64 , "s"      ),
+    FDM_SHARED_FIELD( aircraftType      , Int32   , "-"      ),
+    FDM_SHARED_FIELD( stateOut          , Int32   , "-"      ),
+
+    FDM_SHARED_FIELD( latitude          , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( longitude         , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( altitude_asl      , Float64 , "m"      ),
+    FDM_SHARED_FIELD( altitude_agl      , Float64 , "m"      ),
+    FDM_SHARED_FIELD( roll              , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( pitch             , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( heading           , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( angleOfAttack     , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( sideslipAngle     , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( ias               , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( tas               , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( groundSpeed       , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( machNumber        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( climbRate         , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( rollRate          , Float64 , "rad/s"  ),
+    FDM_SHARED_FIELD( pitchRate         , Float64 , "rad/s"  ),
+    FDM_SHARED_FIELD( yawRate           , Float64 , "rad/s"  ),
+    FDM_SHARED_FIELD( pos_x_wgs         , Float64 , "m"      ),
+    FDM_SHARED_FIELD( pos_y_wgs         , Float64 , "m"      ),
+    FDM_SHARED_FIELD( pos_z_wgs         , Float64 , "m"      ),
+    FDM_SHARED_FIELD( att_e0_wgs        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( att_ex_wgs        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( att_ey_wgs        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( att_ez_wgs        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( vel_north         , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( vel_east          , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( g_pilot_x         , Float64 , "-"      ),
+    FDM_SHARED_FIELD( g_pilot_y         , Float64 , "-"      ),
+    FDM_SHARED_FIELD( g_pilot_z         , Float64 , "-"      ),
+    FDM_SHARED_FIELD( onGround          , Int32   , "-"      ),
+    FDM_SHARED_FIELD( stall             , Int32   , "-"      ),
+
+    FDM_SHARED_FIELD( air_pressure      , Float64 , "Pa"     ),
+    FDM_SHARED_FIELD( air_density       , Float64 , "kg/m^3" ),
+    FDM_SHARED_FIELD( air_temperature   , Float64 , "K"      ),
+    FDM_SHARED_FIELD( wind_direction    , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( wind_speed        , Float64 , "m/s"    ),
+    FDM_SHARED_FIELD( elevation         , Float64 , "m"      ),
+
+    FDM_SHARED_FIELD( ctrl_roll         , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_pitch        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_yaw          , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_collective   , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_brake_l      , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_brake_r      , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_landing_gear , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_flaps        , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ctrl_throttle     , Float64 , "-"      ),
+    FDM_SHARED_FIELD( ailerons          , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( elevator          , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( rudder            , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( flaps             , Float64 , "rad"    ),
+    FDM_SHARED_FIELD( airbrake          , Float64 , "rad"    ),
+
+    FDM_SHARED_FIELD( step_end          , Int64   , "-"      )
+};
+
+static const unsigned int fields_count = sizeof(fields) / sizeof(SharedState::Field);
+
+static_assert( fields_count <= SharedState::_fields_max, "Too many shared state fields." );
+
+////////////////////////////////////////////////////////////////////////////////
+
+const SharedState::Field* SharedState::getSchema( unsigned int *count )
+{
+    if ( count ) (*count) = fields_count;
+
+    return fields;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedState::SharedState() :
+    _segment ( FDM_NULLPTR ),
+    _count ( 0 )
+{
+    memset( &_snapshot, 0, sizeof(Snapshot) );
+    memset( _name, 0, sizeof(_name) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedState::~SharedState()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedState::open( const char *name )
+{
+    close();
+
+#   ifdef _LINUX_
+    // stale segment left by the crashed writer is replaced
+    shm_unlink( name );
+
+    int fd = shm_open( name, O_CREAT | O_RDWR, 0644 );
+
+    if ( fd < 0 )
+    {
+        Log::e() << "Cannot create shared memory segment \"" << name << "\"" << std::endl;
+        return false;
+    }
+
+    if ( ftruncate( fd, sizeof(Segment) ) != 0 )
+    {
+        Log::e() << "Cannot resize shared memory segment \"" << name << "\"" << std::endl;
+        ::close( fd );
+        shm_unlink( name );
+        return false;
+    }
+
+    void *ptr = mmap( FDM_NULLPTR, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+    ::close( fd );
+
+    if ( ptr == MAP_FAILED )
+    {
+        Log::e() << "Cannot map shared memory segment \"" << name << "\"" << std::endl;
+        shm_unlink( name );
+        return false;
+    }
+
+    _segment = new ( ptr ) Segment();
+
+    _segment->header.version       = _version;
+    _segment->header.header_size   = sizeof(Header);
+    _segment->header.snapshot_size = sizeof(Snapshot);
+    _segment->header.slots_count   = _slots_count;
+    _segment->header.fields_count  = fields_count;
+
+    memset( _segment->header.fields, 0, sizeof(_segment->header.fields) );
+    memcpy( _segment->header.fields, fields, sizeof(fields) );
+
+    _segment->header.count.store( 0, std::memory_order_relaxed );
+
+    // readers check magic number before reading anything else
+    _segment->header.magic.store( _magic, std::memory_order_release );
+
+    strncpy( _name, name, sizeof(_name) - 1 );
+
+    _count = 0;
+
+    return true;
+#   else
+    Log::w() << "Shared memory state is not supported on this platform" << std::endl;
+    return false;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedState::close()
+{
+#   ifdef _LINUX_
+    if ( _segment )
+    {
+        _segment->header.magic.store( 0, std::memory_order_release );
+
+        munmap( _segment, sizeof(Segment) );
+        shm_unlink( _name );
+    }
+#   endif
+
+    _segment = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedState::write( const DataInp &dataInp, const DataOut &dataOut, double time )
+{
+    if ( !_segment ) return;
+
+    _snapshot.step = _count;
+
+    _snapshot.time_mono = LatencyTrace::now();
+    _snapshot.time_sim  = time;
+
+    _snapshot.aircraftType = dataInp.aircraftType;
+    _snapshot.stateOut     = dataOut.stateOut;
+
+    _snapshot.latitude      = dataOut.flight.latitude;
+    _snapshot.longitude     = dataOut.flight.longitude;
+    _snapshot.altitude_asl  = dataOut.flight.altitude_asl;
+    _snapshot.altitude_agl  = dataOut.flight.altitude_agl;
+    _snapshot.roll          = dataOut.flight.roll;
+    _snapshot.pitch         = dataOut.flight.pitch;
+    _snapshot.heading       = dataOut.flight.heading;
+    _snapshot.angleOfAttack = dataOut.flight.angleOfAttack;
+    _snapshot.sideslipAngle = dataOut.flight.sideslipAngle;
+    _snapshot.ias           = dataOut.flight.ias;
+    _snapshot.tas           = dataOut.flight.tas;
+    _snapshot.groundSpeed   = dataOut.flight.groundSpeed;
+    _snapshot.machNumber    = dataOut.flight.machNumber;
+    _snapshot.climbRate     = dataOut.flight.climbRate;
+    _snapshot.rollRate      = dataOut.flight.rollRate;
+    _snapshot.pitchRate     = dataOut.flight.pitchRate;
+    _snapshot.yawRate       = dataOut.flight.yawRate;
+    _snapshot.pos_x_wgs     = dataOut.flight.pos_x_wgs;
+    _snapshot.pos_y_wgs     = dataOut.flight.pos_y_wgs;
+    _snapshot.pos_z_wgs     = dataOut.flight.pos_z_wgs;
+    _snapshot.att_e0_wgs    = dataOut.flight.att_e0_wgs;
+    _snapshot.att_ex_wgs    = dataOut.flight.att_ex_wgs;
+    _snapshot.att_ey_wgs    = dataOut.flight.att_ey_wgs;
+    _snapshot.att_ez_wgs    = dataOut.flight.att_ez_wgs;
+    _snapshot.vel_north     = dataOut.flight.vel_north;
+    _snapshot.vel_east      = dataOut.flight.vel_east;
+    _snapshot.g_pilot_x     = dataOut.flight.g_pilot_x;
+    _snapshot.g_pilot_y     = dataOut.flight.g_pilot_y;
+    _snapshot.g_pilot_z     = dataOut.flight.g_pilot_z;
+    _snapshot.onGround      = dataOut.flight.onGround ? 1 : 0;
+    _snapshot.stall         = dataOut.flight.stall    ? 1 : 0;
+
+    _snapshot.air_pressure    = dataOut.environment.air_pressure;
+    _snapshot.air_density     = dataOut.environment.air_density;
+    _snapshot.air_temperature = dataOut.environment.air_temperature;
+    _snapshot.wind_direction  = dataInp.environment.wind_direction;
+    _snapshot.wind_speed      = dataInp.environment.wind_speed;
+    _snapshot.elevation       = dataInp.ground.elevation;
+
+    _snapshot.ctrl_roll         = dataInp.controls.roll;
+    _snapshot.ctrl_pitch        = dataInp.controls.pitch;
+    _snapshot.ctrl_yaw          = dataInp.controls.yaw;
+    _snapshot.ctrl_collective   = dataInp.controls.collective;
+    _snapshot.ctrl_brake_l      = dataInp.controls.brake_l;
+    _snapshot.ctrl_brake_r      = dataInp.controls.brake_r;
+    _snapshot.ctrl_landing_gear = dataInp.controls.landing_gear;
+    _snapshot.ctrl_flaps        = dataInp.controls.flaps;
+    _snapshot.ctrl_throttle     = dataInp.engine[ 0 ].throttle;
+    _snapshot.ailerons          = dataOut.controls.ailerons;
+    _snapshot.elevator          = dataOut.controls.elevator;
+    _snapshot.rudder            = dataOut.controls.rudder;
+    _snapshot.flaps             = dataOut.controls.flaps;
+    _snapshot.airbrake          = dataOut.controls.airbrake;
+
+    _snapshot.step_end = _snapshot.step;
+
+    _segment->ring[ _count % _slots_count ].write( _snapshot );
+
+    _count++;
+
+    _segment->header.count.store( _count, std::memory_order_release );
+}
@@ -0,0 +1,237 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_SHAREDSTATE_H
+#define FDM_SHAREDSTATE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+
+#include <fdm/utils/fdm_SeqLock.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FDM_SHARED_STATE_NAME "/mscsim_state"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Shared memory state publisher class.
+ *
+ * Publishes snapshot of ownship, environment and controls data to a POSIX
+ * shared memory segment at each FDM step, so external clients running on
+ * the same host (e.g. instructor station or extra displays) can read it.
+ *
+ * Segment starts with a header holding magic number, layout version and
+ * schema (name, unit, type and offset of every snapshot field), followed
+ * by a ring of snapshot slots. Each slot is guarded by a sequence lock,
+ * so readers never block the writer. Snapshots count is increased after
+ * each slot is written.
+ *
+ * Shared memory is supported on Linux only, opening fails elsewhere.
+ *
+ * @see SharedStateReader
+ */
+class FDMEXPORT SharedState
+{
+public:
+
+    static const unsigned int _magic       = 0x4d534353;    ///< magic number ("MSCS")
+    static const unsigned int _version     = 1;             ///< layout version
+    static const unsigned int _slots_count = 16;            ///< number of ring slots
+    static const unsigned int _fields_max  = 128;           ///< maximum number of schema fields
+    static const unsigned int _name_max    = 32;            ///< maximum length of field name (including terminating null)
+    static const unsigned int _unit_max    = 16;            ///< maximum length of field unit (including terminating null)
+
+    /** Field types. */
+    enum Type
+    {
+        Float64 = 0,                    ///< 64-bit floating point
+        Int32,                          ///< 32-bit signed integer
+        Int64                           ///< 64-bit signed integer
+    };
+
+    /** Schema field description. */
+    struct Field
+    {
+        char name[ _name_max ];         ///< field name
+        char unit[ _unit_max ];         ///< field unit
+        unsigned int type;              ///< field type
+        unsigned int offset;            ///< [B] field offset within snapshot
+    };
+
+    /**
+     * State snapshot. Step number is repeated as the last member, so readers
+     * can verify that snapshot has not been torn.
+     */
+    struct Snapshot
+    {
+        long long step;                 ///< step number
+
+        long long time_mono;            ///< [ns] monotonic time of writing
+        double    time_sim;             ///< [s] simulation time
+
+        int aircraftType;               ///< aircraft type
+        int stateOut;                   ///< FDM state
+
+        // ownship
+        double latitude;                ///< [rad] geodetic latitude (positive north)
+        double longitude;               ///< [rad] geodetic longitude (positive east)
+        double altitude_asl;            ///< [m] altitude above mean sea level
+        double altitude_agl;            ///< [m] altitude above ground level
+        double roll;                    ///< [rad] roll angle
+        double pitch;                   ///< [rad] pitch angle
+        double heading;                 ///< [rad] true heading
+        double angleOfAttack;           ///< [rad] angle of attack
+        double sideslipAngle;           ///< [rad] angle of sideslip
+        double ias;                     ///< [m/s] IAS
+        double tas;                     ///< [m/s] TAS
+        double groundSpeed;             ///< [m/s] ground speed
+        double machNumber;              ///< [-] Mach number
+        double climbRate;               ///< [m/s] climb rate
+        double rollRate;                ///< [rad/s] roll rate
+        double pitchRate;               ///< [rad/s] pitch rate
+        double yawRate;                 ///< [rad/s] yaw rate
+        double pos_x_wgs;               ///< [m] postion x coordinate expressed in WGS
+        double pos_y_wgs;               ///< [m] postion y coordinate expressed in WGS
+        double pos_z_wgs;               ///< [m] postion z coordinate expressed in WGS
+        double att_e0_wgs;              ///< [-] attitude quaternion e0 component expressed as rotation from WGS to BAS
+        double att_ex_wgs;              ///< [-] attitude quaternion ex component expressed as rotation from WGS to BAS
+        double att_ey_wgs;              ///< [-] attitude quaternion ey component expressed as rotation from WGS to BAS
+        double att_ez_wgs;              ///< [-] attitude quaternion ez component expressed as rotation from WGS to BAS
+        double vel_north;               ///< [m/s] north velocity
+        double vel_east;                ///< [m/s] east velocity
+        double g_pilot_x;               ///< [-] x component of G-Force vector expressed in BAS (pilot)
+        double g_pilot_y;               ///< [-] y component of G-Force vector expressed in BAS (pilot)
+        double g_pilot_z;               ///< [-] z component of G-Force vector expressed in BAS (pilot)
+        int onGround;                   ///< specifies if aircraft is on ground
+        int stall;                      ///< specifies if aircraft is stalling
+
+        // environment
+        double air_pressure;            ///< [Pa] air pressure
+        double air_density;             ///< [kg/m^3] air density
+        double air_temperature;         ///< [K] air temperature
+        double wind_direction;          ///< [rad] wind direction
+        double wind_speed;              ///< [m/s] wind speed
+        double elevation;               ///< [m] ground elevation above mean sea level
+
+        // controls
+        double ctrl_roll;               ///< [-1.0,1.0] roll control
+        double ctrl_pitch;              ///< [-1.0,1.0] pitch control
+        double ctrl_yaw;                ///< [-1.0,1.0] yaw control
+        double ctrl_collective;         ///< [0.0,1.0] collective control
+        double ctrl_brake_l;            ///< [0.0,1.0] left brake
+        double ctrl_brake_r;            ///< [0.0,1.0] right brake
+        double ctrl_landing_gear;       ///< [0.0,1.0] landing gear
+        double ctrl_flaps;              ///< [0.0,1.0] flaps
+        double ctrl_throttle;           ///< [0.0,1.0] throttle (first engine)
+        double ailerons;                ///< [rad] ailerons deflection
+        double elevator;                ///< [rad] elevator deflection
+        double rudder;                  ///< [rad] rudder deflection
+        double flaps;                   ///< [rad] flaps deflection
+        double airbrake;                ///< [rad] airbrake deflection
+
+        long long step_end;             ///< step number, equal to the first member unless torn
+    };
+
+    /** Segment header. */
+    struct Header
+    {
+        std::atomic< unsigned int > magic;  ///< magic number, set when segment is ready
+
+        unsigned int version;               ///< layout version
+        unsigned int header_size;           ///< [B] header size
+        unsigned int snapshot_size;         ///< [B] snapshot size
+        unsigned int slots_count;           ///< number of ring slots
+        unsigned int fields_count;          ///< number of schema fields
+
+        std::atomic< unsigned int > count;  ///< number of snapshots written
+
+        Field fields[ _fields_max ];        ///< schema fields
+    };
+
+    /** Shared memory segment. */
+    struct Segment
+    {
+        Header header;                              ///< segment header
+        SeqLock< Snapshot > ring[ _slots_count ];   ///< ring of snapshot slots
+    };
+
+    /**
+     * @brief Returns snapshot schema.
+     * @param count output number of fields
+     * @return schema fields array
+     */
+    static const Field* getSchema( unsigned int *count );
+
+    /** @brief Constructor. */
+    SharedState();
+
+    /** @brief Destructor. Closes segment. */
+    virtual ~SharedState();
+
+    /**
+     * @brief Creates and maps shared memory segment.
+     * @param name segment name
+     * @return true on success, false on failure
+     */
+    bool open( const char *name = FDM_SHARED_STATE_NAME );
+
+    /** @brief Unmaps and removes shared memory segment. */
+    void close();
+
+    /**
+     * @brief Publishes state snapshot. Must be called by single writer thread only.
+     * @param dataInp FDM input data
+     * @param dataOut FDM output data
+     * @param time [s] simulation time
+     */
+    void write( const DataInp &dataInp, const DataOut &dataOut, double time );
+
+    inline bool isOpen() const { return _segment != FDM_NULLPTR; }
+
+    inline unsigned int getCount() const { return _count; }
+
+private:
+
+    Segment *_segment;              ///< mapped segment, null if not opened
+    Snapshot _snapshot;             ///< snapshot being written
+
+    char _name[ 256 ];              ///< segment name
+
+    unsigned int _count;            ///< number of snapshots written
+
+    /** Using this constructor is forbidden. */
+    SharedState( const SharedState & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_SHAREDSTATE_H
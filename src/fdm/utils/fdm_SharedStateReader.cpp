@@ -0,0 +1,184 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_SharedStateReader.h>
+
+#include <cstring>
+
+#ifdef _LINUX_
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+double SharedStateReader::getValue( const void *snapshot, const Field *field )
+{
+    const char *ptr = (const char*)snapshot + field->offset;
+
+    switch ( field->type )
+    {
+        case SharedState::Float64: { double    v; memcpy( &v, ptr, sizeof(v) ); return v;         }
+        case SharedState::Int32:   { int       v; memcpy( &v, ptr, sizeof(v) ); return (double)v; }
+        case SharedState::Int64:   { long long v; memcpy( &v, ptr, sizeof(v) ); return (double)v; }
+    }
+
+    return 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedStateReader::SharedStateReader() :
+    _segment ( FDM_NULLPTR ),
+    _count   ( 0 ),
+    _missed  ( 0 ),
+    _retries ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedStateReader::~SharedStateReader()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedStateReader::open( const char *name )
+{
+    close();
+
+#   ifdef _LINUX_
+    int fd = shm_open( name, O_RDONLY, 0 );
+
+    if ( fd < 0 ) return false;
+
+    struct stat st;
+
+    if ( fstat( fd, &st ) != 0 || st.st_size < (off_t)sizeof(SharedState::Segment) )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    void *ptr = mmap( FDM_NULLPTR, sizeof(SharedState::Segment), PROT_READ, MAP_SHARED, fd, 0 );
+
+    ::close( fd );
+
+    if ( ptr == MAP_FAILED ) return false;
+
+    const SharedState::Segment *segment = (const SharedState::Segment*)ptr;
+    const SharedState::Header  &header  = segment->header;
+
+    if ( header.magic.load( std::memory_order_acquire ) != SharedState::_magic
+      || header.version       != SharedState::_version
+      || header.header_size   != sizeof(SharedState::Header)
+      || header.snapshot_size != sizeof(Snapshot)
+      || header.slots_count   != SharedState::_slots_count )
+    {
+        munmap( ptr, sizeof(SharedState::Segment) );
+        return false;
+    }
+
+    _segment = segment;
+
+    _count   = header.count.load( std::memory_order_acquire );
+    _missed  = 0;
+    _retries = 0;
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateReader::close()
+{
+#   ifdef _LINUX_
+    if ( _segment )
+    {
+        munmap( (void*)_segment, sizeof(SharedState::Segment) );
+    }
+#   endif
+
+    _segment = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedStateReader::read( Snapshot *snapshot )
+{
+    if ( !_segment ) return false;
+
+    unsigned int count = _segment->header.count.load( std::memory_order_acquire );
+
+    while ( count != _count )
+    {
+        // reader overtaken by the writer skips to the middle of the ring,
+        // so the oldest slot being overwritten is not chased
+        if ( count - _count > SharedState::_slots_count )
+        {
+            _missed += count - _count - SharedState::_slots_count / 2;
+            _count = count - SharedState::_slots_count / 2;
+        }
+
+        if ( _segment->ring[ _count % SharedState::_slots_count ].tryRead( snapshot )
+          && (unsigned int)snapshot->step == _count )
+        {
+            _count++;
+            return true;
+        }
+
+        _retries++;
+        count = _segment->header.count.load( std::memory_order_acquire );
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const SharedStateReader::Field* SharedStateReader::getField( const char *name ) const
+{
+    if ( _segment )
+    {
+        const SharedState::Header &header = _segment->header;
+
+        for ( unsigned int i = 0; i < header.fields_count && i < SharedState::_fields_max; i++ )
+        {
+            if ( 0 == strncmp( header.fields[ i ].name, name, SharedState::_name_max ) )
+            {
+                return &header.fields[ i ];
+            }
+        }
+    }
+
+    return FDM_NULLPTR;
+}
@@ -0,0 +1,112 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_SHAREDSTATEREADER_H
+#define FDM_SHAREDSTATEREADER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/utils/fdm_SharedState.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Shared memory state reader class.
+ *
+ * Maps the segment published by SharedState read-only and reads snapshots
+ * in order. Reading never blocks the writer, copy is retried if the slot
+ * has been modified while being copied. Reader lagging behind the writer
+ * by more than the ring size skips the older half of the ring, skipped
+ * snapshots are counted as missed.
+ *
+ * @see SharedState
+ */
+class FDMEXPORT SharedStateReader
+{
+public:
+
+    typedef SharedState::Field    Field;
+    typedef SharedState::Snapshot Snapshot;
+
+    /**
+     * @brief Returns field value as double.
+     * @param snapshot raw snapshot data
+     * @param field schema field
+     * @return field value
+     */
+    static double getValue( const void *snapshot, const Field *field );
+
+    /** @brief Constructor. */
+    SharedStateReader();
+
+    /** @brief Destructor. Closes segment. */
+    virtual ~SharedStateReader();
+
+    /**
+     * @brief Maps shared memory segment.
+     * @param name segment name
+     * @return true on success, false if segment does not exist, is not ready or layout does not match
+     */
+    bool open( const char *name = FDM_SHARED_STATE_NAME );
+
+    /** @brief Unmaps shared memory segment. */
+    void close();
+
+    /**
+     * @brief Reads the oldest snapshot not read yet.
+     * @param snapshot output snapshot
+     * @return true if snapshot has been read, false if all snapshots have been read already
+     */
+    bool read( Snapshot *snapshot );
+
+    /**
+     * @brief Returns schema field of the given name.
+     * @param name field name
+     * @return schema field on success, null pointer on failure
+     */
+    const Field* getField( const char *name ) const;
+
+    inline bool isOpen() const { return _segment != FDM_NULLPTR; }
+
+    inline unsigned int getCount()   const { return _count;   }
+    inline unsigned int getMissed()  const { return _missed;  }
+    inline unsigned int getRetries() const { return _retries; }
+
+private:
+
+    const SharedState::Segment *_segment;   ///< mapped segment, null if not opened
+
+    unsigned int _count;                    ///< number of snapshots read or skipped
+    unsigned int _missed;                   ///< number of snapshots overwritten before being read
+    unsigned int _retries;                  ///< number of copies retried because slot was being written
+
+    /** Using this constructor is forbidden. */
+    SharedStateReader( const SharedStateReader & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_SHAREDSTATEREADER_H
@@ -247,20 +247,7 @@ double Table1::getValue( double key_value ) const
         if ( key_value > _key_values[ _size - 1 ] )
             return getLastValue();
 
-        unsigned int key_1 = 0;
-        unsigned int key_2 = 0;
-
-        for ( unsigned int i = 1; i < _size; i++ )
-        {
-            key_1 = i - 1;
-            key_2 = i;
-
-            if ( key_value >= _key_values[ key_1 ]
-              && key_value <  _key_values[ key_2 ] )
-            {
-                break;
-            }
-        }
+        unsigned int key_1 = Misc::bracket( _key_values, _size, key_value );
 
         return ( key_value - _key_values[ key_1 ] ) * _inter_data[ key_1 ]
                 + _table_data[ key_1 ];
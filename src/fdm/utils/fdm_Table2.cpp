@@ -179,27 +179,10 @@ double Table2::getValue( double row_value, double col_value ) const
         if ( row_value > _row_values[ _rows - 1 ] ) return getValue( _row_values[ _rows - 1 ], col_value );
         if ( col_value > _col_values[ _cols - 1 ] ) return getValue( row_value, _col_values[ _cols - 1 ] );
 
-        unsigned int row_1 = 0;
-        unsigned int row_2 = 0;
+        unsigned int row_1 = Misc::bracket( _row_values, _rows, row_value );
+        unsigned int row_2 = ( _rows > 1 ) ? row_1 + 1 : row_1;
 
-        for ( unsigned int r = 1; r < _rows; r++ )
-        {
-            row_1 = r - 1;
-            row_2 = r;
-
-            if ( row_value >= _row_values[ row_1 ] && row_value < _row_values[ row_2 ] ) break;
-        }
-
-        unsigned int col_1 = 0;
-        unsigned int col_2 = 0;
-
-        for ( unsigned int c = 1; c < _cols; c++ )
-        {
-            col_1 = c - 1;
-            col_2 = c;
-
-            if ( col_value >= _col_values[ col_1 ] && col_value < _col_values[ col_2 ] ) break;
-        }
+        unsigned int col_1 = Misc::bracket( _col_values, _cols, col_value );
 
         double result_1 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_1 * _cols + col_1 ]
                         + _table_data[ row_1 * _cols + col_1 ];
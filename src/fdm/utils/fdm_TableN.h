@@ -0,0 +1,350 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TABLEN_H
+#define FDM_TABLEN_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/utils/fdm_Misc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief N-dimensional table and multilinear interpolation template class.
+ *
+ * Table data is stored contiguously in row-major order (the last dimension
+ * varies fastest). Values outside keys ranges are clamped to the ranges,
+ * the same way fdm::Table1 and fdm::Table2 do.
+ *
+ * Interpolation gathers 2^N surrounding values into a local array and then
+ * reduces it one dimension at a time. Every reduction pass is a fixed trip
+ * count loop over contiguous data, so it is vectorized by the compiler.
+ *
+ * @see fdm::Table1
+ * @see fdm::Table2
+ * @see https://en.wikipedia.org/wiki/Multilinear_interpolation
+ */
+template < unsigned int N >
+class TableN
+{
+public:
+
+    typedef std::vector< double > Keys;
+
+    static const unsigned int _corners = 1U << N;   ///< number of hypercube corners
+
+    /** @brief Constructor. */
+    TableN()
+    {
+        for ( unsigned int d = 0; d < N; d++ ) _strides[ d ] = 0;
+        for ( unsigned int i = 0; i < _corners; i++ ) _offsets[ i ] = 0;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param keys keys values array (N elements), every sorted in ascending order
+     * @param data table data in row-major order (the last dimension varies fastest)
+     */
+    TableN( const Keys keys[], const std::vector< double > &data )
+    {
+        unsigned int size = 1;
+
+        for ( unsigned int d = 0; d < N; d++ )
+        {
+            _keys[ d ] = keys[ d ];
+            size *= static_cast< unsigned int >( keys[ d ].size() );
+        }
+
+        if ( size > 0 && size == data.size() )
+        {
+            _data = data;
+            updateOffsets();
+        }
+        else
+        {
+            Exception e;
+
+            e.setType( Exception::UnknownException );
+            e.setInfo( "Invalid table size." );
+
+            FDM_THROW( e );
+        }
+    }
+
+    /**
+     * @brief Returns number of keys of the given dimension.
+     * @param dim dimension index
+     * @return number of keys
+     */
+    inline unsigned int getSize( unsigned int dim ) const
+    {
+        return static_cast< unsigned int >( _keys[ dim ].size() );
+    }
+
+    /**
+     * @brief Returns key value.
+     * @param dim dimension index
+     * @param index key index
+     * @return key value
+     */
+    inline double getKeyValue( unsigned int dim, unsigned int index ) const
+    {
+        return _keys[ dim ][ index ];
+    }
+
+    /**
+     * @brief Returns table value for the given keys.
+     * Returns table value for the given keys values using multilinear
+     * interpolation algorithm.
+     * @param values keys values array (N elements)
+     * @return interpolated value on success or NaN on failure
+     */
+    double getValue( const double values[] ) const
+    {
+        if ( _data.size() > 0 )
+        {
+            unsigned int base = 0;
+            double weights[ N ];
+
+            for ( unsigned int d = 0; d < N; d++ )
+            {
+                const unsigned int size = static_cast< unsigned int >( _keys[ d ].size() );
+                const double *keys = &( _keys[ d ][ 0 ] );
+
+                double value = Misc::satur( keys[ 0 ], keys[ size - 1 ], values[ d ] );
+
+                unsigned int index = Misc::bracket( keys, size, value );
+
+                base += index * _strides[ d ];
+                weights[ d ] = 0.0;
+
+                if ( size > 1 )
+                {
+                    double delta = keys[ index + 1 ] - keys[ index ];
+
+                    if ( fabs( delta ) > 1.0e-16 )
+                    {
+                        weights[ d ] = ( value - keys[ index ] ) / delta;
+                    }
+                }
+            }
+
+            double corners[ _corners ];
+
+            const double *data = &( _data[ base ] );
+
+            for ( unsigned int i = 0; i < _corners; i++ )
+            {
+                corners[ i ] = data[ _offsets[ i ] ];
+            }
+
+            // reducing one dimension at a time, starting from the last one
+            for ( unsigned int d = N; d-- > 0; )
+            {
+                const unsigned int half = 1U << d;
+                const double w = weights[ d ];
+
+                for ( unsigned int i = 0; i < half; i++ )
+                {
+                    corners[ i ] += w * ( corners[ i + half ] - corners[ i ] );
+                }
+            }
+
+            return corners[ 0 ];
+        }
+        else
+        {
+            Exception e;
+
+            e.setType( Exception::UnknownException );
+            e.setInfo( "Invalid table size." );
+
+            FDM_THROW( e );
+        }
+
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+
+    /**
+     * @brief Returns table value for the given keys (2-dimensional table).
+     * @param v0 1st dimension key value
+     * @param v1 2nd dimension key value
+     * @return interpolated value on success or NaN on failure
+     */
+    inline double getValue( double v0, double v1 ) const
+    {
+        static_assert( N == 2, "Invalid number of keys." );
+        const double values[] = { v0, v1 };
+        return getValue( values );
+    }
+
+    /**
+     * @brief Returns table value for the given keys (3-dimensional table).
+     * @param v0 1st dimension key value
+     * @param v1 2nd dimension key value
+     * @param v2 3rd dimension key value
+     * @return interpolated value on success or NaN on failure
+     */
+    inline double getValue( double v0, double v1, double v2 ) const
+    {
+        static_assert( N == 3, "Invalid number of keys." );
+        const double values[] = { v0, v1, v2 };
+        return getValue( values );
+    }
+
+    /**
+     * @brief Returns table value for the given keys (4-dimensional table).
+     * @param v0 1st dimension key value
+     * @param v1 2nd dimension key value
+     * @param v2 3rd dimension key value
+     * @param v3 4th dimension key value
+     * @return interpolated value on success or NaN on failure
+     */
+    inline double getValue( double v0, double v1, double v2, double v3 ) const
+    {
+        static_assert( N == 4, "Invalid number of keys." );
+        const double values[] = { v0, v1, v2, v3 };
+        return getValue( values );
+    }
+
+    /**
+     * @brief Returns table value for the given keys indices.
+     * @param indices keys indices array (N elements)
+     * @return table value
+     */
+    double getValueByIndex( const unsigned int indices[] ) const
+    {
+        unsigned int index = 0;
+
+        for ( unsigned int d = 0; d < N; d++ )
+        {
+            index += indices[ d ] * _strides[ d ];
+        }
+
+        return _data[ index ];
+    }
+
+    /**
+     * @brief Checks if table is valid.
+     * @return returns true if size is greater than 0, all keys are sorted
+     * in ascending order and all data is valid
+     */
+    bool isValid() const
+    {
+        bool result = _data.size() > 0;
+
+        for ( unsigned int d = 0; d < N && result; d++ )
+        {
+            for ( unsigned int i = 0; i < _keys[ d ].size() && result; i++ )
+            {
+                result = Misc::isValid( _keys[ d ][ i ] );
+
+                if ( result && i > 0 )
+                {
+                    result = _keys[ d ][ i - 1 ] < _keys[ d ][ i ];
+                }
+            }
+        }
+
+        for ( unsigned int i = 0; i < _data.size() && result; i++ )
+        {
+            result = Misc::isValid( _data[ i ] );
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Multiplies keys values of the given dimension by the given factor.
+     * @param dim dimension index
+     * @param factor given factor
+     */
+    void multiplyKeys( unsigned int dim, double factor )
+    {
+        for ( unsigned int i = 0; i < _keys[ dim ].size(); i++ )
+        {
+            _keys[ dim ][ i ] *= factor;
+        }
+    }
+
+    /**
+     * @brief Multiplies values by the given factor.
+     * @param factor given factor
+     */
+    void multiplyValues( double factor )
+    {
+        for ( unsigned int i = 0; i < _data.size(); i++ )
+        {
+            _data[ i ] *= factor;
+        }
+    }
+
+private:
+
+    Keys _keys[ N ];                    ///< keys values
+    std::vector< double > _data;        ///< table data
+
+    unsigned int _strides[ N ];         ///< data strides
+    unsigned int _offsets[ _corners ];  ///< hypercube corners offsets relative to the lower corner
+
+    /** Updates strides and corners offsets due to keys sizes. */
+    void updateOffsets()
+    {
+        unsigned int stride = 1;
+
+        for ( unsigned int d = N; d-- > 0; )
+        {
+            _strides[ d ] = stride;
+            stride *= static_cast< unsigned int >( _keys[ d ].size() );
+        }
+
+        for ( unsigned int i = 0; i < _corners; i++ )
+        {
+            _offsets[ i ] = 0;
+
+            for ( unsigned int d = 0; d < N; d++ )
+            {
+                // single key dimensions have no upper neighbour
+                if ( ( i & ( 1U << d ) ) && _keys[ d ].size() > 1 )
+                {
+                    _offsets[ i ] += _strides[ d ];
+                }
+            }
+        }
+    }
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TABLEN_H
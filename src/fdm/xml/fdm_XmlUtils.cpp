@@ -248,6 +248,166 @@ int XmlUtils::read( const XmlNode &node, Vector3 *data )
 ////////////////////////////////////////////////////////////////////////////////
 
 int XmlUtils::read( const XmlNode &node, Table1 *table )
+{
+    std::vector< double > keys[ 1 ];
+    std::vector< double > data;
+
+    if ( FDM_SUCCESS == readTableN( node, 1, keys, &data ) )
+    {
+        (*table) = Table1( keys[ 0 ], data );
+        return FDM_SUCCESS;
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlUtils::read( const XmlNode &node, Table2 *table )
+{
+    std::vector< double > keys[ 2 ];
+    std::vector< double > data;
+
+    if ( FDM_SUCCESS == readTableN( node, 2, keys, &data ) )
+    {
+        (*table) = Table2( keys[ 0 ], keys[ 1 ], data );
+        return FDM_SUCCESS;
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlUtils::read( const XmlNode &node, PID *pid, double min, double max )
+{
+    if ( node.isValid() )
+    {
+        int result = FDM_SUCCESS;
+
+        double kp = 0.0;
+        double ki = 0.0;
+        double kd = 0.0;
+
+        double kaw = 0.0;
+
+        double temp_min = min;
+        double temp_max = max;
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kp, "kp", true );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &ki, "ki", true );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kd, "kd", true );
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kaw, "kaw", true );
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &temp_min, "min", true );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &temp_max, "max", true );
+
+        if ( result == FDM_SUCCESS )
+        {
+            if ( temp_min < min ) temp_min = min;
+            if ( temp_max > max ) temp_max = max;
+
+            pid->setKp( kp );
+            pid->setKi( ki );
+            pid->setKd( kd );
+
+            pid->setKaw( kaw );
+
+            pid->setMin( temp_min );
+            pid->setMax( temp_max );
+
+            return FDM_SUCCESS;
+        }
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlUtils::throwError( const char *file, int line, const XmlNode &node )
+{
+    Exception e;
+
+    e.setType( Exception::FileReadingError );
+    e.setInfo( "Reading XML file failed. " + XmlUtils::getErrorInfo( node ) );
+
+    e.setFile( file );
+    e.setLine( line );
+
+    throw e;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlUtils::readTableN( const XmlNode &node, unsigned int dims,
+                          std::vector< double > keys[],
+                          std::vector< double > *data )
+{
+    if ( dims == 1 )
+    {
+        return readTable1Data( node, &keys[ 0 ], data );
+    }
+    else if ( dims == 2 )
+    {
+        return readTable2Data( node, &keys[ 0 ], &keys[ 1 ], data );
+    }
+    else if ( dims > 2 && node.isValid() )
+    {
+        std::vector< std::vector< double > > sub_keys( dims - 1 );
+
+        keys[ 0 ].clear();
+
+        XmlNode tableNode = node.getFirstChildElement( "table" );
+
+        while ( tableNode.isValid() )
+        {
+            double key = String::toDouble( tableNode.getAttribute( "key" ),
+                                           std::numeric_limits< double >::quiet_NaN() );
+
+            if ( !Misc::isValid( key ) )
+            {
+                return FDM_FAILURE;
+            }
+
+            if ( FDM_SUCCESS != readTableN( tableNode, dims - 1, &( sub_keys[ 0 ] ), data ) )
+            {
+                return FDM_FAILURE;
+            }
+
+            // all sub-tables have to share the same keys
+            for ( unsigned int d = 1; d < dims; d++ )
+            {
+                if ( keys[ 0 ].size() == 0 )
+                {
+                    keys[ d ] = sub_keys[ d - 1 ];
+                }
+                else if ( keys[ d ] != sub_keys[ d - 1 ] )
+                {
+                    return FDM_FAILURE;
+                }
+            }
+
+            keys[ 0 ].push_back( key );
+
+            tableNode = tableNode.getNextSiblingElement( "table" );
+        }
+
+        if ( keys[ 0 ].size() > 0 )
+        {
+            return FDM_SUCCESS;
+        }
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlUtils::readTable1Data( const XmlNode &node,
+                              std::vector< double > *keys,
+                              std::vector< double > *data )
 {
     std::vector< double > keyValues;
     std::vector< double > tableData;
@@ -294,7 +454,8 @@ int XmlUtils::read( const XmlNode &node, Table1 *table )
 
             if ( keyValues.size() == tableData.size() && keyValues.size() )
             {
-                (*table) = Table1( keyValues, tableData );
+                (*keys) = keyValues;
+                data->insert( data->end(), tableData.begin(), tableData.end() );
 
                 return FDM_SUCCESS;
             }
@@ -306,7 +467,10 @@ int XmlUtils::read( const XmlNode &node, Table1 *table )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-int XmlUtils::read( const XmlNode &node, Table2 *table )
+int XmlUtils::readTable2Data( const XmlNode &node,
+                              std::vector< double > *rows,
+                              std::vector< double > *cols,
+                              std::vector< double > *data )
 {
     std::vector< double > colValues;
     std::vector< double > rowValues;
@@ -392,7 +556,10 @@ int XmlUtils::read( const XmlNode &node, Table2 *table )
 
             if ( rowValues.size() * colValues.size() == tableData.size() )
             {
-                (*table) = Table2( rowValues, colValues, tableData );
+                (*rows) = rowValues;
+                (*cols) = colValues;
+                data->insert( data->end(), tableData.begin(), tableData.end() );
+
                 return FDM_SUCCESS;
             }
         }
@@ -400,65 +567,3 @@ int XmlUtils::read( const XmlNode &node, Table2 *table )
 
     return FDM_FAILURE;
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-int XmlUtils::read( const XmlNode &node, PID *pid, double min, double max )
-{
-    if ( node.isValid() )
-    {
-        int result = FDM_SUCCESS;
-
-        double kp = 0.0;
-        double ki = 0.0;
-        double kd = 0.0;
-
-        double kaw = 0.0;
-
-        double temp_min = min;
-        double temp_max = max;
-
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kp, "kp", true );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &ki, "ki", true );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kd, "kd", true );
-
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &kaw, "kaw", true );
-
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &temp_min, "min", true );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( node, &temp_max, "max", true );
-
-        if ( result == FDM_SUCCESS )
-        {
-            if ( temp_min < min ) temp_min = min;
-            if ( temp_max > max ) temp_max = max;
-
-            pid->setKp( kp );
-            pid->setKi( ki );
-            pid->setKd( kd );
-
-            pid->setKaw( kaw );
-
-            pid->setMin( temp_min );
-            pid->setMax( temp_max );
-
-            return FDM_SUCCESS;
-        }
-    }
-
-    return FDM_FAILURE;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void XmlUtils::throwError( const char *file, int line, const XmlNode &node )
-{
-    Exception e;
-
-    e.setType( Exception::FileReadingError );
-    e.setInfo( "Reading XML file failed. " + XmlUtils::getErrorInfo( node ) );
-
-    e.setFile( file );
-    e.setLine( line );
-
-    throw e;
-}
@@ -29,6 +29,7 @@
 #include <fdm/utils/fdm_Matrix3x3.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_TableN.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -151,6 +152,48 @@ public:
      */
     static int read( const XmlNode &node, Table2 *table );
 
+    /**
+     * @brief Reads N-dimensional table data from XML file.
+     * @param node XML node
+     * @param table table
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
+     *
+     * Table is given as nested sub-tables of one dimension less, down to
+     * 2-dimensional tables (1-dimensional if N is 1) in fdm::Table2 format.
+     * All sub-tables have to share the same keys values. Factor and unit
+     * attributes are applied to the innermost tables.
+     *
+     * @code
+     * <tag_name>
+     *   <table key="{ 1st dimension key }">
+     *     <table key="{ 2nd dimension key }" [factor="{ value }] [unit="{ unit string }"]>
+     *       { column key } ... { more column keys }
+     *        { row key } { value } ... { more values }
+     *       ... { more entries }
+     *     </table>
+     *     ... { more sub-tables }
+     *   </table>
+     *   ... { more sub-tables }
+     * </tag_name>
+     * @endcode
+     *
+     * @see fdm::TableN
+     */
+    template < unsigned int N >
+    static int read( const XmlNode &node, TableN< N > *table )
+    {
+        std::vector< double > keys[ N ];
+        std::vector< double > data;
+
+        if ( FDM_SUCCESS == readTableN( node, N, keys, &data ) )
+        {
+            (*table) = TableN< N >( keys, data );
+            return FDM_SUCCESS;
+        }
+
+        return FDM_FAILURE;
+    }
+
     /**
      * @brief Reads PID controller data from XML file.
      * @param node XML node
@@ -211,6 +254,44 @@ public:
      * @param node node
      */
     static void throwError( const char *file, int line, const XmlNode &node );
+
+private:
+
+    /**
+     * @brief Reads N-dimensional table data from XML file.
+     * @param node XML node
+     * @param dims number of dimensions
+     * @param keys keys values array (dims elements)
+     * @param data table data (values are appended)
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
+     */
+    static int readTableN( const XmlNode &node, unsigned int dims,
+                           std::vector< double > keys[],
+                           std::vector< double > *data );
+
+    /**
+     * @brief Reads 1-dimensional table data from XML file.
+     * @param node XML node
+     * @param keys keys values
+     * @param data table data (values are appended)
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
+     */
+    static int readTable1Data( const XmlNode &node,
+                               std::vector< double > *keys,
+                               std::vector< double > *data );
+
+    /**
+     * @brief Reads 2-dimensional table data from XML file.
+     * @param node XML node
+     * @param rows rows keys values
+     * @param cols columns keys values
+     * @param data table data (values are appended)
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
+     */
+    static int readTable2Data( const XmlNode &node,
+                               std::vector< double > *rows,
+                               std::vector< double > *cols,
+                               std::vector< double > *data );
 };
 
 } // end of fdm namespace
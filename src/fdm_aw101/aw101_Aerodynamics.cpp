@@ -158,6 +158,9 @@ void AW101_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
+    _mainRotor->integrate( getTimeStep() );
+    _tailRotor->integrate( getTimeStep() );
+
     _mainRotor->update( _aircraft->getProp()->getMainRotorOmega(),
                         _aircraft->getProp()->getMainRotorPsi(),
                         _aircraft->getCtrl()->getCollective(),
@@ -137,7 +137,7 @@ void AW101_Controls::update()
     Controls::update();
     ///////////////////
 
-    _afcs->update( _aircraft->getTimeStep(),
+    _afcs->update( getTimeStep(),
                    _inputCtrlRoll  .getValue() , 0.0,
                    _inputCtrlPitch .getValue() , 0.0,
                    _inputCtrlYaw   .getValue() , 0.0,
@@ -81,8 +81,6 @@ public:
 private:
 
     const AW101_Aircraft *_aircraft;    ///< aircraft model main object
-
-    Wheels _wheels;                     ///< wheels container
 };
 
 } // end of fdm namespace
@@ -104,8 +104,8 @@ void AW101_Propulsion::computeForceAndMoment()
 void AW101_Propulsion::update()
 {
     // TODO
-    _mainRotorPsi += _aircraft->getTimeStep() * _mainRotorOmega;
-    _tailRotorPsi += _aircraft->getTimeStep() * _tailRotorOmega;
+    _mainRotorPsi += getTimeStep() * _mainRotorOmega;
+    _tailRotorPsi += getTimeStep() * _tailRotorOmega;
 
     _mainRotorPsi = Angles::normalize( _mainRotorPsi );
     _tailRotorPsi = Angles::normalize( _tailRotorPsi );
@@ -78,8 +78,6 @@ public:
 private:
 
     const C130_Aircraft *_aircraft;     ///< aircraft model main object
-
-    Wheels _wheels;                     ///< wheels container
 };
 
 } // end of fdm namespace
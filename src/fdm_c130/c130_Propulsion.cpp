@@ -178,7 +178,7 @@ void C130_Propulsion::update()
 {
     for ( int i = 0; i < _enginesCount; i++ )
     {
-        _propeller[ i ]->integrate( _aircraft->getTimeStep(), _engine[ i ]->getInertia() );
+        _propeller[ i ]->integrate( getTimeStep(), _engine[ i ]->getInertia() );
 
         double throttle  = _inputThrottle  [ i ].getDatad();
         double mixture   = _inputMixture   [ i ].getDatad();
@@ -147,7 +147,7 @@ void C172_Propulsion::computeForceAndMoment()
 
 void C172_Propulsion::update()
 {
-    _propeller->integrate( _aircraft->getTimeStep(), _engine->getInertia() );
+    _propeller->integrate( getTimeStep(), _engine->getInertia() );
 
     double throttle  = _inputThrottle  .getDatad();
     double mixture   = _inputMixture   .getDatad();
@@ -75,11 +75,7 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_mac  , "mac"  );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_area , "area" );
 
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh_n25      , "cx_dh_n25"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh_n10      , "cx_dh_n10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh_0        , "cx_dh_0"        );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh_p10      , "cx_dh_p10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh_p25      , "cx_dh_p25"      );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_dh          , "cx_dh"          );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_lef         , "cx_lef"         );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cx_sb    , "delta_cx_sb"    );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx_q           , "cx_q"           );
@@ -97,11 +93,7 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cy_p           , "cy_p"           );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cy_p_lef , "delta_cy_p_lef" );
 
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh_n25      , "cz_dh_n25"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh_n10      , "cz_dh_n10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh_0        , "cz_dh_0"        );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh_p10      , "cz_dh_p10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh_p25      , "cz_dh_p25"      );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_dh          , "cz_dh"          );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_lef         , "cz_lef"         );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cz_sb    , "delta_cz_sb"    );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz_q           , "cz_q"           );
@@ -109,9 +101,7 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cz_tef   , "delta_cz_tef"   );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cz_gear  , "delta_cz_gear"  );
 
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_dh_n25      , "cl_dh_n25"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_dh_0        , "cl_dh_0"        );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_dh_p25      , "cl_dh_p25"      );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_dh          , "cl_dh"          );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_lef         , "cl_lef"         );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_da_20       , "cl_da_20"       );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_da_20_lef   , "cl_da_20_lef"   );
@@ -122,11 +112,7 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cl_p           , "cl_p"           );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cl_p_lef , "delta_cl_p_lef" );
 
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh_n25      , "cm_dh_n25"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh_n10      , "cm_dh_n10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh_0        , "cm_dh_0"        );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh_p10      , "cm_dh_p10"      );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh_p25      , "cm_dh_p25"      );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_dh          , "cm_dh"          );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_lef         , "cm_lef"         );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cm_sb    , "delta_cm_sb"    );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cm_q           , "cm_q"           );
@@ -136,9 +122,7 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_delta_cm_tef   , "delta_cm_tef"   );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_eta_delta_h    , "eta_delta_h"    );
 
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_dh_n25        , "cn_dh_n25"        );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_dh_0          , "cn_dh_0"          );
-        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_dh_p25        , "cn_dh_p25"        );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_dh          , "cn_dh"          );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_lef           , "cn_lef"           );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_da_20         , "cn_da_20"         );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cn_da_20_lef     , "cn_da_20_lef"     );
@@ -155,11 +139,9 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
         {
             _mac_s = _area * _mac;
 
-            _cx_dh_n25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cx_dh_n10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cx_dh_0        .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cx_dh_p10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cx_dh_p25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
+            _cx_dh          .multiplyKeys( 0, Units::deg2rad() );
+            _cx_dh          .multiplyKeys( 1, Units::deg2rad() );
+            _cx_dh          .multiplyKeys( 2, Units::deg2rad() );
             _cx_lef         .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _delta_cx_sb    .multiplyKeys( Units::deg2rad() );
             _cx_q           .multiplyKeys( Units::deg2rad() );
@@ -177,11 +159,9 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
             _cy_p           .multiplyKeys( Units::deg2rad() );
             _delta_cy_p_lef .multiplyKeys( Units::deg2rad() );
 
-            _cz_dh_n25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cz_dh_n10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cz_dh_0        .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cz_dh_p10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cz_dh_p25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
+            _cz_dh          .multiplyKeys( 0, Units::deg2rad() );
+            _cz_dh          .multiplyKeys( 1, Units::deg2rad() );
+            _cz_dh          .multiplyKeys( 2, Units::deg2rad() );
             _cz_lef         .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _delta_cz_sb    .multiplyKeys( Units::deg2rad() );
             _cz_q           .multiplyKeys( Units::deg2rad() );
@@ -189,9 +169,9 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
             _delta_cz_tef   .multiplyKeys( Units::deg2rad() );
             _delta_cz_gear  .multiplyKeys( Units::deg2rad() );
 
-            _cl_dh_n25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cl_dh_0        .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cl_dh_p25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
+            _cl_dh          .multiplyKeys( 0, Units::deg2rad() );
+            _cl_dh          .multiplyKeys( 1, Units::deg2rad() );
+            _cl_dh          .multiplyKeys( 2, Units::deg2rad() );
             _cl_lef         .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _cl_da_20       .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _cl_da_20_lef   .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
@@ -202,11 +182,9 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
             _cl_p           .multiplyKeys( Units::deg2rad() );
             _delta_cl_p_lef .multiplyKeys( Units::deg2rad() );
 
-            _cm_dh_n25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cm_dh_n10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cm_dh_0        .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cm_dh_p10      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cm_dh_p25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
+            _cm_dh          .multiplyKeys( 0, Units::deg2rad() );
+            _cm_dh          .multiplyKeys( 1, Units::deg2rad() );
+            _cm_dh          .multiplyKeys( 2, Units::deg2rad() );
             _cm_lef         .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _delta_cm_sb    .multiplyKeys( Units::deg2rad() );
             _cm_q           .multiplyKeys( Units::deg2rad() );
@@ -216,9 +194,9 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
             _delta_cm_tef   .multiplyKeys( Units::deg2rad() );
             _eta_delta_h    .multiplyKeys( Units::deg2rad() );
 
-            _cn_dh_n25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cn_dh_0        .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
-            _cn_dh_p25      .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
+            _cn_dh          .multiplyKeys( 0, Units::deg2rad() );
+            _cn_dh          .multiplyKeys( 1, Units::deg2rad() );
+            _cn_dh          .multiplyKeys( 2, Units::deg2rad() );
             _cn_lef         .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _cn_da_20       .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
             _cn_da_20_lef   .multiplyColsAndRows( Units::deg2rad(), Units::deg2rad() );
@@ -314,7 +292,7 @@ double F16_Aerodynamics::getCx() const
 {
     // (NASA-TP-1538, p.37)
     double delta_cx_lef = _cx_lef  .getValue( _alpha, _beta )
-                        - _cx_dh_0 .getValue( _alpha, _beta );
+                        - _cx_dh .getValue( 0.0, _alpha, _beta );
 
     double cx_q = _cx_q.getValue( _alpha ) + _delta_cx_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -351,7 +329,7 @@ double F16_Aerodynamics::getCz() const
 {
     // (NASA-TP-1538, p.37)
     double delta_cz_lef = _cz_lef  .getValue( _alpha, _beta )
-                        - _cz_dh_0 .getValue( _alpha, _beta );
+                        - _cz_dh .getValue( 0.0, _alpha, _beta );
 
     double cz_q = _cz_q.getValue( _alpha ) + _delta_cz_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -367,7 +345,7 @@ double F16_Aerodynamics::getCz() const
 double F16_Aerodynamics::getCl() const
 {
     // (NASA-TP-1538, p.39-40)
-    double cl_dh_0  = _cl_dh_0  .getValue( _alpha, _beta );
+    double cl_dh_0  = _cl_dh .getValue( 0.0, _alpha, _beta );
     double cl_lef   = _cl_lef   .getValue( _alpha, _beta );
     double cl_da_20 = _cl_da_20 .getValue( _alpha, _beta );
 
@@ -391,7 +369,7 @@ double F16_Aerodynamics::getCm() const
 {
     // (NASA-TP-1538, p.38)
     double delta_cm_lef = _cm_lef  .getValue( _alpha, _beta )
-                        - _cm_dh_0 .getValue( _alpha, _beta );
+                        - _cm_dh .getValue( 0.0, _alpha, _beta );
 
     double cm_q = _cm_q.getValue( _alpha ) + _delta_cm_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -409,7 +387,7 @@ double F16_Aerodynamics::getCm() const
 double F16_Aerodynamics::getCn() const
 {
     // (NASA-TP-1538, p.39)
-    double cn_dh_0  = _cn_dh_0  .getValue( _alpha, _beta );
+    double cn_dh_0  = _cn_dh .getValue( 0.0, _alpha, _beta );
     double cn_lef   = _cn_lef   .getValue( _alpha, _beta );
     double cn_da_20 = _cn_da_20 .getValue( _alpha, _beta );
 
@@ -431,105 +409,11 @@ double F16_Aerodynamics::getCn() const
 
 void F16_Aerodynamics::updateCoefsDueToElevator()
 {
-    double coef_1 = 0.0;
-    double coef_2 = 0.0;
+    double delta_h = _aircraft->getCtrl()->getElevator();
 
-    double cx_l = 0.0;
-    double cx_h = 0.0;
-    double cz_l = 0.0;
-    double cz_h = 0.0;
-
-    double cl_l = 0.0;
-    double cl_h = 0.0;
-    double cm_l = 0.0;
-    double cm_h = 0.0;
-    double cn_l = 0.0;
-    double cn_h = 0.0;
-
-    double delta_h_deg = Units::rad2deg( _aircraft->getCtrl()->getElevator() );
-
-    if ( delta_h_deg < 0.0 )
-    {
-        coef_2 = ( delta_h_deg + 25.0 ) / 25.0;
-
-        cl_l = _cl_dh_n25 .getValue( _alpha, _beta );
-        cl_h = _cl_dh_0   .getValue( _alpha, _beta );
-
-        cn_l = _cn_dh_n25 .getValue( _alpha, _beta );
-        cn_h = _cn_dh_0   .getValue( _alpha, _beta );
-
-        if ( delta_h_deg < -10.0 )
-        {
-            coef_1 = ( delta_h_deg + 25.0 ) / 15.0;
-
-            cx_l = _cx_dh_n25 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_n10 .getValue( _alpha, _beta );
-
-            cz_l = _cz_dh_n25 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_n10 .getValue( _alpha, _beta );
-
-            cm_l = _cm_dh_n25 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_n10 .getValue( _alpha, _beta );
-        }
-        else
-        {
-            coef_1 = ( delta_h_deg + 10.0 ) / 10.0;
-
-            cx_l = _cx_dh_n10 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_0   .getValue( _alpha, _beta );
-
-            cz_l = _cz_dh_n10 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_0   .getValue( _alpha, _beta );
-
-            cm_l = _cm_dh_n10 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_0   .getValue( _alpha, _beta );
-        }
-    }
-    else
-    {
-        coef_2 = delta_h_deg / 25.0;
-
-        cl_l = _cl_dh_0   .getValue( _alpha, _beta );
-        cl_h = _cl_dh_p25 .getValue( _alpha, _beta );
-
-        cn_l = _cn_dh_0   .getValue( _alpha, _beta );
-        cn_h = _cn_dh_p25 .getValue( _alpha, _beta );
-
-        if ( delta_h_deg < 10.0 )
-        {
-            coef_1 = delta_h_deg / 10.0;
-
-            cx_l = _cx_dh_0   .getValue( _alpha, _beta );
-            cx_h = _cx_dh_p10 .getValue( _alpha, _beta );
-
-            cz_l = _cz_dh_0   .getValue( _alpha, _beta );
-            cz_h = _cz_dh_p10 .getValue( _alpha, _beta );
-
-            cm_l = _cm_dh_0   .getValue( _alpha, _beta );
-            cm_h = _cm_dh_p10 .getValue( _alpha, _beta );
-        }
-        else
-        {
-            coef_1 = ( delta_h_deg - 10.0 ) / 15.0;
-
-            cx_l = _cx_dh_p10 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_p25 .getValue( _alpha, _beta );
-
-            cz_l = _cz_dh_p10 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_p25 .getValue( _alpha, _beta );
-
-            cm_l = _cm_dh_p10 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_p25 .getValue( _alpha, _beta );
-        }
-    }
-
-    coef_1 = Misc::satur( 0.0, 1.0, coef_1 );
-    coef_2 = Misc::satur( 0.0, 1.0, coef_2 );
-
-    _cx_delta_h = cx_l + coef_1 * ( cx_h - cx_l );
-    _cz_delta_h = cz_l + coef_1 * ( cz_h - cz_l );
-    _cm_delta_h = cm_l + coef_1 * ( cm_h - cm_l );
-
-    _cl_delta_h = cl_l + coef_2 * ( cl_h - cl_l );
-    _cn_delta_h = cn_l + coef_2 * ( cn_h - cn_l );
+    _cx_delta_h = _cx_dh.getValue( delta_h, _alpha, _beta );
+    _cz_delta_h = _cz_dh.getValue( delta_h, _alpha, _beta );
+    _cl_delta_h = _cl_dh.getValue( delta_h, _alpha, _beta );
+    _cm_delta_h = _cm_dh.getValue( delta_h, _alpha, _beta );
+    _cn_delta_h = _cn_dh.getValue( delta_h, _alpha, _beta );
 }
@@ -28,6 +28,7 @@
 
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_TableN.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -74,11 +75,7 @@ private:
 
     const F16_Aircraft *_aircraft;  ///< aircraft model main object
 
-    Table2 _cx_dh_n25;              ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=-25)
-    Table2 _cx_dh_n10;              ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=-10)
-    Table2 _cx_dh_0;                ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=0)
-    Table2 _cx_dh_p10;              ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=10)
-    Table2 _cx_dh_p25;              ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=25)
+    TableN<3> _cx_dh;               ///< [-] body x-force coefficient vs elevator deflection, angle of attack and sideslip
     Table2 _cx_lef;                 ///<
     Table1 _delta_cx_sb;            ///<
     Table1 _cx_q;                   ///<
@@ -96,11 +93,7 @@ private:
     Table1 _cy_p;                   ///<
     Table1 _delta_cy_p_lef;         ///<
 
-    Table2 _cz_dh_n25;              ///< [-] body z-force coefficient vs angle of attack and sideslip (delta_h=-25)
-    Table2 _cz_dh_n10;              ///< [-] body z-force coefficient vs angle of attack and sideslip (delta_h=-10)
-    Table2 _cz_dh_0;                ///< [-] body z-force coefficient vs angle of attack and sideslip (delta_h=0)
-    Table2 _cz_dh_p10;              ///< [-] body z-force coefficient vs angle of attack and sideslip (delta_h=10)
-    Table2 _cz_dh_p25;              ///< [-] body z-force coefficient vs angle of attack and sideslip (delta_h=25)
+    TableN<3> _cz_dh;               ///< [-] body z-force coefficient vs elevator deflection, angle of attack and sideslip
     Table2 _cz_lef;                 ///<
     Table1 _delta_cz_sb;            ///<
     Table1 _cz_q;                   ///<
@@ -108,9 +101,7 @@ private:
     Table1 _delta_cz_tef;           ///<
     Table1 _delta_cz_gear;          ///<
 
-    Table2 _cl_dh_n25;              ///<
-    Table2 _cl_dh_0;                ///<
-    Table2 _cl_dh_p25;              ///<
+    TableN<3> _cl_dh;               ///< [-] body rolling moment coefficient vs elevator deflection, angle of attack and sideslip
     Table2 _cl_lef;                 ///<
     Table2 _cl_da_20;               ///<
     Table2 _cl_da_20_lef;           ///<
@@ -121,11 +112,7 @@ private:
     Table1 _cl_p;                   ///<
     Table1 _delta_cl_p_lef;         ///<
 
-    Table2 _cm_dh_n25;              ///< [-] body pitching moment coefficient vs angle of attack and sideslip (delta_h=-25)
-    Table2 _cm_dh_n10;              ///< [-] body pitching moment coefficient vs angle of attack and sideslip (delta_h=-10)
-    Table2 _cm_dh_0;                ///< [-] body pitching moment coefficient vs angle of attack and sideslip (delta_h=0)
-    Table2 _cm_dh_p10;              ///< [-] body pitching moment coefficient vs angle of attack and sideslip (delta_h=10)
-    Table2 _cm_dh_p25;              ///< [-] body pitching moment coefficient vs angle of attack and sideslip (delta_h=25)
+    TableN<3> _cm_dh;               ///< [-] body pitching moment coefficient vs elevator deflection, angle of attack and sideslip
     Table2 _cm_lef;                 ///<
     Table1 _delta_cm_sb;            ///<
     Table1 _cm_q;                   ///<
@@ -135,9 +122,7 @@ private:
     Table1 _delta_cm_tef;           ///<
     Table1 _eta_delta_h;            ///< horizontal stabilator effectiveness factor
 
-    Table2 _cn_dh_n25;              ///< [-] body yawing moment coefficient vs angle of attack and sideslip (delta_h=-25)
-    Table2 _cn_dh_0;                ///< [-] body yawing moment coefficient vs angle of attack and sideslip (delta_h=0)
-    Table2 _cn_dh_p25;              ///< [-] body yawing moment coefficient vs angle of attack and sideslip (delta_h=25)
+    TableN<3> _cn_dh;               ///< [-] body yawing moment coefficient vs elevator deflection, angle of attack and sideslip
     Table2 _cn_lef;                 ///<
     Table2 _cn_da_20;               ///<
     Table2 _cn_da_20_lef;           ///<
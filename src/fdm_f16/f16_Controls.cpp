@@ -192,9 +192,9 @@ void F16_Controls::update()
     _nose_wheel = _channelNoseWheel->output;
 
     // 1000 Hz
-    const unsigned int steps = static_cast< unsigned int >( ceil( _aircraft->getTimeStep() / 0.001 ) );
+    const unsigned int steps = static_cast< unsigned int >( ceil( getTimeStep() / 0.001 ) );
 
-    const double timeStep = _aircraft->getTimeStep() / ( (double)steps );
+    const double timeStep = getTimeStep() / ( (double)steps );
     const double delta_angleOfAttack = _aircraft->getAngleOfAttack() - _angleOfAttack;
     const double delta_g_y = _aircraft->getGForce().y() - _g_y;
     const double delta_g_z = _aircraft->getGForce().z() - _g_z;
@@ -240,7 +240,7 @@ void F16_Controls::update()
                        _inputLGH.getDatab(),
                        _aircraft->getGear()->getOnGround() );
 
-//        _flcs->update( _aircraft->getTimeStep(),
+//        _flcs->update( getTimeStep(),
 //                       _aircraft->getAngleOfAttack(),
 //                       _aircraft->getGForce().y(), _aircraft->getGForce().z(),
 //                       _aircraft->getOmg_BAS()( _i_p ), _aircraft->getOmg_BAS()( _i_q ), _aircraft->getOmg_BAS()( _i_r ),
@@ -24,7 +24,6 @@
 
 #include <algorithm>
 
-#include <fdm/ctrl/fdm_Lag.h>
 #include <fdm/utils/fdm_Misc.h>
 #include <fdm/utils/fdm_Units.h>
 
@@ -62,19 +61,19 @@ F16_FLCS::F16_FLCS() :
     _cat   ( CAT_I  ),
     _gains ( Cruise ),
 
-    _alpha_lef ( FDM_NULLPTR ),
+    _alpha_lef ( 0 ),
 
     _flaps_int ( 0.0 ),
     _flaps_com ( 0.0 ),
 
-    _stick_lat    ( FDM_NULLPTR ),
-    _p_com_lag    ( FDM_NULLPTR ),
-    _p_com_pos    ( FDM_NULLPTR ),
-    _p_com_neg    ( FDM_NULLPTR ),
-    _omg_p_lag    ( FDM_NULLPTR ),
-    _omg_p_fil    ( FDM_NULLPTR ),
-    _delta_fl_lag ( FDM_NULLPTR ),
-    _delta_fr_lag ( FDM_NULLPTR ),
+    _stick_lat    ( 0 ),
+    _p_com_lag    ( 0 ),
+    _p_com_pos    ( 0 ),
+    _p_com_neg    ( 0 ),
+    _omg_p_lag    ( 0 ),
+    _omg_p_fil    ( 0 ),
+    _delta_fl_lag ( 0 ),
+    _delta_fr_lag ( 0 ),
 
     _delta_flc ( 0.0 ),
     _delta_frc ( 0.0 ),
@@ -83,19 +82,19 @@ F16_FLCS::F16_FLCS() :
     _delta_ac  ( 0.0 ),
     _delta_a   ( 0.0 ),
 
-    _stick_lon  ( FDM_NULLPTR ),
-    _alpha_lag  ( FDM_NULLPTR ),
-    _g_com_lag  ( FDM_NULLPTR ),
-    _omg_q_lag  ( FDM_NULLPTR ),
-    _omg_q_fil  ( FDM_NULLPTR ),
-    _g_z_input  ( FDM_NULLPTR ),
-    _sca_bias_1 ( FDM_NULLPTR ),
-    _sca_bias_2 ( FDM_NULLPTR ),
-    _sca_bias_3 ( FDM_NULLPTR ),
-    _u_sca_fil  ( FDM_NULLPTR ),
-    _u_sca_fil2 ( FDM_NULLPTR ),
-    _actuator_l ( FDM_NULLPTR ),
-    _actuator_r ( FDM_NULLPTR ),
+    _stick_lon  ( 0 ),
+    _alpha_lag  ( 0 ),
+    _g_com_lag  ( 0 ),
+    _omg_q_lag  ( 0 ),
+    _omg_q_fil  ( 0 ),
+    _g_z_input  ( 0 ),
+    _sca_bias_1 ( 0 ),
+    _sca_bias_2 ( 0 ),
+    _sca_bias_3 ( 0 ),
+    _u_sca_fil  ( 0 ),
+    _u_sca_fil2 ( 0 ),
+    _actuator_l ( 0 ),
+    _actuator_r ( 0 ),
 
     _pitch_int ( 0.0 ),
     _delta_htl ( 0.0 ),
@@ -103,97 +102,59 @@ F16_FLCS::F16_FLCS() :
     _delta_h   ( 0.0 ),
     _delta_d   ( 0.0 ),
 
-    _pedals      ( FDM_NULLPTR ),
-    _omg_r_lag   ( FDM_NULLPTR ),
-    _omg_p_yaw   ( FDM_NULLPTR ),
-    _u_sum_ll1   ( FDM_NULLPTR ),
-    _u_sum_ll2   ( FDM_NULLPTR ),
-    _delta_r_fil ( FDM_NULLPTR ),
-    _delta_r_lag ( FDM_NULLPTR ),
+    _pedals      ( 0 ),
+    _omg_r_lag   ( 0 ),
+    _omg_p_yaw   ( 0 ),
+    _u_sum_ll1   ( 0 ),
+    _u_sum_ll2   ( 0 ),
+    _delta_r_fil ( 0 ),
+    _delta_r_lag ( 0 ),
 
     _delta_r   ( 0.0 ),
 
     _gun_compensation ( 0.0 )
 {
     // lef
-    _alpha_lef = new LeadLag( 2.0, 7.25, 1.0, 7.25 );
+    _alpha_lef = _inputs.addLeadLag( 2.0, 7.25, 1.0, 7.25 );
 
     // lat
-    _stick_lat    = new Lag( 1.0 / 60.0 );
-    _p_com_lag    = new Lag( 1.0 / 10.0 );
-    _p_com_pos    = new LeadLag( 6.0, 0.0, 1.0, 20.0 );
-    _p_com_neg    = new LeadLag( 6.0, 0.0, 1.0, 20.0 );
-    _omg_p_lag    = new Lag( 1.0 / 50.0 );
-    _omg_p_fil    = new Filter2( 4.0, 64.0, 6400.0, 1.0, 80.0, 6400.0 );
-    _delta_fl_lag = new Lag( 1.0 / 20.0 );
-    _delta_fr_lag = new Lag( 1.0 / 20.0 );
+    _stick_lat    = _inputs.addLag( 1.0 / 60.0 );
+    _p_com_lag    = _filters.addLag( 1.0 / 10.0 );
+    _p_com_pos    = _filters.addLeadLag( 6.0, 0.0, 1.0, 20.0 );
+    _p_com_neg    = _filters.addLeadLag( 6.0, 0.0, 1.0, 20.0 );
+    _omg_p_lag    = _inputs.addLag( 1.0 / 50.0 );
+    _omg_p_fil    = _filters.addFilter2( 4.0, 64.0, 6400.0, 1.0, 80.0, 6400.0 );
+    _delta_fl_lag = _filters.addLag( 1.0 / 20.0 );
+    _delta_fr_lag = _filters.addLag( 1.0 / 20.0 );
 
     // lon
-    _stick_lon  = new Lag( 1.0 / 60.0 );
-    _alpha_lag  = new Lag( 1.0 / 10.0 );
-    _g_com_lag  = new Lag( 1.0 / 8.3 );
-    _omg_q_lag  = new Lag( 1.0 / 50.0 );
-    _omg_q_fil  = new LeadLag( 1.0, 0.0, 1.0, 1.0 );
-    _g_z_input  = new Lag( 1.0 / 50.0 );
-    _sca_bias_1 = new Lag( 1.0 / 10.0 );
-    _sca_bias_2 = new Lag( 1.0 / 0.125 );
-    _sca_bias_3 = new Lag( 1.0 / 0.125 );
-    _u_sca_fil  = new LeadLag( 3.0, 12.0, 1.0, 12.0 );
-    _u_sca_fil2 = new Filter2( 2.0, 20.0, 3500.0, 1.0, 40.0, 3500.0 );
-    _actuator_l = new Lag( 1.0 / 20.0 );
-    _actuator_r = new Lag( 1.0 / 20.0 );
+    _stick_lon  = _inputs.addLag( 1.0 / 60.0 );
+    _alpha_lag  = _inputs.addLag( 1.0 / 10.0 );
+    _g_com_lag  = _filters.addLag( 1.0 / 8.3 );
+    _omg_q_lag  = _inputs.addLag( 1.0 / 50.0 );
+    _omg_q_fil  = _filters.addLeadLag( 1.0, 0.0, 1.0, 1.0 );
+    _g_z_input  = _inputs.addLag( 1.0 / 50.0 );
+    _sca_bias_1 = _inputs.addLag( 1.0 / 10.0 );
+    _sca_bias_2 = _inputs.addLag( 1.0 / 0.125 );
+    _sca_bias_3 = _inputs.addLag( 1.0 / 0.125 );
+    _u_sca_fil  = _filters.addLeadLag( 3.0, 12.0, 1.0, 12.0 );
+    _u_sca_fil2 = _filters.addFilter2( 2.0, 20.0, 3500.0, 1.0, 40.0, 3500.0 );
+    _actuator_l = _filters.addLag( 1.0 / 20.0 );
+    _actuator_r = _filters.addLag( 1.0 / 20.0 );
 
     // yaw
-    _pedals      = new Lag( 1.0 / 60.0 );
-    _omg_r_lag   = new Lag( 1.0 / 50.0 );
-    _omg_p_yaw   = new Filter2( 1.0, 0.0, 3025.0, 1.0, 110.0, 3025.0 );
-    _u_sum_ll1   = new LeadLag( 3.0, 15.0, 1.0, 15.0 );
-    _u_sum_ll2   = new LeadLag( 1.5,  0.0, 1.0,  1.0 );
-    _delta_r_fil = new Filter2( 1.0, 0.0, 1225.0, 1.0, 70.0, 1225.0 );
-    _delta_r_lag = new Lag( 1.0 / 20.0 );
+    _pedals      = _inputs.addLag( 1.0 / 60.0 );
+    _omg_r_lag   = _inputs.addLag( 1.0 / 50.0 );
+    _omg_p_yaw   = _filters.addFilter2( 1.0, 0.0, 3025.0, 1.0, 110.0, 3025.0 );
+    _u_sum_ll1   = _filters.addLeadLag( 3.0, 15.0, 1.0, 15.0 );
+    _u_sum_ll2   = _filters.addLeadLag( 1.5,  0.0, 1.0,  1.0 );
+    _delta_r_fil = _filters.addFilter2( 1.0, 0.0, 1225.0, 1.0, 70.0, 1225.0 );
+    _delta_r_lag = _filters.addLag( 1.0 / 20.0 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-F16_FLCS::~F16_FLCS()
-{
-    // lef
-    FDM_DELPTR( _alpha_lef );
-
-    // lat
-    FDM_DELPTR( _stick_lat );
-    FDM_DELPTR( _p_com_lag );
-    FDM_DELPTR( _p_com_pos );
-    FDM_DELPTR( _p_com_neg );
-    FDM_DELPTR( _omg_p_lag );
-    FDM_DELPTR( _omg_p_fil );
-    FDM_DELPTR( _delta_fl_lag );
-    FDM_DELPTR( _delta_fr_lag );
-
-    // lon
-    FDM_DELPTR( _stick_lon );
-    FDM_DELPTR( _alpha_lag );
-    FDM_DELPTR( _g_com_lag );
-    FDM_DELPTR( _omg_q_lag );
-    FDM_DELPTR( _omg_q_fil );
-    FDM_DELPTR( _g_z_input );
-    FDM_DELPTR( _sca_bias_1 );
-    FDM_DELPTR( _sca_bias_2 );
-    FDM_DELPTR( _sca_bias_3 );
-    FDM_DELPTR( _u_sca_fil );
-    FDM_DELPTR( _u_sca_fil2 );
-    FDM_DELPTR( _actuator_l );
-    FDM_DELPTR( _actuator_r );
-
-    // yaw
-    FDM_DELPTR( _pedals );
-    FDM_DELPTR( _omg_r_lag );
-    FDM_DELPTR( _omg_p_yaw );
-    FDM_DELPTR( _u_sum_ll1 );
-    FDM_DELPTR( _u_sum_ll2 );
-    FDM_DELPTR( _delta_r_fil );
-    FDM_DELPTR( _delta_r_lag );
-}
+F16_FLCS::~F16_FLCS() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -235,11 +196,16 @@ void F16_FLCS::update( double timeStep, double angleOfAttack,
 
         double q_p = dynPress / statPress;
 
+        updateInputs( angleOfAttack, g_z,
+                      rollRate, pitchRate, yawRate,
+                      ctrlLat, ctrlLon, ctrlYaw,
+                      touchdown );
+
         updateTEF( q_p, alt_flaps_ext, lg_handle_dn );
-        updateLEF( angleOfAttack, q_p );
-        updateLat( ctrlLat, trimLat, rollRate );
-        updateLon( ctrlLon, trimLon, pitchRate, angleOfAttack, q_p, dynPress, g_z, touchdown );
-        updateYaw( ctrlYaw, trimYaw, yawRate, q_p, g_y );
+        updateLEF( q_p );
+        updateLat( trimLat );
+        updateLon( trimLon, q_p, dynPress, touchdown );
+        updateYaw( trimYaw, q_p, g_y );
     }
 }
 
@@ -277,13 +243,42 @@ void F16_FLCS::setFlaps_le_max( double flaps_le_max )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F16_FLCS::updateLEF( double angleOfAttack, double q_p )
+void F16_FLCS::updateInputs( double angleOfAttack, double g_z,
+                             double rollRate, double pitchRate, double yawRate,
+                             double ctrlLat, double ctrlLon, double ctrlYaw,
+                             bool touchdown )
 {
-    _alpha_lef->update( _timeStep, Units::rad2deg( angleOfAttack ) );
+    // (AD-A055-417, p.20)
+    double alpha_deg = Units::rad2deg( angleOfAttack );
+
+    // input signals filters do not depend on each other,
+    // so all of them are updated in a single pass
+    _inputs.setInput( _alpha_lef  , alpha_deg );
 
+    _inputs.setInput( _stick_lat  , ctrlLat );
+    _inputs.setInput( _omg_p_lag  , Units::rad2deg( rollRate ) );
+
+    _inputs.setInput( _alpha_lag  , Misc::satur( -5.0, 30.0, alpha_deg ) );
+    _inputs.setInput( _stick_lon  , ctrlLon   );
+    _inputs.setInput( _g_z_input  , g_z - 1.0 );
+    _inputs.setInput( _omg_q_lag  , Units::rad2deg( pitchRate ) );
+    _inputs.setInput( _sca_bias_1 , touchdown ? 0.0 : 6.0 );
+    _inputs.setInput( _sca_bias_2 , _gains == Landing ? 9.0 : 0.0 );
+    _inputs.setInput( _sca_bias_3 , _gains == Landing ? 1.0 : 0.0 );
+
+    _inputs.setInput( _pedals     , ctrlYaw );
+    _inputs.setInput( _omg_r_lag  , Units::rad2deg( yawRate ) );
+
+    _inputs.update( _timeStep );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F16_FLCS::updateLEF( double q_p )
+{
     // (NASA-TP-1538, p.34)
     // delta_lef = 1.38 (2s+7.25)/(s+7.25) alpha - 9.05 q/p_s + 1.45
-    double flaps_le_deg = 1.38 * _alpha_lef->getValue()
+    double flaps_le_deg = 1.38 * _inputs.getValue( _alpha_lef )
             - 9.05 * q_p + 1.45;
 
     _flaps_le = Misc::satur( 0.0, _flaps_le_max, Units::deg2rad( flaps_le_deg ) );
@@ -314,31 +309,25 @@ void F16_FLCS::updateTEF( double q_p, bool alt_flaps_ext, bool lg_handle_dn )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F16_FLCS::updateLat( double ctrlLat, double trimLat,
-                          double rollRate )
+void F16_FLCS::updateLat( double trimLat )
 {
     // (AD-A055-417, p.20)
-    double omg_p_deg = Units::rad2deg( rollRate );
-
-    _stick_lat->update( _timeStep, ctrlLat );
-
-    double p_com = _stick_lat->getValue();
+    double p_com = _inputs.getValue( _stick_lat );
 
     if ( _gains == Landing ) p_com *= 0.542;
 
-    double p_loop_pos = std::max( 0.0, _p_com_pos->getValue() );
-    double p_loop_neg = std::min( 0.0, _p_com_neg->getValue() );
-    _p_com_lag->update( _timeStep, p_com - p_loop_pos - p_loop_neg );
+    double p_loop_pos = std::max( 0.0, _filters.getValue( _p_com_pos ) );
+    double p_loop_neg = std::min( 0.0, _filters.getValue( _p_com_neg ) );
+    _filters.update( _timeStep, _p_com_lag, p_com - p_loop_pos - p_loop_neg );
 
-    _p_com_pos->update( _timeStep, std::max( 0.0, _p_com_lag->getValue() ) );
-    _p_com_neg->update( _timeStep, std::min( 0.0, _p_com_lag->getValue() ) );
+    _filters.update( _timeStep, _p_com_pos, std::max( 0.0, _filters.getValue( _p_com_lag ) ) );
+    _filters.update( _timeStep, _p_com_neg, std::min( 0.0, _filters.getValue( _p_com_lag ) ) );
 
-    _omg_p_lag->update( _timeStep, omg_p_deg );
-    _omg_p_fil->update( _timeStep, _omg_p_lag->getValue() );
+    _filters.update( _timeStep, _omg_p_fil, _inputs.getValue( _omg_p_lag ) );
 
     double roll_ap_tie_in = 0.0; // TODO
-    double roll_control = _omg_p_fil->getValue()
-            - ( _p_com_lag->getValue() + trimLat * 1.67 )
+    double roll_control = _filters.getValue( _omg_p_fil )
+            - ( _filters.getValue( _p_com_lag ) + trimLat * 1.67 )
             - roll_ap_tie_in
             + 1.67 * _gun_compensation;
 
@@ -353,12 +342,12 @@ void F16_FLCS::updateLat( double ctrlLat, double trimLat,
 
     _delta_ac = _delta_frc - _delta_flc;
 
-    _delta_fl_lag->update( _timeStep, _delta_flc );
-    _delta_fr_lag->update( _timeStep, _delta_frc );
+    _filters.update( _timeStep, _delta_fl_lag, _delta_flc );
+    _filters.update( _timeStep, _delta_fr_lag, _delta_frc );
 
     double flaperons_delta_max = 80.0 * _timeStep;
-    _delta_fl = getSurfaceMaxRate( _delta_fl, _delta_fl_lag->getValue(), flaperons_delta_max );
-    _delta_fr = getSurfaceMaxRate( _delta_fr, _delta_fr_lag->getValue(), flaperons_delta_max );
+    _delta_fl = getSurfaceMaxRate( _delta_fl, _filters.getValue( _delta_fl_lag ), flaperons_delta_max );
+    _delta_fr = getSurfaceMaxRate( _delta_fr, _filters.getValue( _delta_fr_lag ), flaperons_delta_max );
 
     _delta_a = 0.5 * ( _delta_fr - _delta_fl );
 
@@ -368,22 +357,14 @@ void F16_FLCS::updateLat( double ctrlLat, double trimLat,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F16_FLCS::updateLon( double ctrlLon, double trimLon,
-                          double pitchRate,
-                          double angleOfAttack, double q_p, double dynPress, double g_z,
+void F16_FLCS::updateLon( double trimLon,
+                          double q_p, double dynPress,
                           bool touchdown )
 {
     // (AD-A055-417, p.20)
-    double alpha_deg = Units::rad2deg( angleOfAttack );
-    double omg_q_deg = Units::rad2deg( pitchRate );
-
-    _alpha_lag->update( _timeStep, Misc::satur( -5.0, 30.0, alpha_deg ) );
-    _stick_lon->update( _timeStep, ctrlLon   );
-    _g_z_input->update( _timeStep, g_z - 1.0 );
-    _omg_q_lag->update( _timeStep, omg_q_deg );
-    _omg_q_fil->update( _timeStep, _omg_q_lag->getValue() );
+    _filters.update( _timeStep, _omg_q_fil, _inputs.getValue( _omg_q_lag ) );
 
-    double g_com = _stick_lon->getValue() + trimLon;
+    double g_com = _inputs.getValue( _stick_lon ) + trimLon;
     double g_max =  8.0;
     double g_min = -4.0;
 
@@ -400,32 +381,29 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
         }
     }
 
-    _g_com_lag->update( _timeStep, Misc::satur( g_min, g_max, g_com ) * ( touchdown ? 1.0 : 0.5 ) );
+    _filters.update( _timeStep, _g_com_lag, Misc::satur( g_min, g_max, g_com ) * ( touchdown ? 1.0 : 0.5 ) );
 
-    double q_gained = 0.7 * getGainF3( dynPress ) * _omg_q_fil->getValue();
-    double aoa_limit = std::max( 0.0, 0.5 * ( _alpha_lag->getValue() - 20.4 + q_gained ) );
+    double q_gained = 0.7 * getGainF3( dynPress ) * _filters.getValue( _omg_q_fil );
+    double aoa_limit = std::max( 0.0, 0.5 * ( _inputs.getValue( _alpha_lag ) - 20.4 + q_gained ) );
 
     double pitch_ap_tie_in = 0.0; // TODO
-    double g_command = aoa_limit - _g_com_lag->getValue() - pitch_ap_tie_in;
+    double g_command = aoa_limit - _filters.getValue( _g_com_lag ) - pitch_ap_tie_in;
 
-    _sca_bias_1->update( _timeStep, touchdown ? 0.0 : 6.0 );
-    _sca_bias_2->update( _timeStep, _gains == Landing ? 9.0 : 0.0 );
-    _sca_bias_3->update( _timeStep, _gains == Landing ? 1.0 : 0.0 );
 
-    double aoa_bias = 9.0 - _sca_bias_2->getValue() + _sca_bias_1->getValue();
+    double aoa_bias = 9.0 - _inputs.getValue( _sca_bias_2 ) + _inputs.getValue( _sca_bias_1 );
 
-    double u_sca_1 = 0.161 * ( q_gained + _alpha_lag->getValue() - aoa_bias );
-    double u_sca_2 = ( touchdown ? 0.231 : 0.167 ) * _omg_q_fil->getValue()
-            + 0.5 * _g_z_input->getValue();
+    double u_sca_1 = 0.161 * ( q_gained + _inputs.getValue( _alpha_lag ) - aoa_bias );
+    double u_sca_2 = ( touchdown ? 0.231 : 0.167 ) * _filters.getValue( _omg_q_fil )
+            + 0.5 * _inputs.getValue( _g_z_input );
 
     double u_sca = std::max( 0.0, u_sca_1 ) //+ std::min( 0.0, u_sca_1 ) * m_sca_bias_3->getValue()
             + u_sca_2;
 
-    _u_sca_fil->update( _timeStep, u_sca );
-    _u_sca_fil2->update( _timeStep, _u_sca_fil->getValue() );
+    _filters.update( _timeStep, _u_sca_fil, u_sca );
+    _filters.update( _timeStep, _u_sca_fil2, _filters.getValue( _u_sca_fil ) );
 
-    double pitch_gained = 3.0 * getGainF3( dynPress ) * ( g_command + _u_sca_fil2->getValue() );
-    double alpha_gained = getGainF2( q_p ) * _alpha_lag->getValue();
+    double pitch_gained = 3.0 * getGainF3( dynPress ) * ( g_command + _filters.getValue( _u_sca_fil2 ) );
+    double alpha_gained = getGainF2( q_p ) * _inputs.getValue( _alpha_lag );
 
     double k_a = 2000.0; // open loop amplifier gain (AD-A055-417, p.22)
     double pitch_out = _pitch_int + pitch_gained;
@@ -440,12 +418,12 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
 
     double delta_dc = 0.5 * getGainF10( q_p ) * _delta_ac;
 
-    _actuator_l->update( _timeStep, selector_input - delta_dc );
-    _actuator_r->update( _timeStep, selector_input + delta_dc );
+    _filters.update( _timeStep, _actuator_l, selector_input - delta_dc );
+    _filters.update( _timeStep, _actuator_r, selector_input + delta_dc );
 
     double elevator_delta_max = 60.0 * _timeStep;
-    _delta_htl = getSurfaceMaxRate( _delta_htl, _actuator_l->getValue(), elevator_delta_max );
-    _delta_htr = getSurfaceMaxRate( _delta_htr, _actuator_r->getValue(), elevator_delta_max );
+    _delta_htl = getSurfaceMaxRate( _delta_htl, _filters.getValue( _actuator_l ), elevator_delta_max );
+    _delta_htr = getSurfaceMaxRate( _delta_htr, _filters.getValue( _actuator_r ), elevator_delta_max );
 
     _delta_htl = Misc::satur( -_elevator_max_deg, _elevator_max_deg, _delta_htl );
     _delta_htr = Misc::satur( -_elevator_max_deg, _elevator_max_deg, _delta_htr );
@@ -461,45 +439,40 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F16_FLCS::updateYaw( double ctrlYaw, double trimYaw,
-                          double yawRate,
+void F16_FLCS::updateYaw( double trimYaw,
                           double q_p, double g_y )
 {
-    double omg_r_deg = Units::rad2deg( yawRate  );
-
-    _pedals->update( _timeStep, ctrlYaw );
-    _omg_r_lag->update( _timeStep, omg_r_deg );
-    _omg_p_yaw->update( _timeStep, _omg_p_lag->getValue() );
+    _filters.update( _timeStep, _omg_p_yaw, _inputs.getValue( _omg_p_lag ) );
 
-    double r_com = _pedals->getValue() + trimYaw;
-    double u_sum = _omg_r_lag->getValue() - ( 1.0 / 57.3 ) * _omg_p_yaw->getValue() * _alpha_lag->getValue();
+    double r_com = _inputs.getValue( _pedals ) + trimYaw;
+    double u_sum = _inputs.getValue( _omg_r_lag ) - ( 1.0 / 57.3 ) * _filters.getValue( _omg_p_yaw ) * _inputs.getValue( _alpha_lag );
 
-    _u_sum_ll1->update( _timeStep, u_sum );
-    _u_sum_ll2->update( _timeStep, _u_sum_ll1->getValue() );
+    _filters.update( _timeStep, _u_sum_ll1, u_sum );
+    _filters.update( _timeStep, _u_sum_ll2, _filters.getValue( _u_sum_ll1 ) );
 
     // Aileron Rudder Interconnect (ARI)
     double ari_gain = 0.0;
 
     // (AD-A055-417, p.20)
     // (NASA-TP-1538, p.216)
-    double alpha_abs = fabs( _alpha_lag->getValue() );
+    double alpha_abs = fabs( _inputs.getValue( _alpha_lag ) );
     if ( alpha_abs < 10.0 )
     {
         ari_gain = 1.0 - alpha_abs / 10.0;
     }
-    double ari = //0.0375 * _alpha_lag->getValue()
-        - 0.65 * ari_gain * _alpha_lag->getValue() * getGainF7( q_p );
+    double ari = //0.0375 * _inputs.getValue( _alpha_lag )
+        - 0.65 * ari_gain * _inputs.getValue( _alpha_lag ) * getGainF7( q_p );
 
     double u_gy = -g_y; // TODO
-    double r_auto = getGainF8( q_p ) * ( _u_sum_ll2->getValue() + 19.32 * u_gy ) + 0.5 * _delta_ac * ari;
+    double r_auto = getGainF8( q_p ) * ( _filters.getValue( _u_sum_ll2 ) + 19.32 * u_gy ) + 0.5 * _delta_ac * ari;
 
     double delta_rc = r_com + r_auto;
 
-    _delta_r_fil->update( _timeStep, delta_rc );
-    _delta_r_lag->update( _timeStep, _delta_r_fil->getValue() );
+    _filters.update( _timeStep, _delta_r_fil, delta_rc );
+    _filters.update( _timeStep, _delta_r_lag, _filters.getValue( _delta_r_fil ) );
 
     double rudder_delta_max = 120.0 * _timeStep;
-    _delta_r = getSurfaceMaxRate( _delta_r, _delta_r_lag->getValue(), rudder_delta_max );
+    _delta_r = getSurfaceMaxRate( _delta_r, _filters.getValue( _delta_r_lag ), rudder_delta_max );
     _delta_r = Misc::satur( -_rudder_max_deg, _rudder_max_deg, _delta_r );
 
     _rudder = Units::deg2rad( _delta_r );
@@ -24,9 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <fdm/ctrl/fdm_Filter2.h>
-#include <fdm/ctrl/fdm_Lag.h>
-#include <fdm/ctrl/fdm_LeadLag.h>
+#include <fdm/ctrl/fdm_FilterBank.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -122,9 +120,12 @@ private:
     CAT   _cat;                         ///< loading category
     Gains _gains;                       ///< FLCS gains mode
 
+    FilterBank _inputs;                 ///< input signals filters, updated at once
+    FilterBank _filters;                ///< control laws filters, updated one by one
+
     // leading edge flaps
 
-    LeadLag *_alpha_lef;                ///<
+    unsigned int _alpha_lef;            ///<
 
     // trailing edge flaps
 
@@ -133,14 +134,14 @@ private:
 
     // roll channel
 
-    Lag     *_stick_lat;                ///< lateral stick input lagged
-    Lag     *_p_com_lag;                ///< roll rate command
-    LeadLag *_p_com_pos;                ///< roll rate command "positive" feedback loop
-    LeadLag *_p_com_neg;                ///< roll rate command "negative" feedback loop
-    Lag     *_omg_p_lag;                ///< filtered roll rate (p_f)
-    Filter2 *_omg_p_fil;                ///<
-    Lag     *_delta_fl_lag;             ///<
-    Lag     *_delta_fr_lag;             ///<
+    unsigned int _stick_lat;            ///< lateral stick input lagged
+    unsigned int _p_com_lag;            ///< roll rate command
+    unsigned int _p_com_pos;            ///< roll rate command "positive" feedback loop
+    unsigned int _p_com_neg;            ///< roll rate command "negative" feedback loop
+    unsigned int _omg_p_lag;            ///< filtered roll rate (p_f)
+    unsigned int _omg_p_fil;            ///<
+    unsigned int _delta_fl_lag;         ///<
+    unsigned int _delta_fr_lag;         ///<
 
     double _delta_flc;                  ///< [deg] left flaperon deflection commanded by control system
     double _delta_frc;                  ///< [deg] right flaperon deflection commanded by control system
@@ -151,19 +152,19 @@ private:
 
     // pitch channel
 
-    Lag     *_stick_lon;                ///< longitudinal stick input lagged
-    Lag     *_alpha_lag;                ///< [deg] filtered angle of attack (alpha_f)
-    Lag     *_g_com_lag;                ///<
-    Lag     *_omg_q_lag;                ///< filtered pitch rate (q_f)
-    LeadLag *_omg_q_fil;                ///< pitch rate filtered
-    Lag     *_g_z_input;                ///< filtered normal acceleration (Az_f)
-    Lag     *_sca_bias_1;               ///<
-    Lag     *_sca_bias_2;               ///<
-    Lag     *_sca_bias_3;               ///<
-    LeadLag *_u_sca_fil;                ///<
-    Filter2 *_u_sca_fil2;               ///<
-    Lag     *_actuator_l;               ///<
-    Lag     *_actuator_r;               ///<
+    unsigned int _stick_lon;            ///< longitudinal stick input lagged
+    unsigned int _alpha_lag;            ///< [deg] filtered angle of attack (alpha_f)
+    unsigned int _g_com_lag;            ///<
+    unsigned int _omg_q_lag;            ///< filtered pitch rate (q_f)
+    unsigned int _omg_q_fil;            ///< pitch rate filtered
+    unsigned int _g_z_input;            ///< filtered normal acceleration (Az_f)
+    unsigned int _sca_bias_1;           ///<
+    unsigned int _sca_bias_2;           ///<
+    unsigned int _sca_bias_3;           ///<
+    unsigned int _u_sca_fil;            ///<
+    unsigned int _u_sca_fil2;           ///<
+    unsigned int _actuator_l;           ///<
+    unsigned int _actuator_r;           ///<
 
     double _pitch_int;                  ///< [deg] pitch integral
     double _delta_htl;                  ///<
@@ -173,13 +174,13 @@ private:
 
     // yaw channel
 
-    Lag     *_pedals;                   ///<
-    Lag     *_omg_r_lag;                ///< yaw rate filtered (r_f)
-    Filter2 *_omg_p_yaw;                ///<
-    LeadLag *_u_sum_ll1;                ///<
-    LeadLag *_u_sum_ll2;                ///<
-    Filter2 *_delta_r_fil;              ///<
-    Lag     *_delta_r_lag;              ///<
+    unsigned int _pedals;               ///<
+    unsigned int _omg_r_lag;            ///< yaw rate filtered (r_f)
+    unsigned int _omg_p_yaw;            ///<
+    unsigned int _u_sum_ll1;            ///<
+    unsigned int _u_sum_ll2;            ///<
+    unsigned int _delta_r_fil;          ///<
+    unsigned int _delta_r_lag;          ///<
 
     double _delta_r;                    ///< [deg] rudder deflection
 
@@ -187,20 +188,22 @@ private:
 
     double _gun_compensation;           ///<
 
-    void updateLEF( double angleOfAttack, double q_p );
+    void updateInputs( double angleOfAttack, double g_z,
+                       double rollRate, double pitchRate, double yawRate,
+                       double ctrlLat, double ctrlLon, double ctrlYaw,
+                       bool touchdown );
+
+    void updateLEF( double q_p );
 
     void updateTEF( double q_p, bool alt_flaps_ext, bool lg_handle_dn );
 
-    void updateLat( double ctrlLat, double trimLat,
-                    double rollRate );
+    void updateLat( double trimLat );
 
-    void updateLon( double ctrlLon, double trimLon,
-                    double pitchRate,
-                    double angleOfAttack, double q_p, double dynPress, double g_z,
+    void updateLon( double trimLon,
+                    double q_p, double dynPress,
                     bool touchdown );
 
-    void updateYaw( double ctrlYaw, double trimYaw,
-                    double yawRate,
+    void updateYaw( double trimYaw,
                     double q_p, double g_y );
 
     double getGainF2( double q_p );
@@ -166,7 +166,7 @@ void F35A_Controls::update()
     Controls::update();
     ///////////////////
 
-    _flcs->update( _aircraft->getTimeStep(),
+    _flcs->update( getTimeStep(),
                    _channelRoll  ->output , 0.0,
                    _channelPitch ->output , 0.0,
                    _channelYaw   ->output , 0.0,
@@ -68,6 +68,14 @@ F35A_FLCS::F35A_FLCS() :
     _pid_pitch_1 .setAntiWindup( PID::Calculation );
     _pid_pitch_2 .setAntiWindup( PID::Calculation );
     _pid_yaw     .setAntiWindup( PID::Calculation );
+
+    _lag_ctrl_roll  = _inputs.addLag( 1.0 );
+    _lag_ctrl_pitch = _inputs.addLag( 1.0 );
+    _lag_ctrl_yaw   = _inputs.addLag( 1.0 );
+
+    _lag_rate_roll  = _inputs.addLag( 1.0 );
+    _lag_rate_pitch = _inputs.addLag( 1.0 );
+    _lag_rate_yaw   = _inputs.addLag( 1.0 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,8 +110,8 @@ void F35A_FLCS::readData( XmlNode &dataNode )
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeRoll, &ctrl_tc, "ctrl_tc" );
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeRoll, &rate_tc, "rate_tc" );
 
-            _lag_ctrl_roll.setTimeConst( ctrl_tc );
-            _lag_rate_roll.setTimeConst( rate_tc );
+            _inputs.setTimeConst( _lag_ctrl_roll, ctrl_tc );
+            _inputs.setTimeConst( _lag_rate_roll, rate_tc );
 
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeRoll, &_ctrl_input_roll, "ctrl_input" );
 
@@ -126,8 +134,8 @@ void F35A_FLCS::readData( XmlNode &dataNode )
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodePitch, &ctrl_tc, "ctrl_tc" );
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodePitch, &rate_tc, "rate_tc" );
 
-            _lag_ctrl_pitch.setTimeConst( ctrl_tc );
-            _lag_rate_pitch.setTimeConst( rate_tc );
+            _inputs.setTimeConst( _lag_ctrl_pitch, ctrl_tc );
+            _inputs.setTimeConst( _lag_rate_pitch, rate_tc );
 
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodePitch, &_ctrl_input_pitch, "ctrl_input" );
 
@@ -157,8 +165,8 @@ void F35A_FLCS::readData( XmlNode &dataNode )
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeYaw, &ctrl_tc, "ctrl_tc" );
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeYaw, &rate_tc, "rate_tc" );
 
-            _lag_ctrl_yaw.setTimeConst( ctrl_tc );
-            _lag_rate_yaw.setTimeConst( rate_tc );
+            _inputs.setTimeConst( _lag_ctrl_yaw, ctrl_tc );
+            _inputs.setTimeConst( _lag_rate_yaw, rate_tc );
 
             if ( result == FDM_SUCCESS ) result = XmlUtils::read( nodeYaw, &_yaw_rate_gain, "yaw_rate_gain" );
 
@@ -201,9 +209,19 @@ void F35A_FLCS::update( double timeStep,
     {
         _timeStep = timeStep;
 
-        updateCtrlRoll  ( timeStep, ctrlLat, trimLat, omg_bas );
-        updateCtrlPitch ( timeStep, ctrlLon, trimLon, omg_bas, gforce_bas, grav_bas, statPress, dynPress, angleOfAttack );
-        updateCtrlYaw   ( timeStep, ctrlYaw, trimYaw, omg_bas );
+        _inputs.setInput( _lag_ctrl_roll  , ctrlLat );
+        _inputs.setInput( _lag_ctrl_pitch , ctrlLon );
+        _inputs.setInput( _lag_ctrl_yaw   , ctrlYaw );
+
+        _inputs.setInput( _lag_rate_roll  , omg_bas.p() );
+        _inputs.setInput( _lag_rate_pitch , omg_bas.q() );
+        _inputs.setInput( _lag_rate_yaw   , omg_bas.r() );
+
+        _inputs.update( timeStep );
+
+        updateCtrlRoll  ( timeStep, trimLat );
+        updateCtrlPitch ( timeStep, trimLon, gforce_bas, grav_bas, statPress, dynPress, angleOfAttack );
+        updateCtrlYaw   ( timeStep, trimYaw );
 
         updateFlapsLE( timeStep, angleOfAttack );
         updateFlapsTE( timeStep, lg_handle_dn  );
@@ -212,15 +230,10 @@ void F35A_FLCS::update( double timeStep,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F35A_FLCS::updateCtrlRoll( double timeStep,
-                                double ctrlLat, double trimLat,
-                                const Vector3 &omg_bas )
+void F35A_FLCS::updateCtrlRoll( double timeStep, double trimLat )
 {
-    _lag_ctrl_roll.update( timeStep, ctrlLat );
-    _lag_rate_roll.update( timeStep, omg_bas.p() );
-
-    double ctrl_filtered = _lag_ctrl_roll.getValue();
-    double rate_filtered = _lag_rate_roll.getValue();
+    double ctrl_filtered = _inputs.getValue( _lag_ctrl_roll );
+    double rate_filtered = _inputs.getValue( _lag_rate_roll );
 
     double command = _ctrl_input_roll.getValue( ctrl_filtered );
 
@@ -236,9 +249,7 @@ void F35A_FLCS::updateCtrlRoll( double timeStep,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F35A_FLCS::updateCtrlPitch( double timeStep,
-                                 double ctrlLon, double trimLon,
-                                 const Vector3 &omg_bas,
+void F35A_FLCS::updateCtrlPitch( double timeStep, double trimLon,
                                  const Vector3 &gforce_bas,
                                  const Vector3 &grav_bas,
                                  double statPress, double dynPress,
@@ -246,11 +257,8 @@ void F35A_FLCS::updateCtrlPitch( double timeStep,
 {
     // NASA-TP-1689, p.49
 
-    _lag_ctrl_pitch.update( timeStep, ctrlLon );
-    _lag_rate_pitch.update( timeStep, omg_bas.q() );
-
-    double ctrl_filtered = _lag_ctrl_pitch.getValue();
-    double rate_filtered = _lag_rate_pitch.getValue();
+    double ctrl_filtered = _inputs.getValue( _lag_ctrl_pitch );
+    double rate_filtered = _inputs.getValue( _lag_rate_pitch );
 
     double command = _ctrl_input_pitch.getValue( ctrl_filtered );
 
@@ -274,15 +282,10 @@ void F35A_FLCS::updateCtrlPitch( double timeStep,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F35A_FLCS::updateCtrlYaw( double timeStep,
-                               double ctrlYaw, double trimYaw,
-                               const Vector3 &omg_bas )
+void F35A_FLCS::updateCtrlYaw( double timeStep, double trimYaw )
 {
-    _lag_ctrl_yaw.update( timeStep, ctrlYaw );
-    _lag_rate_yaw.update( timeStep, omg_bas.r() );
-
-    double ctrl_filtered = _lag_ctrl_yaw.getValue();
-    double rate_filtered = _lag_rate_yaw.getValue();
+    double ctrl_filtered = _inputs.getValue( _lag_ctrl_yaw );
+    double rate_filtered = _inputs.getValue( _lag_rate_yaw );
 
     double error = -_yaw_rate_gain * rate_filtered;
 
@@ -24,7 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <fdm/ctrl/fdm_Lag.h>
+#include <fdm/ctrl/fdm_FilterBank.h>
 #include <fdm/ctrl/fdm_PID.h>
 
 #include <fdm/utils/fdm_Table1.h>
@@ -85,13 +85,15 @@ private:
 
     Table1 _lef_aoa_flaps;              ///<
 
-    Lag _lag_ctrl_roll;                 ///<
-    Lag _lag_ctrl_pitch;                ///<
-    Lag _lag_ctrl_yaw;                  ///<
+    FilterBank _inputs;                 ///< input signals filters, updated at once
 
-    Lag _lag_rate_roll;                 ///<
-    Lag _lag_rate_pitch;                ///<
-    Lag _lag_rate_yaw;                  ///<
+    unsigned int _lag_ctrl_roll;        ///<
+    unsigned int _lag_ctrl_pitch;       ///<
+    unsigned int _lag_ctrl_yaw;         ///<
+
+    unsigned int _lag_rate_roll;        ///<
+    unsigned int _lag_rate_pitch;       ///<
+    unsigned int _lag_rate_yaw;         ///<
 
     PID _pid_roll;                      ///<
     PID _pid_pitch_1;                   ///<
@@ -119,21 +121,15 @@ private:
     double _norm_flaps_le;              ///< [-]
     double _norm_flaps_te;              ///< [-]
 
-    void updateCtrlRoll( double timeStep,
-                         double ctrlLat, double trimLat,
-                         const Vector3 &omg_bas );
+    void updateCtrlRoll( double timeStep, double trimLat );
 
-    void updateCtrlPitch( double timeStep,
-                          double ctrlLon, double trimLon,
-                          const Vector3 &omg_bas,
+    void updateCtrlPitch( double timeStep, double trimLon,
                           const Vector3 &gforce_bas,
                           const Vector3 &grav_bas,
                           double statPress, double dynPress,
                           double angleOfAttack );
 
-    void updateCtrlYaw( double timeStep,
-                        double ctrlYaw, double trimYaw,
-                        const Vector3 &omg_bas );
+    void updateCtrlYaw( double timeStep, double trimYaw );
 
     void updateFlapsLE( double timeStep, double angleOfAttack );
     void updateFlapsTE( double timeStep, bool lg_handle_dn );
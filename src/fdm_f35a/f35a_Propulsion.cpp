@@ -127,7 +127,7 @@ void F35A_Propulsion::update()
     bool fuel    = _inputFuel    .getDatab();
     bool starter = _inputStarter .getDatab();
 
-    _engine->integrate( _aircraft->getTimeStep() );
+    _engine->integrate( getTimeStep() );
     _engine->update( throttle, Units::k2c( _aircraft->getEnvir()->getTemperature() ),
                      _aircraft->getMachNumber(),
                      _aircraft->getEnvir()->getDensity(),
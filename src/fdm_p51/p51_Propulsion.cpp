@@ -155,7 +155,7 @@ void P51_Propulsion::update()
     bool ignition = _inputIgnition .getDatab();
     bool starter  = _inputStarter  .getDatab();
 
-    _propeller->integrate( _aircraft->getTimeStep(), _engine->getInertia() );
+    _propeller->integrate( getTimeStep(), _engine->getInertia() );
 
     _engine->update( throttle, mixture, _propeller->getEngineRPM(),
                      _aircraft->getEnvir()->getPressure(),
@@ -147,18 +147,6 @@ void PW5_LandingGear::update()
         DataRef &input = (*it).second.input;
         Wheel   &wheel = (*it).second.wheel;
 
-        Vector3 r_c_bas;
-        Vector3 n_c_bas;
-
-        getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
-
-        wheel.integrate( _aircraft->getTimeStep(),
-                         _aircraft->getVel_BAS(),
-                         _aircraft->getOmg_BAS(),
-                         r_c_bas,
-                         n_c_bas,
-                         _steering );
-
         double brake = 0.0;
         if      ( wheel.getBrakeGroup() == Wheel::Both  ) brake = 0.5 * ( _brake_l + _brake_r );
         else if ( wheel.getBrakeGroup() == Wheel::Left  ) brake = _brake_l;
@@ -169,6 +157,6 @@ void PW5_LandingGear::update()
 
     for ( WingRunners::iterator it = _runners.begin(); it != _runners.end(); ++it )
     {
-        (*it).update( _aircraft->getTimeStep(), _aircraft->getVel_BAS(), _onGround );
+        (*it).update( getTimeStep(), _aircraft->getVel_BAS(), _onGround );
     }
 }
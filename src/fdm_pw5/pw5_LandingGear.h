@@ -90,7 +90,6 @@ private:
 
     const PW5_Aircraft *_aircraft;      ///< aircraft model main object
 
-    Wheels _wheels;                     ///< wheels container
     WingRunners _runners;               ///< wing runners conatiner
 };
 
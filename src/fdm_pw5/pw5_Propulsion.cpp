@@ -82,7 +82,7 @@ void PW5_Propulsion::computeForceAndMoment()
 
 void PW5_Propulsion::update()
 {
-    _winchLauncher->update( _aircraft->getTimeStep(),
+    _winchLauncher->update( getTimeStep(),
                             _aircraft->getBAS2WGS(),
                             _aircraft->getWGS2NED(),
                             _aircraft->getPos_WGS(),
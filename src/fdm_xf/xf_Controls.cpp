@@ -151,7 +151,7 @@ void XF_Controls::update()
     Controls::update();
     ///////////////////
 
-    _flcs->update( _aircraft->getTimeStep() );
+    _flcs->update( getTimeStep() );
 
     _ailerons = _ailerons_max * _channelRoll->output;
     _elevator = _elevator_max * _channelPitch->output;
@@ -188,7 +188,7 @@ void XH_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
-    _mainRotor->update( _aircraft->getTimeStep(),
+    _mainRotor->update( getTimeStep(),
                         _aircraft->getVel_air_BAS(),
                         _aircraft->getOmg_air_BAS(),
                         _aircraft->getOmg_BAS(),
@@ -202,6 +202,8 @@ void XH_Aerodynamics::update()
                         _aircraft->getCtrl()->getCyclicLat(),
                         _aircraft->getCtrl()->getCyclicLon() );
 
+    _tailRotor->integrate( getTimeStep() );
+
     _tailRotor->update( _aircraft->getProp()->getTailRotorOmega(),
                         _aircraft->getCtrl()->getTailPitch() );
 }
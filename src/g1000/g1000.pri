@@ -4,9 +4,6 @@ HEADERS += \
     $$PWD/g1000_Input.h \
     $$PWD/g1000_Path.h
 
-SOURCES += \
-    $$PWD/g1000_Log.cpp
-
 ################################################################################
 
 HEADERS += \
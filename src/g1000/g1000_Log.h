@@ -24,30 +24,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <sstream>
+#include <fdm/fdm_Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace g1000
 {
 
-/**
- * @brief Logging class.
- */
-class Log
-{
-public:
-
-    static std::ostream &_out;  ///< log output stream
-
-    inline static std::ostream& i() { return ( timeTag() << "[INFO] "    ); }
-    inline static std::ostream& w() { return ( timeTag() << "[WARNING] " ); }
-    inline static std::ostream& e() { return ( timeTag() << "[ERROR] "   ); }
-
-    inline static std::ostream& out() { return _out; }
-
-    static std::ostream& timeTag();
-};
+typedef fdm::Log Log;
 
 } // end of g1000 namespace
 
@@ -35,14 +35,14 @@ using namespace g1000;
 ////////////////////////////////////////////////////////////////////////////////
 
 GDC::GDC( IFD *ifd ) :
-    _ifd ( ifd ),
-
-    _altitude  ( 0.0 ),
-    _climbRate ( 0.0 ),
+    _ifd ( ifd )
+{
+    _data.altitude  = 0.0;
+    _data.climbRate = 0.0;
 
-    _ias ( 0.0 ),
-    _tas ( 0.0 )
-{}
+    _data.ias = 0.0;
+    _data.tas = 0.0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -60,21 +60,21 @@ void GDC::update()
     double air_density  = _ifd->input().air_density;
     double ref_pressure = _ifd->input().ref_pressure;
 
-    double altitude_prev = _altitude;
+    double altitude_prev = _data.altitude;
 
-    _altitude = ( Const::_std_sl_t / Const::_dt_dh )
+    _data.altitude = ( Const::_std_sl_t / Const::_dt_dh )
         * ( 1.0 - pow( air_pressure / ref_pressure, Const::_dt_dh * Const::_r_spec_air / Const::_g ) );
 
-    double delta_h = _altitude - altitude_prev;
+    double delta_h = _data.altitude - altitude_prev;
 
     if ( timeStep > 0.0 && fabs( delta_h ) > 1.0e-3 )
     {
         double climbRate = ( delta_h ) / timeStep;
-        _climbRate = Misc::inertia( climbRate, _climbRate, timeStep, 0.5 );
+        _data.climbRate = Misc::inertia( climbRate, _data.climbRate, timeStep, 0.5 );
     }
 
     double q = 0.5 * air_density * Misc::pow2( airspeed_u_bas );
 
-    _ias = sqrt( 2.0 * q / Const::_std_sl_rho );
-    _tas = _ias * sqrt( Const::_std_sl_rho / air_density );
+    _data.ias = sqrt( 2.0 * q / Const::_std_sl_rho );
+    _data.tas = _data.ias * sqrt( Const::_std_sl_rho / air_density );
 }
@@ -40,6 +40,16 @@ class GDC
 {
 public:
 
+    /** Air Data Computer data. */
+    struct Data
+    {
+        double altitude;        ///< [m] barometric altitude
+        double climbRate;       ///< [m/s] climb rate
+
+        double ias;             ///< [m/s] indicated airspeed
+        double tas;             ///< [m/s] true airspeed
+    };
+
     /** Constructor. */
     GDC( IFD *ifd );
 
@@ -49,21 +59,21 @@ public:
     /** Updates Air Data Computer. */
     void update();
 
-    inline double getAltitude()  const { return _altitude;  }
-    inline double getClimbRate() const { return _climbRate; }
+    inline double getAltitude()  const { return _data.altitude;  }
+    inline double getClimbRate() const { return _data.climbRate; }
+
+    inline double getIAS() const { return _data.ias; }
+    inline double getTAS() const { return _data.tas; }
 
-    inline double getIAS() const { return _ias; }
-    inline double getTAS() const { return _tas; }
+    inline const Data& getData() const { return _data; }
+
+    inline void setData( const Data &data ) { _data = data; }
 
 private:
 
     const IFD *_ifd;        ///< IFD object
 
-    double _altitude;       ///< [m] barometric altitude
-    double _climbRate;      ///< [m/s] climb rate
-
-    double _ias;            ///< [m/s] indicated airspeed
-    double _tas;            ///< [m/s] true airspeed
+    Data _data;             ///< Air Data Computer data
 };
 
 } // end of g1000 namespace
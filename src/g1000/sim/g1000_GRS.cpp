@@ -32,14 +32,14 @@ using namespace g1000;
 ////////////////////////////////////////////////////////////////////////////////
 
 GRS::GRS( IFD *ifd ) :
-    _ifd ( ifd ),
-
-    _roll    ( 0.0 ),
-    _pitch   ( 0.0 ),
-    _heading ( 0.0 ),
+    _ifd ( ifd )
+{
+    _data.roll    = 0.0;
+    _data.pitch   = 0.0;
+    _data.heading = 0.0;
 
-    _slipSkid ( 0.0 )
-{}
+    _data.slipSkid = 0.0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -56,9 +56,9 @@ void GRS::update()
     double g_force_y = 0.0;
     double g_force_z = 0.0;
 
-    _roll    = roll;
-    _pitch   = pitch;
-    _heading = heading;
+    _data.roll    = roll;
+    _data.pitch   = pitch;
+    _data.heading = heading;
 
-    _slipSkid = atan2( -g_force_y, g_force_z );
+    _data.slipSkid = atan2( -g_force_y, g_force_z );
 }
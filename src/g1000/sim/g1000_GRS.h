@@ -40,6 +40,16 @@ class GRS
 {
 public:
 
+    /** AHRS data. */
+    struct Data
+    {
+        double roll;            ///< [rad]
+        double pitch;           ///< [rad]
+        double heading;         ///< [rad]
+
+        double slipSkid;        ///< [rad]
+    };
+
     /** Constructor. */
     GRS( IFD *ifd );
 
@@ -49,21 +59,21 @@ public:
     /** Updates AHRS. */
     void update();
 
-    inline double getRoll()    const { return _roll;    }
-    inline double getPitch()   const { return _pitch;   }
-    inline double getHeading() const { return _heading; }
+    inline double getRoll()    const { return _data.roll;    }
+    inline double getPitch()   const { return _data.pitch;   }
+    inline double getHeading() const { return _data.heading; }
+
+    inline double getSlipSkid() const { return _data.slipSkid; }
 
-    inline double getSlipSkid() const { return _slipSkid; }
+    inline const Data& getData() const { return _data; }
+
+    inline void setData( const Data &data ) { _data = data; }
 
 private:
 
     const IFD *_ifd;        ///< IFD object
 
-    double _roll;           ///< [rad]
-    double _pitch;          ///< [rad]
-    double _heading;        ///< [rad]
-
-    double _slipSkid;       ///< [rad]
+    Data _data;             ///< AHRS data
 };
 
 } // end of g1000 namespace
@@ -85,3 +85,27 @@ void IFD::update( double timeStep, const Input &input )
     _gmu->update();
     _gtx->update();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IFD::getState( State *state ) const
+{
+    state->timeStep = _timeStep;
+
+    memcpy( &state->input, &_input, sizeof(Input) );
+
+    state->gdc = _gdc->getData();
+    state->grs = _grs->getData();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IFD::setState( const State &state )
+{
+    _timeStep = state.timeStep;
+
+    memcpy( &_input, &state.input, sizeof(Input) );
+
+    _gdc->setData( state.gdc );
+    _grs->setData( state.grs );
+}
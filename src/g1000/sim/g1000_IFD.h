@@ -45,6 +45,20 @@ class IFD
 {
 public:
 
+    /**
+     * Integrated Flight Deck state. Sensors are simulated in one thread,
+     * their state is passed to the IFD instance used by displays.
+     */
+    struct State
+    {
+        double timeStep;        ///< [s] time step
+
+        Input input;            ///< input data
+
+        GDC::Data gdc;          ///< Air Data Computer data
+        GRS::Data grs;          ///< AHRS data
+    };
+
     /** Constructor. */
     IFD();
 
@@ -54,6 +68,18 @@ public:
     /** Updates Integrated Flight Deck simulation. */
     void update( double timeStep, const Input &input );
 
+    /**
+     * Gets state.
+     * @param state output state
+     */
+    void getState( State *state ) const;
+
+    /**
+     * Sets state instead of updating simulation.
+     * @param state state
+     */
+    void setState( const State &state );
+
     inline const Input& input() const { return _input; }
 
     inline double timeStep() const { return _timeStep; }
@@ -42,7 +42,9 @@ DockWidgetAuto::DockWidgetAuto( QWidget *parent ) :
     QDockWidget ( parent ),
     _ui ( new Ui::DockWidgetAuto ),
     _ap ( NULLPTR ),
-    _timerId ( 0 )
+    _timerId ( 0 ),
+
+    _idle ( false )
 {
     _ui->setupUi( this );
 
@@ -100,7 +102,9 @@ void DockWidgetAuto::timerEvent( QTimerEvent *event )
     QDockWidget::timerEvent( event );
     /////////////////////////////////
 
-    if ( Data::get()->stateOut == fdm::DataOut::Idle )
+    bool idle = ( Data::get()->stateOut == fdm::DataOut::Idle );
+
+    if ( idle )
     {
         updateIdle();
     }
@@ -108,6 +112,8 @@ void DockWidgetAuto::timerEvent( QTimerEvent *event )
     {
         updateWork();
     }
+
+    _idle = idle;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -180,8 +186,12 @@ void DockWidgetAuto::updateIdle()
     _ui->labelVS->setEnabled( false );
     _ui->labelARM->setEnabled( false );
 
-    _ap->setAltitude( fdm::Units::ft2m( 100.0 ) );
-    _ap->setClimbRate( 0.0 );
+    // selections are queued once, on entering idle state
+    if ( !_idle )
+    {
+        _ap->setAltitude( fdm::Units::ft2m( 100.0 ) );
+        _ap->setClimbRate( 0.0 );
+    }
 
     _ui->spinBoxCRS->setValue( 0.0 );
     _ui->spinBoxHDG->setValue( 0.0 );
@@ -194,7 +204,7 @@ void DockWidgetAuto::updateIdle()
 
 void DockWidgetAuto::updateWork()
 {
-    _ap->update( GUI_TIME_STEP, _ui->pushButtonDN->isDown(), _ui->pushButtonUP->isDown() );
+    _ap->setButtons( _ui->pushButtonDN->isDown(), _ui->pushButtonUP->isDown() );
 
     _ui->spinBoxALT_VS->setReadOnly( _ap->isInited() );
 
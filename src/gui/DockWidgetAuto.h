@@ -83,6 +83,8 @@ private:
 
     int _timerId;               ///< timer ID
 
+    bool _idle;                 ///< specifies if simulation was idle at the previous timer event
+
     double normalizeHeading( double heading );
 
     void settingsRead();
@@ -288,6 +288,11 @@ void WidgetMap::timerEvent( QTimerEvent *event )
 
     update();
 
+    cgi::Manager::instance()->setMapView( _manipulator->getMapLeft(),
+                                          _manipulator->getMapRight(),
+                                          _manipulator->getMapBottom(),
+                                          _manipulator->getMapTop() );
+
     cgi::Manager::instance()->updateMap();
 
     updateMouseGeoPositionStr( _manipulator->getMouseLat(),
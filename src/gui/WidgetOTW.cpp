@@ -35,6 +35,19 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/** Records latency trace of the OTW data when drawing of the frame is finished. */
+class FrameEndCallback : public osg::Camera::DrawCallback
+{
+public:
+
+    void operator() ( osg::RenderInfo & ) const
+    {
+        cgi::Manager::instance()->recordFrame();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 const double WidgetOTW::_zNear = 0.55;
 const double WidgetOTW::_zFar  = CGI_SKYDOME_RADIUS + 0.1f * CGI_SKYDOME_RADIUS;
 
@@ -310,5 +323,8 @@ void WidgetOTW::createCameraHUD()
     cameraHUD->addChild( cgi::Manager::instance()->getNodeHUD() );
     cameraHUD->setViewport( new osg::Viewport( 0, 0, traits->width, traits->height ) );
 
+    // HUD is drawn after OTW, so the frame is finished after drawing HUD
+    cameraHUD->setFinalDrawCallback( new FrameEndCallback() );
+
     getOsgViewer()->addSlave( cameraHUD, false );
 }
@@ -1,10 +1,13 @@
 HEADERS += \
     $$PWD/hid_Assignment.h \
     $$PWD/hid_AxisTune.h \
+    $$PWD/hid_Defines.h \
+    $$PWD/hid_InputReader.h \
     $$PWD/hid_Joysticks.h \
     $$PWD/hid_Manager.h
 
 SOURCES += \
     $$PWD/hid_AxisTune.cpp \
+    $$PWD/hid_InputReader.cpp \
     $$PWD/hid_Joysticks.cpp \
     $$PWD/hid_Manager.cpp
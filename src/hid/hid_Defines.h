@@ -19,84 +19,37 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  ******************************************************************************/
+#ifndef HID_DEFINES_H
+#define HID_DEFINES_H
 
-#include <g1000/g1000_Log.h>
-
-#include <ctime>
-#include <iomanip>
-#include <iostream>
-#include <cmath>
-
-#ifdef _LINUX_
-#   include <sys/time.h>
-#endif
+////////////////////////////////////////////////////////////////////////////////
 
 #ifdef WIN32
-#   include <Windows.h>
+#   define HID_WINMM_JOYSTICK
+#else
+#   ifdef _LINUX_
+#       define HID_LINUX_JOYSTICK
+#   endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
-using namespace g1000;
-
-////////////////////////////////////////////////////////////////////////////////
+#ifdef HID_LINUX_JOYSTICK
+#   define HID_MAX_JOYS 32
+#   define HID_MAX_POVS 4
+#   define HID_MAX_AXES 24
+#   define HID_MAX_BUTT 32
+#   define HID_MAX_EVDEV 64
+#endif
 
-std::ostream& Log::_out = std::cerr;
+#ifdef HID_WINMM_JOYSTICK
+#   define HID_MAX_JOYS 2
+#   define HID_MAX_POVS 1
+#   define HID_MAX_AXES 6
+#   define HID_MAX_BUTT 32
+#   define HID_AXIS_RANGE 65535.0f
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::ostream& Log::timeTag()
-{
-    int year = 2000;
-    int mon  = 1;
-    int day  = 1;
-    int hour = 0;
-    int min  = 0;
-    int sec  = 0;
-    int msec = 0;
-
-#   ifdef _LINUX_
-    struct timeval tp;
-    gettimeofday( &tp, NULL );
-    std::tm *tm = std::localtime( &tp.tv_sec );
-
-    year = 1900 + tm->tm_year;
-    mon  = tm->tm_mon + 1;
-    day  = tm->tm_mday;
-    hour = tm->tm_hour;
-    min  = tm->tm_min;
-    sec  = tm->tm_sec;
-    msec = floor( tp.tv_usec * 0.001 );
-#   endif
-
-#   ifdef WIN32
-    SYSTEMTIME st;
-    GetLocalTime( &st );
-
-    year = st.wYear;
-    mon  = st.wMonth;
-    day  = st.wDay;
-    hour = st.wHour;
-    min  = st.wMinute;
-    sec  = st.wSecond;
-    msec = st.wMilliseconds;
-#   endif
-
-    _out << "[";
-    _out << year;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << mon;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << day;
-    _out << " ";
-    _out << std::setfill('0') << std::setw( 2 ) << hour;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << min;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << sec;
-    _out << ".";
-    _out << std::setfill('0') << std::setw( 3 ) << msec;
-    _out << "]";
-
-    return _out;
-}
+#endif // HID_DEFINES_H
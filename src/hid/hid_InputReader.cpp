@@ -0,0 +1,422 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <hid/hid_InputReader.h>
+
+#ifdef HID_LINUX_JOYSTICK
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+
+#include <unistd.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace hid;
+
+////////////////////////////////////////////////////////////////////////////////
+
+long long InputReader::now()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return 1000000000LL * ts.tv_sec + ts.tv_nsec;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::initMapping( Mapping *mapping )
+{
+    for ( int i = 0; i < ABS_CNT; i++ )
+    {
+        mapping->axis   [ i ] = -1;
+        mapping->center [ i ] = 0.0f;
+        mapping->range  [ i ] = 1.0f;
+    }
+
+    for ( int i = 0; i < KEY_CNT; i++ )
+    {
+        mapping->butt[ i ] = -1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::readState( int fd, const Mapping &mapping, State *state )
+{
+    for ( int code = 0; code < ABS_CNT; code++ )
+    {
+        input_absinfo absinfo;
+
+        if ( mapping.axis[ code ] >= 0 && ioctl( fd, EVIOCGABS( code ), &absinfo ) >= 0 )
+        {
+            state->axis[ mapping.axis[ code ] ] = ( absinfo.value - mapping.center[ code ] )
+                                                / mapping.range[ code ];
+        }
+    }
+
+    unsigned char keys[ KEY_CNT / 8 + 1 ];
+
+    if ( ioctl( fd, EVIOCGKEY( sizeof(keys) ), keys ) >= 0 )
+    {
+        for ( int code = 0; code < KEY_CNT; code++ )
+        {
+            if ( mapping.butt[ code ] >= 0 )
+            {
+                state->butt[ mapping.butt[ code ] ] = ( keys[ code / 8 ] & ( 1 << ( code % 8 ) ) ) != 0;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+InputReader::InputReader() :
+    _epoll ( -1 ),
+    _wake  ( -1 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+InputReader::~InputReader()
+{
+    stop();
+
+    for ( unsigned int i = 0; i < _devices.size(); i++ )
+    {
+        close( _devices[ i ]->fd );
+        FDM_DELPTR( _devices[ i ] );
+    }
+
+    _devices.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int InputReader::addDevice( int fd, const Mapping &mapping )
+{
+    if ( _thread.joinable() || _devices.size() >= HID_MAX_JOYS ) return -1;
+
+    Device *device = new Device();
+
+    device->fd      = fd;
+    device->mapping = mapping;
+    device->size    = 0;
+    device->dropped = false;
+
+    memset( &device->state, 0, sizeof(State) );
+    device->state.active = true;
+
+    readState( fd, mapping, &device->state );
+    device->published.write( device->state );
+
+    _devices.push_back( device );
+
+    return (int)_devices.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool InputReader::start()
+{
+    if ( _thread.joinable() ) return true;
+
+    _epoll = epoll_create1( EPOLL_CLOEXEC );
+    _wake  = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    if ( _epoll < 0 || _wake < 0 )
+    {
+        Log::e() << "Cannot create input reader epoll instance." << std::endl;
+        stop();
+        return false;
+    }
+
+    epoll_event event;
+
+    // index equal to the devices count stands for the wake up descriptor
+    event.events   = EPOLLIN;
+    event.data.u32 = (unsigned int)_devices.size();
+    epoll_ctl( _epoll, EPOLL_CTL_ADD, _wake, &event );
+
+    for ( unsigned int i = 0; i < _devices.size(); i++ )
+    {
+        event.events   = EPOLLIN;
+        event.data.u32 = i;
+
+        if ( epoll_ctl( _epoll, EPOLL_CTL_ADD, _devices[ i ]->fd, &event ) < 0 )
+        {
+            Log::w() << "Cannot watch input device " << i << "." << std::endl;
+        }
+    }
+
+    _thread = std::thread( &InputReader::run, this );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::stop()
+{
+    if ( _thread.joinable() )
+    {
+        unsigned long long value = 1;
+
+        if ( write( _wake, &value, sizeof(value) ) < 0 )
+        {
+            Log::e() << "Cannot stop input reader thread." << std::endl;
+        }
+
+        _thread.join();
+    }
+
+    if ( _epoll >= 0 ) close( _epoll );
+    if ( _wake  >= 0 ) close( _wake  );
+
+    _epoll = -1;
+    _wake  = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool InputReader::getState( int index, State *state ) const
+{
+    if ( index >= 0 && index < (int)_devices.size() )
+    {
+        _devices[ index ]->published.read( state );
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int InputReader::getEvents( int index, Event events[], unsigned int max )
+{
+    unsigned int count = 0;
+
+    if ( index >= 0 && index < (int)_devices.size() )
+    {
+        History &history = _devices[ index ]->history;
+
+        const Event *event = history.front();
+
+        while ( event && count < max )
+        {
+            events[ count ] = (*event);
+            count++;
+
+            history.pop();
+            event = history.front();
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::clearEvents( int index )
+{
+    if ( index >= 0 && index < (int)_devices.size() )
+    {
+        History &history = _devices[ index ]->history;
+
+        while ( !history.isEmpty() )
+        {
+            history.pop();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::run()
+{
+    epoll_event events[ 8 ];
+
+    while ( true )
+    {
+        int n = epoll_wait( _epoll, events, 8, -1 );
+
+        if ( n < 0 )
+        {
+            if ( errno == EINTR ) continue;
+
+            Log::e() << "Input reader epoll wait failed." << std::endl;
+            return;
+        }
+
+        for ( int i = 0; i < n; i++ )
+        {
+            unsigned int index = events[ i ].data.u32;
+
+            if ( index >= _devices.size() ) return;
+
+            if ( !read( _devices[ index ] ) )
+            {
+                // disconnected device is no longer watched, its last state is kept
+                epoll_ctl( _epoll, EPOLL_CTL_DEL, _devices[ index ]->fd, FDM_NULLPTR );
+
+                _devices[ index ]->state.active = false;
+                _devices[ index ]->published.write( _devices[ index ]->state );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool InputReader::read( Device *device )
+{
+    char *buffer = reinterpret_cast< char* >( device->buffer );
+
+    while ( true )
+    {
+        ssize_t result = ::read( device->fd, buffer + device->size,
+                                 sizeof(device->buffer) - device->size );
+
+        if ( result > 0 )
+        {
+            device->size += (unsigned int)result;
+
+            unsigned int count = device->size / sizeof(input_event);
+
+            for ( unsigned int i = 0; i < count; i++ )
+            {
+                process( device, device->buffer[ i ] );
+            }
+
+            // incomplete event is kept for the next read
+            device->size -= count * sizeof(input_event);
+            memmove( buffer, buffer + count * sizeof(input_event), device->size );
+        }
+        else if ( result < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) )
+        {
+            return true;
+        }
+        else if ( result < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        else
+        {
+            if ( result < 0 && errno != ENODEV )
+            {
+                Log::e() << "Cannot read input device: " << strerror( errno ) << std::endl;
+            }
+
+            // end of file (e.g. closed pipe), device unplugged (ENODEV) or read error
+            return false;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReader::process( Device *device, const input_event &event )
+{
+    long long time = 1000000000LL * event.input_event_sec + 1000LL * event.input_event_usec;
+
+    if ( time == 0 ) time = now();
+
+    if ( event.type == EV_SYN )
+    {
+        if ( event.code == SYN_REPORT )
+        {
+            if ( device->dropped )
+            {
+                // events since SYN_DROPPED are incomplete, querying device state instead
+                readState( device->fd, device->mapping, &device->state );
+                device->dropped = false;
+            }
+
+            device->state.time = time;
+            device->published.write( device->state );
+        }
+        else if ( event.code == SYN_DROPPED )
+        {
+            device->dropped = true;
+        }
+
+        return;
+    }
+
+    if ( device->dropped ) return;
+
+    Event *history = FDM_NULLPTR;
+
+    if ( event.type == EV_ABS && event.code < ABS_CNT && device->mapping.axis[ event.code ] >= 0 )
+    {
+        short index = device->mapping.axis[ event.code ];
+
+        device->state.axis[ index ] = ( event.value - device->mapping.center[ event.code ] )
+                                    / device->mapping.range[ event.code ];
+        device->state.events++;
+
+        history = device->history.reserve();
+
+        if ( history )
+        {
+            history->type  = EV_ABS;
+            history->index = index;
+            history->value = device->state.axis[ index ];
+        }
+    }
+    else if ( event.type == EV_KEY && event.code < KEY_CNT && device->mapping.butt[ event.code ] >= 0 )
+    {
+        short index = device->mapping.butt[ event.code ];
+
+        device->state.butt[ index ] = event.value != 0;
+        device->state.events++;
+
+        history = device->history.reserve();
+
+        if ( history )
+        {
+            history->type  = EV_KEY;
+            history->index = index;
+            history->value = ( event.value != 0 ) ? 1.0f : 0.0f;
+        }
+    }
+
+    // newest events are dropped if consumer does not drain history
+    if ( history )
+    {
+        history->time = time;
+        device->history.commit();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // HID_LINUX_JOYSTICK
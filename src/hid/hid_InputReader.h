@@ -0,0 +1,230 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef HID_INPUTREADER_H
+#define HID_INPUTREADER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hid/hid_Defines.h>
+
+#ifdef HID_LINUX_JOYSTICK
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+#include <vector>
+
+#include <linux/input.h>
+
+#include <fdm/utils/fdm_RingBuffer.h>
+#include <fdm/utils/fdm_SeqLock.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace hid
+{
+
+/**
+ * @brief Event driven input devices reader.
+ *
+ * Reads Linux evdev devices on a dedicated thread waiting on epoll, so each
+ * event is processed as soon as it arrives instead of being polled at the
+ * GUI rate. Events are timestamped with the monotonic clock: device clock
+ * is switched to CLOCK_MONOTONIC and kernel event time is used.
+ *
+ * Device state is published at each SYN_REPORT through a sequence lock,
+ * so any thread (e.g. simulation thread at each step) can sample the latest
+ * consistent state without locks. Mapped events are also pushed into
+ * the device history ring buffer which has to be drained by a single
+ * consumer, otherwise the newest events are dropped once it is full.
+ *
+ * Any file descriptor delivering input_event structures can be used as
+ * a device, e.g. pipe fed with synthetic events.
+ *
+ * @see https://www.kernel.org/doc/html/latest/input/input.html
+ * @see https://www.kernel.org/doc/html/latest/input/event-codes.html
+ */
+class InputReader
+{
+public:
+
+    static const unsigned int _history_size = 64;   ///< device history size
+
+    /** Device mapping. */
+    struct Mapping
+    {
+        short axis[ ABS_CNT ];          ///< state axis index of each absolute axis code, -1 if not used
+        short butt[ KEY_CNT ];          ///< state button index of each key code, -1 if not used
+        float center[ ABS_CNT ];        ///< raw value of each absolute axis center
+        float range[ ABS_CNT ];         ///< raw value half range of each absolute axis
+    };
+
+    /** Device state. */
+    struct State
+    {
+        float axis[ HID_MAX_AXES ];     ///< -1.0 ... 1.0 normalized axis position
+        bool  butt[ HID_MAX_BUTT ];     ///< false: released, true: pressed
+
+        long long time;                 ///< [ns] monotonic time of the last event
+        unsigned int events;            ///< number of events processed so far
+
+        bool active;                    ///< specifies if device is still connected
+    };
+
+    /** Timestamped event. */
+    struct Event
+    {
+        long long time;                 ///< [ns] monotonic time
+        unsigned short type;            ///< EV_ABS for axes, EV_KEY for buttons
+        short index;                    ///< state axis or button index
+        float value;                    ///< normalized axis position or button state
+    };
+
+    typedef fdm::RingBuffer< Event, _history_size > History;
+
+    /**
+     * @brief Returns monotonic clock time.
+     * @return [ns] CLOCK_MONOTONIC time
+     */
+    static long long now();
+
+    /**
+     * @brief Creates empty mapping with no axes and buttons.
+     * @param mapping output mapping
+     */
+    static void initMapping( Mapping *mapping );
+
+    /**
+     * @brief Reads current device state using evdev ioctls.
+     * State is left unchanged for descriptors which are not evdev devices.
+     * @param fd device file descriptor
+     * @param mapping device mapping
+     * @param state output state
+     */
+    static void readState( int fd, const Mapping &mapping, State *state );
+
+    /** @brief Constructor. */
+    InputReader();
+
+    /** @brief Destructor. Stops reading thread and closes devices. */
+    virtual ~InputReader();
+
+    /**
+     * @brief Adds device. Must be called before start().
+     * Reader takes ownership of the file descriptor.
+     * @param fd non-blocking device file descriptor
+     * @param mapping device mapping
+     * @return device index, -1 on failure
+     */
+    int addDevice( int fd, const Mapping &mapping );
+
+    /**
+     * @brief Starts reading thread.
+     * @return true on success, false on failure
+     */
+    bool start();
+
+    /** @brief Stops reading thread. */
+    void stop();
+
+    /**
+     * @brief Returns the latest device state. Can be called by any thread.
+     * @param index device index
+     * @param state output state
+     * @return true on success, false if device index is wrong
+     */
+    bool getState( int index, State *state ) const;
+
+    /**
+     * @brief Returns the oldest events from device history and removes them.
+     * Must be called by single consumer thread.
+     * @param index device index
+     * @param events output events array
+     * @param max events array size
+     * @return number of events returned
+     */
+    unsigned int getEvents( int index, Event events[], unsigned int max );
+
+    /**
+     * @brief Removes all events from device history.
+     * Must be called by the same single consumer thread as getEvents().
+     * @param index device index
+     */
+    void clearEvents( int index );
+
+    inline int getCount() const { return (int)_devices.size(); }
+
+private:
+
+    /** Input device. */
+    struct Device
+    {
+        int fd;                                 ///< file descriptor
+
+        Mapping mapping;                        ///< device mapping
+
+        State state;                            ///< working state (reading thread)
+        fdm::SeqLock< State > published;        ///< published state
+
+        History history;                        ///< events history
+
+        input_event buffer[ 64 ];               ///< read buffer
+        unsigned int size;                      ///< [B] read buffer content size
+
+        bool dropped;                           ///< specifies if events were dropped (SYN_DROPPED)
+    };
+
+    std::vector< Device* > _devices;            ///< input devices
+
+    std::thread _thread;                        ///< reading thread
+
+    int _epoll;                                 ///< epoll file descriptor
+    int _wake;                                  ///< event file descriptor used to stop reading thread
+
+    /** @brief Reading thread function. */
+    void run();
+
+    /**
+     * @brief Reads all available events from the device.
+     * @param device input device
+     * @return false if device has been disconnected, true otherwise
+     */
+    bool read( Device *device );
+
+    /**
+     * @brief Processes single event.
+     * @param device input device
+     * @param event input event
+     */
+    void process( Device *device, const input_event &event );
+
+    /** Using this constructor is forbidden. */
+    InputReader( const InputReader & ) {}
+};
+
+} // end of hid namepsace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // HID_LINUX_JOYSTICK
+
+#endif // HID_INPUTREADER_H
@@ -28,6 +28,17 @@
 #include <sstream>
 #include <string>
 
+#ifdef HID_LINUX_JOYSTICK
+#   include <ctime>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/ioctl.h>
+#endif
+
+#ifdef HID_WINMM_JOYSTICK
+#   include <fdm/utils/fdm_LatencyTrace.h>
+#endif
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -125,8 +136,6 @@ Joysticks::Joysticks() :
         {
             _data[ i ].hasPOV[ i_pov ] = false;
         }
-
-        _fd[ i ] = 0;
 #       endif
 
 #       ifdef HID_WINMM_JOYSTICK
@@ -144,192 +153,18 @@ Joysticks::~Joysticks() {}
 void Joysticks::init()
 {
 #   ifdef HID_LINUX_JOYSTICK
-    for ( int i = 0; i < HID_MAX_JOYS; i++ )
+    for ( int i = 0; i < HID_MAX_EVDEV && _count < HID_MAX_JOYS; i++ )
     {
         std::stringstream ss;
 
-        ss << "/dev/input/js" << i;
-
-        int joyFD = open( ss.str().c_str(), O_NONBLOCK );
-
-        if ( joyFD > 0 )
-        {
-            _fd[ _count ] = joyFD;
-
-            char tempAxisCount = 0;
-            char tempButtCount = 0;
-            char tempName[ 512 ] = "";
-            char tempAxesMap[ HID_MAX_AXES + 2*HID_MAX_POVS ] = { 0 };
-
-            ioctl( _fd[ _count ], JSIOCGAXES     , &tempAxisCount );
-            ioctl( _fd[ _count ], JSIOCGBUTTONS  , &tempButtCount );
-            ioctl( _fd[ _count ], JSIOCGNAME(64) , tempName );
-            ioctl( _fd[ _count ], JSIOCGAXMAP    , tempAxesMap );
-
-            _data[ _count ].name = tempName;
-
-            _data[ _count ].axisCount = std::min( (int)tempAxisCount, HID_MAX_AXES );
-            _data[ _count ].buttCount = std::min( (int)tempButtCount, HID_MAX_BUTT );
-            _data[ _count ].povsCount = 0;
+        ss << "/dev/input/event" << i;
 
-            _data[ _count ].active = true;
-
-            for ( int j = 0; j < HID_MAX_AXES + 2 * HID_MAX_POVS; j++ )
-            {
-                switch ( tempAxesMap[ j ] )
-                {
-                case ABS_X:
-                    _data[ _count ].hasAxis[ AxisX ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisX;
-                    break;
-
-                case ABS_Y:
-                    _data[ _count ].hasAxis[ AxisY ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisY;
-                    break;
-
-                case ABS_Z:
-                    _data[ _count ].hasAxis[ AxisZ ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisZ;
-                    break;
-
-                case ABS_RX:
-                    _data[ _count ].hasAxis[ AxisRX ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRX;
-                    break;
-
-                case ABS_RY:
-                    _data[ _count ].hasAxis[ AxisRY ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRY;
-                    break;
-
-                case ABS_RZ:
-                    _data[ _count ].hasAxis[ AxisRZ ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRZ;
-                    break;
-
-                case ABS_THROTTLE:
-                    _data[ _count ].hasAxis[ Throttle ] = true;
-                    _data[ _count ].axesMap[ j ] = Throttle;
-                    break;
-
-                case ABS_RUDDER:
-                    _data[ _count ].hasAxis[ Rudder ] = true;
-                    _data[ _count ].axesMap[ j ] = Rudder;
-                    break;
-
-                case ABS_WHEEL:
-                    _data[ _count ].hasAxis[ Wheel ] = true;
-                    _data[ _count ].axesMap[ j ] = Wheel;
-                    break;
-
-                case ABS_GAS:
-                    _data[ _count ].hasAxis[ Gas ] = true;
-                    _data[ _count ].axesMap[ j ] = Gas;
-                    break;
-
-                case ABS_BRAKE:
-                    _data[ _count ].hasAxis[ Brake ] = true;
-                    _data[ _count ].axesMap[ j ] = Brake;
-                    break;
-
-                case ABS_HAT0X:
-                    _data[ _count ].hasAxis[ Hat0X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat0X;
-                    break;
-
-                case ABS_HAT0Y:
-                    _data[ _count ].hasAxis[ Hat0Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat0Y;
-                    break;
-
-                case ABS_HAT1X:
-                    _data[ _count ].hasAxis[ Hat1X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat1X;
-                    break;
-
-                case ABS_HAT1Y:
-                    _data[ _count ].hasAxis[ Hat1Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat1Y;
-                    break;
-
-                case ABS_HAT2X:
-                    _data[ _count ].hasAxis[ Hat2X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat2X;
-                    break;
-
-                case ABS_HAT2Y:
-                    _data[ _count ].hasAxis[ Hat2Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat2Y;
-                    break;
-
-                case ABS_HAT3X:
-                    _data[ _count ].hasAxis[ Hat3X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat3X;
-                    break;
-
-                case ABS_HAT3Y:
-                    _data[ _count ].hasAxis[ Hat3Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat3Y;
-                    break;
-
-                case ABS_PRESSURE:
-                    _data[ _count ].hasAxis[ Pressure ] = true;
-                    _data[ _count ].axesMap[ j ] = Pressure;
-                    break;
-
-                case ABS_DISTANCE:
-                    _data[ _count ].hasAxis[ Distance ] = true;
-                    _data[ _count ].axesMap[ j ] = Distance;
-                    break;
-
-                case ABS_TILT_X:
-                    _data[ _count ].hasAxis[ TiltX ] = true;
-                    _data[ _count ].axesMap[ j ] = TiltX;
-                    break;
-
-                case ABS_TILT_Y:
-                    _data[ _count ].hasAxis[ TiltY ] = true;
-                    _data[ _count ].axesMap[ j ] = TiltY;
-                    break;
-
-                case ABS_TOOL_WIDTH:
-                    _data[ _count ].hasAxis[ ToolWidth ] = true;
-                    _data[ _count ].axesMap[ j ] = ToolWidth;
-                    break;
-                }
-            }
-
-            if ( _data[ _count ].hasAxis[ Hat0X ]
-              || _data[ _count ].hasAxis[ Hat0Y ] )
-            {
-                _data[ _count ].hasPOV[ 0 ] = true;
-                _data[ _count ].povsCount++;
-            }
-
-            if ( _data[ _count ].hasAxis[ Hat1X ]
-              || _data[ _count ].hasAxis[ Hat1Y ] )
-            {
-                _data[ _count ].hasPOV[ 1 ] = true;
-                _data[ _count ].povsCount++;
-            }
-
-            if ( _data[ _count ].hasAxis[ Hat2X ]
-              || _data[ _count ].hasAxis[ Hat2Y ] )
-            {
-                _data[ _count ].hasPOV[ 2 ] = true;
-                _data[ _count ].povsCount++;
-            }
-
-            if ( _data[ _count ].hasAxis[ Hat3X ]
-              || _data[ _count ].hasAxis[ Hat3Y ] )
-            {
-                _data[ _count ].hasPOV[ 3 ] = true;
-                _data[ _count ].povsCount++;
-            }
+        openDevice( ss.str().c_str() );
+    }
 
-            _count++;
-        }
+    if ( _count > 0 )
+    {
+        _reader.start();
     }
 #   endif
 
@@ -390,91 +225,16 @@ void Joysticks::init()
 void Joysticks::update()
 {
 #   ifdef HID_LINUX_JOYSTICK
-    for( short i = 0; i < _count && i < HID_MAX_JOYS; i++ )
+    for ( short i = 0; i < _count && i < HID_MAX_JOYS; i++ )
     {
-        while( read( _fd[ i ], &_event, sizeof(js_event) ) > 0 )
-        {
-            // buttons
-            if ( _event.type == JS_EVENT_BUTTON )
-            {
-                if ( _event.number < HID_MAX_BUTT )
-                {
-                    _data[ i ].butt[ _event.number ] = ( _event.value ) ? 1 : 0;
-                }
-            }
-
-            // axes
-            if ( _event.type == JS_EVENT_AXIS )
-            {
-                float value = _event.value / (double)HID_AXIS_RANGE;
+        State state;
 
-                switch ( _data[ i ].axesMap[ _event.number ] )
-                {
-                    case AxisX:  _data[ i ].axis[ AxisX  ] = value; break;
-                    case AxisY:  _data[ i ].axis[ AxisY  ] = value; break;
-                    case AxisZ:  _data[ i ].axis[ AxisZ  ] = value; break;
-                    case AxisRX: _data[ i ].axis[ AxisRX ] = value; break;
-                    case AxisRY: _data[ i ].axis[ AxisRY ] = value; break;
-                    case AxisRZ: _data[ i ].axis[ AxisRZ ] = value; break;
-
-                    case Throttle: _data[ i ].axis[ Throttle ] = value; break;
-                    case Rudder:   _data[ i ].axis[ Rudder   ] = value; break;
-                    case Gas:      _data[ i ].axis[ Gas      ] = value; break;
-                    case Wheel:    _data[ i ].axis[ Wheel    ] = value; break;
-                    case Brake:    _data[ i ].axis[ Brake    ] = value; break;
-
-                    case Hat0X: _data[ i ].axis[ Hat0X ] = value; break;
-                    case Hat0Y: _data[ i ].axis[ Hat0Y ] = value; break;
-                    case Hat1X: _data[ i ].axis[ Hat1X ] = value; break;
-                    case Hat1Y: _data[ i ].axis[ Hat1Y ] = value; break;
-                    case Hat2X: _data[ i ].axis[ Hat2X ] = value; break;
-                    case Hat2Y: _data[ i ].axis[ Hat2Y ] = value; break;
-                    case Hat3X: _data[ i ].axis[ Hat3X ] = value; break;
-                    case Hat3Y: _data[ i ].axis[ Hat3Y ] = value; break;
-
-                    case Pressure:  _data[ i ].axis[ Pressure  ] = value; break;
-                    case Distance:  _data[ i ].axis[ Distance  ] = value; break;
-                    case TiltX:     _data[ i ].axis[ TiltX     ] = value; break;
-                    case TiltY:     _data[ i ].axis[ TiltY     ] = value; break;
-                    case ToolWidth: _data[ i ].axis[ ToolWidth ] = value; break;
-                }
+        if ( _reader.getState( i, &state ) )
+        {
+            for ( int a = 0; a < HID_MAX_AXES; a++ ) _data[ i ].axis[ a ] = state.axis[ a ];
+            for ( int b = 0; b < HID_MAX_BUTT; b++ ) _data[ i ].butt[ b ] = state.butt[ b ];
 
-                for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
-                {
-                    _data[ i ].povs[ i_pov ] = -1;
-
-                    if ( _data[ i ].hasPOV[ i_pov ] )
-                    {
-                        if ( 0 )
-                        {
-                            // multidirectional POV
-                            short angle_deg = 360 * _data[ i ].axis[ Hat0X + i_pov ];
-
-                            while ( angle_deg <   0 ) angle_deg += 360;
-                            while ( angle_deg > 360 ) angle_deg -= 360;
-
-                            _data[ i ].povs[ i_pov ] = angle_deg;
-                        }
-                        else
-                        {
-                            // default model
-                            if ( _data[ i ].axis[ Hat0X + i_pov ] != 0.0f
-                              || _data[ i ].axis[ Hat0Y + i_pov ] != 0.0f )
-                            {
-                                float angle_rad = atan2( _data[ i ].axis[ Hat0X + i_pov ],
-                                                        -_data[ i ].axis[ Hat0Y + i_pov ] );
-
-                                short angle_deg = 180 * angle_rad / M_PI;
-
-                                while ( angle_deg <   0 ) angle_deg += 360;
-                                while ( angle_deg > 360 ) angle_deg -= 360;
-
-                                _data[ i ].povs[ i_pov ] = angle_deg;
-                            }
-                        }
-                    }
-                }
-            }
+            updatePOVs( &_data[ i ] );
         }
     }
 #   endif
@@ -512,6 +272,17 @@ void Joysticks::update()
             _data[ i ].povs[ 0 ] = (short)( joyInfoEx.dwPOV / 100 );
         }
 
+        State state;
+
+        for ( int a = 0; a < HID_MAX_AXES; a++ ) state.axis[ a ] = _data[ i ].axis[ a ];
+        for ( int b = 0; b < HID_MAX_BUTT; b++ ) state.butt[ b ] = _data[ i ].butt[ b ];
+
+        state.time   = fdm::LatencyTrace::now();
+        state.events = _states[ i ].getSequence() / 2 + 1; // each write adds 2
+        state.active = true;
+
+        _states[ i ].write( state );
+
         if ( joyIdTemp == JOYSTICKID2 ) break;
         if ( joyIdTemp == JOYSTICKID1 ) joyIdTemp = JOYSTICKID2;
     }
@@ -533,3 +304,218 @@ Joysticks::Data Joysticks::getData( short joyNum ) const
 
     return _data[ joyNum ];
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Joysticks::clearEvents()
+{
+#   ifdef HID_LINUX_JOYSTICK
+    for ( short i = 0; i < _count && i < HID_MAX_JOYS; i++ )
+    {
+        _reader.clearEvents( i );
+    }
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Joysticks::getState( short joyNum, State *state ) const
+{
+    if ( joyNum < 0 || joyNum >= _count ) return false;
+
+#   ifdef HID_LINUX_JOYSTICK
+    return _reader.getState( joyNum, state );
+#   endif
+
+#   ifdef HID_WINMM_JOYSTICK
+    _states[ joyNum ].read( state );
+    return true;
+#   endif
+}
+
+#ifdef HID_LINUX_JOYSTICK
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Joysticks::getAxis( int code )
+{
+    switch ( code )
+    {
+        case ABS_X:  return AxisX;
+        case ABS_Y:  return AxisY;
+        case ABS_Z:  return AxisZ;
+        case ABS_RX: return AxisRX;
+        case ABS_RY: return AxisRY;
+        case ABS_RZ: return AxisRZ;
+
+        case ABS_THROTTLE: return Throttle;
+        case ABS_RUDDER:   return Rudder;
+        case ABS_WHEEL:    return Wheel;
+        case ABS_GAS:      return Gas;
+        case ABS_BRAKE:    return Brake;
+
+        case ABS_HAT0X: return Hat0X;
+        case ABS_HAT0Y: return Hat0Y;
+        case ABS_HAT1X: return Hat1X;
+        case ABS_HAT1Y: return Hat1Y;
+        case ABS_HAT2X: return Hat2X;
+        case ABS_HAT2Y: return Hat2Y;
+        case ABS_HAT3X: return Hat3X;
+        case ABS_HAT3Y: return Hat3Y;
+
+        case ABS_PRESSURE:   return Pressure;
+        case ABS_DISTANCE:   return Distance;
+        case ABS_TILT_X:     return TiltX;
+        case ABS_TILT_Y:     return TiltY;
+        case ABS_TOOL_WIDTH: return ToolWidth;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Joysticks::openDevice( const char *path )
+{
+    int fd = open( path, O_RDONLY | O_NONBLOCK | O_CLOEXEC );
+
+    if ( fd < 0 ) return false;
+
+    unsigned char evBits  [ EV_CNT  / 8 + 1 ] = { 0 };
+    unsigned char absBits [ ABS_CNT / 8 + 1 ] = { 0 };
+    unsigned char keyBits [ KEY_CNT / 8 + 1 ] = { 0 };
+
+    ioctl( fd, EVIOCGBIT( 0       , sizeof(evBits)  ), evBits  );
+    ioctl( fd, EVIOCGBIT( EV_ABS  , sizeof(absBits) ), absBits );
+    ioctl( fd, EVIOCGBIT( EV_KEY  , sizeof(keyBits) ), keyBits );
+
+#   define HID_TEST_BIT( bits, bit ) ( bits[ (bit) / 8 ] & ( 1 << ( (bit) % 8 ) ) )
+
+    // devices accepted by joydev driver: joystick or gamepad buttons
+    // and absolute axes, excluding touchpads and tablets
+    bool joystick = false;
+
+    if ( HID_TEST_BIT( evBits, EV_ABS ) && HID_TEST_BIT( evBits, EV_KEY )
+      && !HID_TEST_BIT( keyBits, BTN_TOUCH ) )
+    {
+        for ( int code = BTN_JOYSTICK; code < BTN_DIGI && !joystick; code++ )
+        {
+            if ( HID_TEST_BIT( keyBits, code ) ) joystick = true;
+        }
+
+        for ( int code = BTN_TRIGGER_HAPPY; code <= BTN_TRIGGER_HAPPY40 && !joystick; code++ )
+        {
+            if ( HID_TEST_BIT( keyBits, code ) ) joystick = true;
+        }
+    }
+
+    if ( !joystick )
+    {
+        close( fd );
+        return false;
+    }
+
+    // kernel events timestamps are taken from the monotonic clock
+    int clock = CLOCK_MONOTONIC;
+    ioctl( fd, EVIOCSCLOCKID, &clock );
+
+    char tempName[ 512 ] = "";
+    ioctl( fd, EVIOCGNAME( sizeof(tempName) - 1 ), tempName );
+
+    Data &data = _data[ _count ];
+
+    data.name = tempName;
+
+    data.axisCount = 0;
+    data.buttCount = 0;
+    data.povsCount = 0;
+
+    data.active = true;
+
+    InputReader::Mapping mapping;
+    InputReader::initMapping( &mapping );
+
+    for ( int code = 0; code < ABS_CNT; code++ )
+    {
+        int axis = getAxis( code );
+
+        if ( axis >= 0 && HID_TEST_BIT( absBits, code ) )
+        {
+            input_absinfo absinfo;
+
+            if ( ioctl( fd, EVIOCGABS( code ), &absinfo ) >= 0 && absinfo.maximum > absinfo.minimum )
+            {
+                mapping.axis   [ code ] = axis;
+                mapping.center [ code ] = 0.5f * ( absinfo.maximum + absinfo.minimum );
+                mapping.range  [ code ] = 0.5f * ( absinfo.maximum - absinfo.minimum );
+
+                data.hasAxis[ axis ] = true;
+                data.axisCount++;
+            }
+        }
+    }
+
+    // buttons are numbered the way joydev driver does
+    for ( int i = 0; i < KEY_CNT && data.buttCount < HID_MAX_BUTT; i++ )
+    {
+        int code = ( i + BTN_MISC ) % KEY_CNT;
+
+        if ( HID_TEST_BIT( keyBits, code ) )
+        {
+            mapping.butt[ code ] = data.buttCount;
+            data.buttCount++;
+        }
+    }
+
+#   undef HID_TEST_BIT
+
+    for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
+    {
+        if ( data.hasAxis[ Hat0X + 2*i_pov ] || data.hasAxis[ Hat0Y + 2*i_pov ] )
+        {
+            data.hasPOV[ i_pov ] = true;
+            data.povsCount++;
+        }
+    }
+
+    if ( _reader.addDevice( fd, mapping ) < 0 )
+    {
+        close( fd );
+        data.active = false;
+        return false;
+    }
+
+    _count++;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Joysticks::updatePOVs( Data *data )
+{
+    for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
+    {
+        data->povs[ i_pov ] = -1;
+
+        if ( data->hasPOV[ i_pov ] )
+        {
+            float x = data->axis[ Hat0X + 2*i_pov ];
+            float y = data->axis[ Hat0Y + 2*i_pov ];
+
+            if ( x != 0.0f || y != 0.0f )
+            {
+                float angle_rad = atan2( x, -y );
+
+                short angle_deg = 180 * angle_rad / M_PI;
+
+                while ( angle_deg <   0 ) angle_deg += 360;
+                while ( angle_deg > 360 ) angle_deg -= 360;
+
+                data->povs[ i_pov ] = angle_deg;
+            }
+        }
+    }
+}
+
+#endif // HID_LINUX_JOYSTICK
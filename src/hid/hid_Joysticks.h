@@ -24,60 +24,33 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef WIN32
-#   define HID_WINMM_JOYSTICK
-#else
-#   ifdef _LINUX_
-#       define HID_LINUX_JOYSTICK
-#   endif
-#endif
-
-////////////////////////////////////////////////////////////////////////////////
-
 #include <string>
 
+#include <hid/hid_Defines.h>
+
 #ifdef HID_LINUX_JOYSTICK
-#   include <fcntl.h>
-#   include <unistd.h>
-#   include <linux/joystick.h>
+#   include <hid/hid_InputReader.h>
 #endif
 
 #ifdef HID_WINMM_JOYSTICK
 #   include <Windows.h>
+#   include <fdm/utils/fdm_SeqLock.h>
 #endif
 
 #include <sim/Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HID_LINUX_JOYSTICK
-#   define HID_MAX_JOYS 32
-#   define HID_MAX_POVS 4
-#   define HID_MAX_AXES 24
-#   define HID_MAX_BUTT 32
-#   define HID_AXIS_RANGE 32767.0f
-#endif
-
-#ifdef HID_WINMM_JOYSTICK
-#   define HID_MAX_JOYS 2
-#   define HID_MAX_POVS 1
-#   define HID_MAX_AXES 6
-#   define HID_MAX_BUTT 32
-#   define HID_AXIS_RANGE 65535.0f
-#endif
-
-#ifndef HID_AXIS_RANGE
-#   error 'HID_AXIS_RANGE' not defined!
-#endif
-
-////////////////////////////////////////////////////////////////////////////////
-
 namespace hid
 {
 
 /**
  * @brief This class handles joystick like input devices.
  *
+ * On Linux evdev devices are read by InputReader thread. Data is refreshed
+ * by update() on the GUI thread, while getState() returns the latest state
+ * to any thread without locks (e.g. to simulation thread at each step).
+ *
  * @see https://www.kernel.org/doc/html/v4.14/input/joydev/index.html
  * @see https://docs.microsoft.com/en-us/windows/desktop/multimedia/joysticks
  */
@@ -145,8 +118,6 @@ public:
 
 #       ifdef HID_LINUX_JOYSTICK
         bool hasPOV[ HID_MAX_POVS ];    ///< specifies if joystick has a POV
-
-        Axes axesMap[ HID_MAX_AXES + 2*HID_MAX_POVS ];  ///< axes map
 #       endif
 
 #       ifdef HID_WINMM_JOYSTICK
@@ -154,6 +125,24 @@ public:
 #       endif
     };
 
+#   ifdef HID_LINUX_JOYSTICK
+    typedef InputReader::State State;
+#   endif
+
+#   ifdef HID_WINMM_JOYSTICK
+    /** Joystick state. */
+    struct State
+    {
+        float axis[ HID_MAX_AXES ];     ///< -1.0 ... 1.0 normalized axis position
+        bool  butt[ HID_MAX_BUTT ];     ///< false: released, true: pressed
+
+        long long time;                 ///< [ns] monotonic time of the last update
+        unsigned int events;            ///< number of updates so far
+
+        bool active;                    ///< specifies if device is still connected
+    };
+#   endif
+
     static const std::string _axisNames[ HID_MAX_AXES ];    ///< axes names
 
 private:
@@ -187,6 +176,21 @@ public:
      */
     Joysticks::Data getData( short joyNum ) const;
 
+    /**
+     * @brief Returns the latest joystick state. Can be called by any thread.
+     * @param joyNum joystick index
+     * @param state output state
+     * @return true on success, false if joystick index is wrong
+     */
+    bool getState( short joyNum, State *state ) const;
+
+    /**
+     * @brief Removes all events from joysticks histories.
+     * Must be called by single thread (simulation thread at each step).
+     * WinMM joysticks have no events history.
+     */
+    void clearEvents();
+
 private:
 
     short _count;                               ///< number of active joysticks
@@ -194,12 +198,35 @@ private:
     Joysticks::Data _data[ HID_MAX_JOYS ];      ///< joysticks data
 
 #   ifdef HID_LINUX_JOYSTICK
-    int _fd[ HID_MAX_JOYS ];                    ///<
-    js_event _event;                            ///< joystick event
+    InputReader _reader;                        ///< evdev devices reader
 #   endif
 
 #   ifdef HID_WINMM_JOYSTICK
     DWORD _buttons[ HID_MAX_BUTT ];             ///< buttons state
+
+    fdm::SeqLock< State > _states[ HID_MAX_JOYS ];  ///< published joysticks states
+#   endif
+
+#   ifdef HID_LINUX_JOYSTICK
+    /**
+     * @brief Returns axis corresponding to the evdev absolute axis code.
+     * @param code absolute axis code
+     * @return axis, -1 if code is not supported
+     */
+    static int getAxis( int code );
+
+    /**
+     * @brief Opens evdev device if it is a joystick.
+     * @param path device path
+     * @return true if joystick has been added, false otherwise
+     */
+    bool openDevice( const char *path );
+
+    /**
+     * @brief Updates POVs out of hat axes.
+     * @param data joystick data
+     */
+    void updatePOVs( Data *data );
 #   endif
 };
 
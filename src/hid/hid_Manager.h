@@ -122,6 +122,9 @@ public:
 
     bool isLgHandleDown() const { return _stateLandingGear; }
 
+    /** */
+    const Assignment& getAssignment( Assignment::Action action ) const { return _assignments[ action ]; }
+
     /** */
     void setAssingment( Assignment::Action action, const Assignment &assignment );
 
@@ -33,6 +33,8 @@
 
 #include <Manager.h>
 
+#include <fdm/utils/fdm_LatencyTrace.h>
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +63,9 @@ int main( int argc, char *argv[] )
     std::cerr.rdbuf( out.rdbuf() );
 #   endif
 
+    // simulation threads must not wait for the log file
+    Log::start();
+
     Log::out() << SIM_APP_NAME << " ";
     Log::out() << SIM_APP_VER  << " ";
     Log::out() << __DATE__ << " ";
@@ -75,6 +80,9 @@ int main( int argc, char *argv[] )
     app->setOrganizationDomain ( SIM_ORG_DOMAIN );
     app->setOrganizationName   ( SIM_ORG_NAME   );
 
+    // input to output latency is traced on demand
+    fdm::LatencyTrace::setEnabled( app->arguments().contains( "--latency-trace" ) );
+
     Manager *mgr = new Manager();
 
     mgr->init();
@@ -84,6 +92,13 @@ int main( int argc, char *argv[] )
     if ( mgr ) { delete mgr; } mgr = NULLPTR;
     if ( app ) { delete app; } app = NULLPTR;
 
+    if ( fdm::LatencyTrace::isEnabled() )
+    {
+        fdm::LatencyTrace::print( Log::out() );
+    }
+
+    Log::stop();
+
 #   ifndef SIM_TEST
     std::cerr.rdbuf( strbuf );
     if ( out.is_open() )
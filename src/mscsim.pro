@@ -119,6 +119,8 @@ unix: LIBS += \
     -lalut \
     -lgdal \
     -lopenal \
+    -lpthread \
+    -lrt \
     -lX11 \
     -lXss \
     -lxml2
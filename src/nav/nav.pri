@@ -1,9 +1,11 @@
 HEADERS += \
     $$PWD/nav_DataBase.h \
     $$PWD/nav_Frequency.h \
+    $$PWD/nav_Index.h \
     $$PWD/nav_Manager.h
 
 SOURCES += \
     $$PWD/nav_DataBase.cpp \
     $$PWD/nav_Frequency.cpp \
+    $$PWD/nav_Index.cpp \
     $$PWD/nav_Manager.cpp
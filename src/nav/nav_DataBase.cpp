@@ -22,11 +22,14 @@
 
 #include <nav/nav_DataBase.h>
 
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 
 #include <QDomElement>
 #include <QFile>
+#include <QFileInfo>
 
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
@@ -42,6 +45,123 @@ using namespace nav;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const char DataBase::_binary_file[] = "nav/nav_db.bin";
+
+////////////////////////////////////////////////////////////////////////////////
+
+static const char     _bin_magic[ 8 ] = { 'M', 'S', 'C', 'N', 'A', 'V', 'D', 'B' };
+static const uint32_t _bin_version    = 1;
+static const uint32_t _bin_endian     = 0x01020304;
+
+/** Binary data base header. */
+struct BinHeader
+{
+    char magic[ 8 ];            ///< file signature
+    uint32_t version;           ///< format version
+    uint32_t endian;            ///< byte order mark
+    uint32_t count_apt;         ///< number of APT records
+    uint32_t count_ils;         ///< number of ILS records
+    uint32_t count_nav;         ///< number of NAV records
+    uint32_t count_rwy;         ///< number of RWY records
+    uint32_t size_pool;         ///< [B] strings pool size
+    uint32_t reserved;          ///< padding
+};
+
+/** Binary data base APT record. */
+struct BinAPT
+{
+    uint32_t ident;             ///< ident strings pool offset
+    uint32_t name;              ///< name strings pool offset
+    uint32_t icao;              ///< ICAO code strings pool offset
+    uint32_t reserved;          ///< padding
+
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+};
+
+/** Binary data base ILS record. */
+struct BinILS
+{
+    int32_t type;               ///< type
+    int32_t freq;               ///< [kHz] frequency
+
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+    double elev;                ///< [m] elevation
+
+    double true_bearing;        ///< [rad] true bearing
+    double glide_slope;         ///< [rad] glide slope angle
+
+    double pos_wgs[ 3 ];        ///< [m] position expressed in WGS
+};
+
+/** Binary data base NAV record. */
+struct BinNAV
+{
+    int32_t type;               ///< type
+    int32_t freq;               ///< [kHz] frequency
+
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+    double elev;                ///< [m] elevation
+
+    double pos_wgs[ 3 ];        ///< [m] position expressed in WGS
+};
+
+/** Binary data base RWY record. */
+struct BinRWY
+{
+    double he_lat;              ///< [rad] latitude
+    double he_lon;              ///< [rad] longitude
+    double he_elev;             ///< [m] elevation
+
+    double le_lat;              ///< [rad] latitude
+    double le_lon;              ///< [rad] longitude
+    double le_elev;             ///< [m] elevation
+
+    double true_hdg;            ///< [rad] true heading
+
+    double length;              ///< [m] length
+    double width;               ///< [m] width
+};
+
+// records have to be 8 bytes aligned when the file is mapped
+static_assert( sizeof(BinHeader) % 8 == 0, "Wrong binary data base header size." );
+static_assert( sizeof(BinAPT)    % 8 == 0, "Wrong binary data base APT record size." );
+static_assert( sizeof(BinILS)    % 8 == 0, "Wrong binary data base ILS record size." );
+static_assert( sizeof(BinNAV)    % 8 == 0, "Wrong binary data base NAV record size." );
+static_assert( sizeof(BinRWY)    % 8 == 0, "Wrong binary data base RWY record size." );
+
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t addToPool( std::string *pool, const std::string &str )
+{
+    uint32_t offset = (uint32_t)pool->size();
+
+    pool->append( str );
+    pool->push_back( '\0' );
+
+    return offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void readFiles( std::vector< std::string > *files, const QDomElement &node )
+{
+    if ( !node.isNull() )
+    {
+        QDomElement fileNode = node.firstChildElement( "file" );
+
+        while ( !fileNode.isNull() )
+        {
+            files->push_back( fileNode.text().toStdString() );
+            fileNode = fileNode.nextSiblingElement( "file" );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 double DataBase::getTrueBearing( const char *str_bear, const char *str_magvar )
 {
     double bear = fdm::Units::deg2rad( fdm::String::toDouble( str_bear ) );
@@ -84,7 +204,51 @@ double DataBase::getTrueBearing( const char *str_bear, const char *str_magvar )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-DataBase::DataBase()
+bool DataBase::compile( const char *path )
+{
+    DataBase db( false );
+
+    return db.saveBinary( path );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataBase::DataBase( bool binary )
+{
+    Sources sources;
+
+    readSources( &sources );
+
+    bool loaded = false;
+
+    if ( binary && isBinaryUpToDate( sources ) )
+    {
+        loaded = loadBinary( Path::get( _binary_file ).c_str() );
+    }
+
+    if ( !loaded )
+    {
+        _list_apt.clear();
+        _list_ils.clear();
+        _list_nav.clear();
+        _list_rwy.clear();
+
+        for ( Files::iterator it = sources.apt.begin(); it != sources.apt.end(); ++it ) parseAPT( (*it).c_str() );
+        for ( Files::iterator it = sources.ils.begin(); it != sources.ils.end(); ++it ) parseILS( (*it).c_str() );
+        for ( Files::iterator it = sources.nav.begin(); it != sources.nav.end(); ++it ) parseNAV( (*it).c_str() );
+        for ( Files::iterator it = sources.rwy.begin(); it != sources.rwy.end(); ++it ) parseRWY( (*it).c_str() );
+    }
+
+    createIndex();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataBase::~DataBase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataBase::readSources( Sources *sources )
 {
     QFile file( Path::get( "nav/nav_db.xml" ).c_str() );
 
@@ -98,61 +262,249 @@ DataBase::DataBase()
 
         if ( rootNode.tagName() == "nav_db" )
         {
-            QDomElement nodeAPT = rootNode.firstChildElement( "apt" );
-            QDomElement nodeILS = rootNode.firstChildElement( "ils" );
-            QDomElement nodeNAV = rootNode.firstChildElement( "nav" );
-            QDomElement nodeRWY = rootNode.firstChildElement( "rwy" );
+            readFiles( &sources->apt, rootNode.firstChildElement( "apt" ) );
+            readFiles( &sources->ils, rootNode.firstChildElement( "ils" ) );
+            readFiles( &sources->nav, rootNode.firstChildElement( "nav" ) );
+            readFiles( &sources->rwy, rootNode.firstChildElement( "rwy" ) );
+        }
+    }
+}
 
-            if ( !nodeAPT.isNull() )
-            {
-                QDomElement fileNode = nodeAPT.firstChildElement( "file" );
+////////////////////////////////////////////////////////////////////////////////
 
-                while ( !fileNode.isNull() )
-                {
-                    parseAPT( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+bool DataBase::isBinaryUpToDate( const Sources &sources )
+{
+    QFileInfo binInfo( Path::get( _binary_file ).c_str() );
 
-            if ( !nodeILS.isNull() )
-            {
-                QDomElement fileNode = nodeILS.firstChildElement( "file" );
+    if ( !binInfo.exists() ) return false;
 
-                while ( !fileNode.isNull() )
-                {
-                    parseILS( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+    Files files;
 
-            if ( !nodeNAV.isNull() )
-            {
-                QDomElement fileNode = nodeNAV.firstChildElement( "file" );
+    files.push_back( "nav/nav_db.xml" );
+    files.insert( files.end(), sources.apt.begin(), sources.apt.end() );
+    files.insert( files.end(), sources.ils.begin(), sources.ils.end() );
+    files.insert( files.end(), sources.nav.begin(), sources.nav.end() );
+    files.insert( files.end(), sources.rwy.begin(), sources.rwy.end() );
 
-                while ( !fileNode.isNull() )
-                {
-                    parseNAV( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+    for ( Files::iterator it = files.begin(); it != files.end(); ++it )
+    {
+        QFileInfo txtInfo( Path::get( *it ).c_str() );
 
-            if ( !nodeRWY.isNull() )
-            {
-                QDomElement fileNode = nodeRWY.firstChildElement( "file" );
+        if ( txtInfo.lastModified() > binInfo.lastModified() ) return false;
+    }
 
-                while ( !fileNode.isNull() )
-                {
-                    parseRWY( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool DataBase::loadBinary( const char *path )
+{
+    QFile file( path );
+
+    if ( !file.open( QFile::ReadOnly ) ) return false;
+
+    const qint64 size = file.size();
+
+    if ( size < (qint64)sizeof(BinHeader) ) return false;
+
+    const uchar *data = file.map( 0, size );
+
+    if ( !data ) return false;
+
+    BinHeader header;
+    memcpy( &header, data, sizeof(BinHeader) );
+
+    const qint64 size_exp = (qint64)sizeof(BinHeader)
+            + header.count_apt * (qint64)sizeof(BinAPT)
+            + header.count_ils * (qint64)sizeof(BinILS)
+            + header.count_nav * (qint64)sizeof(BinNAV)
+            + header.count_rwy * (qint64)sizeof(BinRWY)
+            + header.size_pool;
+
+    if ( 0 != memcmp( header.magic, _bin_magic, sizeof(header.magic) )
+      || header.version != _bin_version
+      || header.endian  != _bin_endian
+      || size != size_exp )
+    {
+        file.unmap( const_cast< uchar* >( data ) );
+        return false;
+    }
+
+    const BinAPT *apt = reinterpret_cast< const BinAPT* >( data + sizeof(BinHeader) );
+    const BinILS *ils = reinterpret_cast< const BinILS* >( apt + header.count_apt );
+    const BinNAV *nav = reinterpret_cast< const BinNAV* >( ils + header.count_ils );
+    const BinRWY *rwy = reinterpret_cast< const BinRWY* >( nav + header.count_nav );
+
+    const char *pool = reinterpret_cast< const char* >( rwy + header.count_rwy );
+
+    // strings pool has to be terminated
+    if ( header.size_pool > 0 && pool[ header.size_pool - 1 ] != '\0' )
+    {
+        file.unmap( const_cast< uchar* >( data ) );
+        return false;
+    }
+
+    // records are copied rather than referenced in the mapped file, because
+    // public record types own their strings and vectors, copying costs about
+    // as much as creating the index and far less than parsing text files
+    _list_apt.resize( header.count_apt );
+    _list_ils.resize( header.count_ils );
+    _list_nav.resize( header.count_nav );
+    _list_rwy.resize( header.count_rwy );
+
+    bool valid = true;
+
+    for ( unsigned int i = 0; i < header.count_apt && valid; i++ )
+    {
+        valid = apt[ i ].ident < header.size_pool
+             && apt[ i ].name  < header.size_pool
+             && apt[ i ].icao  < header.size_pool;
+
+        if ( valid )
+        {
+            _list_apt[ i ].ident = pool + apt[ i ].ident;
+            _list_apt[ i ].name  = pool + apt[ i ].name;
+            _list_apt[ i ].icao  = pool + apt[ i ].icao;
+
+            _list_apt[ i ].lat = apt[ i ].lat;
+            _list_apt[ i ].lon = apt[ i ].lon;
         }
     }
+
+    for ( unsigned int i = 0; i < header.count_ils; i++ )
+    {
+        _list_ils[ i ].type         = (ILS::Type)ils[ i ].type;
+        _list_ils[ i ].lat          = ils[ i ].lat;
+        _list_ils[ i ].lon          = ils[ i ].lon;
+        _list_ils[ i ].elev         = ils[ i ].elev;
+        _list_ils[ i ].true_bearing = ils[ i ].true_bearing;
+        _list_ils[ i ].glide_slope  = ils[ i ].glide_slope;
+        _list_ils[ i ].freq         = ils[ i ].freq;
+        _list_ils[ i ].pos_wgs.set( ils[ i ].pos_wgs[ 0 ],
+                                    ils[ i ].pos_wgs[ 1 ],
+                                    ils[ i ].pos_wgs[ 2 ] );
+    }
+
+    for ( unsigned int i = 0; i < header.count_nav; i++ )
+    {
+        _list_nav[ i ].type = (NAV::Type)nav[ i ].type;
+        _list_nav[ i ].lat  = nav[ i ].lat;
+        _list_nav[ i ].lon  = nav[ i ].lon;
+        _list_nav[ i ].elev = nav[ i ].elev;
+        _list_nav[ i ].freq = nav[ i ].freq;
+        _list_nav[ i ].pos_wgs.set( nav[ i ].pos_wgs[ 0 ],
+                                    nav[ i ].pos_wgs[ 1 ],
+                                    nav[ i ].pos_wgs[ 2 ] );
+    }
+
+    for ( unsigned int i = 0; i < header.count_rwy; i++ )
+    {
+        _list_rwy[ i ].he_lat   = rwy[ i ].he_lat;
+        _list_rwy[ i ].he_lon   = rwy[ i ].he_lon;
+        _list_rwy[ i ].he_elev  = rwy[ i ].he_elev;
+        _list_rwy[ i ].le_lat   = rwy[ i ].le_lat;
+        _list_rwy[ i ].le_lon   = rwy[ i ].le_lon;
+        _list_rwy[ i ].le_elev  = rwy[ i ].le_elev;
+        _list_rwy[ i ].true_hdg = rwy[ i ].true_hdg;
+        _list_rwy[ i ].length   = rwy[ i ].length;
+        _list_rwy[ i ].width    = rwy[ i ].width;
+    }
+
+    file.unmap( const_cast< uchar* >( data ) );
+
+    return valid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-DataBase::~DataBase() {}
+bool DataBase::saveBinary( const char *path ) const
+{
+    std::fstream file( path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+
+    if ( !file.is_open() ) return false;
+
+    std::vector< BinAPT > apt( _list_apt.size() );
+    std::vector< BinILS > ils( _list_ils.size() );
+    std::vector< BinNAV > nav( _list_nav.size() );
+    std::vector< BinRWY > rwy( _list_rwy.size() );
+
+    std::string pool;
+
+    for ( unsigned int i = 0; i < _list_apt.size(); i++ )
+    {
+        apt[ i ].ident = addToPool( &pool, _list_apt[ i ].ident );
+        apt[ i ].name  = addToPool( &pool, _list_apt[ i ].name  );
+        apt[ i ].icao  = addToPool( &pool, _list_apt[ i ].icao  );
+        apt[ i ].reserved = 0;
+
+        apt[ i ].lat = _list_apt[ i ].lat;
+        apt[ i ].lon = _list_apt[ i ].lon;
+    }
+
+    for ( unsigned int i = 0; i < _list_ils.size(); i++ )
+    {
+        ils[ i ].type         = _list_ils[ i ].type;
+        ils[ i ].freq         = _list_ils[ i ].freq;
+        ils[ i ].lat          = _list_ils[ i ].lat;
+        ils[ i ].lon          = _list_ils[ i ].lon;
+        ils[ i ].elev         = _list_ils[ i ].elev;
+        ils[ i ].true_bearing = _list_ils[ i ].true_bearing;
+        ils[ i ].glide_slope  = _list_ils[ i ].glide_slope;
+        ils[ i ].pos_wgs[ 0 ] = _list_ils[ i ].pos_wgs.x();
+        ils[ i ].pos_wgs[ 1 ] = _list_ils[ i ].pos_wgs.y();
+        ils[ i ].pos_wgs[ 2 ] = _list_ils[ i ].pos_wgs.z();
+    }
+
+    for ( unsigned int i = 0; i < _list_nav.size(); i++ )
+    {
+        nav[ i ].type         = _list_nav[ i ].type;
+        nav[ i ].freq         = _list_nav[ i ].freq;
+        nav[ i ].lat          = _list_nav[ i ].lat;
+        nav[ i ].lon          = _list_nav[ i ].lon;
+        nav[ i ].elev         = _list_nav[ i ].elev;
+        nav[ i ].pos_wgs[ 0 ] = _list_nav[ i ].pos_wgs.x();
+        nav[ i ].pos_wgs[ 1 ] = _list_nav[ i ].pos_wgs.y();
+        nav[ i ].pos_wgs[ 2 ] = _list_nav[ i ].pos_wgs.z();
+    }
+
+    for ( unsigned int i = 0; i < _list_rwy.size(); i++ )
+    {
+        rwy[ i ].he_lat   = _list_rwy[ i ].he_lat;
+        rwy[ i ].he_lon   = _list_rwy[ i ].he_lon;
+        rwy[ i ].he_elev  = _list_rwy[ i ].he_elev;
+        rwy[ i ].le_lat   = _list_rwy[ i ].le_lat;
+        rwy[ i ].le_lon   = _list_rwy[ i ].le_lon;
+        rwy[ i ].le_elev  = _list_rwy[ i ].le_elev;
+        rwy[ i ].true_hdg = _list_rwy[ i ].true_hdg;
+        rwy[ i ].length   = _list_rwy[ i ].length;
+        rwy[ i ].width    = _list_rwy[ i ].width;
+    }
+
+    BinHeader header;
+
+    memcpy( header.magic, _bin_magic, sizeof(header.magic) );
+
+    header.version   = _bin_version;
+    header.endian    = _bin_endian;
+    header.count_apt = (uint32_t)apt.size();
+    header.count_ils = (uint32_t)ils.size();
+    header.count_nav = (uint32_t)nav.size();
+    header.count_rwy = (uint32_t)rwy.size();
+    header.size_pool = (uint32_t)pool.size();
+    header.reserved  = 0;
+
+    file.write( reinterpret_cast< const char* >( &header ), sizeof(BinHeader) );
+
+    if ( apt.size() > 0 ) file.write( reinterpret_cast< const char* >( &apt[ 0 ] ), apt.size() * sizeof(BinAPT) );
+    if ( ils.size() > 0 ) file.write( reinterpret_cast< const char* >( &ils[ 0 ] ), ils.size() * sizeof(BinILS) );
+    if ( nav.size() > 0 ) file.write( reinterpret_cast< const char* >( &nav[ 0 ] ), nav.size() * sizeof(BinNAV) );
+    if ( rwy.size() > 0 ) file.write( reinterpret_cast< const char* >( &rwy[ 0 ] ), rwy.size() * sizeof(BinRWY) );
+
+    file.write( pool.c_str(), pool.size() );
+
+    return file.good();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -385,3 +737,21 @@ void DataBase::parseRWY( const char *path )
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataBase::createIndex()
+{
+    _index_ils.clear();
+    _index_nav.clear();
+
+    for ( unsigned int i = 0; i < _list_ils.size(); i++ )
+    {
+        _index_ils.insert( i, _list_ils[ i ].freq, _list_ils[ i ].lat, _list_ils[ i ].lon );
+    }
+
+    for ( unsigned int i = 0; i < _list_nav.size(); i++ )
+    {
+        _index_nav.insert( i, _list_nav[ i ].freq, _list_nav[ i ].lat, _list_nav[ i ].lon );
+    }
+}
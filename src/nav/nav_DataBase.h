@@ -29,6 +29,8 @@
 
 #include <fdm/utils/fdm_Vector3.h>
 
+#include <nav/nav_Index.h>
+
 #include <sim/Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +40,15 @@ namespace nav
 
 /**
  * @brief Navigation data base class.
+ *
+ * Data base is read from the DAFIF text files listed in "nav/nav_db.xml".
+ * If compiled binary data base file "nav/nav_db.bin" exists and is not older
+ * than any of the text files, it is loaded instead, which requires no text
+ * parsing and no coordinates conversion.
+ *
+ * Binary data base file consists of header, fixed-size APT, ILS, NAV and RWY
+ * records arrays and zero-terminated strings pool referenced by APT records.
+ * It is created by the nav_compiler tool, see compile().
  */
 class DataBase : public Singleton< DataBase >
 {
@@ -136,8 +147,17 @@ public:
     typedef std::vector< NAV > ListNAV;
     typedef std::vector< RWY > ListRWY;
 
+    static const char _binary_file[];   ///< binary data base file path
+
     static double getTrueBearing( const char *str_bear, const char *str_magvar );
 
+    /**
+     * @brief Compiles DAFIF text files into binary data base.
+     * @param path output binary data base file path
+     * @return true on success, false on failure
+     */
+    static bool compile( const char *path );
+
     /** @brief Destructor. */
     virtual ~DataBase();
 
@@ -146,26 +166,53 @@ public:
     const ListNAV& getListNAV() const { return _list_nav; }
     const ListRWY& getListRWY() const { return _list_rwy; }
 
+    const Index& getIndexILS() const { return _index_ils; }
+    const Index& getIndexNAV() const { return _index_nav; }
+
 private:
 
+    typedef std::vector< std::string > Files;
+
+    /** Data base text files. */
+    struct Sources
+    {
+        Files apt;              ///< APT files
+        Files ils;              ///< ILS files
+        Files nav;              ///< NAV files
+        Files rwy;              ///< RWY files
+    };
+
     ListAPT _list_apt;          ///<
     ListILS _list_ils;          ///<
     ListNAV _list_nav;          ///<
     ListRWY _list_rwy;          ///<
 
+    Index _index_ils;           ///< ILS frequency and spatial index
+    Index _index_nav;           ///< NAV frequency and spatial index
+
     /**
      * You should use static function instance() due to get refernce
      * to DataBase class instance.
+     * @param binary specifies if binary data base should be used if available
      */
-    DataBase();
+    DataBase( bool binary = true );
 
     /** Using this constructor is forbidden. */
     DataBase( const DataBase & ) {}
 
+    void readSources( Sources *sources );
+
+    bool isBinaryUpToDate( const Sources &sources );
+
+    bool loadBinary( const char *path );
+    bool saveBinary( const char *path ) const;
+
     void parseAPT( const char *path );
     void parseILS( const char *path );
     void parseNAV( const char *path );
     void parseRWY( const char *path );
+
+    void createIndex();
 };
 
 } // end of nav namepsace
@@ -0,0 +1,140 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <nav/nav_Index.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace nav;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Index::Index( double cellSize ) :
+    _cellSize ( cellSize ),
+    _rows ( (int)ceil( M_PI / cellSize ) ),
+    _cols ( (int)ceil( 2.0 * M_PI / cellSize ) ),
+    _count ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Index::~Index() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Index::clear()
+{
+    _freqs.clear();
+    _count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Index::insert( unsigned int item, int freq, double lat, double lon )
+{
+    int cell = getRow( lat ) * _cols + getCol( lon );
+
+    _freqs[ freq ][ cell ].push_back( item );
+    _count++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Index::find( Items *items, int freq, double lat, double lon, double range ) const
+{
+    items->clear();
+
+    Freqs::const_iterator it_freq = _freqs.find( freq );
+
+    if ( it_freq == _freqs.end() ) return;
+
+    const Cells &cells = it_freq->second;
+
+    // angular range, distance is computed using geocentric coordinates
+    // which differ from the geodetic ones by up to about 0.2 deg
+    double ang = range / fdm::WGS84::_r1 + fdm::Units::deg2rad( 0.2 );
+
+    int row_min = getRow( lat - ang );
+    int row_max = getRow( lat + ang );
+
+    int col_min = 0;
+    int col_num = _cols;
+
+    // longitude extent of the spherical cap, unless it contains a pole
+    if ( fabs( lat ) + ang < M_PI_2 )
+    {
+        double dlon = asin( sin( ang ) / cos( lat ) );
+
+        col_min = getCol( lon - dlon );
+        col_num = getCol( lon + dlon ) - col_min;
+
+        if ( col_num < 0 ) col_num += _cols;
+
+        col_num = std::min( col_num + 1, _cols );
+    }
+
+    for ( int row = row_min; row <= row_max; row++ )
+    {
+        for ( int i = 0; i < col_num; i++ )
+        {
+            int col = ( col_min + i ) % _cols;
+
+            Cells::const_iterator it_cell = cells.find( row * _cols + col );
+
+            if ( it_cell != cells.end() )
+            {
+                items->insert( items->end(), it_cell->second.begin(), it_cell->second.end() );
+            }
+        }
+    }
+
+    // keeps data base order
+    std::sort( items->begin(), items->end() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::getRow( double lat ) const
+{
+    int row = (int)floor( ( lat + M_PI_2 ) / _cellSize );
+
+    if ( row < 0      ) row = 0;
+    if ( row >= _rows ) row = _rows - 1;
+
+    return row;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::getCol( double lon ) const
+{
+    int col = (int)floor( ( lon + M_PI ) / _cellSize ) % _cols;
+
+    if ( col < 0 ) col += _cols;
+
+    return col;
+}
@@ -0,0 +1,108 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef NAV_INDEX_H
+#define NAV_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <vector>
+
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace nav
+{
+
+/**
+ * @brief Navaids frequency and spatial index class.
+ *
+ * Items are bucketed by frequency first and then by geodetic grid cell,
+ * so a tuning query only visits stations on the tuned frequency located
+ * in the cells overlapping the reception range.
+ *
+ * Query returns candidates only, exact distance has to be checked by
+ * the caller.
+ */
+class Index
+{
+public:
+
+    typedef std::vector< unsigned int > Items;
+
+    /**
+     * @brief Constructor.
+     * @param cellSize [rad] grid cell size
+     */
+    Index( double cellSize = fdm::Units::deg2rad( 1.0 ) );
+
+    /** @brief Destructor. */
+    virtual ~Index();
+
+    /** @brief Removes all items. */
+    void clear();
+
+    /**
+     * @brief Inserts item.
+     * @param item item index
+     * @param freq [kHz] frequency
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     */
+    void insert( unsigned int item, int freq, double lat, double lon );
+
+    /**
+     * @brief Finds items on the given frequency which might be within range.
+     * @param items output candidate items sorted in ascending order
+     * @param freq [kHz] frequency
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     * @param range [m] range
+     */
+    void find( Items *items, int freq, double lat, double lon, double range ) const;
+
+    inline unsigned int getCount() const { return _count; }
+
+private:
+
+    typedef std::map< int, Items > Cells;   ///< cell -> items
+    typedef std::map< int, Cells > Freqs;   ///< frequency -> cells
+
+    Freqs _freqs;                   ///< index
+
+    double _cellSize;               ///< [rad] grid cell size
+
+    int _rows;                      ///< number of grid rows
+    int _cols;                      ///< number of grid columns
+
+    unsigned int _count;            ///< number of items
+
+    int getRow( double lat ) const;
+    int getCol( double lon ) const;
+};
+
+} // end of nav namepsace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // NAV_INDEX_H
@@ -203,17 +203,24 @@ void Manager::updateNavaidsActive()
             _ndb = NULLPTR;
     }
 
+    const DataBase::ListILS &list_ils = DataBase::instance()->getListILS();
+    const DataBase::ListNAV &list_nav = DataBase::instance()->getListNAV();
+
+    const double lat = _aircraft_wgs.getPos_Geo().lat;
+    const double lon = _aircraft_wgs.getPos_Geo().lon;
+
     if ( !_ils_loc )
     {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
+        DataBase::instance()->getIndexILS().find( &_items, _nav_freq, lat, lon, _range_ils );
+
+        for ( Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
         {
-            if ( (*it).type == DataBase::ILS::LOC
-              && (*it).freq == _nav_freq
-              && getDistance( (*it).pos_wgs ) < _range_ils )
+            const DataBase::ILS &ils = list_ils[ *it ];
+
+            if ( ils.type == DataBase::ILS::LOC
+              && getDistance( ils.pos_wgs ) < _range_ils )
             {
-                _ils_loc = &(*it);
+                _ils_loc = &ils;
                 break;
             }
         }
@@ -221,15 +228,16 @@ void Manager::updateNavaidsActive()
 
     if ( !_ils_dme )
     {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
+        DataBase::instance()->getIndexILS().find( &_items, Frequency::getFreqDME( _nav_freq ), lat, lon, _range_ils );
+
+        for ( Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
         {
-            if ( (*it).type == DataBase::ILS::DME
-              && (*it).freq == Frequency::getFreqDME( _nav_freq )
-              && getDistance( (*it).pos_wgs ) < _range_ils )
+            const DataBase::ILS &ils = list_ils[ *it ];
+
+            if ( ils.type == DataBase::ILS::DME
+              && getDistance( ils.pos_wgs ) < _range_ils )
             {
-                _ils_dme = &(*it);
+                _ils_dme = &ils;
                 break;
             }
         }
@@ -237,15 +245,16 @@ void Manager::updateNavaidsActive()
 
     if ( !_ils_gs )
     {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
+        DataBase::instance()->getIndexILS().find( &_items, Frequency::getFreqGS( _nav_freq ), lat, lon, _range_ils );
+
+        for ( Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
         {
-            if ( (*it).type == DataBase::ILS::GS
-              && (*it).freq == Frequency::getFreqGS( _nav_freq )
-              && getDistance( (*it).pos_wgs ) < _range_ils )
+            const DataBase::ILS &ils = list_ils[ *it ];
+
+            if ( ils.type == DataBase::ILS::GS
+              && getDistance( ils.pos_wgs ) < _range_ils )
             {
-                _ils_gs = &(*it);
+                _ils_gs = &ils;
                 break;
             }
         }
@@ -253,15 +262,16 @@ void Manager::updateNavaidsActive()
 
     if ( !_vor )
     {
-        for ( DataBase::ListNAV::const_iterator it = DataBase::instance()->getListNAV().begin();
-              it != DataBase::instance()->getListNAV().end();
-              ++it )
+        DataBase::instance()->getIndexNAV().find( &_items, _nav_freq, lat, lon, _range_vor );
+
+        for ( Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
         {
-            if ( ( (*it).type == DataBase::NAV::VOR || (*it).type == DataBase::NAV::VOR_DME || (*it).type == DataBase::NAV::VORTAC )
-              && (*it).freq == _nav_freq
-              && getDistance( (*it).pos_wgs ) < _range_vor )
+            const DataBase::NAV &nav = list_nav[ *it ];
+
+            if ( ( nav.type == DataBase::NAV::VOR || nav.type == DataBase::NAV::VOR_DME || nav.type == DataBase::NAV::VORTAC )
+              && getDistance( nav.pos_wgs ) < _range_vor )
             {
-                _vor = &(*it);
+                _vor = &nav;
                 break;
             }
         }
@@ -269,15 +279,16 @@ void Manager::updateNavaidsActive()
 
     if ( !_ndb )
     {
-        for ( DataBase::ListNAV::const_iterator it = DataBase::instance()->getListNAV().begin();
-              it != DataBase::instance()->getListNAV().end();
-              ++it )
+        DataBase::instance()->getIndexNAV().find( &_items, _adf_freq, lat, lon, _range_ndb );
+
+        for ( Index::Items::const_iterator it = _items.begin(); it != _items.end(); ++it )
         {
-            if ( ( (*it).type == DataBase::NAV::NDB || (*it).type == DataBase::NAV::NDB_DME )
-              && (*it).freq == _adf_freq
-              && getDistance( (*it).pos_wgs ) < _range_ndb )
+            const DataBase::NAV &nav = list_nav[ *it ];
+
+            if ( ( nav.type == DataBase::NAV::NDB || nav.type == DataBase::NAV::NDB_DME )
+              && getDistance( nav.pos_wgs ) < _range_ndb )
             {
-                _ndb = &(*it);
+                _ndb = &nav;
                 break;
             }
         }
@@ -80,6 +80,8 @@ private:
 
     fdm::WGS84 _aircraft_wgs;       ///<
 
+    Index::Items _items;            ///< navaids index query result
+
     double _course;                 ///< [rad]
 
     int _adf_freq;                  ///< [kHz]
@@ -0,0 +1,76 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fdm/fdm_Log.h>
+
+#include <nav/nav_DataBase.h>
+
+#include <sim/Path.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage( const char *name )
+{
+    fdm::Log::out() << "Usage: " << name << " [options]" << std::endl;
+    fdm::Log::out() << "  -o <file>    output binary data base file (default: " << Path::get( nav::DataBase::_binary_file ) << ")" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This is navigation data base compiler main function. It converts DAFIF
+ * text files listed in "nav/nav_db.xml" into binary data base.
+ */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    std::string file = Path::get( nav::DataBase::_binary_file );
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool hasValue = ( i + 1 < argc );
+
+        if ( 0 == strcmp( argv[ i ], "-o" ) && hasValue ) file = argv[ ++i ];
+        else
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( !nav::DataBase::compile( file.c_str() ) )
+    {
+        fdm::Log::e() << "Cannot write navigation data base file \"" << file << "\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fdm::Log::i() << "Navigation data base compiled to \"" << file << "\"" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -77,6 +77,8 @@ void Thread::run()
 void Thread::onDataInpUpdated( const Data::DataBuf *data )
 {
     memcpy( &_data, data, sizeof(Data::DataBuf) );
+
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Sound, _data.trace );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,155 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/ctrl/fdm_Filter2.h>
+#include <fdm/ctrl/fdm_FilterBank.h>
+#include <fdm/ctrl/fdm_Lag.h>
+#include <fdm/ctrl/fdm_LeadLag.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class FilterBankTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    FilterBankTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_update();
+    void test_updateSingle();
+    void test_setTimeConst();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+FilterBankTest::FilterBankTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_update()
+{
+    fdm::Lag     lag( 0.2 );
+    fdm::LeadLag leadLag( 2.0, 7.25, 1.0, 7.25 );
+    fdm::Filter2 filter2( 4.0, 64.0, 6400.0, 1.0, 80.0, 6400.0 );
+
+    fdm::FilterBank bank;
+
+    unsigned int i_lag = bank.addLag( 0.2 );
+    unsigned int i_ll  = bank.addLeadLag( 2.0, 7.25, 1.0, 7.25 );
+    unsigned int i_f2  = bank.addFilter2( 4.0, 64.0, 6400.0, 1.0, 80.0, 6400.0 );
+
+    QCOMPARE( bank.getCount(), 3U );
+
+    double t = 0.0;
+
+    for ( int i = 0; i < 500; i++ )
+    {
+        // time step changes half way to check coefficients recomputing
+        double dt = ( i < 250 ) ? TIME_STEP : 0.5 * TIME_STEP;
+        double u = ( t < 0.99 ) ? 0.0 : 1.0;
+
+        lag.update( dt, u );
+        leadLag.update( dt, u );
+        filter2.update( dt, u );
+
+        bank.setInput( i_lag , u );
+        bank.setInput( i_ll  , u );
+        bank.setInput( i_f2  , u );
+        bank.update( dt );
+
+        QVERIFY2( fabs( bank.getValue( i_lag ) - lag.getValue()     ) < 1.0e-12, "Failure" );
+        QVERIFY2( fabs( bank.getValue( i_ll  ) - leadLag.getValue() ) < 1.0e-12, "Failure" );
+        QVERIFY2( fabs( bank.getValue( i_f2  ) - filter2.getValue() ) < 1.0e-12, "Failure" );
+
+        t += dt;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_updateSingle()
+{
+    fdm::Lag     lag( 0.1 );
+    fdm::LeadLag leadLag( 3.0, 12.0, 1.0, 12.0 );
+
+    fdm::FilterBank bank;
+
+    unsigned int i_lag = bank.addLag( 0.1 );
+    unsigned int i_ll  = bank.addLeadLag( 3.0, 12.0, 1.0, 12.0 );
+
+    double t = 0.0;
+
+    for ( int i = 0; i < 300; i++ )
+    {
+        double u = ( t < 0.99 ) ? 0.0 : 1.0;
+
+        // chained elements
+        lag.update( TIME_STEP, u );
+        leadLag.update( TIME_STEP, lag.getValue() );
+
+        bank.update( TIME_STEP, i_lag, u );
+        bank.update( TIME_STEP, i_ll, bank.getValue( i_lag ) );
+
+        QVERIFY2( fabs( bank.getValue( i_lag ) - lag.getValue()     ) < 1.0e-12, "Failure" );
+        QVERIFY2( fabs( bank.getValue( i_ll  ) - leadLag.getValue() ) < 1.0e-12, "Failure" );
+
+        t += TIME_STEP;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_setTimeConst()
+{
+    fdm::Lag lag( 1.0 );
+
+    fdm::FilterBank bank;
+
+    unsigned int i_lag = bank.addLag( 1.0 );
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        if ( i == 100 )
+        {
+            lag.setTimeConst( 0.1 );
+            bank.setTimeConst( i_lag, 0.1 );
+        }
+
+        lag.update( TIME_STEP, 1.0 );
+        bank.update( TIME_STEP, i_lag, 1.0 );
+
+        QVERIFY2( fabs( bank.getValue( i_lag ) - lag.getValue() ) < 1.0e-12, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(FilterBankTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_filterbank.moc"
@@ -0,0 +1,356 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <QString>
+#include <QtTest>
+
+#include <hid/hid_InputReader.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FRAMES        1000
+#define FRAME_PERIOD  1000000LL     // [ns] 1 kHz synthetic device
+#define STEP_PERIOD   10000000LL    // [ns] 100 Hz simulation
+#define AXIS_RANGE    32767.0
+#define TIMEOUT       1000000000LL  // [ns]
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Mock joystick, synthetic events are written to the pipe read by the reader.
+ */
+class MockDevice
+{
+public:
+
+    MockDevice() : fd_r ( -1 ), fd_w ( -1 )
+    {
+        int fds[ 2 ];
+
+        if ( pipe( fds ) == 0 )
+        {
+            fd_r = fds[ 0 ];
+            fd_w = fds[ 1 ];
+
+            fcntl( fd_r, F_SETFL, fcntl( fd_r, F_GETFL ) | O_NONBLOCK );
+        }
+    }
+
+    ~MockDevice()
+    {
+        if ( fd_w >= 0 ) close( fd_w );
+    }
+
+    void frame( long long time, int x, int y )
+    {
+        input_event events[ 3 ];
+
+        set( &events[ 0 ], time, EV_ABS, ABS_X, x );
+        set( &events[ 1 ], time, EV_ABS, ABS_Y, y );
+        set( &events[ 2 ], time, EV_SYN, SYN_REPORT, 0 );
+
+        write( events, 3 );
+    }
+
+    void event( long long time, unsigned short type, unsigned short code, int value )
+    {
+        input_event ev;
+        set( &ev, time, type, code, value );
+        write( &ev, 1 );
+    }
+
+    void disconnect()
+    {
+        close( fd_w );
+        fd_w = -1;
+    }
+
+    int fd_r;
+    int fd_w;
+
+private:
+
+    void set( input_event *ev, long long time, unsigned short type, unsigned short code, int value )
+    {
+        memset( ev, 0, sizeof(input_event) );
+
+        ev->input_event_sec  = time / 1000000000LL;
+        ev->input_event_usec = ( time % 1000000000LL ) / 1000LL;
+
+        ev->type  = type;
+        ev->code  = code;
+        ev->value = value;
+    }
+
+    void write( const input_event *events, int count )
+    {
+        if ( ::write( fd_w, events, count * sizeof(input_event) ) < 0 )
+        {
+            cout << "Cannot write mock events." << endl;
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class InputReaderTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    InputReaderTest() {}
+
+private:
+
+    hid::InputReader::Mapping _mapping;
+
+    bool waitForEvents( const hid::InputReader &reader, unsigned int events,
+                        hid::InputReader::State *state );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_latency();
+    void test_history();
+    void test_dropped();
+    void test_disconnect();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::initTestCase()
+{
+    hid::InputReader::initMapping( &_mapping );
+
+    _mapping.axis  [ ABS_X ] = 0;
+    _mapping.range [ ABS_X ] = AXIS_RANGE;
+    _mapping.axis  [ ABS_Y ] = 1;
+    _mapping.range [ ABS_Y ] = AXIS_RANGE;
+
+    _mapping.butt[ BTN_TRIGGER ] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool InputReaderTest::waitForEvents( const hid::InputReader &reader, unsigned int events,
+                                     hid::InputReader::State *state )
+{
+    long long t0 = hid::InputReader::now();
+
+    while ( hid::InputReader::now() - t0 < TIMEOUT )
+    {
+        reader.getState( 0, state );
+        if ( state->events >= events ) return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::test_latency()
+{
+    MockDevice device;
+    hid::InputReader reader;
+
+    QCOMPARE( reader.addDevice( device.fd_r, _mapping ), 0 );
+    QVERIFY2( reader.start(), "Failure" );
+
+    std::vector< long long > latency;
+    std::vector< long long > age;
+
+    bool running = true;
+    bool torn = false;
+
+    // simulation thread sampling the latest state at each step
+    std::thread sim( [ & ]()
+    {
+        long long next = hid::InputReader::now();
+
+        while ( running )
+        {
+            hid::InputReader::State state;
+            reader.getState( 0, &state );
+
+            long long t = hid::InputReader::now();
+
+            if ( state.events > 0 )
+            {
+                age.push_back( t - state.time );
+
+                // both axes of a frame are published together
+                if ( state.axis[ 0 ] != -state.axis[ 1 ] ) torn = true;
+            }
+
+            next += STEP_PERIOD;
+            std::this_thread::sleep_for( std::chrono::nanoseconds( next - hid::InputReader::now() ) );
+        }
+    } );
+
+    long long next = hid::InputReader::now();
+
+    for ( int i = 0; i < FRAMES; i++ )
+    {
+        int x = (int)floor( AXIS_RANGE * sin( 0.01 * i ) + 0.5 );
+
+        long long t = hid::InputReader::now();
+        device.frame( t, x, -x );
+
+        hid::InputReader::State state;
+        QVERIFY2( waitForEvents( reader, 2 * ( i + 1 ), &state ), "Failure" );
+
+        latency.push_back( hid::InputReader::now() - t );
+
+        QCOMPARE( state.time, 1000LL * ( t / 1000LL ) );
+        QVERIFY2( fabs( state.axis[ 0 ] - x / AXIS_RANGE ) < 1.0e-6, "Failure" );
+
+        next += FRAME_PERIOD;
+        std::this_thread::sleep_for( std::chrono::nanoseconds( next - hid::InputReader::now() ) );
+    }
+
+    running = false;
+    sim.join();
+
+    std::sort( latency.begin(), latency.end() );
+    std::sort( age.begin(), age.end() );
+
+    double latency_med = 1.0e-3 * latency[ latency.size() / 2 ];
+    double latency_max = 1.0e-3 * latency.back();
+    double age_med     = 1.0e-3 * age[ age.size() / 2 ];
+    double age_max     = 1.0e-3 * age.back();
+
+    cout << "event to state latency: median " << latency_med << " us, max " << latency_max << " us" << endl;
+    cout << "sampled state age:      median " << age_med     << " us, max " << age_max     << " us" << endl;
+
+    QVERIFY2( !torn, "Failure" );
+
+    // state sampled at a step is about one device frame old
+    QVERIFY2( latency_med < 1000.0, "Failure" );
+    QVERIFY2( age_med < 2.0e-3 * FRAME_PERIOD, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::test_history()
+{
+    MockDevice device;
+    hid::InputReader reader;
+
+    reader.addDevice( device.fd_r, _mapping );
+    reader.start();
+
+    device.frame( 1000000000LL, 0, 32767 );
+    device.event( 2000000000LL, EV_KEY, BTN_TRIGGER, 1 );
+    device.event( 2000000000LL, EV_KEY, BTN_TOP, 1 );     // not mapped
+    device.event( 2000000000LL, EV_SYN, SYN_REPORT, 0 );
+
+    hid::InputReader::State state;
+    QVERIFY2( waitForEvents( reader, 3, &state ), "Failure" );
+
+    QVERIFY2( state.butt[ 0 ], "Failure" );
+    QCOMPARE( state.time, 2000000000LL );
+
+    hid::InputReader::Event events[ 8 ];
+    unsigned int count = reader.getEvents( 0, events, 8 );
+
+    QCOMPARE( count, (unsigned int)3 );
+
+    QCOMPARE( events[ 0 ].type, (unsigned short)EV_ABS );
+    QCOMPARE( events[ 0 ].index, (short)0 );
+    QCOMPARE( events[ 0 ].time, 1000000000LL );
+
+    QCOMPARE( events[ 1 ].type, (unsigned short)EV_ABS );
+    QCOMPARE( events[ 1 ].index, (short)1 );
+    QVERIFY2( fabs( events[ 1 ].value - 1.0f ) < 1.0e-6, "Failure" );
+
+    QCOMPARE( events[ 2 ].type, (unsigned short)EV_KEY );
+    QCOMPARE( events[ 2 ].index, (short)0 );
+    QCOMPARE( events[ 2 ].time, 2000000000LL );
+
+    QCOMPARE( reader.getEvents( 0, events, 8 ), (unsigned int)0 );
+
+    device.frame( 3000000000LL, 100, 200 );
+    QVERIFY2( waitForEvents( reader, 5, &state ), "Failure" );
+
+    reader.clearEvents( 0 );
+
+    QCOMPARE( reader.getEvents( 0, events, 8 ), (unsigned int)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::test_dropped()
+{
+    MockDevice device;
+    hid::InputReader reader;
+
+    reader.addDevice( device.fd_r, _mapping );
+    reader.start();
+
+    long long t = hid::InputReader::now();
+
+    device.frame( t, 100, -100 );
+
+    // events following SYN_DROPPED up to the next SYN_REPORT are incomplete
+    device.event( t, EV_SYN, SYN_DROPPED, 0 );
+    device.event( t, EV_ABS, ABS_X, 200 );
+    device.event( t, EV_SYN, SYN_REPORT, 0 );
+    device.frame( t, 300, -300 );
+
+    hid::InputReader::State state;
+    QVERIFY2( waitForEvents( reader, 4, &state ), "Failure" );
+
+    QCOMPARE( state.events, (unsigned int)4 );
+    QVERIFY2( fabs( state.axis[ 0 ] - 300.0 / AXIS_RANGE ) < 1.0e-6, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void InputReaderTest::test_disconnect()
+{
+    MockDevice device;
+    hid::InputReader reader;
+
+    reader.addDevice( device.fd_r, _mapping );
+    reader.start();
+
+    device.frame( hid::InputReader::now(), 100, -100 );
+    device.disconnect();
+
+    hid::InputReader::State state;
+    long long t0 = hid::InputReader::now();
+
+    do
+    {
+        reader.getState( 0, &state );
+    }
+    while ( state.active && hid::InputReader::now() - t0 < TIMEOUT );
+
+    QVERIFY2( !state.active, "Failure" );
+    QCOMPARE( state.events, (unsigned int)2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(InputReaderTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_hid_inputreader.moc"
@@ -0,0 +1,475 @@
+#include <algorithm>
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/fdm_Collisions.h>
+
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+#define VELOCITY  300.0
+#define ALTITUDE  50.0
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Local frame at the ground level: x-axis pointing east, y-axis pointing
+ * north and z-axis pointing up.
+ */
+class LocalFrame
+{
+public:
+
+    LocalFrame()
+    {
+        fdm::Geo geo;
+
+        geo.lat = fdm::Units::deg2rad(   21.3 );
+        geo.lon = fdm::Units::deg2rad( -157.9 );
+        geo.alt = 0.0;
+
+        fdm::WGS84 wgs( geo );
+
+        _origin_wgs = wgs.getPos_WGS();
+
+        fdm::Vector3 e_wgs = wgs.getNED2WGS() * fdm::Vector3( 0.0, 1.0,  0.0 );
+        fdm::Vector3 n_wgs = wgs.getNED2WGS() * fdm::Vector3( 1.0, 0.0,  0.0 );
+        fdm::Vector3 u_wgs = wgs.getNED2WGS() * fdm::Vector3( 0.0, 0.0, -1.0 );
+
+        _enu2wgs = fdm::Matrix3x3( e_wgs.x(), n_wgs.x(), u_wgs.x(),
+                                   e_wgs.y(), n_wgs.y(), u_wgs.y(),
+                                   e_wgs.z(), n_wgs.z(), u_wgs.z() );
+
+        _wgs2enu = _enu2wgs.getTransposed();
+    }
+
+    fdm::Vector3 toWGS( const fdm::Vector3 &r ) const { return _origin_wgs + _enu2wgs * r; }
+    fdm::Vector3 toLocal( const fdm::Vector3 &r_wgs ) const { return _wgs2enu * ( r_wgs - _origin_wgs ); }
+
+    fdm::Vector3 dirWGS( const fdm::Vector3 &v ) const { return _enu2wgs * v; }
+
+    const fdm::Matrix3x3& getBAS2WGS() const { return _enu2wgs; }
+
+private:
+
+    fdm::Vector3 _origin_wgs;
+    fdm::Matrix3x3 _enu2wgs;
+    fdm::Matrix3x3 _wgs2enu;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Scenery made of a single obstacle over flat ground at z = 0. Obstacle is
+ * defined in the local frame, ground is only the intersections ground plane.
+ */
+class ObstacleIntersections : public fdm::Intersections
+{
+public:
+
+    ObstacleIntersections( const LocalFrame &frame ) :
+        _frame ( frame ),
+        _queries ( 0 )
+    {
+        _inited = true;
+
+        _ground_wgs = _frame.toWGS( fdm::Vector3( 0.0, 0.0, 0.0 ) );
+        _normal_wgs = _frame.dirWGS( fdm::Vector3( 0.0, 0.0, 1.0 ) );
+    }
+
+    int getIntersection( const fdm::Vector3 &b, const fdm::Vector3 &e,
+                         fdm::Vector3 *r, fdm::Vector3 *n, bool ) const
+    {
+        double t = 0.0;
+
+        if ( isect( _frame.toLocal( b ), _frame.toLocal( e ), &t ) )
+        {
+            (*r) = b + t * ( e - b );
+            (*n) = _frame.dirWGS( fdm::Vector3( -1.0, 0.0, 0.0 ) );
+
+            return FDM_SUCCESS;
+        }
+
+        return FDM_FAILURE;
+    }
+
+    unsigned int getIntersections( const fdm::Vector3 b[], const fdm::Vector3 e[],
+                                   Hit hits[], unsigned int count, bool ) const
+    {
+        unsigned int result = 0;
+
+        _queries++;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            hits[ i ].valid = isect( _frame.toLocal( b[ i ] ), _frame.toLocal( e[ i ] ), &hits[ i ].t );
+
+            if ( hits[ i ].valid )
+            {
+                hits[ i ].r = b[ i ] + hits[ i ].t * ( e[ i ] - b[ i ] );
+                hits[ i ].n = _frame.dirWGS( fdm::Vector3( -1.0, 0.0, 0.0 ) );
+
+                result++;
+            }
+        }
+
+        return result;
+    }
+
+    inline unsigned int getQueries() const { return _queries; }
+
+protected:
+
+    const LocalFrame &_frame;
+
+    mutable unsigned int _queries;
+
+    /** Segment given in the local frame, t is the segment parameter. */
+    virtual bool isect( const fdm::Vector3 &b, const fdm::Vector3 &e, double *t ) const = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Thin plate perpendicular to x-axis.
+ */
+class PlateIntersections : public ObstacleIntersections
+{
+public:
+
+    PlateIntersections( const LocalFrame &frame, double x ) :
+        ObstacleIntersections( frame ),
+        _x ( x )
+    {}
+
+private:
+
+    const double _x;
+
+    bool isect( const fdm::Vector3 &b, const fdm::Vector3 &e, double *t ) const
+    {
+        double den = e.x() - b.x();
+
+        if ( fabs( den ) < 1.0e-12 ) return false;
+
+        (*t) = ( _x - b.x() ) / den;
+
+        if ( (*t) < 0.0 || (*t) >= 1.0 ) return false;
+
+        fdm::Vector3 r = b + (*t) * ( e - b );
+
+        return 4.0 < r.y() && r.y() < 6.0 && ALTITUDE - 1.0 < r.z() && r.z() < ALTITUDE + 1.0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Ridge along y-axis, from x_0 to x_1 and from the ground up to height h.
+ */
+class RidgeIntersections : public ObstacleIntersections
+{
+public:
+
+    RidgeIntersections( const LocalFrame &frame, double x_0, double x_1, double h ) :
+        ObstacleIntersections( frame ),
+        _x_0 ( x_0 ),
+        _x_1 ( x_1 ),
+        _h ( h )
+    {}
+
+private:
+
+    const double _x_0;
+    const double _x_1;
+    const double _h;
+
+    bool isect( const fdm::Vector3 &b, const fdm::Vector3 &e, double *t ) const
+    {
+        // slabs clipping, ridge is unbounded along y-axis and downwards
+        double t_0 = 0.0;
+        double t_1 = 1.0;
+
+        if ( !clip( b.x(), e.x(), _x_0, _x_1, &t_0, &t_1 ) ) return false;
+        if ( !clip( b.z(), e.z(), -1.0e9, _h, &t_0, &t_1 ) ) return false;
+
+        (*t) = t_0;
+
+        return t_0 < 1.0;
+    }
+
+    static bool clip( double b, double e, double min, double max, double *t_0, double *t_1 )
+    {
+        double d = e - b;
+
+        if ( fabs( d ) < 1.0e-12 ) return min <= b && b <= max;
+
+        double t_a = ( min - b ) / d;
+        double t_b = ( max - b ) / d;
+
+        if ( t_a > t_b ) std::swap( t_a, t_b );
+
+        (*t_0) = std::max( (*t_0), t_a );
+        (*t_1) = std::min( (*t_1), t_b );
+
+        return (*t_0) <= (*t_1);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class CollisionsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    CollisionsTest();
+
+private:
+
+    LocalFrame _frame;
+
+    fdm::Collisions::Points _points;
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_thinObstacle();
+    void test_broadPhase();
+    void test_ridge();
+    void test_clearance();
+    void test_reset();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+CollisionsTest::CollisionsTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::initTestCase()
+{
+    _points.push_back( fdm::Vector3(  5.0,  0.0, 0.0 ) ); // nose
+    _points.push_back( fdm::Vector3(  0.0, -5.0, 0.0 ) ); // left wing tip
+    _points.push_back( fdm::Vector3(  0.0,  5.0, 0.0 ) ); // right wing tip
+    _points.push_back( fdm::Vector3( -5.0,  0.0, 0.0 ) ); // tail
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::test_thinObstacle()
+{
+    const double step = VELOCITY * TIME_STEP;
+
+    const fdm::Matrix3x3 &bas2wgs = _frame.getBAS2WGS();
+
+    int missed_swept = 0;
+    int missed_round_robin = 0;
+
+    // plate positions within a single step
+    for ( int k = 0; k < 100; k++ )
+    {
+        double x = 100.0 + 0.01 * k * step;
+
+        PlateIntersections isect( _frame, x );
+
+        fdm::Collisions collisions( &isect );
+        collisions.setPoints( _points );
+
+        bool contact = false;
+
+        unsigned int cp_index = 0;
+        bool contact_round_robin = false;
+
+        for ( int i = 0; i < 100 && !contact; i++ )
+        {
+            fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * step, 0.0, ALTITUDE ) );
+
+            if ( collisions.update( pos_wgs, bas2wgs ) )
+            {
+                contact = true;
+
+                QCOMPARE( collisions.getIndex(), (unsigned int)2 );
+                QVERIFY2( fabs( _frame.toLocal( collisions.getContact_WGS() ).x() - x ) < 1.0e-6, "Failure" );
+
+                double toi = ( x - ( i - 1 ) * step ) / step;
+                QVERIFY2( fabs( collisions.getTimeOfImpact() - toi ) < 1.0e-6, "Failure" );
+            }
+
+            // previous approach: single point per step, segment from the aircraft origin
+            if ( isect.isIntersection( pos_wgs, pos_wgs + bas2wgs * _points[ cp_index ], true ) )
+            {
+                contact_round_robin = true;
+            }
+
+            cp_index = ( cp_index + 1 ) % _points.size();
+        }
+
+        if ( !contact ) missed_swept++;
+        if ( !contact_round_robin ) missed_round_robin++;
+    }
+
+    cout << "missed (swept): " << missed_swept << "/100" << endl;
+    cout << "missed (round robin): " << missed_round_robin << "/100" << endl;
+
+    QCOMPARE( missed_swept, 0 );
+    QCOMPARE( missed_round_robin, 100 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::test_broadPhase()
+{
+    const fdm::Matrix3x3 &bas2wgs = _frame.getBAS2WGS();
+
+    PlateIntersections isect( _frame, 1.0e6 );
+
+    fdm::Collisions collisions( &isect );
+    collisions.setPoints( _points );
+
+    // high above terrain, only terrain bound is sampled
+    for ( int i = 0; i < 10; i++ )
+    {
+        fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * VELOCITY * TIME_STEP, 0.0, 2.0 * collisions.getClearance() ) );
+
+        QVERIFY2( !collisions.update( pos_wgs, bas2wgs ), "Failure" );
+    }
+
+    QCOMPARE( isect.getQueries(), (unsigned int)1 );
+
+    // close to terrain, all points are tested in a single query
+    for ( int i = 10; i < 20; i++ )
+    {
+        fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * VELOCITY * TIME_STEP, 0.0, ALTITUDE ) );
+
+        QVERIFY2( !collisions.update( pos_wgs, bas2wgs ), "Failure" );
+    }
+
+    QCOMPARE( isect.getQueries(), (unsigned int)11 );
+
+    // climbing step is tested, then terrain bound is sampled again
+    // after leaving the grid center
+    for ( int i = 20; i < 300; i++ )
+    {
+        fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * VELOCITY * TIME_STEP, 0.0, 2.0 * collisions.getClearance() ) );
+
+        QVERIFY2( !collisions.update( pos_wgs, bas2wgs ), "Failure" );
+    }
+
+    QCOMPARE( isect.getQueries(), (unsigned int)13 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::test_ridge()
+{
+    const double step = VELOCITY * TIME_STEP;
+
+    const fdm::Matrix3x3 &bas2wgs = _frame.getBAS2WGS();
+
+    // ridge 1500 m high ahead, aircraft 1100 m above the ground under it,
+    // which is more than the default clearance above the ground plane
+    RidgeIntersections isect( _frame, 402.5, 1200.0, 1500.0 );
+
+    fdm::Collisions collisions( &isect );
+    collisions.setPoints( _points );
+
+    QVERIFY2( 1100.0 > collisions.getClearance(), "Failure" );
+
+    bool contact = false;
+    int i = 0;
+
+    for ( ; i < 200 && !contact; i++ )
+    {
+        fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * step, 0.0, 1100.0 ) );
+
+        contact = collisions.update( pos_wgs, bas2wgs );
+    }
+
+    QVERIFY2( contact, "Failure" );
+    QVERIFY2( fabs( collisions.getBound() - 1500.0 ) < 1.0, "Failure" );
+
+    // nose hits the ridge face in the step from 401 m to 404 m
+    QCOMPARE( i - 1, 133 );
+    QCOMPARE( collisions.getIndex(), (unsigned int)0 );
+    QVERIFY2( fabs( _frame.toLocal( collisions.getContact_WGS() ).x() - 402.5 ) < 1.0e-6, "Failure" );
+    QVERIFY2( fabs( collisions.getTimeOfImpact() - 0.5 ) < 1.0e-6, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::test_clearance()
+{
+    const fdm::Matrix3x3 &bas2wgs = _frame.getBAS2WGS();
+
+    PlateIntersections isect( _frame, 1.0e6 );
+
+    fdm::Collisions collisions( &isect );
+    collisions.setPoints( _points );
+
+    QCOMPARE( collisions.getClearance(), fdm::Collisions::_clearance_default );
+
+    collisions.setClearance( 20.0 );
+
+    // 50 m above the terrain bound with 20 m clearance, narrow phase is skipped
+    for ( int i = 0; i < 10; i++ )
+    {
+        fdm::Vector3 pos_wgs = _frame.toWGS( fdm::Vector3( i * VELOCITY * TIME_STEP, 0.0, ALTITUDE ) );
+
+        QVERIFY2( !collisions.update( pos_wgs, bas2wgs ), "Failure" );
+    }
+
+    QCOMPARE( isect.getQueries(), (unsigned int)1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionsTest::test_reset()
+{
+    const fdm::Matrix3x3 &bas2wgs = _frame.getBAS2WGS();
+
+    PlateIntersections isect( _frame, 100.0 );
+
+    fdm::Collisions collisions( &isect );
+    collisions.setPoints( _points );
+
+    // aircraft moved over the obstacle
+    QVERIFY2( !collisions.update( _frame.toWGS( fdm::Vector3(   0.0, 0.0, ALTITUDE ) ), bas2wgs ), "Failure" );
+    collisions.reset();
+    QVERIFY2( !collisions.update( _frame.toWGS( fdm::Vector3( 200.0, 0.0, ALTITUDE ) ), bas2wgs ), "Failure" );
+
+    // aircraft flown through the obstacle
+    collisions.reset();
+    QVERIFY2( !collisions.update( _frame.toWGS( fdm::Vector3(   0.0, 0.0, ALTITUDE ) ), bas2wgs ), "Failure" );
+    QVERIFY2(  collisions.update( _frame.toWGS( fdm::Vector3( 200.0, 0.0, ALTITUDE ) ), bas2wgs ), "Failure" );
+    QVERIFY2( fabs( collisions.getTimeOfImpact() - 0.5 ) < 1.0e-6, "Failure" );
+
+    // aircraft placed in contact, there is no previous position
+    collisions.reset();
+    QVERIFY2(  collisions.update( _frame.toWGS( fdm::Vector3( 100.0, 0.0, ALTITUDE ) ), bas2wgs ), "Failure" );
+    QCOMPARE( collisions.getTimeOfImpact(), 1.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(CollisionsTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_collisions.moc"
@@ -0,0 +1,484 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/fdm_Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP_MS 10     // simulation step
+#define STEPS        20
+#define MESSAGES     100    // messages per step, 10k messages per second
+#define LINE_DELAY   200    // [us] slow sink delay per line, 5k lines per second
+#define THREADS      4
+#define LONG_SIZE    600    // long message payload size, longer than a single record
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Unbuffered output, every character goes through overflow() or xsputn(),
+ * which take LINE_DELAY to write each line.
+ * Records if it has ever been written by the given producer thread.
+ */
+class SlowBuffer : public std::streambuf
+{
+public:
+
+    SlowBuffer( std::thread::id producer ) :
+        _producer ( producer ),
+        _producerWrites ( false )
+    {}
+
+    std::string str() const { return _text; }
+
+    void reset() { _text.clear(); _producerWrites.store( false ); }
+
+    bool producerWrites() const { return _producerWrites.load(); }
+
+protected:
+
+    int_type overflow( int_type c )
+    {
+        check();
+
+        if ( !traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            if ( c == '\n' ) delay( 1 );
+            _text.push_back( traits_type::to_char_type( c ) );
+        }
+
+        return traits_type::not_eof( c );
+    }
+
+    std::streamsize xsputn( const char *s, std::streamsize n )
+    {
+        check();
+        int lines = 0;
+        for ( std::streamsize i = 0; i < n; i++ ) if ( s[ i ] == '\n' ) lines++;
+        delay( lines );
+        _text.append( s, n );
+        return n;
+    }
+
+private:
+
+    std::thread::id _producer;
+    std::atomic< bool > _producerWrites;
+
+    std::string _text;
+
+    void check()
+    {
+        if ( std::this_thread::get_id() == _producer ) _producerWrites.store( true );
+    }
+
+    void delay( int lines )
+    {
+        if ( lines > 0 )
+        {
+            std::this_thread::sleep_for( std::chrono::microseconds( lines * LINE_DELAY ) );
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns calling thread CPU time [ms], unlike wall time it does not depend
+ * on other processes running on the machine.
+ */
+double threadTime()
+{
+#   ifdef WIN32
+    return std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#   else
+    timespec ts;
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+    return 1.0e3 * (double)ts.tv_sec + 1.0e-6 * (double)ts.tv_nsec;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+class LogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    LogTest();
+
+private:
+
+    std::streambuf *_cerr;
+
+    double flood( int steps, int messages, double *max_cpu = 0 );
+
+    std::vector< std::string > lines( const std::string &text );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_flood();
+    void test_repeats();
+    void test_threads();
+    void test_split();
+    void test_repeatsLong();
+    void test_synchronous();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+LogTest::LogTest() : _cerr ( 0 ) {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::initTestCase()
+{
+    _cerr = std::cerr.rdbuf();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::cleanupTestCase()
+{
+    fdm::Log::stop();
+    std::cerr.rdbuf( _cerr );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double LogTest::flood( int steps, int messages, double *max_cpu )
+{
+    double max_ms = 0.0;
+    double max_cpu_ms = 0.0;
+    double sum = 0.0;
+
+    for ( int i = 0; i < steps; i++ )
+    {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        double c0 = threadTime();
+
+        // simulation step work
+        for ( int j = 0; j < 100000; j++ )
+        {
+            sum += sqrt( (double)( i + j ) );
+        }
+
+        for ( int j = 0; j < messages; j++ )
+        {
+            fdm::Log::i() << "step " << i << " message " << j << " sum " << sum << std::endl;
+        }
+
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        double c1 = threadTime();
+
+        double step_ms = std::chrono::duration< double, std::milli >( t1 - t0 ).count();
+
+        if ( step_ms > max_ms ) max_ms = step_ms;
+        if ( c1 - c0 > max_cpu_ms ) max_cpu_ms = c1 - c0;
+
+        if ( step_ms < TIME_STEP_MS )
+        {
+            std::this_thread::sleep_for( std::chrono::microseconds( (int)( 1000.0 * ( TIME_STEP_MS - step_ms ) ) ) );
+        }
+    }
+
+    if ( max_cpu ) *max_cpu = max_cpu_ms;
+
+    return max_ms;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector< std::string > LogTest::lines( const std::string &text )
+{
+    std::vector< std::string > result;
+    std::istringstream iss( text );
+    std::string line;
+
+    while ( std::getline( iss, line ) )
+    {
+        result.push_back( line );
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_flood()
+{
+    SlowBuffer sink( std::this_thread::get_id() );
+    std::cerr.rdbuf( &sink );
+
+    double max_none = flood( STEPS, 0 );
+
+    // synchronous logging writes the slow sink in the step itself
+    double max_sync = flood( 2, MESSAGES );
+
+    sink.reset();
+
+    unsigned long dropped = fdm::Log::getDropped();
+
+    double max_async_cpu = 0.0;
+
+    fdm::Log::start();
+    double max_async = flood( STEPS, MESSAGES, &max_async_cpu );
+
+    // records left at stop are written by the stopping thread
+    bool producerWrites = sink.producerWrites();
+
+    fdm::Log::stop();
+
+    std::cerr.rdbuf( _cerr );
+
+    dropped = fdm::Log::getDropped() - dropped;
+
+    std::vector< std::string > result = lines( sink.str() );
+
+    unsigned long delivered = 0;
+
+    for ( unsigned int i = 0; i < result.size(); i++ )
+    {
+        if ( result[ i ].find( " message " ) != std::string::npos ) delivered++;
+    }
+
+    cout << "max step time (no logging): " << max_none  << " ms" << endl;
+    cout << "max step time (sync):       " << max_sync  << " ms" << endl;
+    cout << "max step time (async):      " << max_async << " ms, CPU " << max_async_cpu << " ms" << endl;
+    cout << "delivered: " << delivered << " dropped: " << dropped << endl;
+
+    // synchronous logging to this sink takes MESSAGES*LINE_DELAY = 20 ms per step
+    QVERIFY2( max_sync > TIME_STEP_MS, "Failure" );
+
+    // while logging the slow sink is written only by the background thread,
+    // so step work including logging fits in the simulation time step,
+    // CPU time is checked as wall time depends on the machine load
+    QVERIFY2( !producerWrites, "Failure" );
+    QVERIFY2( max_async_cpu < TIME_STEP_MS, "Failure" );
+
+    // every message is either written or counted as dropped
+    QCOMPARE( delivered + dropped, (unsigned long)( STEPS * MESSAGES ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_repeats()
+{
+    std::stringstream sink;
+    std::cerr.rdbuf( sink.rdbuf() );
+
+    fdm::Log::start();
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        fdm::Log::w() << "stall warning" << std::endl;
+    }
+
+    fdm::Log::i() << "recovered" << std::endl;
+
+    fdm::Log::flush();
+    fdm::Log::stop();
+
+    std::cerr.rdbuf( _cerr );
+
+    std::vector< std::string > result = lines( sink.str() );
+
+    QCOMPARE( (int)result.size(), 3 );
+
+    QVERIFY2( result[ 0 ].find( "[WARNING] stall warning" ) != std::string::npos, "Failure" );
+    QVERIFY2( result[ 1 ].find( "[WARNING] last message repeated 999 times" ) != std::string::npos, "Failure" );
+    QVERIFY2( result[ 2 ].find( "[INFO] recovered" ) != std::string::npos, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_threads()
+{
+    std::stringstream sink;
+    std::cerr.rdbuf( sink.rdbuf() );
+
+    unsigned long dropped = fdm::Log::getDropped();
+
+    fdm::Log::start();
+
+    std::vector< std::thread > threads;
+
+    for ( int t = 0; t < THREADS; t++ )
+    {
+        threads.push_back( std::thread( [ t ]()
+        {
+            for ( int i = 0; i < 500; i++ )
+            {
+                fdm::Log::i() << "thread " << t << " message " << i << std::endl;
+            }
+        } ) );
+    }
+
+    for ( unsigned int t = 0; t < threads.size(); t++ )
+    {
+        threads[ t ].join();
+    }
+
+    fdm::Log::flush();
+    fdm::Log::stop();
+
+    std::cerr.rdbuf( _cerr );
+
+    std::vector< std::string > result = lines( sink.str() );
+
+    QCOMPARE( (int)result.size(), THREADS * 500 );
+    QCOMPARE( fdm::Log::getDropped(), dropped );
+
+    // messages of each thread keep their order
+    std::vector< int > next( THREADS, 0 );
+
+    for ( unsigned int i = 0; i < result.size(); i++ )
+    {
+        int t = 0;
+        int m = 0;
+
+        size_t pos = result[ i ].find( "thread " );
+        QVERIFY2( pos != std::string::npos, "Failure" );
+        QVERIFY2( 2 == sscanf( result[ i ].c_str() + pos, "thread %d message %d", &t, &m ), "Failure" );
+        QCOMPARE( m, next[ t ] );
+
+        next[ t ]++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_split()
+{
+    std::stringstream sink;
+    std::cerr.rdbuf( sink.rdbuf() );
+
+    unsigned long dropped = fdm::Log::getDropped();
+
+    fdm::Log::start();
+
+    std::vector< std::thread > threads;
+
+    for ( int t = 0; t < THREADS; t++ )
+    {
+        threads.push_back( std::thread( [ t ]()
+        {
+            std::string payload( LONG_SIZE, (char)( 'a' + t ) );
+
+            for ( int i = 0; i < 100; i++ )
+            {
+                fdm::Log::i() << "thread " << t << " message " << i << " " << payload << " end" << std::endl;
+            }
+        } ) );
+    }
+
+    for ( unsigned int t = 0; t < threads.size(); t++ )
+    {
+        threads[ t ].join();
+    }
+
+    fdm::Log::flush();
+    fdm::Log::stop();
+
+    std::cerr.rdbuf( _cerr );
+
+    std::vector< std::string > result = lines( sink.str() );
+
+    QCOMPARE( (int)result.size(), THREADS * 100 );
+    QCOMPARE( fdm::Log::getDropped(), dropped );
+
+    // records of long messages are not interleaved with other messages
+    std::vector< int > next( THREADS, 0 );
+
+    for ( unsigned int i = 0; i < result.size(); i++ )
+    {
+        int t = 0;
+        int m = 0;
+        int n = 0;
+
+        size_t pos = result[ i ].find( "thread " );
+        QVERIFY2( pos != std::string::npos, "Failure" );
+        QVERIFY2( 2 == sscanf( result[ i ].c_str() + pos, "thread %d message %d %n", &t, &m, &n ), "Failure" );
+        QCOMPARE( m, next[ t ] );
+
+        std::string payload( LONG_SIZE, (char)( 'a' + t ) );
+        QVERIFY2( result[ i ].substr( pos + n ) == payload + " end", "Failure" );
+
+        next[ t ]++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_repeatsLong()
+{
+    std::stringstream sink;
+    std::cerr.rdbuf( sink.rdbuf() );
+
+    // messages differing only in their continuation records
+    std::string text( LONG_SIZE, 'x' );
+
+    fdm::Log::start();
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        fdm::Log::w() << text << " A" << std::endl;
+    }
+
+    fdm::Log::w() << text << " B" << std::endl;
+
+    fdm::Log::flush();
+    fdm::Log::stop();
+
+    std::cerr.rdbuf( _cerr );
+
+    std::vector< std::string > result = lines( sink.str() );
+
+    QCOMPARE( (int)result.size(), 3 );
+
+    QVERIFY2( result[ 0 ].find( "[WARNING] " + text + " A" ) != std::string::npos, "Failure" );
+    QVERIFY2( result[ 1 ].find( "[WARNING] last message repeated 2 times" ) != std::string::npos, "Failure" );
+    QVERIFY2( result[ 2 ].find( "[WARNING] " + text + " B" ) != std::string::npos, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LogTest::test_synchronous()
+{
+    std::stringstream sink;
+    std::cerr.rdbuf( sink.rdbuf() );
+
+    QVERIFY2( !fdm::Log::isAsync(), "Failure" );
+
+    fdm::Log::e() << "error" << std::endl;
+
+    std::cerr.rdbuf( _cerr );
+
+    QVERIFY2( sink.str().find( "[ERROR] error\n" ) != std::string::npos, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(LogTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_log.moc"
@@ -56,6 +56,7 @@ mkdir temp_dest_dir
 ################################################################################
 
 makeAllTestsInDir ctrl
+makeAllTestsInDir hid
 makeAllTestsInDir main
 makeAllTestsInDir models
 makeAllTestsInDir utils
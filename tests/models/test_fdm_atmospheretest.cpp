@@ -3,7 +3,7 @@
 
 #include <iostream>
 
-#include <fdm/models/fdm_Atmosphere.h>
+#include <fdm/models/fdm_AtmosphereUS76.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -32,7 +32,7 @@ public:
 
 private:
 
-    fdm::Atmosphere *_atmosphere;
+    fdm::AtmosphereUS76 *_atmosphere;
 
 private Q_SLOTS:
 
@@ -132,7 +132,7 @@ AtmosphereTest::AtmosphereTest() : _atmosphere ( 0 ) {}
 
 void AtmosphereTest::initTestCase()
 {
-    _atmosphere = new fdm::Atmosphere();
+    _atmosphere = new fdm::AtmosphereUS76();
 
 //    double h = 0.0;
 
@@ -166,8 +166,8 @@ void AtmosphereTest::cleanupTestCase()
 
 void AtmosphereTest::stdConditions()
 {
-    _atmosphere->setPressureSL(    fdm::Atmosphere::_std_sl_p );
-    _atmosphere->setTemperatureSL( fdm::Atmosphere::_std_sl_t );
+    _atmosphere->setPressureSL(    fdm::AtmosphereUS76::_std_sl_p );
+    _atmosphere->setTemperatureSL( fdm::AtmosphereUS76::_std_sl_t );
 
     for ( int i = 0; i < NUM; i++ )
     {
@@ -192,8 +192,8 @@ void AtmosphereTest::stdConditions()
 
 void AtmosphereTest::modifiedSeaLevelConditions()
 {
-    _atmosphere->setPressureSL(    fdm::Atmosphere::_std_sl_p + 1000.0 );
-    _atmosphere->setTemperatureSL( fdm::Atmosphere::_std_sl_t + 10.0 );
+    _atmosphere->setPressureSL(    fdm::AtmosphereUS76::_std_sl_p + 1000.0 );
+    _atmosphere->setTemperatureSL( fdm::AtmosphereUS76::_std_sl_t + 10.0 );
 
     for ( int i = 2; i < NUM; i++ )
     {
@@ -25,6 +25,13 @@ public:
     {
     public:
 
+        PistonEngine()
+        {
+            // linear manifold absolute pressure ratios
+            _map_throttle = fdm::Table1( { 0.0, 1.0    }, { 0.6, 1.0  } );
+            _map_rpm      = fdm::Table1( { 0.0, 2500.0 }, { 1.0, 0.95 } );
+        }
+
         double getManifoldAbsolutePressure( double throttle, double rpm,
                                             double airPressure )
         {
@@ -82,8 +89,7 @@ void PistonEngineTest::getManifoldAbsolutePressure()
         airPressure = 1.0 + i * 0.05;
 
         double map_e = _engine->getManifoldAbsolutePressure( throttle, rpm, airPressure );
-        double map_t = airPressure + fdm::Units::inhg2pa( ( 0.04635 * throttle - 0.0469 ) * rpm );
-        map_t = fdm::Misc::max( 0.0, map_t );
+        double map_t = airPressure * ( 0.6 + 0.4 * throttle ) * ( 1.0 - 0.05 * rpm / 2500.0 );
 
         QVERIFY2( fabs( map_e - map_t ) < 1.0e-6, "Failure" );
     }
@@ -0,0 +1,199 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/models/fdm_Turbulence.h>
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TurbulenceTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TurbulenceTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_none();
+    void test_seed();
+    void test_intensityLowAltitude();
+    void test_intensityHighAltitude();
+
+private:
+
+    void getStDev( fdm::Turbulence *turbulence, double altitude_agl,
+                   double *sigma_u, double *sigma_w );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TurbulenceTest::TurbulenceTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::test_none()
+{
+    fdm::Turbulence turbulence;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        turbulence.update( TIME_STEP, 300.0, 60.0 );
+
+        QVERIFY2( turbulence.getVel_BAS().getLength() == 0.0, "Failure" );
+        QVERIFY2( turbulence.getOmg_BAS().getLength() == 0.0, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::test_seed()
+{
+    fdm::Turbulence turbulence_1( 1 );
+    fdm::Turbulence turbulence_2( 1 );
+    fdm::Turbulence turbulence_3( 2 );
+
+    turbulence_1.setIntensity( fdm::Turbulence::Moderate );
+    turbulence_2.setIntensity( fdm::Turbulence::Moderate );
+    turbulence_3.setIntensity( fdm::Turbulence::Moderate );
+
+    bool different = false;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        turbulence_1.update( TIME_STEP, 300.0, 60.0 );
+        turbulence_2.update( TIME_STEP, 300.0, 60.0 );
+        turbulence_3.update( TIME_STEP, 300.0, 60.0 );
+
+        QVERIFY2( turbulence_1.getVel_BAS() == turbulence_2.getVel_BAS(), "Failure" );
+        QVERIFY2( turbulence_1.getOmg_BAS() == turbulence_2.getOmg_BAS(), "Failure" );
+
+        if ( turbulence_1.getVel_BAS() != turbulence_3.getVel_BAS() ) different = true;
+    }
+
+    QVERIFY2( different, "Failure" );
+
+    // restarting gives the same sequence
+    fdm::Vector3 vel_bas = turbulence_1.getVel_BAS();
+
+    turbulence_1.setSeed( 1 );
+    turbulence_2.setSeed( 1 );
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        turbulence_1.update( TIME_STEP, 300.0, 60.0 );
+    }
+
+    QVERIFY2( turbulence_1.getVel_BAS() == vel_bas, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::test_intensityLowAltitude()
+{
+    // MIL-F-8785C, low altitude: sigma_w = 0.1 * W20,
+    // sigma_u = sigma_w / ( 0.177 + 0.000823 * h )^0.4
+    const double w_20[] = { 15.0, 30.0, 45.0 };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        fdm::Turbulence turbulence;
+        turbulence.setIntensity( static_cast< fdm::Turbulence::Intensity >( i + 1 ) );
+
+        double h = 100.0;
+
+        double sigma_w_ref = 0.1 * fdm::Units::kts2mps( w_20[ i ] );
+        double sigma_u_ref = sigma_w_ref / pow( 0.177 + 0.000823 * fdm::Units::m2ft( h ), 0.4 );
+
+        double sigma_u = 0.0;
+        double sigma_w = 0.0;
+
+        getStDev( &turbulence, h, &sigma_u, &sigma_w );
+
+        cout << "sigma_u= " << sigma_u << " (" << sigma_u_ref << ")";
+        cout << " sigma_w= " << sigma_w << " (" << sigma_w_ref << ")" << endl;
+
+        QVERIFY2( fabs( sigma_u - sigma_u_ref ) < 0.1 * sigma_u_ref, "Failure" );
+        QVERIFY2( fabs( sigma_w - sigma_w_ref ) < 0.1 * sigma_w_ref, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::test_intensityHighAltitude()
+{
+    // MIL-F-8785C, Figure 7, 10^-3 probability of exceedance at 7500 ft
+    fdm::Turbulence turbulence;
+    turbulence.setIntensity( fdm::Turbulence::Moderate );
+
+    double sigma_ref = fdm::Units::fps2mps( 10.1 );
+
+    double sigma_u = 0.0;
+    double sigma_w = 0.0;
+
+    getStDev( &turbulence, fdm::Units::ft2m( 7500.0 ), &sigma_u, &sigma_w );
+
+    cout << "sigma_u= " << sigma_u << " sigma_w= " << sigma_w << " (" << sigma_ref << ")" << endl;
+
+    QVERIFY2( fabs( sigma_u - sigma_ref ) < 0.15 * sigma_ref, "Failure" );
+    QVERIFY2( fabs( sigma_w - sigma_ref ) < 0.15 * sigma_ref, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::getStDev( fdm::Turbulence *turbulence, double altitude_agl,
+                               double *sigma_u, double *sigma_w )
+{
+    const int n = 200000;
+
+    double sum_u = 0.0;
+    double sum_w = 0.0;
+    double sum_sq_u = 0.0;
+    double sum_sq_w = 0.0;
+
+    for ( int i = 0; i < n; i++ )
+    {
+        turbulence->update( TIME_STEP, altitude_agl, 100.0 );
+
+        double u = turbulence->getVel_BAS().u();
+        double w = turbulence->getVel_BAS().w();
+
+        sum_u += u;
+        sum_w += w;
+        sum_sq_u += u * u;
+        sum_sq_w += w * w;
+    }
+
+    *sigma_u = sqrt( sum_sq_u / n - ( sum_u / n ) * ( sum_u / n ) );
+    *sigma_w = sqrt( sum_sq_w / n - ( sum_w / n ) * ( sum_w / n ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(TurbulenceTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_turbulence.moc"
@@ -0,0 +1,238 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/models/fdm_WindField.h>
+#include <fdm/utils/fdm_Units.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+
+#define FILE_NAME "test_fdm_windfield.bin"
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class WindFieldTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    WindFieldTest();
+
+private:
+
+    fdm::WindField::Grid _grid;
+
+    fdm::Vector3 getWindRef( double x, double y, double z, double t );
+
+    fdm::Vector3 getPos_WGS( double x, double y, double z );
+
+    void waitForSlice( fdm::WindField *windField, double time );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_notLoaded();
+    void test_interpolation();
+    void test_boundaries();
+    void test_streaming();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+WindFieldTest::WindFieldTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::initTestCase()
+{
+    _grid.nx = 11;
+    _grid.ny = 9;
+    _grid.nz = 5;
+    _grid.nt = 6;
+
+    _grid.origin.lat = fdm::Units::deg2rad( 52.0 );
+    _grid.origin.lon = fdm::Units::deg2rad( 21.0 );
+    _grid.origin.alt = 100.0;
+
+    _grid.dx = 200.0;
+    _grid.dy = 250.0;
+    _grid.dz = 100.0;
+    _grid.dt = 10.0;
+
+    _grid.scale = 0.001;
+
+    std::vector< fdm::WindField::Slice > slices;
+
+    for ( unsigned int l = 0; l < _grid.nt; l++ )
+    {
+        fdm::WindField::Slice slice;
+
+        for ( unsigned int k = 0; k < _grid.nz; k++ )
+        {
+            for ( unsigned int j = 0; j < _grid.ny; j++ )
+            {
+                for ( unsigned int i = 0; i < _grid.nx; i++ )
+                {
+                    slice.push_back( getWindRef( i * _grid.dx, j * _grid.dy, k * _grid.dz, l * _grid.dt ) );
+                }
+            }
+        }
+
+        slices.push_back( slice );
+    }
+
+    QVERIFY2( fdm::WindField::save( FILE_NAME, _grid, slices ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::cleanupTestCase()
+{
+    remove( FILE_NAME );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::test_notLoaded()
+{
+    fdm::WindField windField;
+
+    QVERIFY2( !windField.load( "not_existing_file.bin" ), "Failure" );
+    QVERIFY2( !windField.isLoaded(), "Failure" );
+
+    windField.update( TIME_STEP );
+
+    QVERIFY2( windField.getWind_WGS( getPos_WGS( 100.0, 100.0, 100.0 ) ).getLength() == 0.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::test_interpolation()
+{
+    fdm::WindField windField;
+
+    QVERIFY2( windField.load( FILE_NAME ), "Failure" );
+
+    // linear field is reproduced by trilinear interpolation
+    const double x[] = {   0.0, 130.0, 999.0, 1550.0, 2000.0 };
+    const double y[] = {   0.0, 420.0, 777.0, 1999.0,  150.0 };
+    const double z[] = { 400.0,  50.0, 333.0,   10.0,  250.0 };
+
+    double t = 0.0;
+
+    for ( int i = 0; i < 1500; i++ )
+    {
+        windField.update( TIME_STEP );
+        t += TIME_STEP;
+
+        waitForSlice( &windField, t );
+
+        for ( int n = 0; n < 5; n++ )
+        {
+            fdm::WGS84 wgs( getPos_WGS( x[ n ], y[ n ], z[ n ] ) );
+
+            fdm::Vector3 wind_ned = wgs.getWGS2NED() * windField.getWind_WGS( wgs.getPos_WGS() );
+            fdm::Vector3 wind_ref = getWindRef( x[ n ], y[ n ], z[ n ], t );
+
+            QVERIFY2( ( wind_ned - wind_ref ).getLength() < 0.02, "Failure" );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::test_boundaries()
+{
+    fdm::WindField windField;
+
+    QVERIFY2( windField.load( FILE_NAME ), "Failure" );
+
+    windField.update( TIME_STEP );
+
+    fdm::Vector3 wind_out = windField.getWind_WGS( getPos_WGS( -500.0, 5000.0, 2000.0 ) );
+    fdm::Vector3 wind_bnd = windField.getWind_WGS( getPos_WGS(    0.0, 2000.0,  400.0 ) );
+
+    QVERIFY2( ( wind_out - wind_bnd ).getLength() < 0.02, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::test_streaming()
+{
+    fdm::WindField windField;
+
+    QVERIFY2( windField.load( FILE_NAME ), "Failure" );
+
+    // beyond the last slice the last one is held
+    double t = 0.0;
+
+    while ( t < ( _grid.nt + 2 ) * _grid.dt )
+    {
+        windField.update( TIME_STEP );
+        t += TIME_STEP;
+
+        waitForSlice( &windField, t );
+    }
+
+    fdm::Vector3 wind = windField.getWind_WGS( getPos_WGS( 500.0, 500.0, 200.0 ) );
+    fdm::Vector3 wind_ned = fdm::WGS84( getPos_WGS( 500.0, 500.0, 200.0 ) ).getWGS2NED() * wind;
+    fdm::Vector3 wind_ref = getWindRef( 500.0, 500.0, 200.0, ( _grid.nt - 1 ) * _grid.dt );
+
+    QVERIFY2( ( wind_ned - wind_ref ).getLength() < 0.02, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Vector3 WindFieldTest::getWindRef( double x, double y, double z, double t )
+{
+    return fdm::Vector3( 2.0 + 0.002 * x - 0.001 * y + 0.01 * z + 0.1 * t,
+                        -1.0 + 0.001 * x + 0.003 * y - 0.02 * z - 0.05 * t,
+                         0.5 - 0.0005 * x + 0.0002 * y + 0.001 * z + 0.02 * t );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Vector3 WindFieldTest::getPos_WGS( double x, double y, double z )
+{
+    fdm::WGS84 origin( _grid.origin );
+    return origin.getPos_WGS() + origin.getNED2WGS() * fdm::Vector3( x, y, -z );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::waitForSlice( fdm::WindField *windField, double time )
+{
+    // slices are read in background, test waits until the expected slice
+    // is in use (simulation would just hold the last slice)
+    for ( int i = 0; i < 1000; i++ )
+    {
+        unsigned int slice = static_cast< unsigned int >( time / _grid.dt );
+        if ( slice > _grid.nt - 2 ) slice = _grid.nt - 2;
+
+        if ( windField->getSlice() >= slice ) return;
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        windField->update( 0.0 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(WindFieldTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_windfield.moc"
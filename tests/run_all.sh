@@ -36,8 +36,9 @@ function runAllTestsInDir()
 ################################################################################
 
 runAllTestsInDir ctrl
+runAllTestsInDir hid
 runAllTestsInDir main
-# runAllTestsInDir models
+runAllTestsInDir models
 runAllTestsInDir utils
 
 ################################################################################
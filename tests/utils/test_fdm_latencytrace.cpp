@@ -0,0 +1,192 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_LatencyTrace.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class LatencyTraceTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    LatencyTraceTest() {}
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void init();
+
+    void test_disabled();
+    void test_once();
+    void test_histogram();
+    void test_threads();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::cleanupTestCase()
+{
+    fdm::LatencyTrace::setEnabled( false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::init()
+{
+    fdm::LatencyTrace::setEnabled( true );
+    fdm::LatencyTrace::reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::test_disabled()
+{
+    fdm::LatencyTrace::setEnabled( false );
+
+    fdm::LatencyTrace::Stamp stamp = fdm::LatencyTrace::stamp( fdm::LatencyTrace::now() );
+
+    QCOMPARE( stamp.seq, (unsigned int)0 );
+
+    fdm::LatencyTrace::setEnabled( true );
+
+    // not stamped data is never recorded
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Step, stamp );
+
+    fdm::LatencyTrace::Histogram histogram;
+    fdm::LatencyTrace::getHistogram( fdm::LatencyTrace::Step, &histogram );
+
+    QCOMPARE( histogram.count, (unsigned int)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::test_once()
+{
+    fdm::LatencyTrace::Stamp s1 = fdm::LatencyTrace::stamp( fdm::LatencyTrace::now() );
+    fdm::LatencyTrace::Stamp s2 = fdm::LatencyTrace::stamp( fdm::LatencyTrace::now() );
+
+    QVERIFY2( s1.seq > 0, "Failure" );
+    QVERIFY2( s2.seq > s1.seq, "Failure" );
+
+    // the same data shown in many frames
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, s1 );
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, s1 );
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, s2 );
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, s2 );
+
+    // older data arriving late
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Frame, s1 );
+
+    fdm::LatencyTrace::Histogram histogram;
+    fdm::LatencyTrace::getHistogram( fdm::LatencyTrace::Frame, &histogram );
+
+    QCOMPARE( histogram.count, (unsigned int)2 );
+
+    // stages are independent
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Sound, s1 );
+    fdm::LatencyTrace::getHistogram( fdm::LatencyTrace::Sound, &histogram );
+
+    QCOMPARE( histogram.count, (unsigned int)1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::test_histogram()
+{
+    long long t = fdm::LatencyTrace::now();
+
+    // 3 ms and 40 ms old input samples
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Update, fdm::LatencyTrace::stamp( t -  3000000LL ) );
+    fdm::LatencyTrace::record( fdm::LatencyTrace::Update, fdm::LatencyTrace::stamp( t - 40000000LL ) );
+
+    fdm::LatencyTrace::Histogram histogram;
+    fdm::LatencyTrace::getHistogram( fdm::LatencyTrace::Update, &histogram );
+
+    QCOMPARE( histogram.count, (unsigned int)2 );
+
+    // [2048;4096) us and [32768;65536) us
+    QCOMPARE( histogram.bins[ 11 ], (unsigned int)1 );
+    QCOMPARE( histogram.bins[ 15 ], (unsigned int)1 );
+
+    QVERIFY2( histogram.max >= 40000000LL, "Failure" );
+    QVERIFY2( histogram.max <  41000000LL, "Failure" );
+    QVERIFY2( histogram.sum >= 43000000LL, "Failure" );
+
+    QCOMPARE( fdm::LatencyTrace::getPercentile( histogram, 0.5 ), 4096.0 );
+    QCOMPARE( fdm::LatencyTrace::getPercentile( histogram, 1.0 ), 65536.0 );
+
+    fdm::LatencyTrace::reset();
+    fdm::LatencyTrace::getHistogram( fdm::LatencyTrace::Update, &histogram );
+
+    QCOMPARE( histogram.count, (unsigned int)0 );
+    QCOMPARE( histogram.bins[ 11 ], (unsigned int)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyTraceTest::test_threads()
+{
+    const unsigned int count = 10000;
+
+    std::vector< fdm::LatencyTrace::Stamp > stamps( count );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        stamps[ i ] = fdm::LatencyTrace::stamp( fdm::LatencyTrace::now() );
+    }
+
+    // every stage recorded by its own thread
+    std::vector< std::thread > threads;
+
+    for ( unsigned int s = 0; s < fdm::LatencyTrace::_stages_count; s++ )
+    {
+        threads.push_back( std::thread( [ &stamps, s ]()
+        {
+            for ( unsigned int i = 0; i < stamps.size(); i++ )
+            {
+                fdm::LatencyTrace::record( (fdm::LatencyTrace::Stage)s, stamps[ i ] );
+                fdm::LatencyTrace::record( (fdm::LatencyTrace::Stage)s, stamps[ i ] );
+            }
+        } ) );
+    }
+
+    for ( unsigned int i = 0; i < threads.size(); i++ ) threads[ i ].join();
+
+    for ( unsigned int s = 0; s < fdm::LatencyTrace::_stages_count; s++ )
+    {
+        fdm::LatencyTrace::Histogram histogram;
+        fdm::LatencyTrace::getHistogram( (fdm::LatencyTrace::Stage)s, &histogram );
+
+        unsigned int sum = 0;
+        for ( unsigned int i = 0; i < fdm::LatencyTrace::_bins_count; i++ ) sum += histogram.bins[ i ];
+
+        QCOMPARE( histogram.count, count );
+        QCOMPARE( sum, count );
+    }
+
+    fdm::LatencyTrace::print( cout );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(LatencyTraceTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_latencytrace.moc"
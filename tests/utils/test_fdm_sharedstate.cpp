@@ -0,0 +1,287 @@
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_SharedState.h>
+#include <fdm/utils/fdm_SharedStateReader.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class SharedStateTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    SharedStateTest() {}
+
+private:
+
+    std::string _name;
+
+    fdm::DataInp _dataInp;
+    fdm::DataOut _dataOut;
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void init();
+
+    void test_open();
+    void test_schema();
+    void test_order();
+    void test_missed();
+    void test_threads();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::initTestCase()
+{
+    _name = std::string( FDM_SHARED_STATE_NAME ) + "_test_" + std::to_string( getpid() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::init()
+{
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::test_open()
+{
+    fdm::SharedStateReader reader;
+
+    // segment does not exist yet
+    QVERIFY2( !reader.open( _name.c_str() ), "Failure" );
+
+    fdm::SharedState state;
+
+    QVERIFY2( state.open( _name.c_str() ), "Failure" );
+    QVERIFY2( state.isOpen(), "Failure" );
+
+    QVERIFY2( reader.open( _name.c_str() ), "Failure" );
+    QVERIFY2( reader.isOpen(), "Failure" );
+
+    state.close();
+
+    // segment removed by the writer
+    QVERIFY2( !reader.open( _name.c_str() ), "Failure" );
+    QVERIFY2( !reader.isOpen(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::test_schema()
+{
+    unsigned int count = 0;
+    const fdm::SharedState::Field *fields = fdm::SharedState::getSchema( &count );
+
+    QVERIFY2( count > 0, "Failure" );
+    QVERIFY2( count <= fdm::SharedState::_fields_max, "Failure" );
+
+    // step number is the first and the last field
+    QCOMPARE( QString( fields[ 0 ].name ), QString( "step" ) );
+    QCOMPARE( QString( fields[ count - 1 ].name ), QString( "step_end" ) );
+    QCOMPARE( fields[ count - 1 ].offset, (unsigned int)( sizeof(fdm::SharedState::Snapshot) - sizeof(long long) ) );
+
+    for ( unsigned int i = 1; i < count; i++ )
+    {
+        QVERIFY2( fields[ i ].offset > fields[ i - 1 ].offset, "Failure" );
+    }
+
+    fdm::SharedState state;
+    fdm::SharedStateReader reader;
+
+    QVERIFY2( state.open( _name.c_str() ), "Failure" );
+    QVERIFY2( reader.open( _name.c_str() ), "Failure" );
+
+    QVERIFY2( reader.getField( "unknown" ) == FDM_NULLPTR, "Failure" );
+
+    const fdm::SharedState::Field *field = reader.getField( "altitude_asl" );
+
+    QVERIFY2( field != FDM_NULLPTR, "Failure" );
+    QCOMPARE( QString( field->unit ), QString( "m" ) );
+    QCOMPARE( field->type, (unsigned int)fdm::SharedState::Float64 );
+
+    const fdm::SharedState::Field *onGround = reader.getField( "onGround" );
+
+    QVERIFY2( onGround != FDM_NULLPTR, "Failure" );
+    QCOMPARE( onGround->type, (unsigned int)fdm::SharedState::Int32 );
+
+    _dataOut.flight.altitude_asl = 1234.5;
+    _dataOut.flight.onGround = true;
+
+    state.write( _dataInp, _dataOut, 1.0 );
+
+    fdm::SharedState::Snapshot snapshot;
+
+    QVERIFY2( reader.read( &snapshot ), "Failure" );
+
+    QCOMPARE( fdm::SharedStateReader::getValue( &snapshot, field    ), 1234.5 );
+    QCOMPARE( fdm::SharedStateReader::getValue( &snapshot, onGround ), 1.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::test_order()
+{
+    fdm::SharedState state;
+    fdm::SharedStateReader reader;
+
+    QVERIFY2( state.open( _name.c_str() ), "Failure" );
+    QVERIFY2( reader.open( _name.c_str() ), "Failure" );
+
+    fdm::SharedState::Snapshot snapshot;
+
+    QVERIFY2( !reader.read( &snapshot ), "Failure" );
+
+    for ( unsigned int i = 0; i < 5; i++ )
+    {
+        _dataOut.flight.roll = 0.1 * i;
+        state.write( _dataInp, _dataOut, 0.01 * i );
+    }
+
+    for ( unsigned int i = 0; i < 5; i++ )
+    {
+        QVERIFY2( reader.read( &snapshot ), "Failure" );
+
+        QCOMPARE( snapshot.step, (long long)i );
+        QCOMPARE( snapshot.step_end, (long long)i );
+        QCOMPARE( snapshot.roll, 0.1 * i );
+        QCOMPARE( snapshot.time_sim, 0.01 * i );
+    }
+
+    QVERIFY2( !reader.read( &snapshot ), "Failure" );
+
+    QCOMPARE( reader.getMissed(), (unsigned int)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::test_missed()
+{
+    fdm::SharedState state;
+    fdm::SharedStateReader reader;
+
+    QVERIFY2( state.open( _name.c_str() ), "Failure" );
+    QVERIFY2( reader.open( _name.c_str() ), "Failure" );
+
+    const unsigned int lag = 10;
+
+    for ( unsigned int i = 0; i < fdm::SharedState::_slots_count + lag; i++ )
+    {
+        state.write( _dataInp, _dataOut, 0.0 );
+    }
+
+    fdm::SharedState::Snapshot snapshot;
+
+    const unsigned int skip = lag + fdm::SharedState::_slots_count / 2;
+
+    // overtaken reader skips the older half of the ring
+    QVERIFY2( reader.read( &snapshot ), "Failure" );
+    QCOMPARE( snapshot.step, (long long)skip );
+    QCOMPARE( reader.getMissed(), skip );
+
+    unsigned int count = 1;
+    while ( reader.read( &snapshot ) ) count++;
+
+    QCOMPARE( count, fdm::SharedState::_slots_count / 2 );
+    QCOMPARE( snapshot.step, (long long)( fdm::SharedState::_slots_count + lag - 1 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedStateTest::test_threads()
+{
+    const unsigned int count = 100000;
+
+    fdm::SharedState state;
+    fdm::SharedStateReader reader;
+
+    QVERIFY2( state.open( _name.c_str() ), "Failure" );
+    QVERIFY2( reader.open( _name.c_str() ), "Failure" );
+
+    unsigned int received = 0;
+    unsigned int torn     = 0;
+
+    std::atomic< bool > started( false );
+    std::atomic< bool > done( false );
+
+    std::thread thread( [ &reader, &received, &torn, &started, &done ]()
+    {
+        fdm::SharedState::Snapshot snapshot;
+
+        started.store( true );
+
+        while ( true )
+        {
+            // all snapshots are visible once writer is done
+            bool last = done.load();
+
+            if ( reader.read( &snapshot ) )
+            {
+                // every field written from the same step number
+                if ( snapshot.step != snapshot.step_end
+                  || snapshot.altitude_asl != (double)snapshot.step
+                  || snapshot.ctrl_roll    != (double)snapshot.step )
+                {
+                    torn++;
+                }
+
+                received++;
+            }
+            else if ( last )
+            {
+                break;
+            }
+        }
+    } );
+
+    while ( !started.load() ) {}
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        _dataInp.controls.roll       = i;
+        _dataOut.flight.altitude_asl = i;
+
+        state.write( _dataInp, _dataOut, 0.0 );
+    }
+
+    done.store( true );
+    thread.join();
+
+    QCOMPARE( torn, (unsigned int)0 );
+    QCOMPARE( received + reader.getMissed(), count );
+
+    cout << "received: " << received << " missed: " << reader.getMissed()
+         << " retries: " << reader.getRetries() << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(SharedStateTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_sharedstate.moc"
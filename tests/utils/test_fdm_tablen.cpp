@@ -0,0 +1,170 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_TableN.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TableNTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TableNTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getValue2D();
+    void getValue3D();
+    void getValueSaturation();
+    void getValueSingleKey();
+    void multiplyKeys();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TableNTest::TableNTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::getValue2D()
+{
+    // f(x,y) = 2x + 3y sampled on non-uniform grid
+    fdm::TableN<2>::Keys keys[ 2 ];
+
+    keys[ 0 ] = { 0.0, 1.0, 3.0 };
+    keys[ 1 ] = { -1.0, 0.0, 2.0, 5.0 };
+
+    std::vector< double > data;
+
+    for ( double x : keys[ 0 ] )
+        for ( double y : keys[ 1 ] )
+            data.push_back( 2.0 * x + 3.0 * y );
+
+    fdm::TableN<2> table( keys, data );
+
+    QCOMPARE( table.getSize( 0 ), 3U );
+    QCOMPARE( table.getSize( 1 ), 4U );
+
+    QVERIFY( table.isValid() );
+
+    QVERIFY( fabs( table.getValue( 0.0, -1.0 ) - ( -3.0 ) ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue( 3.0,  5.0 ) -   21.0   ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue( 0.5,  1.0 ) -    4.0   ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue( 2.0,  3.5 ) -   14.5   ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::getValue3D()
+{
+    // f(x,y,z) = x*y + z is multilinear, so interpolation is exact
+    fdm::TableN<3>::Keys keys[ 3 ];
+
+    keys[ 0 ] = { -25.0, -10.0, 0.0, 10.0, 25.0 };
+    keys[ 1 ] = { -20.0, 0.0, 20.0, 45.0 };
+    keys[ 2 ] = { -30.0, 0.0, 30.0 };
+
+    std::vector< double > data;
+
+    for ( double x : keys[ 0 ] )
+        for ( double y : keys[ 1 ] )
+            for ( double z : keys[ 2 ] )
+                data.push_back( x * y + z );
+
+    fdm::TableN<3> table( keys, data );
+
+    QVERIFY( fabs( table.getValue( -10.0,  0.0,  30.0 ) -   30.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue(  -5.0, 10.0,  15.0 ) - ( -35.0 ) ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue(  17.5, 32.5, -12.0 ) - 556.75 ) < 1.0e-12 );
+
+    const double values[] = { 5.0, 30.0, 6.0 };
+    QVERIFY( fabs( table.getValue( values ) - 156.0 ) < 1.0e-12 );
+
+    const unsigned int indices[] = { 4, 3, 2 };
+    QVERIFY( fabs( table.getValueByIndex( indices ) - 1155.0 ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::getValueSaturation()
+{
+    fdm::TableN<2>::Keys keys[ 2 ];
+
+    keys[ 0 ] = { 0.0, 1.0 };
+    keys[ 1 ] = { 0.0, 1.0 };
+
+    std::vector< double > data = { 0.0, 1.0,
+                                   2.0, 3.0 };
+
+    fdm::TableN<2> table( keys, data );
+
+    QVERIFY( fabs( table.getValue( -1.0, -1.0 ) - 0.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue(  2.0,  2.0 ) - 3.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue(  2.0,  0.5 ) - 2.5 ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::getValueSingleKey()
+{
+    fdm::TableN<2>::Keys keys[ 2 ];
+
+    keys[ 0 ] = { 1.0 };
+    keys[ 1 ] = { 0.0, 2.0 };
+
+    std::vector< double > data = { 4.0, 8.0 };
+
+    fdm::TableN<2> table( keys, data );
+
+    QVERIFY( fabs( table.getValue( -5.0, 1.0 ) - 6.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue(  5.0, 1.0 ) - 6.0 ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableNTest::multiplyKeys()
+{
+    fdm::TableN<2>::Keys keys[ 2 ];
+
+    keys[ 0 ] = { 0.0, 10.0 };
+    keys[ 1 ] = { 0.0, 10.0 };
+
+    std::vector< double > data = { 0.0, 1.0,
+                                   2.0, 3.0 };
+
+    fdm::TableN<2> table( keys, data );
+
+    table.multiplyKeys( 0, 0.1 );
+    table.multiplyValues( 2.0 );
+
+    QVERIFY( fabs( table.getKeyValue( 0, 1 ) -  1.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getKeyValue( 1, 1 ) - 10.0 ) < 1.0e-12 );
+    QVERIFY( fabs( table.getValue( 0.5, 5.0 ) - 3.0 ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(TableNTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_tablen.moc"